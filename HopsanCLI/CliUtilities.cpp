@@ -258,6 +258,51 @@ size_t getNumAvailibleCores()
     return nCores;
 }
 
+//! @brief Parses a list of processor cores, such as "0-7,16-23" or "0,2,4"
+//! @param[in] rCoreList The comma separated list of cores and core ranges
+//! @param[out] rCores The core indexes in the given order
+//! @returns False if the list could not be parsed
+bool parseCoreList(const std::string &rCoreList, std::vector<size_t> &rCores)
+{
+    rCores.clear();
+    vector<string> items;
+    splitStringOnDelimiter(rCoreList, ',', items);
+    for (size_t i=0; i<items.size(); ++i)
+    {
+        const string &item = items[i];
+        if (item.empty() || (item.find_first_not_of("0123456789-") != string::npos))
+        {
+            return false;
+        }
+        const size_t dashPos = item.find('-');
+        size_t first, last;
+        if (dashPos == string::npos)
+        {
+            first = last = size_t(atoi(item.c_str()));
+        }
+        else
+        {
+            const string firstStr = item.substr(0, dashPos);
+            const string lastStr = item.substr(dashPos+1);
+            if (firstStr.empty() || lastStr.empty() || (lastStr.find('-') != string::npos))
+            {
+                return false;
+            }
+            first = size_t(atoi(firstStr.c_str()));
+            last = size_t(atoi(lastStr.c_str()));
+        }
+        if (last < first)
+        {
+            return false;
+        }
+        for (size_t c=first; c<=last; ++c)
+        {
+            rCores.push_back(c);
+        }
+    }
+    return !rCores.empty();
+}
+
 //! @brief Compares a vector with a reference vector
 //! @param rVec Vector to compare
 //! @param rRef Reference vector
@@ -55,6 +55,7 @@ void setTerminalColor(const ColorsEnumT color);
 
 // ===== Sys Functions =====
 size_t getNumAvailibleCores();
+bool parseCoreList(const std::string &rCoreList, std::vector<size_t> &rCores);
 
 // ===== Data Functions =====
 bool compareVectors(const std::vector<double> &rVec, const std::vector<double> &rRef, const double tol);
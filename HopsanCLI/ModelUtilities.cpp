@@ -40,6 +40,7 @@
 
 #ifdef USEHDF5
 #include "hopsanhdf5exporter.h"
+#include "hopsanhdf5logsink.h"
 #endif
 
 using namespace std;
@@ -470,18 +471,16 @@ void saveResultsToHDF5(ComponentSystem *pRootSystem, const string &rFileName, co
     };
 
     auto addVariable = [&exporter, howMany](const ComponentSystem* pSystem, const Component* pComponent, const Port* pPort, size_t variableIndex) {
-        const vector< vector<double> > *pLogData = pPort->getLogDataVectorPtr();
+        const LogDataStore *pLogData = pPort->getLogDataStorePtr();
         const size_t numLoggedSamples = pSystem->getNumActuallyLoggedSamples();
         if( (pLogData != nullptr) && !pLogData->empty() && (numLoggedSamples > 0)) {
+            const double *pColumn = pLogData->getColumn(variableIndex);
             HVector<double> dataVector;
             if(howMany == Full) {
-                dataVector.reserve(numLoggedSamples);
-                for (size_t t=0; t < numLoggedSamples; ++t) {
-                    dataVector.append((*pLogData)[t][variableIndex]);
-                }
+                dataVector.assign_from(pColumn, numLoggedSamples);
             }
             else {
-                dataVector.append((*pLogData)[numLoggedSamples-1][variableIndex]);
+                dataVector.append(pColumn[numLoggedSamples-1]);
             }
 
             HString parentSystemNames = generateFullSubSystemHierarchyName(pSystem,".", false);
@@ -503,6 +502,23 @@ void saveResultsToHDF5(ComponentSystem *pRootSystem, const string &rFileName, co
 #endif
 }
 
+//! @brief Create a log sink that streams results to file during simulation
+//! @param [in] rFileName File name for output file, files ending with .h5 or .hdf5 are written as HDF5, others as raw binary
+//! @returns A new log sink (the caller takes ownership) or nullptr if the format is not supported
+LogSink *createResultsStreamSink(const string &rFileName)
+{
+    const string ext = rFileName.substr(rFileName.rfind('.')+1);
+    if ((ext == "h5") || (ext == "hdf5")) {
+#ifdef USEHDF5
+        return new HopsanHDF5LogSink(rFileName.c_str(), std::string("HopsanCLI "+std::string(HOPSANCLIVERSION)).c_str());
+#else
+        printErrorMessage("HopsanCLI was built without HDF5 support");
+        return nullptr;
+#endif
+    }
+    return new BinaryFileLogSink(rFileName.c_str());
+}
+
 //! @brief Save results to HDF5 format
 //! @param [in] pRootSystem Pointer to component system
 //! @param [in] rFileName File name for output file
@@ -536,7 +552,7 @@ void saveResultsToCSV(ComponentSystem *pRootSystem, const string &rFileName, con
 
             auto addVariable = [&outfile, howMany](const ComponentSystem* pSystem, const Component* pComponent, const Port* pPort, size_t variableIndex) {
                 const NodeDataDescription& variable = *pPort->getNodeDataDescription(variableIndex);
-                const vector< vector<double> > *pLogData = pPort->getLogDataVectorPtr();
+                const LogDataStore *pLogData = pPort->getLogDataStorePtr();
                 if( (pLogData != nullptr) && !pLogData->empty()) {
                     const HString fullVarName = generateFullSubSystemHierarchyName(pSystem,"$") + pComponent->getName() + "#" + pPort->getName() + "#" + variable.name;
                     if (howMany == Final) {
@@ -547,10 +563,11 @@ void saveResultsToCSV(ComponentSystem *pRootSystem, const string &rFileName, con
                     {
                         // Only write something if data has been logged (skip ports that are not logged)
                         // We assume that the data vector has been cleared
-                        if (pPort->getLogDataVectorPtr()->size() > 0) {
+                        if (pLogData->getNumSlots() > 0) {
                             outfile << fullVarName.c_str() << "," << pPort->getVariableAlias(variableIndex).c_str() << "," << variable.unit.c_str();
+                            const double *pColumn = pLogData->getColumn(variableIndex);
                             for (size_t t=0; t<pSystem->getNumActuallyLoggedSamples(); ++t) {
-                                outfile << "," << std::scientific << (*pLogData)[t][variableIndex];
+                                outfile << "," << std::scientific << pColumn[t];
                             }
                             outfile << endl;
                         }
@@ -35,6 +35,7 @@
 #include <vector>
 #include "core_cli.h"
 #include "HopsanEssentials.h"
+#include "CoreUtilities/LogSink.h"
 
 void printTsInfo(const hopsan::ComponentSystem* pSystem);
 void printSystemParams(hopsan::ComponentSystem* pSystem);
@@ -46,6 +47,7 @@ void printComponentHierarchy(hopsan::ComponentSystem *pSystem, std::string prefi
 enum SaveResults {Final, Full};
 void saveResultsToCSV(hopsan::ComponentSystem *pRootSystem, const std::string &rFileName, const SaveResults howMany, const std::vector<std::string>& includeFilter);
 void saveResultsToHDF5(hopsan::ComponentSystem *pRootSystem, const std::string &rFileName, const std::vector<std::string>& includeFilter, const SaveResults howMany);
+hopsan::LogSink *createResultsStreamSink(const std::string &rFileName);
 
 void transposeCSVresults(const std::string &rFileName);
 void exportParameterValuesToCSV(const std::string &rFileName, hopsan::ComponentSystem* pSystem, std::string prefix="", std::ofstream *pFile=0);
@@ -123,8 +125,8 @@ void saveResultsTo(hopsan::ComponentSystem *pCurrentSystem, const std::vector<st
                     const hopsan::NodeDataDescription* pVariable = &pVariables->at(v);
 
                     // Create data vector
-                    const std::vector< std::vector<double> > *pLogData = pPort->getLogDataVectorPtr();
-                    if(pLogData == nullptr || pLogData->empty()) {
+                    const hopsan::LogDataStore *pLogData = pPort->getLogDataStorePtr();
+                    if(pLogData == nullptr || !pLogData->isLogged(v)) {
                         continue;
                     }
 
@@ -142,19 +142,20 @@ bool exportHVCData(const string modelpath, const string baseFilePath, const std:
             appendValueNode(pVariableNode, "tolerance", to_string(tol));
 
             // Write data line to csv
-            std::vector< std::vector<double> > *pLogData = rPorts[p]->getLogDataVectorPtr();
-            if (pLogData &&  pLogData->size() > 0)
+            const LogDataStore *pLogData = rPorts[p]->getLogDataStorePtr();
+            if (pLogData &&  pLogData->getNumSlots() > 0)
             {
-                size_t nRows = pLogData->size();
-                size_t nCols = pLogData->front().size();
+                size_t nRows = pLogData->getNumSlots();
+                size_t nCols = pLogData->getNumVariables();
                 const size_t c = rDataIds[p];
                 if (rDataIds[p] < nCols)
                 {
+                    const double *pColumn = pLogData->getColumn(c);
                     for (size_t r=0; r<nRows-1; ++r)
                     {
-                        csvFile << std::scientific << (*pLogData)[r][c] << ", ";
+                        csvFile << std::scientific << pColumn[r] << ", ";
                     }
-                    csvFile << std::scientific << (*pLogData)[nRows-1][c] << std::endl;
+                    csvFile << std::scientific << pColumn[nRows-1] << std::endl;
                     ++csvRow;
                 }
             }
@@ -306,12 +307,8 @@ bool extractTestData(ComponentSystem *pRootSystem, string fullVarName, std::vect
         printErrorMessage("No such varaiable name: " + varName + " in: " + pPort->getNodeType().c_str());
         return false;
     }
-    vector< vector<double> > *pLogData = pPort->getLogDataVectorPtr();
-    rvSim.reserve(rvTime.size());
-    for(size_t i=0; i<rvTime.size(); ++i)
-    {
-        rvSim.push_back(pLogData->at(i).at(dataId));
-    }
+    const double *pColumn = pPort->getLogDataStorePtr()->getColumn(dataId);
+    rvSim.assign(pColumn, pColumn+rvTime.size());
     return true;
 }
 
@@ -492,10 +489,8 @@ bool performModelTest(const std::string hvcFilePath)
                                     return false;
                                 }
 
-                                for(size_t i=0; i<vTime.size(); ++i)
-                                {
-                                    vSim1.push_back(pRootSystem->getSubComponent(compName.c_str())->getPort(portName.c_str())->getLogDataVectorPtr()->at(i).at(dataId));
-                                }
+                                const double *pSim1Column = pRootSystem->getSubComponent(compName.c_str())->getPort(portName.c_str())->getLogDataStorePtr()->getColumn(dataId);
+                                vSim1.assign(pSim1Column, pSim1Column+vTime.size());
 
                                 //Second simulation
                                 if (pRootSystem->initialize(startTime, stopTime))
@@ -510,10 +505,8 @@ bool performModelTest(const std::string hvcFilePath)
                                 }
                                 pRootSystem->finalize();
 
-                                for(size_t i=0; i<vTime.size(); ++i)
-                                {
-                                    vSim2.push_back(pRootSystem->getSubComponent(compName.c_str())->getPort(portName.c_str())->getLogDataVectorPtr()->at(i).at(dataId));
-                                }
+                                const double *pSim2Column = pRootSystem->getSubComponent(compName.c_str())->getPort(portName.c_str())->getLogDataStorePtr()->getColumn(dataId);
+                                vSim2.assign(pSim2Column, pSim2Column+vTime.size());
 
                                 // Print the messages if there were any errors or warnings
                                 if ( (gHopsanCore.getNumErrorMessages() + gHopsanCore.getNumFatalMessages() + gHopsanCore.getNumWarningMessages()) != 0)
@@ -248,18 +248,24 @@ int main(int argc, char *argv[])
         TCLAP::ValueArg<std::string> resultsFullCSVOption("", "resultsFullCSV", "Export the results (all logged data) to CSV", false, "", "Path to file", cmd);
         TCLAP::ValueArg<std::string> resultsFinalHDF5Option("", "resultsFinalHDF5", "Exeport the results (only final values) to HDF5", false, "", "Path to file", cmd);
         TCLAP::ValueArg<std::string> resultsFullHDF5Option("", "resultsFullHDF5", "Exeport the results (all logged data) to HDF5", false, "", "Path to file", cmd);
+        TCLAP::ValueArg<std::string> resultsStreamOption("", "resultsStream", "Stream the top-level system results to file during simulation instead of keeping them in memory. Files ending with .h5 are written as HDF5, others as raw binary", false, "", "Path to file", cmd);
         TCLAP::ValueArg<std::string> parameterExportOption("", "parameterExport", "CSV file with exported parameter values", false, "", "Path to file", cmd);
         TCLAP::ValueArg<std::string> parameterImportOption("", "parameterImport", "CSV file with parameter values to import", false, "", "Path to file", cmd);
         TCLAP::ValueArg<std::string> hvcTestOption("t","validate","Perform model validation based on HopsanValidationConfiguration",false,"","Path to .hvc file", cmd);
         TCLAP::ValueArg<std::string> nLogSamplesOption("l","numLogSamples","Set the number of log samples to store for the top-level system, (default: Use number in .hmf)",false,"","integer", cmd);
-        TCLAP::ValueArg<std::string> logonlyOption("","logonly","If specified, log only given ports or variables. Can be a file (one full port/variable name per line) or coma separated list.",false,"","string", cmd);
+        TCLAP::ValueArg<std::string> logonlyOption("","logonly","If specified, log only given ports or variables, no log memory is allocated for other variables. Can be a file (one full port/variable name per line) or coma separated list.",false,"","string", cmd);
         TCLAP::ValueArg<std::string> simulateOption("s","simulate","Specify simulation time as: [hmf] or [start,ts,stop] or [ts,stop] or [stop]",false,"","Comma separated string", cmd);
         TCLAP::ValueArg<std::string> parallelOption("p","parallel","Enable parallel simulation with specified number of threads. 0 threads  means auto-detect number of procssors.",false,"0","integer", cmd);
+        TCLAP::ValueArg<std::string> parallelAlgorithmOption("","parallelAlgorithm","The parallel simulation algorithm: [apriori, taskpool, taskstealing, forkjoin, clusteredforkjoin, workstealing, partitioning]",false,"apriori","string", cmd);
+        TCLAP::ValueArg<std::string> parallelBarrierOption("","parallelBarrier","How idle threads wait in parallel simulation: [spin, yield, block]",false,"spin","string", cmd);
+        TCLAP::ValueArg<std::string> parallelAffinityOption("","parallelAffinity","Pin the parallel simulation threads to these cores, e.g. 0-7,16-23. Thread i uses core i in the list",false,"","Comma separated string", cmd);
+        TCLAP::SwitchArg parallelNumaOption("","parallelNuma","Move the node data of each parallel simulation thread to the NUMA node of its core (requires --parallelAffinity)", cmd);
         TCLAP::ValueArg<std::string> extLibsFileOption("","externalLibsFile","A text file containing the external libs to load",false,"","Path to file", cmd);
         TCLAP::MultiArg<std::string> extLibPathsOption("e","externalLib","Path to a .dll/.so/.dylib externalComponentLib. Can be given multiple times",false,"Path to file", cmd);
         TCLAP::MultiArg<std::string> optimizationOption("o","optScript","Optimization scripts",false,"Path to files", cmd);
         TCLAP::MultiArg<std::string> optimizationSettings("","optSettings","Optimization settings",false,"Settings", cmd);
         TCLAP::ValueArg<std::string> hmfPathOption("m","hmf","The Hopsan model file to load",false,"","Path to file", cmd);
+        TCLAP::ValueArg<std::string> modelCacheOption("","modelCache","Load the model through this binary model cache file. The cache is rewritten from the hmf file if it is missing or out of date",false,"","Path to file", cmd);
 
         // Parse the argv array.
         cmd.parse( argc, argv );
@@ -611,7 +617,14 @@ int main(int argc, char *argv[])
                 std::vector<ComponentSystem*> rootSystemPtrs;
                 for(size_t m=0; m<nModels; ++m)
                 {
-                    rootSystemPtrs.push_back(gHopsanCore.loadHMFModelFile(hmfPathOption.getValue().c_str(), startTime, stopTime));
+                    if (modelCacheOption.isSet())
+                    {
+                        rootSystemPtrs.push_back(gHopsanCore.loadHMFModelFileCached(hmfPathOption.getValue().c_str(), modelCacheOption.getValue().c_str(), startTime, stopTime));
+                    }
+                    else
+                    {
+                        rootSystemPtrs.push_back(gHopsanCore.loadHMFModelFile(hmfPathOption.getValue().c_str(), startTime, stopTime));
+                    }
                     if(rootSystemPtrs.at(m))
                     {
                         if (parameterImportOption.isSet())
@@ -818,7 +831,15 @@ int main(int argc, char *argv[])
 
             cout << "Loading Hopsan Model File: " << hmfPathOption.getValue() << endl;
             double startTime=0, stopTime=2;
-            ComponentSystem* pRootSystem = gHopsanCore.loadHMFModelFile(hmfPathOption.getValue().c_str(), startTime, stopTime);
+            ComponentSystem* pRootSystem;
+            if (modelCacheOption.isSet())
+            {
+                pRootSystem = gHopsanCore.loadHMFModelFileCached(hmfPathOption.getValue().c_str(), modelCacheOption.getValue().c_str(), startTime, stopTime);
+            }
+            else
+            {
+                pRootSystem = gHopsanCore.loadHMFModelFile(hmfPathOption.getValue().c_str(), startTime, stopTime);
+            }
             size_t nErrors = gHopsanCore.getNumErrorMessages() + gHopsanCore.getNumFatalMessages();
             printWaitingMessages(printDebugOption.getValue(), silentOption.getValue());
             if (nErrors < 1)
@@ -910,20 +931,13 @@ int main(int argc, char *argv[])
                             splitStringOnDelimiter(file_or_list,',',logOnlyPortsOrVariables);
                         }
 
-                        // Now disable all nodes and then enable the requested ones
-                        forEachPort(pRootSystem, [](hopsan::Port& port){port.setEnableLogging(false);});
-                        for (const auto& port_name : logOnlyPortsOrVariables)
+                        // Let the core allocate and log only the requested variables
+                        std::vector<hopsan::HString> logOnlyNames;
+                        for (const auto& name : logOnlyPortsOrVariables)
                         {
-                            hopsan::Port* pPort = getPortWithFullName(pRootSystem, port_name);
-                            if (pPort)
-                            {
-                                pPort->setEnableLogging(true);
-                            }
-                            else
-                            {
-                                printWarningMessage("Could not find port: '"+port_name+"' when processing logonly input");
-                            }
+                            logOnlyNames.push_back(name.c_str());
                         }
+                        pRootSystem->setLogOnlyVariables(logOnlyNames);
                     }
 
                     // Apply loaded simulation states or only load start values
@@ -942,6 +956,16 @@ int main(int argc, char *argv[])
                         pRootSystem->setKeepValuesAsStartValues(true);
                     }
 
+                    // Stream results to file during simulation, if requested
+                    hopsan::LogSink *pResultsStreamSink = nullptr;
+                    if (resultsStreamOption.isSet())
+                    {
+                        cout << "Streaming results to file: " << destinationPath+resultsStreamOption.getValue() << endl;
+                        pResultsStreamSink = createResultsStreamSink(destinationPath+resultsStreamOption.getValue());
+                        doSimulate = doSimulate && (pResultsStreamSink != nullptr);
+                        pRootSystem->setLogSink(pResultsStreamSink, false);
+                    }
+
                     //! @todo maybe use simulation handler object instead
                     TicToc isoktimer("IsOkTime");
                     doSimulate = doSimulate && pRootSystem->checkModelBeforeSimulation();
@@ -950,6 +974,11 @@ int main(int argc, char *argv[])
                     {
                         TicToc initTimer("InitializeTime");
                         doSimulate = doSimulate && pRootSystem->initialize(startTime, stopTime);
+                        // Put back node data and internal component states, overwritten by initialize
+                        if (doSimulate && loadSimulationStateOption.isSet())
+                        {
+                            resumeSimulationPoint(loadSimulationStateOption.getValue().c_str(), pRootSystem);
+                        }
                         initTimer.TocPrint();
                     }
                     else
@@ -968,7 +997,53 @@ int main(int argc, char *argv[])
                                 printErrorMessage("Number of threads cannot be negative.");
                                 return -1;
                             }
-                            pRootSystem->simulateMultiThreaded(startTime, stopTime, nThreads);
+
+                            const string algorithmName = parallelAlgorithmOption.getValue();
+                            const char* algorithmNames[] = {"apriori", "taskpool", "taskstealing", "forkjoin", "clusteredforkjoin", "workstealing", "partitioning"};
+                            const ParallelAlgorithmT algorithms[] = {APrioriScheduling, TaskPoolAlgorithm, TaskStealingAlgorithm, ForkJoinAlgorithm, ClusteredForkJoinAlgorithm, WorkStealingAlgorithm, GraphPartitioningAlgorithm};
+                            int algorithmIdx = -1;
+                            for (int a=0; a<7; ++a) {
+                                if (algorithmName == algorithmNames[a]) {
+                                    algorithmIdx = a;
+                                }
+                            }
+                            if (algorithmIdx < 0) {
+                                printErrorMessage("Unknown parallel algorithm: "+algorithmName);
+                                return -1;
+                            }
+
+                            const string barrierName = parallelBarrierOption.getValue();
+                            if (barrierName == "spin") {
+                                pRootSystem->setMultiThreadingBarrierMode(SpinningBarrier);
+                            }
+                            else if (barrierName == "yield") {
+                                pRootSystem->setMultiThreadingBarrierMode(YieldingBarrier);
+                            }
+                            else if (barrierName == "block") {
+                                pRootSystem->setMultiThreadingBarrierMode(BlockingBarrier);
+                            }
+                            else {
+                                printErrorMessage("Unknown parallel barrier mode: "+barrierName);
+                                return -1;
+                            }
+
+                            if (parallelAffinityOption.isSet()) {
+                                vector<size_t> cores;
+                                if (!parseCoreList(parallelAffinityOption.getValue(), cores)) {
+                                    printErrorMessage("Could not parse parallel core affinity: "+parallelAffinityOption.getValue());
+                                    return -1;
+                                }
+                                pRootSystem->setMultiThreadingCoreAffinity(cores);
+                                printMessage("Pinning simulation threads to cores: "+parallelAffinityOption.getValue(), silentOption.getValue());
+                            }
+                            if (parallelNumaOption.getValue()) {
+                                if (!parallelAffinityOption.isSet()) {
+                                    printWarningMessage("--parallelNuma requires --parallelAffinity, node data will not be moved", silentOption.getValue());
+                                }
+                                pRootSystem->setMultiThreadingNumaPlacement(true);
+                            }
+
+                            pRootSystem->simulateMultiThreaded(startTime, stopTime, nThreads, false, algorithms[algorithmIdx]);
                         }
                         else {
                             pRootSystem->simulate(stopTime);
@@ -986,6 +1061,13 @@ int main(int argc, char *argv[])
                     }
 
                     pRootSystem->finalize();
+
+                    // Failures to write the streamed results are reported by finalize
+                    if (pResultsStreamSink)
+                    {
+                        pRootSystem->setLogSink(nullptr);
+                        delete pResultsStreamSink;
+                    }
                 }
 
                 printWaitingMessages(printDebugOption.getValue(), silentOption.getValue());
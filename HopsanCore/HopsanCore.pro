@@ -166,6 +166,7 @@ SOURCES += \
     src/ComponentUtilities/HopsanPowerUser.cpp \
     src/ComponentUtilities/LookupTable.cpp \
     src/ComponentUtilities/PLOParser.cpp \
+    src/ComponentUtilities/SparseLUSolver.cpp \
     src/ComponentUtilities/TempDirectoryHandle.cpp \
     $${PWD}/dependencies/indexingcsvparser/src/indexingcsvparser.cpp \
     src/Quantities.cpp \
@@ -175,7 +176,12 @@ SOURCES += \
     src/CoreUtilities/SimulationHandler.cpp \
     src/CoreUtilities/MultiThreadingUtilities.cpp \
     src/CoreUtilities/StringUtilities.cpp \
-    src/CoreUtilities/SaveRestoreSimulationPoint.cpp
+    src/CoreUtilities/SaveRestoreSimulationPoint.cpp \
+    src/CoreUtilities/NodeDataArena.cpp \
+    src/CoreUtilities/LogDataStore.cpp \
+    src/CoreUtilities/LogSink.cpp \
+    src/CoreUtilities/MappedFile.cpp \
+    src/CoreUtilities/ModelLoadProgram.cpp
 HEADERS += \
     include/win32dll.h \
     include/Port.h \
@@ -207,6 +213,7 @@ HEADERS += \
     include/ComponentUtilities/DoubleIntegratorWithDampingAndCoulumbFriction.h \
     include/ComponentUtilities/DoubleIntegratorWithDamping.h \
     include/ComponentUtilities/Delay.hpp \
+    include/ComponentUtilities/TLMLineSegments.hpp \
     include/ComponentUtilities/CSVParser.h \
     include/ComponentUtilities/AuxiliarySimulationFunctions.h \
     include/ComponentUtilities/AuxiliaryMathematicaWrapperFunctions.h \
@@ -223,6 +230,7 @@ HEADERS += \
     include/compiler_info.h \
     include/ComponentUtilities/LookupTable.h \
     include/ComponentUtilities/PLOParser.h \
+    include/ComponentUtilities/SparseLUSolver.h \
     $${PWD}/dependencies/indexingcsvparser/include/indexingcsvparser/indexingcsvparser.h \
     include/Quantities.h \
     include/NodeRWHelpfuncs.hpp \
@@ -232,7 +240,13 @@ HEADERS += \
     include/CoreUtilities/ConnectionAssistant.h \
     include/CoreUtilities/AliasHandler.h \
     include/CoreUtilities/SimulationHandler.h \
-    include/CoreUtilities/SaveRestoreSimulationPoint.h
+    include/CoreUtilities/SaveRestoreSimulationPoint.h \
+    include/CoreUtilities/NodeDataArena.h \
+    include/CoreUtilities/LogDataStore.h \
+    include/CoreUtilities/LogSink.h \
+    include/CoreUtilities/MappedFile.h \
+    include/CoreUtilities/ModelLoadProgram.h \
+    include/CoreUtilities/ComponentState.h
 
 #DO NOT remove the commented line below, it will be autoreplaced by script
 #INTERNALCOMPLIB_FMI4C_DEPENDENCY#
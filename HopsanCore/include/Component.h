@@ -37,10 +37,12 @@
 #include "Node.h"
 #include "Port.h"
 #include "Parameters.h"
+#include "CoreUtilities/ComponentState.h"
 #include "win32dll.h"
 #include <map>
 #include <list>
 #include <algorithm>
+#include <typeinfo>
 
 namespace hopsan {
 
@@ -235,6 +237,14 @@ public:
     virtual void getResiduals(double * /*y*/, double* /*res*/);
     virtual void getJacobian(double * /*y*/, double* /*f*/, double* /*J*/);
 
+    // Internal state, saved and restored together with node data in simulation points
+    virtual void saveState(ComponentStateWriter &rWriter) const;
+    virtual void restoreState(ComponentStateReader &rReader);
+
+    // Grouped simulation of components of the same type
+    typedef void (*SimulateBatchFunctionT)(Component **ppComponents, const size_t numComponents);
+    virtual SimulateBatchFunctionT getSimulateBatchFunction() const;
+
 protected:
     //==========Protected member functions==========
     // Constructor - Destructor
@@ -272,6 +282,31 @@ protected:
     // Unique name functions
     virtual HString determineUniquePortName(const HString &rPortname);
 
+    //! @brief Take one time step in a number of components of type T, without virtual calls
+    //! @details This does the same as simulate() for one time step, but T::simulateOneTimestep() can be inlined
+    template<typename T>
+    static void simulateBatch(Component **ppComponents, const size_t numComponents)
+    {
+        for (size_t i=0; i<numComponents; ++i)
+        {
+            T *pComponent = static_cast<T*>(ppComponents[i]);
+            pComponent->mTime += pComponent->mTimestep;
+            pComponent->T::simulateOneTimestep();
+        }
+    }
+
+    //! @brief Returns simulateBatch<T> if this component is exactly of type T, use this to implement getSimulateBatchFunction()
+    //! @details A type derived from T may have its own simulateOneTimestep(), so it must not be simulated as a T
+    template<typename T>
+    SimulateBatchFunctionT getSimulateBatchFunctionFor() const
+    {
+        if (typeid(*this) == typeid(T))
+        {
+            return &simulateBatch<T>;
+        }
+        return 0;
+    }
+
     //==========Protected member variables==========
     ComponentSystem* mpSystemParent;
     bool mInheritTimestep;
@@ -39,6 +39,7 @@
 #include <chrono>
 #include <ctime>
 #endif
+#include <set>
 
 #include "Component.h"
 #include "CoreUtilities/SimulationHandler.h"
@@ -47,6 +48,10 @@
 namespace hopsan {
     class NumHopHelper;
     class ComponentSystemMultiThreadPrivates;
+    class NodeDataArena;
+    class LogSink;
+    class LogSinkVariable;
+    class SimulationSnapshot;
 
     class HOPSANCORE_DLLAPI ComponentSystem :public Component
     {
@@ -129,11 +134,27 @@ namespace hopsan {
         bool checkModelBeforeSimulation();
         virtual bool preInitialize();
         bool initialize(const double startT, const double stopT);
+        void setWarmReinitialization(const bool warm);
+        bool isUsingWarmReinitialization() const;
+        void setGroupedSimulation(const bool grouped);
+        bool isUsingGroupedSimulation() const;
+        size_t getNumSimulationGroups() const;
+        static void markStructureChanged();
         void simulate(const double stopT);
         bool startRealtimeSimulation(double realTimeFactor=1);
         virtual void simulateMultiThreaded(const double startT, const double stopT, const size_t nDesiredThreads = 0, const bool noChanges=false, ParallelAlgorithmT algorithm=APrioriScheduling);
+        void setMultiThreadingBarrierMode(const BarrierModeT mode);
+        BarrierModeT getMultiThreadingBarrierMode() const;
+        void setMultiThreadingCoreAffinity(const std::vector<size_t> &rCores);
+        const std::vector<size_t> &getMultiThreadingCoreAffinity() const;
+        void setMultiThreadingNumaPlacement(const bool useNumaPlacement);
+        bool isUsingMultiThreadingNumaPlacement() const;
         void finalize();
 
+        // Runtime state snapshots
+        void takeSnapshot(SimulationSnapshot &rSnapshot) const;
+        bool restoreSnapshot(const SimulationSnapshot &rSnapshot);
+
         bool simulateAndMeasureTime(const size_t nSteps);
         double getTotalMeasuredTime();
         void sortComponentVectorsByMeasuredTime();
@@ -141,6 +162,7 @@ namespace hopsan {
         void distributeQcomponents(std::vector< std::vector<Component*> > &rSplitQVector, size_t nThreads);
         void distributeSignalcomponents(std::vector< std::vector<Component*> > &rSplitSignalVector, size_t nThreads);
         void distributeNodePointers(std::vector< std::vector<Node*> > &rSplitNodeVector, size_t nThreads);
+        void partitionCQcomponents(std::vector< std::vector<Component*> > &rSplitCVector, std::vector< std::vector<Component*> > &rSplitQVector, size_t nThreads);
         void reschedule(size_t nThreads);
 
         // Set and get desired timestep
@@ -151,6 +173,7 @@ namespace hopsan {
 
         // Log functions
         void logTimeAndNodes(const size_t simStep);
+        void flushLogData();
         void enableLog();
         void disableLog();
         std::vector<double>* getLogTimeVector();
@@ -159,6 +182,12 @@ namespace hopsan {
         void setLogStartTime(const double logStartTime);
         size_t getNumLogSamples() const;
         size_t getNumActuallyLoggedSamples() const;
+        void setLogOnlyVariables(const std::vector<HString> &rFullVariableNames);
+        void clearLogOnlyVariables();
+        const std::vector<HString> &getLogOnlyVariables() const;
+        bool isUsingLogOnlyVariables() const;
+        void setLogSink(LogSink *pLogSink, const bool keepLogDataInMemory=true);
+        LogSink *getLogSink() const;
 
         // Stop a running initialization or simulation
         void stopSimulation(const HString &rReason);
@@ -206,6 +235,36 @@ namespace hopsan {
 //        void setLogSettingsSkipFactor(double factor, double start, double stop, double sampletime);
         void setupLogSlotsAndTs(const double simStartT, const double simStopT, const double simTs);
         void preAllocateLogSpace();
+        void collectLogOnlyDataIds(const std::vector<HString> &rLogOnlyVariables, std::map<Node*, std::vector<bool> > &rLogDataIds, std::set<Port*> &rPorts,
+                                   std::map<HString, std::vector<HString> > &rSubsystemNames);
+        void calcNextLogTimeSteps(const size_t numSlots);
+        size_t findLogSlotAfterStep(const size_t simStep);
+        bool openLogSink();
+        void collectLogSinkVariables(const HString &rSystemHierarchy, std::set<std::pair<Node*, size_t> > &rAddedDataIds, std::vector<LogSinkVariable> &rVariables,
+                                     std::vector<std::pair<Node*, size_t> > &rDataIds);
+        void closeLogSink();
+
+        // Warm re-initialization
+        bool isStructureUnchangedSince(const size_t structureRevision) const;
+
+        // Grouped simulation of components of the same type
+        //! @brief Components in one C or Q stage that are simulated together, by mpSimulateBatch or one by one if it is 0
+        struct SimulationGroupT
+        {
+            Component::SimulateBatchFunctionT mpSimulateBatch;
+            std::vector<Component*> mComponents;
+        };
+        void buildSimulationGroups(const std::vector<Component*> &rComponents, std::vector<SimulationGroupT> &rGroups) const;
+        void simulateGroups(std::vector<SimulationGroupT> &rGroups);
+
+        // Node data memory layout
+        void packNodeData();
+        void placeMultiThreadedNodeData(const size_t nThreads);
+
+        // Runtime state snapshots
+        void writeSnapshot(SimulationSnapshot &rSnapshot) const;
+        bool checkSnapshotComponentNames(const SimulationSnapshot &rSnapshot, size_t &rNameIdx) const;
+        bool readSnapshot(ComponentStateReader &rReader);
 
         // Add and Remove subcomponent ptrs from storage vectors
         void addSubComponentPtrToStorage(Component* pComponent);
@@ -256,8 +315,18 @@ namespace hopsan {
         ComponentSystemMultiThreadPrivates *mpMultiThreadPrivates;
         //------------------------------------------------------------------
 
+        NodeDataArena *mpNodeDataArena;
+
         bool mKeepValuesAsStartValues;
 
+        // Warm re-initialization, model structure revisions at the last successful check and initialization
+        bool mWarmReinitialization;
+        size_t mCheckedStructureRevision, mInitializedStructureRevision;
+
+        // Grouped simulation, the C and Q components grouped by type
+        bool mUseGroupedSimulation, mGroupedSimulationActive;
+        std::vector<SimulationGroupT> mCSimulationGroups, mQSimulationGroups;
+
         AliasHandler mAliasHandler;
 
         // Log related variables
@@ -265,6 +334,20 @@ namespace hopsan {
         double mRequestedLogStartTime, mLogTimeDt;
         bool mEnableLogData;
         std::vector<double> mTimeStorage;
+        std::vector<Node*> mLoggedSubNodePtrs;
+        std::vector<HString> mLogOnlyVariables;
+        bool mUseLogOnlyVariables;
+        std::vector<HString> mForwardedLogOnlyVariables;
+        bool mHasForwardedLogOnlyVariables;
+        std::map<Node*, std::vector<bool> > mLogOnlyDataIds;
+        std::set<Port*> mLogOnlyPorts;
+        double mLogStartT, mLogSimStartT, mLogSimTs, mLastLogT, mLastLogSimT;
+        size_t mLastLogStep, mFirstLogTimeStepSlot, mNumCalculatedLogSlots;
+        LogSink *mpLogSink;
+        bool mKeepLogDataInMemory, mLogSinkIsOpen, mStreamLogDataOnly, mForwardedStreamLogDataOnly;
+        std::vector<std::pair<Node*, size_t> > mLogSinkDataIds;
+        std::vector<double> mLogSinkTimeChunk, mLogSinkValueChunk;
+        size_t mNumLogSinkChunkSamples;
     };
 
 
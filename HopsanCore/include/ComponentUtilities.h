@@ -46,6 +46,8 @@
 #include "ComponentUtilities/WhiteGaussianNoise.h"
 #include "ComponentUtilities/num2string.hpp"
 #include "ComponentUtilities/EquationSystemSolver.h"
+#include "ComponentUtilities/SparseLUSolver.h"
 #include "ComponentUtilities/LookupTable.h"
 #include "ComponentUtilities/TempDirectoryHandle.h"
+#include "ComponentUtilities/TLMLineSegments.hpp"
 #endif // COMPONENTUTILITIES_H_INCLUDED
@@ -35,6 +35,7 @@
 #define DELAY_HPP_INCLUDED
 
 #include "stddef.h"
+#include "CoreUtilities/ComponentState.h"
 
 namespace hopsan {
 
@@ -172,6 +173,50 @@ public:
         return mSize;
     }
 
+    //! @brief Save the buffer contents, from oldest to newest
+    //! @param [in,out] rWriter The state writer to append to
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(mSize);
+        for (size_t i=0; i<mSize; ++i)
+        {
+            rWriter.write(double(getOldIdx(i)));
+        }
+    }
+
+    //! @brief Restore buffer contents saved by saveState(), the buffer is reallocated if the size differs
+    //! @param [in,out] rReader The state reader to read from
+    void restoreState(ComponentStateReader &rReader)
+    {
+        size_t size=0;
+        if (!rReader.read(size))
+        {
+            return;
+        }
+        if (size > rReader.getNumRemaining())
+        {
+            rReader.setFailed();
+            return;
+        }
+        if (size == 0)
+        {
+            clear();
+            return;
+        }
+        if (size != mSize)
+        {
+            initialize(int(size), T());
+        }
+        mOldest = 0;
+        mNewest = mSize-1;
+        for (size_t i=0; i<mSize; ++i)
+        {
+            double value=0;
+            rReader.read(value);
+            mpArray[i] = T(value);
+        }
+    }
+
     //! @brief Clear the delay buffer, deleting all data
     void clear()
     {
@@ -35,6 +35,7 @@
 #define DOUBLEINTEGRATORWITHDAMPINGANDCOULUMBFRICTION_H_INCLUDED
 
 #include "win32dll.h"
+#include "CoreUtilities/ComponentState.h"
 
 namespace hopsan {
 
@@ -51,6 +52,8 @@ namespace hopsan {
         void redoIntegrate(double u);
         double valueFirst();
         double valueSecond();
+        void saveState(ComponentStateWriter &rWriter) const;
+        void restoreState(ComponentStateReader &rReader);
 
     private:
         double mDelayU, mDelayY, mDelaySY;
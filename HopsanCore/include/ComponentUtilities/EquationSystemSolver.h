@@ -39,6 +39,9 @@
 #include "ludcmp.h"
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 
 namespace hopsan {
 
@@ -67,6 +70,318 @@ private:
 };
 
 
+//! @brief A numerical solver utility for equation systems with a size known at compile time
+//! @details Solves in the same way as EquationSystemSolver, with the same LU-decomposition and the same results, but the
+//! matrices are stored in the object instead of on the heap and all loops have compile time bounds, so that they can be
+//! unrolled. Use it for small systems, up to about N=12. Optionally, the LU-decomposition of the Jacobian can be reused
+//! in later iterations and time steps, see setJacobianReuse().
+//! @ingroup ComponentUtilityClasses
+template<int N>
+class FixedSizeEquationSystemSolver
+{
+public:
+    FixedSizeEquationSystemSolver(Component *pParentComponent)
+    {
+        mpParentComponent = pParentComponent;
+
+        // Weights for equations, used when running several iterations
+        mSystemEquationWeight[0]=1;
+        mSystemEquationWeight[1]=0.67;
+        mSystemEquationWeight[2]=0.5;
+        mSystemEquationWeight[3]=0.5;
+
+        mReuseJacobian = false;
+        mMaxContraction = 0.5;
+        mMaxNumReuses = 20;
+        mHaveDecomposition = false;
+        mRefactorize = false;
+        mNumReuses = 0;
+        mPrevDeltaNorm = 0;
+    }
+
+    //! @brief Enable or disable reuse of the LU-decomposed Jacobian between iterations and time steps
+    //! @details With reuse, the Jacobian is only decomposed again when convergence degrades, that is when a Newton step
+    //! is not at least maxContraction times smaller than the previous step, when a step is not finite, or after
+    //! maxNumReuses steps. If a step with a reused decomposition is not finite, the variables are left unchanged and the
+    //! next call decomposes the Jacobian. The result is then no longer identical to a full Newton iteration.
+    //! @param [in] reuse True to enable reuse
+    //! @param [in] maxContraction The largest allowed ratio between the norms of two consecutive Newton steps
+    //! @param [in] maxNumReuses The largest number of steps that use the same decomposition
+    void setJacobianReuse(const bool reuse, const double maxContraction=0.5, const size_t maxNumReuses=20)
+    {
+        mReuseJacobian = reuse;
+        mMaxContraction = maxContraction;
+        mMaxNumReuses = maxNumReuses;
+        mHaveDecomposition = false;
+    }
+
+    //! @brief Check if the next call to solve will use the Jacobian, if not the component does not need to calculate it
+    //! @details This is always true when Jacobian reuse is disabled
+    inline bool needsJacobian() const
+    {
+        return !mReuseJacobian || !mHaveDecomposition || mRefactorize || (mNumReuses >= mMaxNumReuses);
+    }
+
+    //! @brief Make the next call to solve decompose the Jacobian
+    void resetJacobian()
+    {
+        mHaveDecomposition = false;
+    }
+
+    //! @brief Solves a system of equations
+    //! @param jacobian Jacobian matrix, it is not modified and only read if needsJacobian() is true
+    //! @param equations Vector of system equations
+    //! @param variables Vector of state variables
+    //! @param iteration How many times the solver has been executed before in the same time step
+    void solve(const double (&jacobian)[N][N], const double (&equations)[N], double (&variables)[N], const int iteration)
+    {
+        if (needsJacobian())
+        {
+            for (int i=0; i<N; ++i)
+            {
+                for (int j=0; j<N; ++j)
+                {
+                    mLU[i][j] = jacobian[i][j];
+                }
+            }
+            decompose();
+        }
+        else
+        {
+            ++mNumReuses;
+        }
+        solveDecomposed(equations);
+
+        // A reused decomposition may be too far off, then skip this step and decompose the Jacobian in the next call
+        if (mReuseJacobian && (mNumReuses > 0) && !isDeltaFinite())
+        {
+            mRefactorize = true;
+            return;
+        }
+        updateVariables(variables, iteration);
+    }
+
+    //! @brief Solves a system of equations given as Matrix and Vec, as in EquationSystemSolver
+    //! @param jacobian Jacobian matrix, it is not modified
+    //! @param equations Vector of system equations
+    //! @param variables Vector of state variables
+    //! @param iteration How many times the solver has been executed before in the same time step
+    void solve(const Matrix &jacobian, const Vec &equations, Vec &variables, const int iteration)
+    {
+        double jacobianArray[N][N], equationsArray[N], variablesArray[N];
+        for (int i=0; i<N; ++i)
+        {
+            for (int j=0; j<N; ++j)
+            {
+                jacobianArray[i][j] = jacobian[i][j];
+            }
+            equationsArray[i] = equations[i];
+            variablesArray[i] = variables[i];
+        }
+        solve(jacobianArray, equationsArray, variablesArray, iteration);
+        for (int i=0; i<N; ++i)
+        {
+            variables[i] = variablesArray[i];
+        }
+    }
+
+    //! @brief Solves a system of equations with just one iteration
+    //! @param jacobian Jacobian matrix, it is not modified
+    //! @param equations Vector of system equations
+    //! @param variables Vector of state variables
+    void solve(const Matrix &jacobian, const Vec &equations, Vec &variables)
+    {
+        solve(jacobian, equations, variables, 1);
+    }
+
+private:
+    //! @brief LU-decomposition with partial pivoting, the same algorithm as in ludcmp()
+    void decompose()
+    {
+        mHaveDecomposition = true;
+        mRefactorize = false;
+        mNumReuses = 0;
+        mPrevDeltaNorm = 0;
+
+        for (int i=0; i<N; ++i)
+        {
+            mOrder[i] = i;
+        }
+
+        // Stop simulation if LU decomposition failed due to singularity
+        bool ok = pivot(0);
+        if (ok)
+        {
+            const double diag = 1.0/mLU[0][0];
+            for (int i=1; i<N; ++i)
+            {
+                mLU[0][i] *= diag;
+            }
+
+            for (int j=1; j<N-1; ++j)
+            {
+                // Column of L's
+                for (int i=j; i<N; ++i)
+                {
+                    double sum = 0.0;
+                    for (int k=0; k<j; ++k)
+                    {
+                        sum += mLU[i][k]*mLU[k][j];
+                    }
+                    mLU[i][j] -= sum;
+                }
+                // Pivot, and check for singularity
+                if (!pivot(j))
+                {
+                    ok = false;
+                    break;
+                }
+                // Row of U's
+                const double diagj = 1.0/mLU[j][j];
+                for (int k=j+1; k<N; ++k)
+                {
+                    double sum = 0.0;
+                    for (int i=0; i<j; ++i)
+                    {
+                        sum += mLU[j][i]*mLU[i][k];
+                    }
+                    mLU[j][k] = (mLU[j][k]-sum)*diagj;
+                }
+            }
+        }
+        if (ok)
+        {
+            // Last element in L
+            double sum = 0.0;
+            for (int k=0; k<N-1; ++k)
+            {
+                sum += mLU[N-1][k]*mLU[k][N-1];
+            }
+            mLU[N-1][N-1] -= sum;
+        }
+        else if (mpParentComponent)
+        {
+            mpParentComponent->addErrorMessage("Unable to perform LU-decomposition: Jacobian matrix is probably singular.");
+            mpParentComponent->stopSimulation();
+        }
+    }
+
+    //! @brief Find the largest pivot element in column jcol and interchange rows
+    bool pivot(const int jcol)
+    {
+        int ipvt = jcol;
+        double big = fabs(mLU[ipvt][ipvt]);
+        for (int i=ipvt+1; i<N; ++i)
+        {
+            const double anext = fabs(mLU[i][jcol]);
+            if (anext > big)
+            {
+                big = anext;
+                ipvt = i;
+            }
+        }
+        if (!(fabs(big) > 0))
+        {
+            return false;
+        }
+        if (ipvt != jcol)
+        {
+            for (int k=0; k<N; ++k)
+            {
+                const double tmp = mLU[jcol][k];
+                mLU[jcol][k] = mLU[ipvt][k];
+                mLU[ipvt][k] = tmp;
+            }
+            const int tmp = mOrder[jcol];
+            mOrder[jcol] = mOrder[ipvt];
+            mOrder[ipvt] = tmp;
+        }
+        return true;
+    }
+
+    //! @brief Solve using the L and U matrices, the same algorithm as in solvlu()
+    void solveDecomposed(const double (&equations)[N])
+    {
+        double *x = mDeltaStateVar;
+        for (int i=0; i<N; ++i)
+        {
+            x[i] = equations[mOrder[i]];
+        }
+
+        // Forward substitution
+        x[0] /= mLU[0][0];
+        for (int i=1; i<N; ++i)
+        {
+            double sum = 0.0;
+            for (int j=0; j<i; ++j)
+            {
+                sum += mLU[i][j]*x[j];
+            }
+            x[i] = (x[i]-sum)/mLU[i][i];
+        }
+
+        // Back substitution, x[N-1] is already done
+        for (int i=N-2; i>=0; --i)
+        {
+            double sum = 0.0;
+            for (int j=i+1; j<N; ++j)
+            {
+                sum += mLU[i][j]*x[j];
+            }
+            x[i] -= sum;
+        }
+    }
+
+    //! @brief Check that all elements in the latest Newton step are finite
+    bool isDeltaFinite() const
+    {
+        for (int i=0; i<N; ++i)
+        {
+            if (!std::isfinite(mDeltaStateVar[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! @brief Calculate new system variables, and with Jacobian reuse check if convergence has degraded
+    void updateVariables(double (&variables)[N], const int iteration)
+    {
+        const double weight = mSystemEquationWeight[(iteration < 1) ? 0 : ((iteration > 4) ? 3 : iteration-1)];
+        double deltaNorm = 0;
+        for (int i=0; i<N; ++i)
+        {
+            if (mReuseJacobian)
+            {
+                // The step is scaled by the variable magnitude, since variables may have very different units
+                deltaNorm = std::max(deltaNorm, fabs(mDeltaStateVar[i])/(fabs(variables[i])+1e-10));
+            }
+            variables[i] = variables[i] - weight * mDeltaStateVar[i];
+        }
+
+        if (mReuseJacobian)
+        {
+            if ((mNumReuses > 0) && ((iteration > 1) && (deltaNorm > mMaxContraction*mPrevDeltaNorm)))
+            {
+                mRefactorize = true;
+            }
+            mPrevDeltaNorm = deltaNorm;
+        }
+    }
+
+    Component *mpParentComponent;
+    double mSystemEquationWeight[4];
+    double mLU[N][N];
+    double mDeltaStateVar[N];
+    int mOrder[N];
+
+    bool mReuseJacobian, mHaveDecomposition, mRefactorize;
+    double mMaxContraction, mPrevDeltaNorm;
+    size_t mMaxNumReuses, mNumReuses;
+};
+
+
 //! @ingroup ComponentUtilityClasses
 class HOPSANCORE_DLLAPI NumericalIntegrationSolver
 {
@@ -57,6 +57,8 @@ namespace hopsan {
         double delayedU() const;
         double delayedY() const;
         bool isSaturated() const;
+        void saveState(ComponentStateWriter &rWriter) const;
+        void restoreState(ComponentStateReader &rReader);
 
     protected:
         double mValue;
@@ -89,6 +91,8 @@ namespace hopsan {
         void recalculateCoefficients();
         double update(double u);
         double value();
+        void saveState(ComponentStateWriter &rWriter) const;
+        void restoreState(ComponentStateReader &rReader);
 
     private:
         double mValue;
@@ -74,6 +74,22 @@ public:
         return mDelayY;
     }
 
+    //! @brief Save the integrator states
+    //! @param[in,out] rWriter The state writer to append to
+    inline void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(mDelayU);
+        rWriter.write(mDelayY);
+    }
+
+    //! @brief Restore integrator states saved by saveState()
+    //! @param[in,out] rReader The state reader to read from
+    inline void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(mDelayU);
+        rReader.read(mDelayY);
+    }
+
 protected:
     double mDelayU, mDelayY;
     double mTimeStep;
@@ -129,6 +145,24 @@ public:
         return update(u);
     }
 
+    //! @brief Save the integrator states and the backup buffer
+    //! @param[in,out] rWriter The state writer to append to
+    inline void saveState(ComponentStateWriter &rWriter) const
+    {
+        Integrator::saveState(rWriter);
+        mBackupU.saveState(rWriter);
+        mBackupY.saveState(rWriter);
+    }
+
+    //! @brief Restore integrator states and the backup buffer saved by saveState()
+    //! @param[in,out] rReader The state reader to read from
+    inline void restoreState(ComponentStateReader &rReader)
+    {
+        Integrator::restoreState(rReader);
+        mBackupU.restoreState(rReader);
+        mBackupY.restoreState(rReader);
+    }
+
 protected:
     Delay mBackupU, mBackupY;
 
@@ -36,12 +36,82 @@
 
 #include <vector>
 #include <cstring>
+#include <cmath>
+#include <memory>
+
+#include "win32dll.h"
+#include "HopsanTypes.h"
+
+namespace hopsan {
+class MappedFile;
+}
 
 inline double interp1(const double x, const double i1, const double i2, const double v1, const double v2)
 {
     return v1 + (x-i1)*(v2-v1)/(i2-i1);
 }
 
+//! @brief The index and value data of a lookup table
+//! @details The data is either owned by the object or located in a read-only mapped table file
+class LookupTableData
+{
+public:
+    LookupTableData() : mpMappedValueData(0), mNumMappedValues(0) {}
+
+    const double *getIndexData(const size_t d) const
+    {
+        return mpMappedFile ? mMappedIndexData[d] : mIndexData[d].data();
+    }
+
+    size_t getIndexSize(const size_t d) const
+    {
+        return mpMappedFile ? mMappedIndexSizes[d] : mIndexData[d].size();
+    }
+
+    const double *getValueData() const
+    {
+        return mpMappedFile ? mpMappedValueData : mValueData.data();
+    }
+
+    size_t getNumValues() const
+    {
+        return mpMappedFile ? mNumMappedValues : mValueData.size();
+    }
+
+    //! @brief Copy mapped data into the owned data, so that it can be modified
+    void makeOwned()
+    {
+        if (mpMappedFile)
+        {
+            mIndexData.resize(mMappedIndexData.size());
+            for (size_t d=0; d<mMappedIndexData.size(); ++d)
+            {
+                mIndexData[d].assign(mMappedIndexData[d], mMappedIndexData[d]+mMappedIndexSizes[d]);
+            }
+            mValueData.assign(mpMappedValueData, mpMappedValueData+mNumMappedValues);
+            mMappedIndexData.clear();
+            mMappedIndexSizes.clear();
+            mpMappedValueData = 0;
+            mNumMappedValues = 0;
+            mpMappedFile.reset();
+        }
+    }
+
+    // Owned data
+    std::vector< std::vector<double> > mIndexData;
+    std::vector<double> mValueData;
+
+    // Mapped data, used instead of the owned data when a mapped file is set
+    std::shared_ptr<hopsan::MappedFile> mpMappedFile;
+    std::vector<const double*> mMappedIndexData;
+    std::vector<size_t> mMappedIndexSizes;
+    const double *mpMappedValueData;
+    size_t mNumMappedValues;
+};
+
+//! @brief Base class for the N-dimensional lookup tables
+//! @details The index and value data is shared between copies of a table and is copied before it is modified (copy-on-write).
+//! Copying a table that has been loaded is therefore cheap, and components that use the same table only store the data once.
 class LookupTableNDBase
 {
 
@@ -56,8 +126,9 @@ public:
 
     void clear()
     {
-        mValueData.clear();
-        mIndexData.clear(); mIndexData.resize(mNumDims);
+        // Do not touch data that may be shared with other tables, start with a new block instead
+        mpData = std::make_shared<LookupTableData>();
+        mpData->mIndexData.resize(mNumDims);
         mNumSubDimDataElements.clear(); mNumSubDimDataElements.resize(mNumDims, 0);
         mIndexIncreasingOrDecreasing.clear(); mIndexIncreasingOrDecreasing.resize(mNumDims, Unknown);
         resetFirstLast();
@@ -65,17 +136,67 @@ public:
 
     bool isEmpty() const
     {
-        return mValueData.empty();
+        return (mpData->getNumValues() == 0);
     }
 
+    size_t getNumDims() const
+    {
+        return mNumDims;
+    }
+
+    //! @brief Returns a modifiable reference to the index data, the data stops being shared with other tables
     std::vector<double> &getIndexDataRef(const size_t d)
     {
-        return mIndexData[d];
+        detachData();
+        return mpData->mIndexData[d];
     }
 
+    //! @brief Returns a modifiable reference to the value data, the data stops being shared with other tables
     std::vector<double> &getValueDataRef()
     {
-        return mValueData;
+        detachData();
+        return mpData->mValueData;
+    }
+
+    const double *getIndexData(const size_t d) const
+    {
+        return mpData->getIndexData(d);
+    }
+
+    const double *getValueData() const
+    {
+        return mpData->getValueData();
+    }
+
+    size_t getNumValues() const
+    {
+        return mpData->getNumValues();
+    }
+
+    //! @brief Returns the data block, so that it can be stored or shared
+    const std::shared_ptr<LookupTableData> &getSharedData() const
+    {
+        return mpData;
+    }
+
+    //! @brief Replace the data with a data block, that may be shared with other tables
+    //! @returns The result of isDataOK() for the new data
+    bool setSharedData(const std::shared_ptr<LookupTableData> &rpData)
+    {
+        if (!rpData || (rpData->mpMappedFile ? rpData->mMappedIndexData.size() : rpData->mIndexData.size()) != mNumDims)
+        {
+            clear();
+            return false;
+        }
+        mpData = rpData;
+        mIndexIncreasingOrDecreasing.assign(mNumDims, Unknown);
+        return isDataOK();
+    }
+
+    //! @brief Check if the data is currently shared with other tables
+    bool isDataShared() const
+    {
+        return mpData.use_count() > 1;
     }
 
     bool isDataSizeOK()
@@ -83,18 +204,18 @@ public:
         size_t num_index=1;
         for (size_t d=0; d<mNumDims; ++d)
         {
-            const size_t sz = mIndexData[d].size();
+            const size_t sz = mpData->getIndexSize(d);
             if (sz < 2)
             {
                 resetFirstLast();
                 return false;
             }
             num_index *= sz;
-            mIndexFirst[d] = mIndexData[d][0];
-            mIndexLast[d] = mIndexData[d][sz-1];
+            mIndexFirst[d] = mpData->getIndexData(d)[0];
+            mIndexLast[d] = mpData->getIndexData(d)[sz-1];
         }
 
-        return (num_index == mValueData.size());
+        return (num_index == mpData->getNumValues());
     }
 
     bool isDataOK()
@@ -110,7 +231,7 @@ public:
                 mNumSubDimDataElements[dim] = 1;
                 for (size_t sd=dim+1; sd<mNumDims; ++sd )
                 {
-                    mNumSubDimDataElements[dim] *= mIndexData[sd].size();
+                    mNumSubDimDataElements[dim] *= mpData->getIndexSize(sd);
                 }
             }
 
@@ -124,6 +245,7 @@ public:
 
                 isStrictlyInc = isStrictlyInc && (mIndexIncreasingOrDecreasing[d] == StrictlyIncreasing);
             }
+            calcUniformSteps();
             return isStrictlyInc;
         }
         else
@@ -167,27 +289,28 @@ public:
         for (size_t d=start; d<end; ++d)
         {
             mIndexIncreasingOrDecreasing[d] = NotStrictlyIncOrDec;
-            const std::vector<double> &rIndexData = mIndexData[d]; //Create reference
+            const double *pIndexData = mpData->getIndexData(d);
+            const size_t indexSize = mpData->getIndexSize(d);
 
-            if(!rIndexData.empty())
+            if(indexSize > 0)
             {
                 bool increasing=true;
                 bool decreasing=true;
-                for(size_t row=1; row<rIndexData.size(); ++row)
+                for(size_t row=1; row<indexSize; ++row)
                 {
-                    if (rIndexData[row] > rIndexData[row-1])
+                    if (pIndexData[row] > pIndexData[row-1])
                     {
                         increasing = increasing && true;
                         decreasing = false;
                     }
 
-                    if (rIndexData[row] < rIndexData[row-1])
+                    if (pIndexData[row] < pIndexData[row-1])
                     {
                         decreasing = decreasing && true;
                         increasing = false;
                     }
 
-                    if (rIndexData[row] == rIndexData[row-1])
+                    if (pIndexData[row] == pIndexData[row-1])
                     {
                         increasing = false;
                         decreasing = false;
@@ -222,6 +345,7 @@ public:
             // If row is strictly decreasing the swap row order, else run quicksort and hope for the best
             if (mIndexIncreasingOrDecreasing[d] == StrictlyDecreasing)
             {
+                detachData();
                 reverseAlongDim(d);
                 mIndexIncreasingOrDecreasing[d] = Unknown;
                 isDataOK();
@@ -229,7 +353,8 @@ public:
             // Else if not already strictly increasing then sort it
             else if (mIndexIncreasingOrDecreasing[d] == NotStrictlyIncOrDec)
             {
-                quickSort(d, mIndexData[d], 0, mIndexData[d].size()-1);
+                detachData();
+                quickSort(d, mpData->mIndexData[d], 0, mpData->mIndexData[d].size()-1);
                 mIndexIncreasingOrDecreasing[d] = Unknown;
                 isDataOK();
             }
@@ -249,7 +374,7 @@ public:
         size_t sizeOfOneSlice = mNumSubDimDataElements[dim];
         for (int d=int(dim)-1; d>=0; --d)
         {
-            sizeOfOneSlice *= mIndexData[d].size();
+            sizeOfOneSlice *= mpData->getIndexSize(d);
         }
         rData.resize(sizeOfOneSlice);
 
@@ -257,19 +382,20 @@ public:
         // Example: if dim = 0 (row)   then in a 3d case step =  numSubDimDataElements * nRows (nCols*nPlanes * nRows) (but not relevant, since will go out of range)
         // Example: if dim = 1 (col)   then in a 3d case step =  numSubDimDataElements * nCols (nPlanes * nCols)
         // Example: if dim = 3 (plane) then in a 3d case step =  numSubDimDataElements * nPlanes (1 * nPlanes)
-        size_t stepBetweenSliceParts = mNumSubDimDataElements[dim] * mIndexData[dim].size();
+        size_t stepBetweenSliceParts = mNumSubDimDataElements[dim] * mpData->getIndexSize(dim);
 
         // Calculate the start index
         size_t part_start_idx = mNumSubDimDataElements[dim]*idx;
 
         // Copy data
+        const double *pValueData = mpData->getValueData();
         size_t ctr=0;
         while (ctr<sizeOfOneSlice)
         {
             // Copy each sub dimension element
             for (size_t i=0; i<mNumSubDimDataElements[dim]; ++i)
             {
-                rData[ctr] = mValueData[part_start_idx+i];
+                rData[ctr] = pValueData[part_start_idx+i];
                 // Increment counter of how many elements we have copied
                 ++ctr;
             }
@@ -280,6 +406,8 @@ public:
 
     void insertDimDataAt(const size_t dim, const size_t idx, const std::vector<double> &rData)
     {
+        detachData();
+
         // mNumSubDimDataElements = the number of elements belonging to this dimension and sub dimensions
 
         // sizeOfOneSlice = The total number of elements in the slice to extract
@@ -289,14 +417,14 @@ public:
         size_t sizeOfOneSlice = mNumSubDimDataElements[dim];
         for (int d=int(dim)-1; d>=0; --d)
         {
-            sizeOfOneSlice *= mIndexData[d].size();
+            sizeOfOneSlice *= mpData->mIndexData[d].size();
         }
 
         // stepBetweenSlicePartsStarts = The step size between the start of each "part" of a slice
         // Example: if dim = 0 (row)   then in a 3d case step =  numSubDimDataElements * nRows (nCols*nPlanes * nRows) (but not relevant, since will go out of range)
         // Example: if dim = 1 (col)   then in a 3d case step =  numSubDimDataElements * nCols (nPlanes * nCols)
         // Example: if dim = 3 (plane) then in a 3d case step =  numSubDimDataElements * nPlanes (1 * nPlanes)
-        size_t stepBetweenSliceParts = mNumSubDimDataElements[dim] * mIndexData[dim].size();
+        size_t stepBetweenSliceParts = mNumSubDimDataElements[dim] * mpData->mIndexData[dim].size();
 
         // Calculate the start index
         size_t part_start_idx = mNumSubDimDataElements[dim]*idx;
@@ -308,7 +436,7 @@ public:
             // Copy each sub dimension element
             for (size_t i=0; i<mNumSubDimDataElements[dim]; ++i)
             {
-                mValueData[part_start_idx+i] = rData[ctr];
+                mpData->mValueData[part_start_idx+i] = rData[ctr];
                 // Increment counter of how many elements we have copied
                 ++ctr;
             }
@@ -319,16 +447,72 @@ public:
 
     size_t getDimSize(const size_t dim) const
     {
-        return mIndexData[dim].size();
+        return mpData->getIndexSize(dim);
     }
 
+    //! @brief Check if the index data along a dimension is equidistant
+    bool isIndexUniform(const size_t dim) const
+    {
+        return (mUniformInvStep[dim] > 0);
+    }
+
+    //! @brief Find the interval idx such that index[idx] < x <= index[idx+1]
+    //! @details Equidistant index data is indexed directly. For other index data the search starts in the interval
+    //! found by the previous call, since consecutive lookups usually hit the same or a neighbouring interval.
+    //! The result is the same as for a binary search over the whole index.
     //! @note Assumes that x is within index range
     size_t findIndexAlongDim(const size_t dim, const double x) const
     {
-        return intervalHalfSubDiv(x, 0, mIndexData[dim].size()-1, dim);
+        const double *pIndexData = mpData->getIndexData(dim);
+        const size_t lastInterval = mpData->getIndexSize(dim)-2;
+
+        size_t idx = mLastIndex[dim];
+        if (mUniformInvStep[dim] > 0)
+        {
+            // Written so that NaN ends up in the first interval
+            const double pos = (x - mIndexFirst[dim])*mUniformInvStep[dim];
+            idx = 0;
+            if (pos >= double(lastInterval))
+            {
+                idx = lastInterval;
+            }
+            else if (pos > 0)
+            {
+                idx = size_t(pos);
+            }
+        }
+        else if (idx > lastInterval)
+        {
+            idx = lastInterval;
+        }
+
+        // Adjust to a neighbouring interval, or search the part of the index where x must be
+        if (x <= pIndexData[idx])
+        {
+            if (idx > 0)
+            {
+                idx = (x > pIndexData[idx-1]) ? idx-1 : intervalHalfSubDiv(x, 0, idx-1, dim);
+            }
+        }
+        else if (x > pIndexData[idx+1] && idx < lastInterval)
+        {
+            idx = ((idx+1 == lastInterval) || (x <= pIndexData[idx+2])) ? idx+1 : intervalHalfSubDiv(x, idx+1, lastInterval+1, dim);
+        }
+        mLastIndex[dim] = idx;
+        return idx;
     }
 
 protected:
+    //! @brief Make sure that the data is not shared with any other table before it is modified
+    void detachData()
+    {
+        if (mpData.use_count() > 1)
+        {
+            mpData = std::make_shared<LookupTableData>(*mpData);
+        }
+        mpData->makeOwned();
+    }
+
     size_t intervalHalfSubDiv(const double x, const size_t i1, const size_t iend, const size_t dim) const
     {
         if (iend-i1 <= 1)
@@ -341,7 +525,7 @@ protected:
             //Calc split index
             size_t splitIdx = i1 + (iend - i1)/2; //Allow truncation
 
-            if (x <= mIndexData[dim][splitIdx])
+            if (x <= mpData->getIndexData(dim)[splitIdx])
             {
                 // Use lower half
                 return intervalHalfSubDiv(x, i1, splitIdx, dim);
@@ -401,7 +585,7 @@ protected:
 
     void swapDataSliceInDim(const size_t r1, const size_t r2, const size_t dim)
     {
-        std::vector<double> &rIndexdata = mIndexData[dim]; // Get reference to desired index vector
+        std::vector<double> &rIndexdata = mpData->mIndexData[dim]; // Get reference to desired index vector
 
         // Swap index
         double tmp = rIndexdata[r1];
@@ -411,9 +595,9 @@ protected:
         // Swap data
         if (mNumDims == 1)
         {
-            tmp = mValueData[r1];
-            mValueData[r1] = mValueData[r2];
-            mValueData[r2] = tmp;
+            tmp = mpData->mValueData[r1];
+            mpData->mValueData[r1] = mpData->mValueData[r2];
+            mpData->mValueData[r2] = tmp;
         }
         else
         {
@@ -435,7 +619,7 @@ protected:
             std::vector<double>::reverse_iterator rit;
             std::vector<double> tempData;
 
-            std::vector<double> &rIndexdata = mIndexData[d]; // Get reference to desired index vector
+            std::vector<double> &rIndexdata = mpData->mIndexData[d]; // Get reference to desired index vector
 
             // Reverse the index data
             tempData.reserve(rIndexdata.size());
@@ -447,16 +631,16 @@ protected:
 
             // Reverse the value data
             tempData.clear();
-            tempData.reserve(mValueData.size());
-            for (rit=mValueData.rbegin(); rit!=mValueData.rend(); ++rit)
+            tempData.reserve(mpData->mValueData.size());
+            for (rit=mpData->mValueData.rbegin(); rit!=mpData->mValueData.rend(); ++rit)
             {
                 tempData.push_back(*rit);
             }
-            mValueData.swap(tempData);
+            mpData->mValueData.swap(tempData);
         }
         else
         {
-            quickSort(d, mIndexData[d], 0, mIndexData[d].size()-1);
+            quickSort(d, mpData->mIndexData[d], 0, mpData->mIndexData[d].size()-1);
         }
     }
 
@@ -464,6 +648,40 @@ protected:
     {
         mIndexFirst.clear(); mIndexFirst.resize(mNumDims, 0);
         mIndexLast.clear(); mIndexLast.resize(mNumDims, 1);
+        mUniformInvStep.assign(mNumDims, 0);
+        mLastIndex.assign(mNumDims, 0);
+    }
+
+    //! @brief Detect equidistant index data, so that intervals can be found without searching
+    void calcUniformSteps()
+    {
+        mUniformInvStep.assign(mNumDims, 0);
+        for (size_t d=0; d<mNumDims; ++d)
+        {
+            const double *pIndexData = mpData->getIndexData(d);
+            const size_t n = mpData->getIndexSize(d);
+            if ((mIndexIncreasingOrDecreasing[d] != StrictlyIncreasing) || (n < 2))
+            {
+                continue;
+            }
+
+            // The found interval is always checked, so the steps only need to be close enough to never miss by more than one interval
+            const double step = (mIndexLast[d]-mIndexFirst[d])/double(n-1);
+            const double tolerance = 1e-3*step;
+            bool isUniform = true;
+            for (size_t i=1; i<n-1; ++i)
+            {
+                if (fabs(pIndexData[i] - (mIndexFirst[d] + double(i)*step)) > tolerance)
+                {
+                    isUniform = false;
+                    break;
+                }
+            }
+            if (isUniform)
+            {
+                mUniformInvStep[d] = 1.0/step;
+            }
+        }
     }
 
     inline double limitToRange(const size_t dim, const double val) const
@@ -496,9 +714,10 @@ protected:
     std::vector<double> mIndexFirst;
     std::vector<double> mIndexLast;
     std::vector<IncreasingEnumT> mIndexIncreasingOrDecreasing;
+    std::vector<double> mUniformInvStep;
+    mutable std::vector<size_t> mLastIndex;
 
-    std::vector< std::vector<double> > mIndexData;
-    std::vector<double> mValueData;
+    std::shared_ptr<LookupTableData> mpData;
 };
 
 class LookupTable1D : public LookupTableNDBase
@@ -513,28 +732,42 @@ public:
 
     std::vector<double> &getIndexDataRef()
     {
-        return mIndexData[0];
+        detachData();
+        return mpData->mIndexData[0];
     }
 
     double interpolate(const double x) const
     {
         // Handle outside minimum index range
+        const double *pValueData = mpData->getValueData();
         if( x<mIndexFirst[0] )
         {
-            return mValueData[0];
+            return pValueData[0];
         }
         // Handle outside maximum index range
         else if( x>=mIndexLast[0] )
         {
-            return mValueData[mValueData.size()-1];
+            return pValueData[mpData->getNumValues()-1];
         }
         // Handle in range
         {
-            const std::vector<double> &rIndexData = mIndexData[0];
+            const double *pIndexData = mpData->getIndexData(0);
             const size_t idx = findIndexAlongDim(0, x);
 
             // Note, assumes that index data is strictly increasing (two values can not be the same). That will lead to division by zero here
-            return mValueData[idx] + (x - rIndexData[idx])*(mValueData[idx+1] -  mValueData[idx])/(rIndexData[idx+1] -  rIndexData[idx]);
+            return pValueData[idx] + (x - pIndexData[idx])*(pValueData[idx+1] -  pValueData[idx])/(pIndexData[idx+1] -  pIndexData[idx]);
+        }
+    }
+
+    //! @brief Interpolate many points at once, the result is the same as calling interpolate() for each point
+    //! @param[in] pX Array with n points to look up
+    //! @param[out] pOut Array where the n results are written
+    //! @param[in] n The number of points
+    void interpolateBatch(const double *pX, double *pOut, const size_t n) const
+    {
+        for (size_t i=0; i<n; ++i)
+        {
+            pOut[i] = interpolate(pX[i]);
         }
     }
 };
@@ -566,16 +799,29 @@ public:
         const size_t bl_r = tl_r+1;
         const size_t br_r = bl_r;
 
-        const double tl_v = mValueData[calcDataIndex(tl_r, tl_c)];
-        const double tr_v = mValueData[calcDataIndex(tr_r, tr_c)];
-        const double bl_v = mValueData[calcDataIndex(bl_r, bl_c)];
-        const double br_v = mValueData[calcDataIndex(br_r, br_c)];
+        const double tl_v = mpData->getValueData()[calcDataIndex(tl_r, tl_c)];
+        const double tr_v = mpData->getValueData()[calcDataIndex(tr_r, tr_c)];
+        const double bl_v = mpData->getValueData()[calcDataIndex(bl_r, bl_c)];
+        const double br_v = mpData->getValueData()[calcDataIndex(br_r, br_c)];
 
         // Note, interp1 assumes that index data is strictly increasing (two values can not be the same). That will lead to division by zero here
-        const double val_l = interp1(r, mIndexData[0][tl_r], mIndexData[0][bl_r], tl_v, bl_v);
-        const double val_r = interp1(r, mIndexData[0][tr_r], mIndexData[0][br_r], tr_v, br_v);
+        const double val_l = interp1(r, mpData->getIndexData(0)[tl_r], mpData->getIndexData(0)[bl_r], tl_v, bl_v);
+        const double val_r = interp1(r, mpData->getIndexData(0)[tr_r], mpData->getIndexData(0)[br_r], tr_v, br_v);
 
-        return interp1(c, mIndexData[1][tl_c], mIndexData[1][tr_c], val_l, val_r);
+        return interp1(c, mpData->getIndexData(1)[tl_c], mpData->getIndexData(1)[tr_c], val_l, val_r);
+    }
+
+    //! @brief Interpolate many points at once, the result is the same as calling interpolate() for each point
+    //! @param[in] pR Array with n row coordinates
+    //! @param[in] pC Array with n column coordinates
+    //! @param[out] pOut Array where the n results are written
+    //! @param[in] n The number of points
+    void interpolateBatch(const double *pR, const double *pC, double *pOut, const size_t n) const
+    {
+        for (size_t i=0; i<n; ++i)
+        {
+            pOut[i] = interpolate(pR[i], pC[i]);
+        }
     }
 };
 
@@ -607,7 +853,21 @@ public:
         const double vph = interp2d(tl_r, tl_c, pl+1, r, c);
 
         // Return the 1d interpolation between the planes
-        return interp1(p, mIndexData[2][pl], mIndexData[2][pl+1], vpl, vph);
+        return interp1(p, mpData->getIndexData(2)[pl], mpData->getIndexData(2)[pl+1], vpl, vph);
+    }
+
+    //! @brief Interpolate many points at once, the result is the same as calling interpolate() for each point
+    //! @param[in] pR Array with n row coordinates
+    //! @param[in] pC Array with n column coordinates
+    //! @param[in] pP Array with n plane coordinates
+    //! @param[out] pOut Array where the n results are written
+    //! @param[in] n The number of points
+    void interpolateBatch(const double *pR, const double *pC, const double *pP, double *pOut, const size_t n) const
+    {
+        for (size_t i=0; i<n; ++i)
+        {
+            pOut[i] = interpolate(pR[i], pC[i], pP[i]);
+        }
     }
 
 private:
@@ -620,17 +880,104 @@ private:
         const size_t bl_r = tl_r+1;
         const size_t br_r = bl_r;
 
-        const double tl_v = mValueData[calcDataIndex(tl_r, tl_c, plane)];
-        const double tr_v = mValueData[calcDataIndex(tr_r, tr_c, plane)];
-        const double bl_v = mValueData[calcDataIndex(bl_r, bl_c, plane)];
-        const double br_v = mValueData[calcDataIndex(br_r, br_c, plane)];
+        const double tl_v = mpData->getValueData()[calcDataIndex(tl_r, tl_c, plane)];
+        const double tr_v = mpData->getValueData()[calcDataIndex(tr_r, tr_c, plane)];
+        const double bl_v = mpData->getValueData()[calcDataIndex(bl_r, bl_c, plane)];
+        const double br_v = mpData->getValueData()[calcDataIndex(br_r, br_c, plane)];
 
         // Note, interp1 assumes that index data is strictly increasing (two values can not be the same). That will lead to division by zero here
-        const double val_l = interp1(r, mIndexData[0][tl_r], mIndexData[0][bl_r], tl_v, bl_v);
-        const double val_r = interp1(r, mIndexData[0][tr_r], mIndexData[0][br_r], tr_v, br_v);
+        const double val_l = interp1(r, mpData->getIndexData(0)[tl_r], mpData->getIndexData(0)[bl_r], tl_v, bl_v);
+        const double val_r = interp1(r, mpData->getIndexData(0)[tr_r], mpData->getIndexData(0)[br_r], tr_v, br_v);
 
-        return interp1(c, mIndexData[1][tl_c], mIndexData[1][tr_c], val_l, val_r);
+        return interp1(c, mpData->getIndexData(1)[tl_c], mpData->getIndexData(1)[tr_c], val_l, val_r);
     }
 };
 
+//! @brief Lookup table with an arbitrary number of dimensions
+//! @details Values are interpolated multi-linearly between the 2^N surrounding data points.
+//! Dimension 0 is interpolated first, so for two and three dimensions the result is the same as for LookupTable2D and LookupTable3D
+class LookupTableND : public LookupTableNDBase
+{
+public:
+    LookupTableND(const size_t nDims) : LookupTableNDBase(nDims)
+    {
+        mCornerValues.resize(size_t(1) << nDims);
+        mLowIndex.resize(nDims);
+        mLimitedCoordinates.resize(nDims);
+    }
+
+    //! @brief Interpolate one point
+    //! @param[in] pCoordinates Array with one coordinate for each dimension
+    double interpolate(const double *pCoordinates) const
+    {
+        const double *pValueData = mpData->getValueData();
+
+        // Handle outside index range and find the lower corner
+        size_t lowDataIndex = 0;
+        for (size_t d=0; d<mNumDims; ++d)
+        {
+            mLimitedCoordinates[d] = limitToRange(d, pCoordinates[d]);
+            mLowIndex[d] = findIndexAlongDim(d, mLimitedCoordinates[d]);
+            lowDataIndex += mLowIndex[d]*mNumSubDimDataElements[d];
+        }
+
+        // Fetch the corner values, bit d in the corner number selects the lower or higher index in dimension d
+        const size_t numCorners = mCornerValues.size();
+        for (size_t corner=0; corner<numCorners; ++corner)
+        {
+            size_t dataIndex = lowDataIndex;
+            for (size_t d=0; d<mNumDims; ++d)
+            {
+                if (corner & (size_t(1) << d))
+                {
+                    dataIndex += mNumSubDimDataElements[d];
+                }
+            }
+            mCornerValues[corner] = pValueData[dataIndex];
+        }
+
+        // Collapse one dimension at a time, each pass halves the number of values
+        // Note, interp1 assumes that index data is strictly increasing (two values can not be the same). That will lead to division by zero here
+        size_t numValues = numCorners;
+        for (size_t d=0; d<mNumDims; ++d)
+        {
+            const double *pIndexData = mpData->getIndexData(d);
+            const double il = pIndexData[mLowIndex[d]];
+            const double ih = pIndexData[mLowIndex[d]+1];
+            numValues /= 2;
+            for (size_t i=0; i<numValues; ++i)
+            {
+                mCornerValues[i] = interp1(mLimitedCoordinates[d], il, ih, mCornerValues[2*i], mCornerValues[2*i+1]);
+            }
+        }
+        return mCornerValues[0];
+    }
+
+    //! @brief Interpolate many points at once, the result is the same as calling interpolate() for each point
+    //! @param[in] pCoordinates Array with n*nDims coordinates, the coordinates for one point are stored together
+    //! @param[out] pOut Array where the n results are written
+    //! @param[in] n The number of points
+    void interpolateBatch(const double *pCoordinates, double *pOut, const size_t n) const
+    {
+        for (size_t i=0; i<n; ++i)
+        {
+            pOut[i] = interpolate(pCoordinates+i*mNumDims);
+        }
+    }
+
+private:
+    mutable std::vector<double> mCornerValues;
+    mutable std::vector<size_t> mLowIndex;
+    mutable std::vector<double> mLimitedCoordinates;
+};
+
+namespace hopsan {
+
+bool HOPSANCORE_DLLAPI getSharedLookupTable(const HString &rKey, LookupTableNDBase &rTable);
+void HOPSANCORE_DLLAPI addSharedLookupTable(const HString &rKey, const LookupTableNDBase &rTable);
+HString HOPSANCORE_DLLAPI getLookupTableSourceKey(const HString &rFilePath, const HString &rText);
+void HOPSANCORE_DLLAPI setLookupTableCacheDirectory(const HString &rDirectory);
+
+}
+
 #endif // LOOKUPTABLE_H
@@ -59,6 +59,8 @@ namespace hopsan {
         double delayedY() const;
         double delayed2Y() const;
         bool isSaturated() const;
+        void saveState(ComponentStateWriter &rWriter) const;
+        void restoreState(ComponentStateReader &rReader);
 
     private:
         double mValue;
@@ -83,6 +85,8 @@ namespace hopsan {
         double update(double u);
         double value();
         void recalculateCoefficients();
+        void saveState(ComponentStateWriter &rWriter) const;
+        void restoreState(ComponentStateReader &rReader);
 
     private:
         double mValue;
@@ -0,0 +1,88 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   SparseLUSolver.h
+//! @author FluMeS
+//!
+//! @brief Contains a sparse LU-decomposition solver for Jacobians with a fixed sparsity pattern
+//!
+//$Id$
+
+#ifndef SPARSELUSOLVER_H_INCLUDED
+#define SPARSELUSOLVER_H_INCLUDED
+
+#include "win32dll.h"
+#include <vector>
+#include <cstddef>
+
+namespace hopsan {
+
+//! @ingroup ComponentUtilityClasses
+class HOPSANCORE_DLLAPI SparseLUSolver
+{
+public:
+    SparseLUSolver();
+
+    void setSize(const int n);
+    int getSize() const;
+
+    bool factor(const double *pMatrix);
+    void solve(double *pVector);
+
+    size_t getNumNonZeros() const;
+    size_t getNumFactorNonZeros() const;
+    size_t getNumSymbolicFactorizations() const;
+
+private:
+    bool addNonZerosToPattern(const double *pMatrix);
+    void analyzePattern();
+    bool factorWithPivoting(const double *pMatrix);
+    bool refactor(const double *pMatrix);
+
+    int mN;
+    double mPivotTolerance;
+    bool mHaveSymbolic;
+    size_t mNumSymbolicFactorizations;
+
+    // Sparsity pattern of the matrix, column-major, and its rows as column and matrix indexes
+    std::vector<char> mPattern;
+    std::vector<int> mRowStart, mRowColumns, mRowIndexes;
+
+    // Fill reducing row order, and the pivot column of each elimination step
+    std::vector<int> mRowOrder, mPivotColumns;
+
+    // Rows of L as elimination steps, and rows of U as columns with the pivot column first
+    std::vector<int> mLStart, mLSteps;
+    std::vector<double> mLValues;
+    std::vector<int> mUStart, mUColumns;
+    std::vector<double> mUValues;
+
+    std::vector<double> mWork;
+    std::vector<int> mMarks;
+};
+
+}
+
+#endif // SPARSELUSOLVER_H_INCLUDED
@@ -0,0 +1,294 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   TLMLineSegments.hpp
+//! @author FluMeS
+//!
+//! @brief Contains the Component Utility for a chain of lossless transmission line segments
+//!
+//$Id$
+
+#ifndef TLMLINESEGMENTS_HPP_INCLUDED
+#define TLMLINESEGMENTS_HPP_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include "CoreUtilities/ComponentState.h"
+
+namespace hopsan {
+
+//! @brief A chain of identical lossless transmission line (TLM) segments, updated together
+//! @details Each segment is a lossless line with a first order wave filter, as in HydraulicTLMlossless. The segments are
+//! joined by junctions without capacitance. Since all segments have the same impedance, a wave passes a junction
+//! without reflection and enters the next segment unchanged. The chain is therefore one time delay of the summed segment
+//! delays, with the wave filter applied once per segment. The wave variables of all segments are stored in one array
+//! per direction, and the delay buffers of all segments are stored in one block where each row holds one time step for
+//! all segments. The update therefore consists of a few loops over contiguous arrays that the compiler can vectorize.
+//! @ingroup ComponentUtilityClasses
+class TLMLineSegments
+{
+public:
+    TLMLineSegments()
+    {
+        mNumSegments = 0;
+        mDelaySteps = 0;
+        mHead = 0;
+        mZc = 1;
+    }
+
+    //! @brief Initialize the segments so that the line is in steady state with the given end values
+    //! @param [in] numSegments The number of segments, must be >= 1
+    //! @param [in] segmentTimeDelay The time delay of one segment, one time step is built in so it should be >= Ts
+    //! @param [in] Ts The timestep between each call to update
+    //! @param [in] Zc The characteristic impedance of each segment
+    //! @param [in] p1 The start pressure (or effort) at end 1
+    //! @param [in] q1 The start flow into the line at end 1
+    //! @param [in] p2 The start pressure (or effort) at end 2
+    //! @param [in] q2 The start flow into the line at end 2
+    void initialize(const size_t numSegments, const double segmentTimeDelay, const double Ts, const double Zc,
+                    const double p1, const double q1, const double p2, const double q2)
+    {
+        // One time step is built in, so it is subtracted from the delay buffer length
+        //We let truncation round downwards, +0.5 to be sure we don't fall bellow integer value in float
+        const int delaySteps = int((segmentTimeDelay-Ts)/Ts+0.5);
+        initialize(numSegments, size_t(delaySteps > 0 ? delaySteps : 0), Zc, p1, q1, p2, q2);
+    }
+
+    //! @brief Initialize the segments so that the line is in steady state with the given end values
+    //! @param [in] numSegments The number of segments, must be >= 1
+    //! @param [in] delaySteps The number of delay buffer steps in each segment, the segment delay will be delaySteps+1 time steps
+    //! @param [in] Zc The characteristic impedance of each segment
+    //! @param [in] p1 The start pressure (or effort) at end 1
+    //! @param [in] q1 The start flow into the line at end 1
+    //! @param [in] p2 The start pressure (or effort) at end 2
+    //! @param [in] q2 The start flow into the line at end 2
+    void initialize(const size_t numSegments, const size_t delaySteps, const double Zc,
+                    const double p1, const double q1, const double p2, const double q2)
+    {
+        mNumSegments = (numSegments < 1) ? 1 : numSegments;
+        mDelaySteps = delaySteps;
+        mHead = 0;
+        mZc = Zc;
+
+        const size_t n = mNumSegments;
+        mC1.resize(n); mC2.resize(n);
+        mNewC1.resize(n); mNewC2.resize(n);
+
+        // Pressure and flow (positive from end 1 to end 2) are interpolated linearly along the line
+        // Use the exact end values at the ends, so that a single segment matches HydraulicTLMlossless
+        for (size_t k=0; k<n; ++k)
+        {
+            const double x1 = double(k)/double(n);
+            const double x2 = double(k+1)/double(n);
+            const double pEnd1 = (k == 0) ? p1 : p1 + (p2-p1)*x1;
+            const double qEnd1 = (k == 0) ? q1 : q1 + (-q2-q1)*x1;
+            const double pEnd2 = (k+1 == n) ? p2 : p1 + (p2-p1)*x2;
+            const double qEnd2 = (k+1 == n) ? q2 : -(q1 + (-q2-q1)*x2);
+            mC1[k] = pEnd2 + Zc*qEnd2;
+            mC2[k] = pEnd1 + Zc*qEnd1;
+        }
+
+        mDelayed1.resize(mDelaySteps*n);
+        mDelayed2.resize(mDelaySteps*n);
+        for (size_t r=0; r<mDelaySteps; ++r)
+        {
+            for (size_t k=0; k<n; ++k)
+            {
+                mDelayed1[r*n+k] = mC1[k];
+                mDelayed2[r*n+k] = mC2[k];
+            }
+        }
+    }
+
+    //! @brief Take one time step, you should likely run this once in each simulateOneTimestep
+    //! @param [in] p1 The pressure (or effort) at end 1
+    //! @param [in] q1 The flow into the line at end 1
+    //! @param [in] p2 The pressure (or effort) at end 2
+    //! @param [in] q2 The flow into the line at end 2
+    //! @param [in] Zc The characteristic impedance of each segment
+    //! @param [in] alpha The low pass coefficient of the wave filter
+    inline void update(const double p1, const double q1, const double p2, const double q2, const double Zc, const double alpha)
+    {
+        const size_t n = mNumSegments;
+        mZc = Zc;
+
+        // Filter the waves entering each segment, inside the line the wave entering a segment is the one leaving its neighbour
+        filterWaves(&mC1[0], &mNewC1[0], n, 1, p2 + Zc*q2, alpha);
+        filterWaves(&mC2[0], &mNewC2[0], n, -1, p1 + Zc*q1, alpha);
+
+        // The new wave variables pass through the delay buffer of each segment
+        if (mDelaySteps > 0)
+        {
+            delayWaves(&mC1[0], &mNewC1[0], &mDelayed1[mHead*n], n);
+            delayWaves(&mC2[0], &mNewC2[0], &mDelayed2[mHead*n], n);
+            ++mHead;
+            if (mHead >= mDelaySteps)
+            {
+                mHead = 0;
+            }
+        }
+        else
+        {
+            mC1.swap(mNewC1);
+            mC2.swap(mNewC2);
+        }
+    }
+
+    //! @brief Get the wave variable to write to end 1 after update
+    inline double c1() const
+    {
+        return mC1[0];
+    }
+
+    //! @brief Get the wave variable to write to end 2 after update
+    inline double c2() const
+    {
+        return mC2[mNumSegments-1];
+    }
+
+    //! @brief Get the pressure at an internal junction, given the current wave variables
+    //! @param [in] junction The junction index, junction k connects segment k and k+1, no range check is performed
+    inline double junctionPressure(const size_t junction) const
+    {
+        return 0.5*(mC2[junction] + mC1[junction+1]);
+    }
+
+    //! @brief Get the flow from segment k to segment k+1 through an internal junction, given the current wave variables
+    //! @param [in] junction The junction index, junction k connects segment k and k+1, no range check is performed
+    inline double junctionFlow(const size_t junction) const
+    {
+        return 0.5*(mC2[junction] - mC1[junction+1])/mZc;
+    }
+
+    inline size_t getNumSegments() const
+    {
+        return mNumSegments;
+    }
+
+    //! @brief Get the number of delay buffer steps in each segment, the segment delay is one step more than this
+    inline size_t getDelaySteps() const
+    {
+        return mDelaySteps;
+    }
+
+    //! @brief Save the wave variables and the delay buffers, from oldest to newest
+    //! @param [in,out] rWriter The state writer to append to
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        const size_t n = mNumSegments;
+        rWriter.write(n);
+        rWriter.write(mDelaySteps);
+        if (n == 0)
+        {
+            return;
+        }
+        rWriter.write(&mC1[0], n);
+        rWriter.write(&mC2[0], n);
+        for (size_t i=0; i<mDelaySteps; ++i)
+        {
+            const size_t r = (mHead+i < mDelaySteps) ? mHead+i : mHead+i-mDelaySteps;
+            rWriter.write(&mDelayed1[r*n], n);
+            rWriter.write(&mDelayed2[r*n], n);
+        }
+    }
+
+    //! @brief Restore a state saved by saveState(), the number of segments and delay steps must be the same as now
+    //! @param [in,out] rReader The state reader to read from
+    void restoreState(ComponentStateReader &rReader)
+    {
+        size_t n=0, delaySteps=0;
+        if (!rReader.read(n) || !rReader.read(delaySteps))
+        {
+            return;
+        }
+        if ((n != mNumSegments) || (delaySteps != mDelaySteps))
+        {
+            rReader.setFailed();
+            return;
+        }
+        if (n == 0)
+        {
+            return;
+        }
+        rReader.read(&mC1[0], n);
+        rReader.read(&mC2[0], n);
+        mHead = 0;
+        for (size_t r=0; r<mDelaySteps; ++r)
+        {
+            rReader.read(&mDelayed1[r*n], n);
+            rReader.read(&mDelayed2[r*n], n);
+        }
+    }
+
+private:
+    //! @brief Apply the wave filter in all segments
+    //! @param [in] pC The current wave variables
+    //! @param [out] pNewC The filtered wave variables
+    //! @param [in] n The number of segments
+    //! @param [in] direction 1 if the waves entering segment k come from segment k+1, -1 if they come from segment k-1
+    //! @param [in] cEnd The wave entering the outermost segment from the line end
+    //! @param [in] alpha The low pass coefficient of the wave filter
+    static inline void filterWaves(const double *pC, double *pNewC, const size_t n, const int direction, const double cEnd, const double alpha)
+    {
+        const double beta = 1.0-alpha;
+        if (direction > 0)
+        {
+            for (size_t k=0; k+1<n; ++k)
+            {
+                pNewC[k] = alpha*pC[k] + beta*pC[k+1];
+            }
+            pNewC[n-1] = alpha*pC[n-1] + beta*cEnd;
+        }
+        else
+        {
+            pNewC[0] = alpha*pC[0] + beta*cEnd;
+            for (size_t k=1; k<n; ++k)
+            {
+                pNewC[k] = alpha*pC[k] + beta*pC[k-1];
+            }
+        }
+    }
+
+    //! @brief Pop the oldest row of the delay buffer into pC and push pNewC in its place
+    static inline void delayWaves(double *pC, const double *pNewC, double *pDelayedRow, const size_t n)
+    {
+        for (size_t k=0; k<n; ++k)
+        {
+            pC[k] = pDelayedRow[k];
+            pDelayedRow[k] = pNewC[k];
+        }
+    }
+
+    size_t mNumSegments, mDelaySteps, mHead;
+    double mZc;
+    // Wave variables leaving each segment at end 1 and end 2, and the new values before they are delayed
+    std::vector<double> mC1, mC2, mNewC1, mNewC2;
+    // Delay buffers, row r holds the values of all segments for one time step
+    std::vector<double> mDelayed1, mDelayed2;
+};
+
+}
+
+#endif // TLMLINESEGMENTS_HPP_INCLUDED
@@ -0,0 +1,223 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   ComponentState.h
+//! @author FluMeS
+//!
+//! @brief Contains the writer and reader used to save and restore the internal state of components
+//!
+//$Id$
+
+#ifndef COMPONENTSTATE_H
+#define COMPONENTSTATE_H
+
+#include <vector>
+#include <cstddef>
+
+namespace hopsan {
+
+//! @brief Appends the internal state of a component to a flat buffer
+//! @details All values are stored as doubles, so a saved state is always 8-byte aligned and can be read in place
+//! from a memory mapped simulation point file. Only the dynamic state should be written, not values that are
+//! derived from parameters, so that a restored component still uses its current parameter values.
+//! @ingroup ComponentUtilityClasses
+class ComponentStateWriter
+{
+public:
+    inline void write(const double value)
+    {
+        mData.push_back(value);
+    }
+
+    inline void write(const bool value)
+    {
+        mData.push_back(value ? 1.0 : 0.0);
+    }
+
+    inline void write(const int value)
+    {
+        mData.push_back(double(value));
+    }
+
+    inline void write(const size_t value)
+    {
+        mData.push_back(double(value));
+    }
+
+    inline void write(const double *pValues, const size_t numValues)
+    {
+        mData.insert(mData.end(), pValues, pValues+numValues);
+    }
+
+    //! @brief Append a value that is set later with setValue(), such as the size of a block of values that follows
+    //! @returns The index of the value
+    inline size_t writePlaceholder()
+    {
+        mData.push_back(0.0);
+        return mData.size()-1;
+    }
+
+    inline void setValue(const size_t idx, const double value)
+    {
+        mData[idx] = value;
+    }
+
+    inline const std::vector<double> &getData() const
+    {
+        return mData;
+    }
+
+    inline size_t getNumValues() const
+    {
+        return mData.size();
+    }
+
+    inline void clear()
+    {
+        mData.clear();
+    }
+
+private:
+    std::vector<double> mData;
+};
+
+//! @brief Reads back a component state written by ComponentStateWriter
+//! @details Values must be read in the same order as they were written. Reading past the end fails and sets a
+//! sticky failure flag, so a restore function can read everything and check hasFailed() once at the end.
+//! @ingroup ComponentUtilityClasses
+class ComponentStateReader
+{
+public:
+    ComponentStateReader(const double *pData, const size_t numValues)
+        : mpData(pData), mNumValues(numValues), mPosition(0), mHasFailed(false) {}
+
+    inline bool read(double &rValue)
+    {
+        if (mPosition < mNumValues)
+        {
+            rValue = mpData[mPosition++];
+            return true;
+        }
+        mHasFailed = true;
+        return false;
+    }
+
+    inline bool read(bool &rValue)
+    {
+        double value;
+        if (read(value))
+        {
+            rValue = (value != 0.0);
+            return true;
+        }
+        return false;
+    }
+
+    inline bool read(int &rValue)
+    {
+        double value;
+        if (read(value))
+        {
+            rValue = int(value);
+            return true;
+        }
+        return false;
+    }
+
+    inline bool read(size_t &rValue)
+    {
+        double value;
+        if (read(value) && (value >= 0.0))
+        {
+            rValue = size_t(value);
+            return true;
+        }
+        mHasFailed = true;
+        return false;
+    }
+
+    inline bool read(double *pValues, const size_t numValues)
+    {
+        if (mPosition+numValues <= mNumValues)
+        {
+            for (size_t i=0; i<numValues; ++i)
+            {
+                pValues[i] = mpData[mPosition+i];
+            }
+            mPosition += numValues;
+            return true;
+        }
+        mHasFailed = true;
+        return false;
+    }
+
+    //! @brief Read a block of values as a reader of its own, the block is skipped in this reader
+    //! @param [in] numValues The number of values in the block
+    //! @returns A reader for the block, it has failed if there were not enough values left
+    inline ComponentStateReader readBlock(const size_t numValues)
+    {
+        if (mPosition+numValues <= mNumValues)
+        {
+            ComponentStateReader block(mpData+mPosition, numValues);
+            mPosition += numValues;
+            return block;
+        }
+        mHasFailed = true;
+        ComponentStateReader block(0, 0);
+        block.setFailed();
+        return block;
+    }
+
+    inline size_t getNumRemaining() const
+    {
+        return mNumValues-mPosition;
+    }
+
+    inline bool isAtEnd() const
+    {
+        return mPosition == mNumValues;
+    }
+
+    inline bool hasFailed() const
+    {
+        return mHasFailed;
+    }
+
+    //! @brief Mark the restore as failed, use this when the read data is inconsistent with the component
+    inline void setFailed()
+    {
+        mHasFailed = true;
+    }
+
+private:
+    const double *mpData;
+    size_t mNumValues;
+    size_t mPosition;
+    bool mHasFailed;
+};
+
+}
+
+#endif // COMPONENTSTATE_H
@@ -58,11 +58,40 @@ HVector<HString> HOPSANCORE_DLLAPI findValuesNeedingPrependSelfInEmbeddedInitScr
 void HOPSANCORE_DLLAPI autoPrependSelfToEmbeddedInitScript(ComponentSystem* pSystem);
 
 ComponentSystem* loadHopsanModelFile(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime);
+ComponentSystem* loadHopsanModelFileCached(const HString &rFilePath, const HString &rCacheFilePath, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime);
+bool loadHopsanModelFileCopies(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, const size_t nCopies, std::vector<ComponentSystem*> &rSystems, double &rStartTime, double &rStopTime);
 ComponentSystem* loadHopsanModel(const std::vector<unsigned char> xmlVector, HopsanEssentials* pHopsanEssentials);
 ComponentSystem* loadHopsanModel(const char* xmlStr, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime);
 ComponentSystem* loadHopsanModel(char* xmlStr, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime);
 size_t loadHopsanParameterFile(const HString &filePath, HopsanCoreMessageHandler *pMessageHandler, hopsan::Component *pComponentOrSystem);
 
+class ModelLoadProgram;
+
+//! @brief A model that has been read once and from which any number of independent instances can be created
+//! @details The template keeps the parsed model, so creating an instance does not read or parse the model files again.
+//! Parameter texts, descriptions and lookup table data are shared between the instances until an instance changes them,
+//! each instance only stores its own state.
+class HOPSANCORE_DLLAPI ModelTemplate
+{
+public:
+    ModelTemplate(HopsanEssentials* pHopsanEssentials);
+    ~ModelTemplate();
+
+    bool loadFile(const HString &rFilePath);
+    bool isLoaded() const;
+    ComponentSystem* createInstance();
+
+    double getStartTime() const;
+    double getStopTime() const;
+
+private:
+    ModelTemplate(const ModelTemplate &rOther);
+    ModelTemplate &operator=(const ModelTemplate &rOther);
+
+    HopsanEssentials* mpHopsanEssentials;
+    ModelLoadProgram* mpProgram;
+};
+
 }
 
 #endif
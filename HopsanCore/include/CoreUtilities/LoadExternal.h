@@ -68,6 +68,7 @@ public:
     bool unLoad(const HString &rLibpath);
     void setFactory();
     void getLoadedLibNames(std::vector<HString> &rLibNames);
+    void getLoadedLibPaths(std::vector<HString> &rLibPaths);
     void getLibContents(const HString &rLibpath, std::vector<HString> &rComponents, std::vector<HString> &rNodes);
     void getLibPathByTypeName(const HString &rTypeName, HString &rLibPath);
 };
@@ -0,0 +1,84 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   LogDataStore.h
+//! @author FluMeS
+//!
+//! @brief Contains the columnar log data store class
+//!
+//$Id$
+
+#ifndef LOGDATASTORE_H
+#define LOGDATASTORE_H
+
+#include <vector>
+#include <cstddef>
+
+#include "win32dll.h"
+
+namespace hopsan {
+
+//! @brief Columnar storage for logged node data
+//! @details Each logged variable is stored in one contiguous column with one value per log slot.
+//! Samples are first gathered row by row in a small chunk buffer, which is written to the columns once every ChunkSize samples.
+//! Pending samples are written by flush(), which must be called from the logging thread before the last samples are read.
+//! The const functions only read, so they never change the data that the logging thread writes.
+//! Optionally only a subset of the variables is logged, the other variables get no column at all.
+class HOPSANCORE_DLLAPI LogDataStore
+{
+public:
+    LogDataStore();
+
+    void allocate(const size_t numVariables, const size_t numSlots, const std::vector<bool> &rLogVariables=std::vector<bool>());
+    void clear();
+    bool empty() const;
+
+    size_t getNumVariables() const;
+    size_t getNumLoggedVariables() const;
+    size_t getNumSlots() const;
+    bool isLogged(const size_t dataId) const;
+
+    void logSample(const size_t slot, const double *pValues);
+    void flush();
+
+    const double *getColumn(const size_t dataId) const;
+    double getValue(const size_t slot, const size_t dataId) const;
+
+    static const size_t ChunkSize = 64;
+
+private:
+    size_t mNumVariables;
+    size_t mNumSlots;
+    std::vector<size_t> mLoggedDataIds;
+    std::vector<size_t> mColumnIndexes;
+    std::vector<double> mColumns;
+    std::vector<double> mChunk;
+    size_t mChunkStartSlot;
+    size_t mNumChunkSamples;
+};
+
+}
+
+#endif // LOGDATASTORE_H
@@ -0,0 +1,152 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   LogSink.h
+//! @author FluMeS
+//!
+//! @brief Contains the log sink interface and the built-in log sinks
+//!
+//$Id$
+
+#ifndef LOGSINK_H
+#define LOGSINK_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+
+#include "win32dll.h"
+#include "HopsanTypes.h"
+
+namespace hopsan {
+
+//! @brief Description of one variable written to a log sink
+class HOPSANCORE_DLLAPI LogSinkVariable
+{
+public:
+    //! The names of the subsystems from the logged system to the variable, each followed by $, empty for variables in the logged system
+    HString systemHierarchy;
+    HString componentName;
+    HString portName;
+    HString variableName;
+    HString alias;
+    HString unit;
+    HString quantity;
+};
+
+//! @brief Interface for receiving logged data while a simulation is running
+//! @details A sink is attached to a ComponentSystem with ComponentSystem::setLogSink(). It is opened when the system is initialized,
+//! receives chunks of log samples during simulation and is closed when the system is finalized. The logged variables in the subsystems
+//! are included.
+class HOPSANCORE_DLLAPI LogSink
+{
+public:
+    virtual ~LogSink();
+
+    //! @brief Open the sink before the first chunk is written
+    //! @param[in] rSystemName The name of the system that is logged
+    //! @param[in] rVariables Descriptions of the logged variables, in the order they appear in each sample
+    //! @returns true if successful, use getLastError() to get the reason on failure
+    virtual bool open(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables) = 0;
+
+    //! @brief Write a chunk of log samples
+    //! @param[in] pTime Pointer to numSamples time values
+    //! @param[in] pValues Pointer to numSamples samples, each with one value per variable (sample by sample)
+    //! @param[in] numSamples The number of samples in the chunk
+    virtual void writeChunk(const double *pTime, const double *pValues, const size_t numSamples) = 0;
+
+    //! @brief Close the sink, all written chunks must have reached their destination when this returns
+    //! @returns true if all chunks were written successfully, use getLastError() to get the reason on failure
+    virtual bool close() = 0;
+
+    const HString &getLastError() const;
+
+protected:
+    HString mLastError;
+};
+
+class ThreadedLogSinkPrivates;
+
+//! @brief Base class for log sinks that write their output from a background thread
+//! @details Chunks are gathered in a front buffer. When it is full it is swapped with the back buffer, which is written by the background thread
+//! while the simulation continues filling the front buffer. Without multi-threading support the output is written directly instead.
+//! Derived classes must call close() in their destructor.
+class HOPSANCORE_DLLAPI ThreadedLogSink : public LogSink
+{
+public:
+    ThreadedLogSink(const size_t bufferSamples=4096);
+    virtual ~ThreadedLogSink();
+
+    bool open(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables);
+    void writeChunk(const double *pTime, const double *pValues, const size_t numSamples);
+    bool close();
+
+protected:
+    //! @brief Open the output, called from the thread calling open()
+    virtual bool openOutput(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables) = 0;
+    //! @brief Write buffered samples to the output, called from the background thread
+    //! @returns false on failure, after setting mLastError, no more samples are written after a failure
+    virtual bool writeOutput(const double *pTime, const double *pValues, const size_t numSamples) = 0;
+    //! @brief Close the output, called after all buffered samples have been written
+    //! @returns false on failure, after setting mLastError
+    virtual bool closeOutput() = 0;
+
+    size_t getNumVariables() const;
+
+private:
+    void swapAndWriteBuffers();
+    void writeBackBuffer();
+
+    ThreadedLogSinkPrivates *mpPrivates;
+    size_t mBufferSamples, mNumVariables, mNumFrontSamples, mNumBackSamples;
+    std::vector<double> mFrontTime, mBackTime, mFrontValues, mBackValues;
+    bool mIsOpen, mOutputFailed;
+};
+
+//! @brief Log sink that writes samples to a raw binary file
+//! @details The file starts with the text "HOPSANLOG", a 32-bit format version and the 64-bit number of variables.
+//! Then, for each variable, the full name, unit and quantity follow as 32-bit length prefixed strings.
+//! After that each sample is written as the time followed by one value for each variable, all as native doubles.
+class HOPSANCORE_DLLAPI BinaryFileLogSink : public ThreadedLogSink
+{
+public:
+    BinaryFileLogSink(const HString &rFilePath, const size_t bufferSamples=4096);
+    ~BinaryFileLogSink();
+
+    static const unsigned int FormatVersion = 1;
+
+protected:
+    bool openOutput(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables);
+    bool writeOutput(const double *pTime, const double *pValues, const size_t numSamples);
+    bool closeOutput();
+
+private:
+    HString mFilePath;
+    FILE *mpFile;
+};
+
+}
+
+#endif // LOGSINK_H
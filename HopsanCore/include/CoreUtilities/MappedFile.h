@@ -0,0 +1,73 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   MappedFile.h
+//! @author FluMeS
+//!
+//! @brief Contains a read-only memory mapped file
+//!
+//$Id$
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+
+#include "win32dll.h"
+#include "HopsanTypes.h"
+
+namespace hopsan {
+
+//! @brief A read-only memory mapping of a whole file
+//! @details The file contents can be accessed in place until close() is called or the object is destroyed.
+//! The mapping is page aligned, so data placed at 8-byte aligned offsets in the file can be read as doubles.
+class HOPSANCORE_DLLAPI MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const HString &rFilePath);
+    void close();
+    bool isOpen() const;
+
+    const char *getData() const;
+    size_t getSize() const;
+
+private:
+    MappedFile(const MappedFile &rOther);
+    MappedFile &operator=(const MappedFile &rOther);
+
+    const char *mpData;
+    size_t mSize;
+#ifdef _WIN32
+    void *mpFileHandle;
+    void *mpMappingHandle;
+#endif
+};
+
+}
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,119 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   ModelLoadProgram.h
+//! @author FluMeS
+//!
+//! @brief Contains the model load program and the binary model cache file
+//!
+//$Id$
+
+#ifndef MODELLOADPROGRAM_H
+#define MODELLOADPROGRAM_H
+
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+#include "win32dll.h"
+#include "HopsanTypes.h"
+
+namespace hopsan {
+
+//! @brief The resolved sequence of operations that builds a model
+//! @details Model files are translated into a load program after the model file upgrades have been applied, running the
+//! program then builds the model. The program can be saved as a binary model cache file, loading the cache is much faster
+//! than parsing and upgrading the model file again.
+class HOPSANCORE_DLLAPI ModelLoadProgram
+{
+public:
+    enum OpCodeT {InvalidOp, CreateSystemOp, CreateConditionalSystemOp, AddToParentSystemOp, EndSystemOp, SetSystemNameOp,
+                  SetSystemDisabledOp, SetTimestepOp, SetLogStartTimeOp, SetNumLogSamplesOp, SystemParameterOp,
+                  PrependSelfToSystemParametersOp, NumHopScriptOp, PrependSelfToScriptOp, ComponentOp, ComponentParameterOp,
+                  PrependSelfToComponentParametersOp, PortQuantityOp, SystemPortOp, ConnectOp, VariableAliasOp,
+                  AddSearchPathOp, SetExternalPathOp, NumOpCodes};
+
+    ModelLoadProgram();
+    void clear();
+
+    // Writing the program
+    void addOp(const OpCodeT op);
+    void addString(const HString &rString);
+    void addDouble(const double value);
+    void addInt(const int value);
+    size_t getSize() const;
+    void truncate(const size_t size);
+
+    // Reading the program, reading past the end gives InvalidOp and zero values
+    bool atEnd(const size_t pos) const;
+    OpCodeT readOp(size_t &rPos) const;
+    const HString &readString(size_t &rPos) const;
+    double readDouble(size_t &rPos) const;
+    int readInt(size_t &rPos) const;
+
+    void setSimulationTime(const double startTime, const double stopTime);
+    double getStartTime() const;
+    double getStopTime() const;
+
+    void addDependency(const HString &rFilePath);
+    const std::vector<HString> &getDependencies() const;
+    void setCacheable(const bool cacheable);
+    bool isCacheable() const;
+
+    // The binary model cache file
+    bool save(const HString &rFilePath, const uint64_t fingerprint) const;
+    bool load(const HString &rFilePath);
+    uint64_t getFingerprint() const;
+
+private:
+    uint32_t getStringIndex(const HString &rString);
+
+    std::vector<uint32_t> mCode;
+    std::vector<HString> mStrings;
+    std::map<HString, uint32_t> mStringIndices;
+    std::vector<HString> mDependencies;
+    double mStartTime, mStopTime;
+    uint64_t mFingerprint;
+    bool mIsCacheable;
+};
+
+//! @brief Computes a fingerprint of strings and file contents, used to detect stale model cache files
+//! @note This is a fast non-cryptographic hash, it detects changes but does not protect against deliberate collisions
+class HOPSANCORE_DLLAPI ModelFingerprint
+{
+public:
+    ModelFingerprint();
+    void addString(const HString &rString);
+    bool addFile(const HString &rFilePath);
+    uint64_t getValue() const;
+
+private:
+    void addBytes(const char *pData, const size_t size);
+    uint64_t mValue;
+};
+
+}
+
+#endif // MODELLOADPROGRAM_H
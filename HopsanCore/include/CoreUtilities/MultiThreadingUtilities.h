@@ -36,7 +36,9 @@
 #include <vector>
 #include <cstddef>
 #include <algorithm>
+#include <utility>
 #include "win32dll.h"
+#include "CoreUtilities/SimulationHandler.h"
 
 #if (__cplusplus >= 201103L) && !defined(HOPSANCORE_NOMULTITHREADING)
 #define HOPSANCORE_USEMULTITHREADING
@@ -53,6 +55,10 @@ size_t HOPSANCORE_DLLAPI determineActualNumberOfThreads(const size_t nDesiredThr
 
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <functional>
 
 namespace hopsan {
 
@@ -61,39 +67,92 @@ class Component;
 class ComponentSystem;
 class Node;
 
-//! @brief Class for barrier locks in multi-threaded simulations.
+HOPSANCORE_DLLAPI bool setThreadCoreAffinity(std::thread &rThread, const size_t core);
+HOPSANCORE_DLLAPI bool clearThreadCoreAffinity(std::thread &rThread);
+HOPSANCORE_DLLAPI int getNumaNodeOfCore(const size_t core);
+HOPSANCORE_DLLAPI size_t placeDataOnNumaNodes(const std::vector< std::vector< std::pair<const double*, size_t> > > &rThreadData, const std::vector<size_t> &rThreadCores);
+
+
+//! @brief Persistent pool of simulation threads, reused between simulations to avoid creating new threads each time
+//! @details Each call to run() gets a set of idle worker threads of its own, new workers are only created if too few
+//! are idle. The pool can therefore be used by several simulations at the same time, and from within a running task.
+//! Each task gets a thread of its own, so the tasks in one run may wait for each other at barriers.
+//! Workers are never removed, so the number of tasks in one run should be limited to the number of simulation threads.
+class HOPSANCORE_DLLAPI SimulationThreadPool
+{
+public:
+    SimulationThreadPool();
+    ~SimulationThreadPool();
+
+    bool run(const std::vector< std::function<void()> > &rTasks, const std::vector<size_t> &rCores=std::vector<size_t>());
+    size_t getNumThreads();
+
+private:
+    class Worker;
+    static void workerLoop(Worker *pWorker);
+
+    std::vector<Worker*> mWorkers;
+    std::mutex mMutex;
+};
+
+extern SimulationThreadPool *gpInternalCoreSimulationThreadPool; // Do not use this pointer outside of HopsanCore
+
+
+//! @brief Class for sense-reversing barrier locks in multi-threaded simulations.
+//! @details The slave threads arrive and wait, the master thread waits for all slaves to arrive and then releases them.
+//! Each release flips the barrier generation (the sense) and resets the arrival counter, so the barrier can be reused
+//! directly without being locked again. How the threads wait is decided by the barrier mode.
 class BarrierLock
 {
 public:
     //! @brief Constructor.
     //! @note Number of threads must be correct! Wrong value will result in either deadlocks or threads or non-synchronized threads.
     //! @param nThreads Number of threads to by synchronized.
-    BarrierLock(size_t nThreads)
+    //! @param mode How the threads wait at the barrier
+    BarrierLock(size_t nThreads, BarrierModeT mode=SpinningBarrier)
     {
         mnThreads=nThreads;
+        mMode = mode;
         mCounter = 0;
-        mLock = true;
+        mGeneration = 0;
+        mAborted = false;
+        mnBlockedSlaves = 0;
+        mnBlockedMasters = 0;
     }
 
-    //! @brief Locks the barrier.
-    inline void lock() { mCounter=0; mLock=true; }
+    //! @brief Arrive at the barrier and wait until the master thread releases it (slave threads only).
+    void arriveAndWait();
 
-    //! @brief Unlocks the barrier.
-    inline void unlock() { mLock=false; }
+    //! @brief Wait until all slave threads have arrived at the barrier (master thread only).
+    //! @param pSystem Pointer to the system, the wait is interrupted if its simulation is aborted
+    //! @returns False if the simulation was aborted
+    bool waitForAllArrived(ComponentSystem *pSystem);
 
-    //! @brief Returns whether or not the barrier is locked.
-    inline bool isLocked() { return mLock; }
+    //! @brief Release the waiting slave threads and reset the barrier for the next use (master thread only).
+    void release();
 
-    //! @brief Increments barrier counter by one.
-    inline void increment() { ++mCounter; }
+    //! @brief Permanently release the barrier, all current and future waits return immediately.
+    void abort();
 
     //! @brief Returns whether or not all threads have incremented the barrier.
-    inline bool allArrived() { return (mCounter == (mnThreads-1)); }      //One less due to master thread
+    inline bool allArrived() const { return (mCounter.load() == (mnThreads-1)); }      //One less due to master thread
 
 private:
+    static const size_t SpinIterations = 2000;
+    static const int YieldMicroSeconds = 200;
+
     int mnThreads;
+    BarrierModeT mMode;
     std::atomic<int> mCounter;
-    std::atomic<bool> mLock;
+    std::atomic<unsigned int> mGeneration;
+    std::atomic<bool> mAborted;
+
+    // Used by the blocking mode only
+    std::atomic<int> mnBlockedSlaves;
+    std::atomic<int> mnBlockedMasters;
+    std::mutex mMutex;
+    std::condition_variable mSlaveCondition;
+    std::condition_variable mMasterCondition;
 };
 
 
@@ -325,6 +384,144 @@ HOPSANCORE_DLLAPI void simStealingSlave(ComponentSystem *pSystem,
                                         size_t maxSize);
 
 
+//////////////////////////////////////////
+// Lock-free work-stealing algorithm    //
+//////////////////////////////////////////
+
+
+//! @brief Lock-free work-stealing deque (Chase-Lev) with fixed capacity
+//! @details The owner thread pushes and pops components at the bottom, other threads steal from the top.
+//! The indexes are never reset, so the deque can be refilled between barriers without ABA problems.
+//! The capacity must be at least the number of components that can be in the deque at the same time.
+class WorkStealingDeque
+{
+public:
+    WorkStealingDeque(size_t capacity)
+    {
+        size_t powerOfTwoCapacity = 1;
+        while(powerOfTwoCapacity < capacity)
+        {
+            powerOfTwoCapacity *= 2;
+        }
+        mMask = powerOfTwoCapacity-1;
+        mpBuffer = new std::atomic<Component*>[powerOfTwoCapacity];
+        mTop.store(0);
+        mBottom.store(0);
+    }
+
+    ~WorkStealingDeque()
+    {
+        delete[] mpBuffer;
+    }
+
+    //! @brief Add a component at the bottom of the deque
+    //! @note May only be called by the owner thread
+    void push(Component *pComp)
+    {
+        const std::int64_t b = mBottom.load(std::memory_order_relaxed);
+        mpBuffer[b & mMask].store(pComp, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mBottom.store(b+1, std::memory_order_relaxed);
+    }
+
+    //! @brief Take the component at the bottom of the deque
+    //! @note May only be called by the owner thread
+    //! @returns Pointer to the component, or 0 if the deque is empty
+    Component *pop()
+    {
+        const std::int64_t b = mBottom.load(std::memory_order_relaxed)-1;
+        mBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = mTop.load(std::memory_order_relaxed);
+        Component *pComp = 0;
+        if(t <= b)
+        {
+            pComp = mpBuffer[b & mMask].load(std::memory_order_relaxed);
+            if(t == b)
+            {
+                // Last component, race against thieves for it
+                if(!mTop.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    pComp = 0;
+                }
+                mBottom.store(b+1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            mBottom.store(b+1, std::memory_order_relaxed);
+        }
+        return pComp;
+    }
+
+    //! @brief Steal the component at the top of the deque
+    //! @note May be called by any thread
+    //! @returns Pointer to the component, or 0 if the deque is empty
+    Component *steal()
+    {
+        while(true)
+        {
+            std::int64_t t = mTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t b = mBottom.load(std::memory_order_acquire);
+            if(t >= b)
+            {
+                return 0;
+            }
+            Component *pComp = mpBuffer[t & mMask].load(std::memory_order_relaxed);
+            if(mTop.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return pComp;
+            }
+            // Lost the race to the owner or another thief, try again
+        }
+    }
+
+private:
+    WorkStealingDeque(const WorkStealingDeque &);
+    WorkStealingDeque &operator=(const WorkStealingDeque &);
+
+    // Top and bottom are kept on separate cache lines, since they are written by different threads
+    std::atomic<std::int64_t> mTop;
+    char mTopPadding[64-sizeof(std::atomic<std::int64_t>)];
+    std::atomic<std::int64_t> mBottom;
+    char mBottomPadding[64-sizeof(std::atomic<std::int64_t>)];
+    std::atomic<Component*> *mpBuffer;
+    std::int64_t mMask;
+};
+
+
+HOPSANCORE_DLLAPI void simWorkStealingMaster(ComponentSystem *pSystem,
+                                             std::vector<Component*> &sVector,
+                                             std::vector<Component*> cVector,
+                                             std::vector<Component*> qVector,
+                                             std::vector<WorkStealingDeque*> *pDequesC,
+                                             std::vector<WorkStealingDeque*> *pDequesQ,
+                                             std::vector<double *> &pSimTimes,
+                                             double startTime,
+                                             double timeStep,
+                                             size_t numSimSteps,
+                                             size_t threadID,
+                                             BarrierLock *pBarrier_S,
+                                             BarrierLock *pBarrier_C,
+                                             BarrierLock *pBarrier_Q,
+                                             BarrierLock *pBarrier_N);
+
+HOPSANCORE_DLLAPI void simWorkStealingSlave(ComponentSystem *pSystem,
+                                            std::vector<Component*> cVector,
+                                            std::vector<Component*> qVector,
+                                            std::vector<WorkStealingDeque*> *pDequesC,
+                                            std::vector<WorkStealingDeque*> *pDequesQ,
+                                            double startTime,
+                                            double timeStep,
+                                            size_t numSimSteps,
+                                            size_t threadID,
+                                            BarrierLock *pBarrier_S,
+                                            BarrierLock *pBarrier_C,
+                                            BarrierLock *pBarrier_Q,
+                                            BarrierLock *pBarrier_N);
+
+
 /////////////////////////////////////////////
 // Parallel for loop algorithm using tasks //
 /////////////////////////////////////////////
@@ -0,0 +1,73 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   NodeDataArena.h
+//! @author FluMeS
+//!
+//! @brief Contains the node data arena help class
+//!
+//$Id$
+
+#ifndef NODEDATAARENA_H
+#define NODEDATAARENA_H
+
+#include <vector>
+#include <cstddef>
+
+#include "win32dll.h"
+
+namespace hopsan {
+
+class Node;
+
+//! @brief Contiguous, cache-line aligned storage for the data values of all nodes in a system
+//! @details The nodes are packed in the order they are given, which should be the order they are accessed during simulation.
+//! A node that fits in one cache line will never be placed so that it straddles two cache lines.
+class HOPSANCORE_DLLAPI NodeDataArena
+{
+public:
+    NodeDataArena();
+    ~NodeDataArena();
+
+    void pack(const std::vector<Node*> &rNodes);
+    void unpack(const std::vector<Node*> &rNodes);
+    void unpackNode(Node *pNode);
+    bool contains(const Node *pNode) const;
+
+    size_t getNumDataValues() const;
+
+    static const size_t CacheLineSize = 64;
+
+private:
+    void deallocate();
+
+    char *mpAllocation;
+    double *mpData;
+    size_t mNumDataValues;
+};
+
+}
+
+#endif // NODEDATAARENA_H
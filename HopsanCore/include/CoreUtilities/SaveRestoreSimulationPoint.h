@@ -27,15 +27,91 @@
 #ifndef SAVERESTORESIMULATIONPOINT_H
 #define SAVERESTORESIMULATIONPOINT_H
 
+#include <vector>
+
 #include "win32dll.h"
 #include "HopsanTypes.h"
+#include "CoreUtilities/MappedFile.h"
+#include "CoreUtilities/ComponentState.h"
 
 namespace hopsan {
 
 class ComponentSystem;
 
-void HOPSANCORE_DLLAPI saveSimulationPoint(HString fileName, ComponentSystem* pRootSystem);
-void HOPSANCORE_DLLAPI restoreSimulationPoint(HString fileName, ComponentSystem* pRootSystem, double &rTimeOffset);
+//! @brief A simulation point (checkpoint) file, loaded once and applied to any number of model instances
+//! @details A simulation point contains the node data of all ports and the internal states saved by
+//! Component::saveState(). The file is memory mapped and the values are used in place. Files written by older
+//! versions, with node data only, are also accepted.
+//!
+//! To continue a simulation exactly where the checkpoint was taken, initialize the model with getTime() as start
+//! time and then call resume(). To only use the node data as start values, call restoreNodeData() before
+//! initialization and let the system keep its values as start values.
+class HOPSANCORE_DLLAPI SimulationPoint
+{
+public:
+    SimulationPoint();
+
+    bool load(const HString &rFileName);
+    void clear();
+    bool isLoaded() const;
+    unsigned int getVersion() const;
+    double getTime() const;
+
+    size_t restoreNodeData(ComponentSystem *pRootSystem) const;
+    size_t restoreComponentStates(ComponentSystem *pRootSystem) const;
+    bool resume(ComponentSystem *pRootSystem) const;
+
+private:
+    SimulationPoint(const SimulationPoint &rOther);
+    SimulationPoint &operator=(const SimulationPoint &rOther);
+
+    enum RecordTypeT {PortRecord=1, ComponentStateRecord=2};
+    struct Record
+    {
+        RecordTypeT type;
+        HString name;
+        size_t valueIdx;
+        size_t numValues;
+    };
+
+    bool loadLegacy(const HString &rFileName);
+    const double *getValues(const Record &rRecord) const;
+
+    MappedFile mFile;
+    const double *mpValues;
+    std::vector<double> mLegacyValues;
+    std::vector<Record> mRecords;
+    unsigned int mVersion;
+    double mTime;
+};
+
+//! @brief An in-memory snapshot of the complete runtime state of a running simulation
+//! @details A snapshot holds the time and simulation step count of every system, all node data and the internal states
+//! saved by Component::saveState(). It is taken with ComponentSystem::takeSnapshot() and applied with
+//! ComponentSystem::restoreSnapshot(). Restoring it into the system it was taken from rewinds the simulation. Restoring
+//! it into another initialized instance of the same model, for example one of the copies loaded by
+//! HopsanEssentials::loadHMFModelFileCopies(), forks the simulation. The snapshot does not refer to any system, so it
+//! can be restored any number of times and into systems that are simulated in other threads.
+class HOPSANCORE_DLLAPI SimulationSnapshot
+{
+    friend class ComponentSystem;
+public:
+    SimulationSnapshot();
+
+    void clear();
+    bool isEmpty() const;
+    double getTime() const;
+    size_t getNumValues() const;
+
+private:
+    std::vector<HString> mComponentNames;
+    ComponentStateWriter mValues;
+    double mTime;
+};
+
+bool HOPSANCORE_DLLAPI saveSimulationPoint(HString fileName, ComponentSystem* pRootSystem);
+bool HOPSANCORE_DLLAPI restoreSimulationPoint(HString fileName, ComponentSystem* pRootSystem, double &rTimeOffset);
+bool HOPSANCORE_DLLAPI resumeSimulationPoint(HString fileName, ComponentSystem* pRootSystem);
 
 }
 
@@ -36,7 +36,10 @@
 
 #include <cstddef>
 #include <vector>
+#include <utility>
 #include "win32dll.h"
+#include "HopsanTypes.h"
+#include "CoreUtilities/LogSink.h"
 
 namespace hopsan {
 
@@ -44,10 +47,61 @@ enum ParallelAlgorithmT {APrioriScheduling,
                          TaskPoolAlgorithm,
                          TaskStealingAlgorithm,
                          ForkJoinAlgorithm,
-                         ClusteredForkJoinAlgorithm};
+                         ClusteredForkJoinAlgorithm,
+                         WorkStealingAlgorithm,
+                         GraphPartitioningAlgorithm};
+
+//! @brief How threads wait at the barriers in multi-threaded simulations
+//! @details SpinningBarrier has the lowest latency but idle threads use a full core each. YieldingBarrier spins for a
+//! bounded time and then yields the core to other threads. BlockingBarrier also goes to sleep if the wait is long.
+enum BarrierModeT {SpinningBarrier,
+                   YieldingBarrier,
+                   BlockingBarrier};
 
 // Forward declaration
 class ComponentSystem;
+class BatchLogSink;
+
+//! @brief Parameter values for one instance in a batch simulation, as pairs of full parameter name and value
+//! @details Names are on the form Component#Parameter, Subsystem$Component#Parameter or Component#Port#Variable (start values).
+//! System parameters are given by their name only, or as self#Parameter.
+typedef std::vector< std::pair<HString, HString> > BatchParameterValuesT;
+
+//! @brief Shared columnar result buffer for batch simulations
+//! @details All instances log the same variables. The buffer holds one column of getSampleCapacity() values for the time
+//! and for each variable, instance by instance. Column c (0 is the time, 1+v is variable v) of instance i starts at
+//! (i*(1+getNumVariables())+c)*getSampleCapacity(). Only the first getNumSamples(i) values in the columns of instance i are valid.
+class HOPSANCORE_DLLAPI BatchSimulationResults
+{
+public:
+    BatchSimulationResults();
+
+    size_t getNumInstances() const;
+    size_t getNumVariables() const;
+    size_t getSampleCapacity() const;
+    const std::vector<LogSinkVariable> &getVariables() const;
+
+    size_t getNumSamples(const size_t instance) const;
+    bool wasSuccessful(const size_t instance) const;
+    const double *getTimeColumn(const size_t instance) const;
+    const double *getColumn(const size_t instance, const size_t variable) const;
+    const std::vector<double> &getData() const;
+
+private:
+    friend class SimulationHandler;
+    friend class BatchLogSink;
+
+    void reset(const size_t numInstances, const size_t sampleCapacity);
+    bool setVariables(const std::vector<LogSinkVariable> &rVariables);
+    double *getColumnPtr(const size_t instance, const size_t column);
+
+    size_t mNumInstances, mSampleCapacity;
+    bool mHaveVariables;
+    std::vector<LogSinkVariable> mVariables;
+    std::vector<double> mData;
+    std::vector<size_t> mNumSamples;
+    std::vector<char> mSuccessful;
+};
 
 class HOPSANCORE_DLLAPI SimulationHandler
 {
@@ -68,6 +122,9 @@ public:
     void finalizeSystem(ComponentSystem* pSystem);
     void finalizeSystem(std::vector<ComponentSystem*> &rSystemVector);
 
+    bool simulateBatch(const double startT, const double stopT, const size_t nDesiredThreads, std::vector<ComponentSystem*> &rSystemVector,
+                       const std::vector<BatchParameterValuesT> &rParameterValues, BatchSimulationResults &rResults);
+
 private:
     bool simulateMultipleSystemsMultiThreaded(const double startT, const double stopT, const size_t nDesiredThreads, const std::vector<ComponentSystem*> &rSystemVector, bool noChanges=false);
     bool simulateMultipleSystems(const double stopT, const std::vector<ComponentSystem *> &rSystemVector);
@@ -102,8 +102,14 @@ public:
     HString& operator=(const char* rhs);
     HString& operator=(const char rhs);
     HString& operator=(const HString &rhs);
+
+private:
+    void makeUniqueWithSize(const size_t newSize);
+    void makeUnshareable();
 };
 
+HString HOPSANCORE_DLLAPI internString(const HString &rString);
+
 inline bool operator==(const HString& lhs, const HString& rhs){return lhs.compare(rhs);}
 inline bool operator!=(const HString& lhs, const HString& rhs){return !operator==(lhs,rhs);}
 inline bool operator> (const HString& lhs, const HString& rhs){return rhs<lhs;}
@@ -105,13 +105,16 @@ public:
     bool loadExternalComponentLib(const char* path);
     bool unLoadExternalComponentLib(const char* path);
     void getExternalComponentLibNames(std::vector<HString> &rLibNames);
+    void getExternalComponentLibPaths(std::vector<HString> &rLibPaths);
     void getExternalLibraryContents(const char* libPath, std::vector<HString> &rComponents, std::vector<HString> &rNodes);
     void getLibPathForComponentType(const HString &rTypeName, HString &rLibPath);
 
     // Loading HMF models
     ComponentSystem* loadHMFModelFile(const char* filePath, double &rStartTime, double &rStopTime);
+    ComponentSystem* loadHMFModelFileCached(const char* filePath, const char* cacheFilePath, double &rStartTime, double &rStopTime);
     ComponentSystem* loadHMFModel(const std::vector<unsigned char> xmlVector);
     ComponentSystem* loadHMFModel(const char* xmlString, double &rStartTime, double &rStopTime);
+    bool loadHMFModelFileCopies(const char* filePath, const size_t nCopies, std::vector<ComponentSystem*> &rSystems, double &rStartTime, double &rStopTime);
 
     // Running simulation
     SimulationHandler *getSimulationHandler();
@@ -35,6 +35,7 @@
 #include <vector>
 #include "HopsanTypes.h"
 #include "CoreUtilities/ClassFactory.hpp"
+#include "CoreUtilities/LogDataStore.h"
 #include "win32dll.h"
 
 namespace hopsan {
@@ -72,6 +73,7 @@ class HOPSANCORE_DLLAPI Node
     friend class ComponentSystem;
     friend class ConnectionAssistant;
     friend class HopsanEssentials;
+    friend class NodeDataArena;
 
 public:
     Node(const size_t datalength);
@@ -89,14 +91,14 @@ public:
     //! @return The data value
     inline double getDataValue(const size_t dataId) const
     {
-        return mDataValues[dataId];
+        return mpDataValues[dataId];
     }
     //! @brief set data in node
     //! @param [in] dataId Identifier for the type of node data to set, (no bounds check is performed)
     //! @param [in] data The data value
     inline void setDataValue(const size_t dataId, const double data)
     {
-        mDataValues[dataId] = data;
+        mpDataValues[dataId] = data;
     }
 
     const std::vector<NodeDataDescription>* getDataDescriptions() const;
@@ -108,6 +110,7 @@ public:
     virtual bool getSignalQuantityModifyable(const size_t dataId=0) const;
 
     void logData(const size_t logSlot);
+    void flushLogData();
 
     int getNumberOfPortsByType(const int type) const;
     size_t getNumConnectedPorts() const;
@@ -127,29 +130,34 @@ protected:
     virtual void copySignalQuantityAndUnitTo(Node *pOtherNode) const;
     virtual void setTLMNodeDataValuesTo(Node *pOtherNode) const;
 
-    void preAllocateLogSpace(const size_t nLogSlots);
+    void preAllocateLogSpace(const size_t nLogSlots, const std::vector<bool> &rLogDataIds=std::vector<bool>());
 
     double *getDataPtr(const size_t data_type);
+    void resizeDataValues(const size_t numValues);
 
     // Protected member variables
     HString mNiceName;
     std::vector<NodeDataDescription> mDataDescriptions;
-    std::vector<double> mDataValues;
+    //! @brief Points to the node data values, either in the local storage or in the owner system node data arena
+    double *mpDataValues;
 
 private:
     // Private member functions
     void addConnectedPort(Port *pPort);
     void removeConnectedPort(const Port *pPort);
+    void relocateDataValues(double *pStorage);
+    bool hasLocalDataValues() const;
 
     void setDoLogIfEnabled(bool doLog=true);
 
     // Private member variables
+    std::vector<double> mLocalDataValues;
     HString mNodeType;
     std::vector<Port*> mConnectedPorts;
     ComponentSystem *mpOwnerSystem;
 
     // Log specific variables
-    std::vector<std::vector<double> > mDataStorage;
+    LogDataStore mLogDataStore;
     bool mDoLog;
 };
 
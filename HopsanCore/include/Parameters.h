@@ -42,6 +42,7 @@ namespace hopsan {
 //Forward declaration
 class Component;
 class ParameterEvaluatorHandler;
+class NumHopHelper;
 
 class HOPSANCORE_DLLAPI ParameterEvaluator
 {
@@ -49,6 +50,7 @@ class HOPSANCORE_DLLAPI ParameterEvaluator
 public:
     ParameterEvaluator(const HString &rName, const HString &rValue, const HString &rDescription, const HString &rQuantity, const HString &rUnit,
                        const HString &rType, const bool internal=false, void* pDataPtr=0, ParameterEvaluatorHandler* pParameterEvalHandler=0);
+    ~ParameterEvaluator();
 
     bool setParameterValue(const HString &rValue, ParameterEvaluator **ppNeedEvaluation=0, bool force=false);
     bool setParameter(const HString &rValue, const HString &rDescription, const HString &rQuantity, const HString &rUnit,
@@ -72,10 +74,30 @@ public:
     void setTriggersReconfiguration();
     bool triggersReconfiguration();
 
+    static void invalidateDependencies();
+
 protected:
+    enum TypeT {DoubleType, IntegerType, BoolType, StringType, ConditionalType, UnknownType};
+
+    //! @brief A parameter that was used in the last evaluation, and its revision at that time
+    struct Dependency
+    {
+        Dependency(ParameterEvaluator *pParameter, size_t revision) : mpParameter(pParameter), mRevision(revision) {}
+        ParameterEvaluator *mpParameter;
+        size_t mRevision;
+    };
+
     void resolveSignPrefix(HString &rSignPrefix) const;
     void splitSignPrefix(const HString &rString, HString &rPrefix, HString &rValue);
 
+    void setType(const HString &rType);
+    void invalidate();
+    bool isUpToDate();
+    bool evaluateCached(HString *pResult);
+    bool evaluateExpression(HString &rResult);
+    bool evaluateValue(HString &rResult);
+    void writeCachedValue();
+
     HString mParameterName;
     HString mParameterValue;
     HString mDescription;
@@ -88,6 +110,18 @@ protected:
     std::vector<HString> mConditions;
     bool mInternal;
     bool mTriggersReconfiguration;
+
+    // Compiled value, the result of the last evaluation is reused until the value, type or a dependency changes
+    TypeT mTypeId;
+    NumHopHelper *mpExpression;
+    bool mExpressionOK;
+    bool mIsCached, mCachedSuccess;
+    HString mCachedResult;
+    double mCachedDouble;
+    int mCachedInt;
+    bool mCachedBool;
+    size_t mRevision, mDependencyRevision;
+    std::vector<Dependency> mDependencies;
 };
 
 
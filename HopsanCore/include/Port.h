@@ -74,7 +74,7 @@ namespace hopsan {
         //! @return The data value
         inline double readNode(const size_t idx) const
         {
-            return mpNode->mDataValues[idx];
+            return mpNode->mpDataValues[idx];
         }
 
         //! @brief Reads a value from the connected node
@@ -85,7 +85,7 @@ namespace hopsan {
         virtual inline double readNode(const size_t idx, const size_t subPortIdx) const
         {
             HOPSAN_UNUSED(subPortIdx)
-            return mpNode->mDataValues[idx];
+            return mpNode->mpDataValues[idx];
         }
 
         //! @brief Writes a value to the connected node
@@ -94,7 +94,7 @@ namespace hopsan {
         //! @param [in] value The value to write
         inline void writeNode(const size_t idx, const double value)
         {
-            mpNode->mDataValues[idx] = value;
+            mpNode->mpDataValues[idx] = value;
         }
 
         //! @brief Writes a value to the connected node
@@ -105,34 +105,34 @@ namespace hopsan {
         virtual inline void writeNode(const size_t idx, const double value, const size_t subPortIdx)
         {
             HOPSAN_UNUSED(subPortIdx)
-            mpNode->mDataValues[idx] = value;
+            mpNode->mpDataValues[idx] = value;
         }
 
         ///@{
-        //! @brief Returns a reference to the Node data in the port
-        //! @returns A reference to the node data vector
-        inline std::vector<double> &getNodeDataVector()
+        //! @brief Returns a pointer to the Node data in the port
+        //! @returns A pointer to the first node data value
+        inline double *getNodeDataVector()
         {
-            return mpNode->mDataValues;
+            return mpNode->mpDataValues;
         }
 
-        inline const std::vector<double> &getNodeDataVector() const
+        inline const double *getNodeDataVector() const
         {
-            return mpNode->mDataValues;
+            return mpNode->mpDataValues;
         }
         ///@}
 
         ///@{
-        //! @brief Returns a reference to the Node data in the port
+        //! @brief Returns a pointer to the Node data in the port
         //! @param[in] subPortIdx The index of a multiport subport to access
-        //! @returns A reference to the node data vector
-        virtual inline std::vector<double> &getNodeDataVector(const size_t subPortIdx)
+        //! @returns A pointer to the first node data value
+        virtual inline double *getNodeDataVector(const size_t subPortIdx)
         {
             HOPSAN_UNUSED(subPortIdx);
             return getNodeDataVector();
         }
 
-        virtual inline const std::vector<double> &getNodeDataVector(const size_t subPortIdx) const
+        virtual inline const double *getNodeDataVector(const size_t subPortIdx) const
         {
             HOPSAN_UNUSED(subPortIdx);
             return getNodeDataVector();
@@ -145,7 +145,7 @@ namespace hopsan {
         virtual Node *getNodePtr(const size_t subPortIdx=0);
         virtual const Node *getNodePtr(const size_t subPortIdx=0) const;
         virtual double *getNodeDataPtr(const size_t idx, const size_t subPortIdx=0) const;
-        virtual std::vector<double> *getDataVectorPtr(const size_t subPortIdx=0);
+        virtual double *getDataVectorPtr(const size_t subPortIdx=0);
 
         virtual size_t getNumDataVariables() const;
         virtual const std::vector<NodeDataDescription>* getNodeDataDescriptions(const size_t subPortIdx=0) const;
@@ -162,8 +162,7 @@ namespace hopsan {
 
         virtual bool haveLogData(const size_t subPortIdx=0);
         virtual std::vector<double> *getLogTimeVectorPtr(const size_t subPortIdx=0);
-        virtual std::vector<std::vector<double> > *getLogDataVectorPtr(size_t subPortIdx=0);
-        virtual const std::vector<std::vector<double> > *getLogDataVectorPtr(size_t subPortIdx=0) const;
+        virtual const LogDataStore *getLogDataStorePtr(const size_t subPortIdx=0) const;
         virtual void setEnableLogging(const bool enableLog);
         bool isLoggingEnabled() const;
 
@@ -291,15 +290,15 @@ namespace hopsan {
         }
 
         ///@{
-        //! @brief Returns a reference to the Node data in the port
+        //! @brief Returns a pointer to the Node data in the port
         //! @param[in] subPortIdx The index of a multiport subport to access
-        //! @returns A reference to the node data vector
-        inline std::vector<double> &getNodeDataVector(const size_t subPortIdx)
+        //! @returns A pointer to the first node data value
+        inline double *getNodeDataVector(const size_t subPortIdx)
         {
             return mSubPortsVector[subPortIdx]->getNodeDataVector();
         }
 
-        inline const std::vector<double> &getNodeDataVector(const size_t subPortIdx) const
+        inline const double *getNodeDataVector(const size_t subPortIdx) const
         {
             return mSubPortsVector[subPortIdx]->getNodeDataVector();
         }
@@ -307,7 +306,7 @@ namespace hopsan {
 
         const Node *getNodePtr(const size_t subPortIdx=0) const;
         double *getNodeDataPtr(const size_t idx, const size_t subPortIdx) const;
-        std::vector<double> *getDataVectorPtr(const size_t subPortIdx=0);
+        double *getDataVectorPtr(const size_t subPortIdx=0);
 
         const std::vector<NodeDataDescription>* getNodeDataDescriptions(const size_t subPortIdx=0) const;
         const NodeDataDescription* getNodeDataDescription(const size_t dataid, const size_t subPortIdx=0) const;
@@ -315,8 +314,7 @@ namespace hopsan {
 
         bool haveLogData(const size_t subPortIdx=0);
         std::vector<double> *getLogTimeVectorPtr(const size_t subPortIdx=0);
-        std::vector<std::vector<double> > *getLogDataVectorPtr(const size_t subPortIdx=0);
-        const std::vector<std::vector<double> > *getLogDataVectorPtr(size_t subPortIdx=0) const;
+        const LogDataStore *getLogDataStorePtr(const size_t subPortIdx=0) const;
         virtual void setEnableLogging(const bool enableLog);
 
         double getStartValue(const size_t idx, const size_t subPortIdx=0);
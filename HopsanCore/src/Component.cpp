@@ -136,6 +136,7 @@ bool Component::setParameterValue(const HString &rName, const HString &rValue, b
 {
     bool success = mpParameters->setParameterValue(rName, rValue, force);
     if(success && mpParameters->parameterTriggersReconfiguration(rName)) {
+        ComponentSystem::markStructureChanged();
         this->reconfigure();
     }
     return success;
@@ -299,6 +300,10 @@ void Component::simulate(const double stopT)
 
 void Component::setDisabled(bool value)
 {
+    if (value != mIsDisabled)
+    {
+        ComponentSystem::markStructureChanged();
+    }
     mIsDisabled = value;
 }
 
@@ -419,7 +424,7 @@ const HString &Component::getSubTypeName() const
 //! @brief Set the SubType name of the component
 void Component::setSubTypeName(const HString &rSubTypeName)
 {
-    mSubTypeName = rSubTypeName;
+    mSubTypeName = internString(rSubTypeName);
 }
 
 
@@ -852,6 +857,7 @@ Port *Component::addPort(const HString &rPortName, const PortTypesEnumT portType
         mPortPtrMap.insert(PortPtrPairT(newname, pNewPort));
         // Store the port in the vector, to remember the order of added ports (useful when retrieving variameters)
         mPortPtrVector.push_back(pNewPort);
+        ComponentSystem::markStructureChanged();
 
         //Signal automatic name change
         if (newname != rPortName)
@@ -1016,6 +1022,7 @@ void Component::deletePort(const HString &rName)
 
         // Erase from map
         mPortPtrMap.erase(it);
+        ComponentSystem::markStructureChanged();
 
         // Unregister any start value parameters connected to this port
         pPort->unRegisterStartValueParameters();
@@ -1250,12 +1257,14 @@ HString Component::determineUniquePortName(const HString &rPortname)
 void Component::setSystemParent(ComponentSystem *pComponentSystem)
 {
     mpSystemParent = pComponentSystem;
+    // System parameters are looked up in the parent systems, so references may now resolve differently
+    ParameterEvaluator::invalidateDependencies();
 }
 
 //! @brief This is supposed to be used by hopsan essentials to set the typename to the same as the registered key value
 void Component::setTypeName(const HString &rTypeName)
 {
-    mTypeName = rTypeName;
+    mTypeName = internString(rTypeName);
 }
 
 
@@ -1858,3 +1867,33 @@ double Component::getStateVariableSecondDerivative(int)
     return 0;
 }
 
+//! @brief Save internal states that are not stored in node data, such as integrator or delay buffer states
+//! @details Override this in components that keep states between time steps. The states are stored in simulation
+//! points and given back to restoreState() in the same order. Values derived from parameters should not be saved.
+//! The default implementation saves nothing.
+//! @param [in,out] rWriter The state writer to append to
+void Component::saveState(ComponentStateWriter &rWriter) const
+{
+    HOPSAN_UNUSED(rWriter)
+}
+
+//! @brief Restore internal states saved by saveState()
+//! @details This is called after the component has been initialized. If the reader fails or is not fully consumed
+//! the previous states of the component are put back.
+//! @param [in,out] rReader The state reader to read from
+void Component::restoreState(ComponentStateReader &rReader)
+{
+    HOPSAN_UNUSED(rReader)
+}
+
+//! @brief Returns a function that takes one time step in a group of components of this type, or 0 if there is none
+//! @details A system in grouped simulation mode calls this function once for all its components of the same type in the
+//! same C or Q stage, instead of making two virtual calls per component. Override this and return
+//! getSimulateBatchFunctionFor<YourComponent>() to allow it. The component must not depend on being simulated through
+//! simulate(), since that function is bypassed.
+//! @returns The batch simulation function, or 0 if components of this type must be simulated one by one
+Component::SimulateBatchFunctionT Component::getSimulateBatchFunction() const
+{
+    return 0;
+}
+
@@ -37,6 +37,7 @@
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <set>
 #include <time.h>
 
 #include "ComponentSystem.h"
@@ -48,6 +49,9 @@
 #include "CoreUtilities/HmfLoader.h"
 #include "CoreUtilities/NumHopHelper.h"
 #include "CoreUtilities/ConnectionAssistant.h"
+#include "CoreUtilities/NodeDataArena.h"
+#include "CoreUtilities/LogSink.h"
+#include "CoreUtilities/SaveRestoreSimulationPoint.h"
 #include "ComponentUtilities/num2string.hpp"
 
 using namespace std;
@@ -87,6 +91,17 @@ HighResClock::time_point HighResClock::now()
 #include <thread>
 #endif // multithreading
 
+#include <atomic>
+
+namespace {
+//! @brief Revision of the model structure, changed when components, ports, nodes, connections or sort hints change anywhere
+//! @details Systems that use warm re-initialization compare it with the revision of their last initialization
+std::atomic<size_t> gModelStructureRevision(0);
+
+//! @brief Revision value that no initialization has been done for
+const size_t gNoStructureRevision = size_t(-1);
+}
+
 namespace {
 //! @brief Figure out whether or not a vector contains a certain "object", exact comparison
 //! @param[in] rVector Vector of objects
@@ -111,11 +126,19 @@ namespace hopsan {
 
 class ComponentSystemMultiThreadPrivates {
 public:
+    ComponentSystemMultiThreadPrivates() : mBarrierMode(SpinningBarrier), mUseNumaPlacement(false), mScheduleNumThreads(0), mScheduleAlgorithm(APrioriScheduling) {}
+
     std::vector<double *> mvTimePtrs;
     std::vector< std::vector<Component*> > mSplitCVector;
     std::vector< std::vector<Component*> > mSplitQVector;
     std::vector< std::vector<Component*> > mSplitSignalVector;
     std::vector< std::vector<Node*> > mSplitNodeVector;
+    BarrierModeT mBarrierMode;
+    std::vector<size_t> mThreadCores;
+    bool mUseNumaPlacement;
+    // The number of threads and the algorithm that the split vectors were created for, zero threads if not created
+    size_t mScheduleNumThreads;
+    ParallelAlgorithmT mScheduleAlgorithm;
 #if defined(HOPSANCORE_USEMULTITHREADING)
     std::mutex mStopMutex;
 #endif
@@ -134,9 +157,25 @@ ComponentSystem::ComponentSystem() : Component(), mAliasHandler(this)
     mInheritTimestep = true;
     mKeepValuesAsStartValues = false;
     mRequestedNumLogSamples = 0; //This has to be 0 since we want logging to be disabled by default
+    mUseLogOnlyVariables = false;
+    mHasForwardedLogOnlyVariables = false;
+    mpLogSink = 0;
+    mKeepLogDataInMemory = true;
+    mLogSinkIsOpen = false;
+    mStreamLogDataOnly = false;
+    mForwardedStreamLogDataOnly = false;
+    mNumLogSinkChunkSamples = 0;
+    mFirstLogTimeStepSlot = 0;
+    mNumCalculatedLogSlots = 0;
     mRequestedLogStartTime = 0;
     mpMultiThreadPrivates = new ComponentSystemMultiThreadPrivates;
+    mpNodeDataArena = new NodeDataArena;
     mpNumHopHelper = 0;
+    mWarmReinitialization = false;
+    mUseGroupedSimulation = false;
+    mGroupedSimulationActive = false;
+    mCheckedStructureRevision = gNoStructureRevision;
+    mInitializedStructureRevision = gNoStructureRevision;
 
     // Prevent creation of components, system parameters and system ports named "self"
     // that would collide with embedded scripts
@@ -159,6 +198,7 @@ ComponentSystem::~ComponentSystem()
     // Clear the contents of the system
     clear();
     delete mpMultiThreadPrivates;
+    delete mpNodeDataArena;
 }
 
 void ComponentSystem::configure()
@@ -206,6 +246,60 @@ size_t ComponentSystem::getNumActuallyLoggedSamples() const
     return mLogCtr;
 }
 
+//! @brief Log only the given variables, instead of all variables, in this system and its subsystems
+//! @details Memory is only allocated for the given variables, the selection takes effect at the next initialize.
+//! Names that belong to subsystems are forwarded to them at each initialize, and are logged in addition to any selection
+//! that has been set directly on the subsystem.
+//! @param[in] rFullVariableNames Variable names relative this system, on the form Subsystem$Component#Port#Variable, or Component#Port to log all variables in a port
+void ComponentSystem::setLogOnlyVariables(const std::vector<HString> &rFullVariableNames)
+{
+    mLogOnlyVariables = rFullVariableNames;
+    mUseLogOnlyVariables = true;
+}
+
+//! @brief Log all variables again in this system, and stop forwarding selected variables to its subsystems
+//! @details Selections that have been set directly on subsystems are kept, the change takes effect at the next initialize.
+void ComponentSystem::clearLogOnlyVariables()
+{
+    mLogOnlyVariables.clear();
+    mUseLogOnlyVariables = false;
+}
+
+//! @brief Returns the variable names that should be logged, only relevant if isUsingLogOnlyVariables() is true
+const std::vector<HString> &ComponentSystem::getLogOnlyVariables() const
+{
+    return mLogOnlyVariables;
+}
+
+//! @brief Check if only selected variables are logged
+bool ComponentSystem::isUsingLogOnlyVariables() const
+{
+    return mUseLogOnlyVariables;
+}
+
+//! @brief Set a log sink that receives the logged data of this system while simulating
+//! @details The sink is opened in initialize, receives chunks of samples from logTimeAndNodes and is closed in finalize.
+//! The logged variables of all subsystems are also written to the sink, with the subsystem names in LogSinkVariable::systemHierarchy.
+//! The caller owns the sink.
+//! @param[in] pLogSink The sink, or 0 to remove the current sink
+//! @param[in] keepLogDataInMemory If false, log data (including the log time vector) is only written to the sink and never stored in memory,
+//! neither in this system nor in its subsystems
+void ComponentSystem::setLogSink(LogSink *pLogSink, const bool keepLogDataInMemory)
+{
+    if (pLogSink != mpLogSink)
+    {
+        closeLogSink();
+    }
+    mpLogSink = pLogSink;
+    mKeepLogDataInMemory = keepLogDataInMemory;
+}
+
+//! @brief Returns the log sink, or 0 if no sink is set
+LogSink *ComponentSystem::getLogSink() const
+{
+    return mpLogSink;
+}
+
 
 //! @brief Set the stop simulation flag to abort the initialization or simulation loops
 //! @param[in] rReason An optional HString describing the reason for the stop
@@ -418,6 +512,9 @@ void ComponentSystem::renameSubComponent(const HString &rOldName, const HString
 
         // Now change the actual component name, without trying to do rename (we are in rename now, would cause infinite loop)
         pTempComp->mName = mod_new_name;
+
+        // Parameter expressions refer to components by name
+        ParameterEvaluator::invalidateDependencies();
     }
     else
     {
@@ -510,6 +607,10 @@ void ComponentSystem::unReserveUniqueName(const HString &rName)
 
 void ComponentSystem::addSubComponentPtrToStorage(Component* pComponent)
 {
+    // The multi-threading schedule refers to the sub components, so it can not be reused
+    mpMultiThreadPrivates->mScheduleNumThreads = 0;
+    markStructureChanged();
+
     switch (pComponent->getTypeCQS())
     {
     case Component::CType :
@@ -534,6 +635,12 @@ void ComponentSystem::addSubComponentPtrToStorage(Component* pComponent)
 
 void ComponentSystem::removeSubComponentPtrFromStorage(Component* pComponent)
 {
+    // The multi-threading schedule refers to the sub components, so it can not be reused
+    mpMultiThreadPrivates->mScheduleNumThreads = 0;
+    // Nor can parameter values that were evaluated from the component parameters
+    ParameterEvaluator::invalidateDependencies();
+    markStructureChanged();
+
     SubComponentMapT::iterator it = mSubComponentMap.find(pComponent->getName());
     if (it != mSubComponentMap.end())
     {
@@ -594,6 +701,9 @@ void ComponentSystem::removeSubComponentPtrFromStorage(Component* pComponent)
 //! @brief Clear all the contents of a system (deleting any remaining components and connections)
 void ComponentSystem::clear()
 {
+    // Move node data out of the arena in one go, instead of one by one when nodes are removed
+    mpNodeDataArena->unpack(mSubNodePtrs);
+
     // Remove and delete every subcomponent, one by one
     while (!mSubComponentMap.empty())
     {
@@ -919,6 +1029,7 @@ void ComponentSystem::addSubNode(Node* pNode)
     }
     mSubNodePtrs.push_back(pNode);
     pNode->mpOwnerSystem = this;
+    markStructureChanged();
 }
 
 
@@ -930,14 +1041,61 @@ void ComponentSystem::removeSubNode(Node* pNode)
     {
         if (*it == pNode)
         {
+            mpNodeDataArena->unpackNode(pNode);
+            mLoggedSubNodePtrs.erase(std::remove(mLoggedSubNodePtrs.begin(), mLoggedSubNodePtrs.end(), pNode), mLoggedSubNodePtrs.end());
             pNode->mpOwnerSystem = 0;
             mSubNodePtrs.erase(it);
+            markStructureChanged();
             break;
         }
     }
 }
 
 
+//! @brief Pack the data of all sub nodes into one contiguous memory block, ordered by simulation order
+//! @details Nodes are ordered by the first port that accesses them, going through signal, C and Q components in simulation order.
+//! Nodes not reached that way (e.g. only connected to disabled components) are placed last.
+//! This must be done before sub components are initialized, since they may fetch node data pointers in initialize.
+void ComponentSystem::packNodeData()
+{
+    std::vector<Node*> orderedNodes;
+    orderedNodes.reserve(mSubNodePtrs.size());
+    std::set<Node*> addedNodes;
+
+    const std::vector<Component*> *componentVectors[] = {&mComponentSignalptrs, &mComponentCptrs, &mComponentQptrs};
+    for (size_t v=0; v<3; ++v)
+    {
+        const std::vector<Component*> &rComponents = *componentVectors[v];
+        for (size_t c=0; c<rComponents.size(); ++c)
+        {
+            const std::vector<Port*> ports = rComponents[c]->getPortPtrVector();
+            for (size_t p=0; p<ports.size(); ++p)
+            {
+                const size_t numSubPorts = ports[p]->isMultiPort() ? ports[p]->getNumPorts() : 1;
+                for (size_t sp=0; sp<numSubPorts; ++sp)
+                {
+                    Node *pNode = ports[p]->getNodePtr(sp);
+                    if (pNode && (pNode->getOwnerSystem() == this) && addedNodes.insert(pNode).second)
+                    {
+                        orderedNodes.push_back(pNode);
+                    }
+                }
+            }
+        }
+    }
+    for (size_t n=0; n<mSubNodePtrs.size(); ++n)
+    {
+        if (addedNodes.insert(mSubNodePtrs[n]).second)
+        {
+            orderedNodes.push_back(mSubNodePtrs[n]);
+        }
+    }
+
+    mpNodeDataArena->pack(orderedNodes);
+    addDebugMessage("Packed "+to_hstring(orderedNodes.size())+" nodes into node data arena with "+to_hstring(mpNodeDataArena->getNumDataValues())+" values");
+}
+
+
 //! @brief preAllocates log space (to speed up later access for log writing)
 void ComponentSystem::preAllocateLogSpace()
 {
@@ -946,14 +1104,53 @@ void ComponentSystem::preAllocateLogSpace()
     //    this->setLogSettingsNSamples(nSamples, startT, stopT, mTimestep);
     //! @todo Fix /Peter
     mLogCtr = 0;
+    mLoggedSubNodePtrs.clear();
+    mLogOnlyDataIds.clear();
+    mLogOnlyPorts.clear();
+    closeLogSink();
     if (mEnableLogData)
     {
         try
         {
-            mTimeStorage.resize(mnLogSlots, 0);
+            // If data is only streamed to the log sink, no log slots are needed in memory
+            if (mStreamLogDataOnly)
+            {
+                std::vector<double>().swap(mTimeStorage);
+            }
+            else
+            {
+                mTimeStorage.resize(mnLogSlots, 0);
+            }
+
+            // Determine which node data ids to log, if only selected variables should be logged
+            // The selection of this system is combined with the selection forwarded from the parent system in this initialization
+            const bool useLogOnlyVariables = mUseLogOnlyVariables || mHasForwardedLogOnlyVariables;
+            std::map<HString, std::vector<HString> > subsystemLogOnlyVariables;
+            if (useLogOnlyVariables)
+            {
+                std::vector<HString> logOnlyVariables = mForwardedLogOnlyVariables;
+                if (mUseLogOnlyVariables)
+                {
+                    logOnlyVariables.insert(logOnlyVariables.end(), mLogOnlyVariables.begin(), mLogOnlyVariables.end());
+                }
+                collectLogOnlyDataIds(logOnlyVariables, mLogOnlyDataIds, mLogOnlyPorts, subsystemLogOnlyVariables);
+            }
+
+            // Forward the selection to the subsystems, they are initialized after this system so it only affects this initialization
+            // If data is only streamed, the subsystems do not keep it in memory either, their variables are streamed by this system
+            SubComponentMapT::iterator sit;
+            for (sit=mSubComponentMap.begin(); sit!=mSubComponentMap.end(); ++sit)
+            {
+                if (sit->second->isComponentSystem())
+                {
+                    ComponentSystem *pSubsystem = static_cast<ComponentSystem*>(sit->second);
+                    pSubsystem->mHasForwardedLogOnlyVariables = useLogOnlyVariables;
+                    pSubsystem->mForwardedLogOnlyVariables = subsystemLogOnlyVariables[sit->first];
+                    pSubsystem->mForwardedStreamLogDataOnly = mStreamLogDataOnly;
+                }
+            }
 
-            // Allocate log data memory for subnodes
-            //! @todo we should have an other vector with those nodes that should be logged, if we make individual nodes possible to disable logging
+            // Allocate log data memory for subnodes, and remember which nodes that should be logged
             vector<Node*>::iterator it;
             for (it=mSubNodePtrs.begin(); it!=mSubNodePtrs.end(); ++it)
             {
@@ -969,14 +1166,32 @@ void ComponentSystem::preAllocateLogSpace()
                 {
                     // If the node is in a read port and if that port is not connected (node only have one connected port)
                     // Then we should disable logging for that node as logging the start value does not make sense
+                    // If only selected variables should be logged, then nodes without any selected variables are not logged at all
+                    std::map<Node*, std::vector<bool> >::iterator logOnlyIt = mLogOnlyDataIds.find(*it);
                     if ( ((*it)->getNumConnectedPorts() < 2) && ((*it)->getNumberOfPortsByType(ReadPortType) == 1) )
                     {
                         (*it)->setDoLogIfEnabled(false);
                     }
+                    else if (useLogOnlyVariables && (logOnlyIt == mLogOnlyDataIds.end()))
+                    {
+                        (*it)->setDoLogIfEnabled(false);
+                    }
                     else
                     {
                         (*it)->setDoLogIfEnabled(true);
-                        (*it)->preAllocateLogSpace(mnLogSlots);
+                        const size_t nNodeLogSlots = mStreamLogDataOnly ? 0 : mnLogSlots;
+                        if (useLogOnlyVariables)
+                        {
+                            (*it)->preAllocateLogSpace(nNodeLogSlots, logOnlyIt->second);
+                        }
+                        else
+                        {
+                            (*it)->preAllocateLogSpace(nNodeLogSlots);
+                        }
+                        if ((*it)->mDoLog)
+                        {
+                            mLoggedSubNodePtrs.push_back(*it);
+                        }
                     }
                     success = true;
                 }
@@ -997,6 +1212,11 @@ void ComponentSystem::preAllocateLogSpace()
         }
     }
 
+    // The forwarded selection is only used in the initialization that the parent system is running
+    mHasForwardedLogOnlyVariables = false;
+    mForwardedLogOnlyVariables.clear();
+    mForwardedStreamLogDataOnly = false;
+
     // If we failed to allocate log memory then stop simulation
     if (!success)
     {
@@ -1005,19 +1225,204 @@ void ComponentSystem::preAllocateLogSpace()
 }
 
 
+//! @brief Resolve the log only variable names that belong to this system into node data ids to log
+//! @param[in] rLogOnlyVariables The variable names to log, relative this system
+//! @param[out] rLogDataIds Map with one log flag per data id, for each node that has at least one variable to log
+//! @param[out] rPorts The ports that the variables were selected in
+//! @param[out] rSubsystemNames The names that belong to each subsystem, relative the subsystem
+void ComponentSystem::collectLogOnlyDataIds(const std::vector<HString> &rLogOnlyVariables, std::map<Node*, std::vector<bool> > &rLogDataIds, std::set<Port*> &rPorts,
+                                            std::map<HString, std::vector<HString> > &rSubsystemNames)
+{
+    for (size_t i=0; i<rLogOnlyVariables.size(); ++i)
+    {
+        const HString &rName = rLogOnlyVariables[i];
+
+        // Names on the form Subsystem$Component#Port#Variable belong to a subsystem
+        const size_t dollarPos = rName.find('$');
+        if ((dollarPos != HString::npos) && (dollarPos < rName.find('#')))
+        {
+            rSubsystemNames[rName.substr(0, dollarPos)].push_back(rName.substr(dollarPos+1));
+            continue;
+        }
+
+        // Names on the form Component#Port log all variables in the port, Component#Port#Variable logs one variable
+        HVector<HString> parts = rName.split('#');
+        Component *pComponent = (parts.size() >= 2) ? getSubComponent(parts[0]) : 0;
+        Port *pPort = pComponent ? pComponent->getPort(parts[1]) : 0;
+        Node *pNode = pPort ? pPort->getNodePtr() : 0;
+        if (!pNode || (parts.size() > 3) || (pNode->getOwnerSystem() != this))
+        {
+            addWarningMessage("Could not find log only variable: "+rName+" in system: "+getName(), "nologonlyvariable");
+            continue;
+        }
+
+        std::vector<bool> &rNodeDataIds = rLogDataIds[pNode];
+        rNodeDataIds.resize(pNode->getNumDataVariables(), false);
+        if (parts.size() == 2)
+        {
+            rNodeDataIds.assign(rNodeDataIds.size(), true);
+        }
+        else
+        {
+            const int dataId = pPort->getNodeDataIdFromName(parts[2]);
+            if (dataId < 0)
+            {
+                addWarningMessage("Could not find log only variable: "+rName+" in system: "+getName(), "nologonlyvariable");
+                continue;
+            }
+            rNodeDataIds[size_t(dataId)] = true;
+        }
+        rPorts.insert(pPort);
+    }
+}
+
+
+//! @brief Open the log sink and determine which node data values to write to it
+//! @details The sink receives the logged variables of this system and all subsystems, the subsystems must have been initialized
+//! @returns true if the sink was opened successfully
+bool ComponentSystem::openLogSink()
+{
+    std::set<std::pair<Node*, size_t> > addedDataIds;
+    std::vector<LogSinkVariable> variables;
+    mLogSinkDataIds.clear();
+    collectLogSinkVariables("", addedDataIds, variables, mLogSinkDataIds);
+
+    mLogSinkTimeChunk.resize(LogDataStore::ChunkSize);
+    mLogSinkValueChunk.resize(LogDataStore::ChunkSize*mLogSinkDataIds.size());
+    mNumLogSinkChunkSamples = 0;
+    mLogSinkIsOpen = mpLogSink->open(getName(), variables);
+    return mLogSinkIsOpen;
+}
+
+//! @brief Collect the logged variables in this system and its subsystems for a log sink
+//! @details One sink variable is added for each logged node data value, even if several ports share the node.
+//! The variable is named after the port it was selected in as a log only variable, or a write port, or the first port that was found.
+//! @param[in] rSystemHierarchy The subsystem names from the sink system to this system, each followed by $
+//! @param[in,out] rAddedDataIds The node data values already added, to avoid duplicates
+//! @param[in,out] rVariables The sink variable descriptions
+//! @param[in,out] rDataIds The node and data id of each sink variable
+void ComponentSystem::collectLogSinkVariables(const HString &rSystemHierarchy, std::set<std::pair<Node*, size_t> > &rAddedDataIds, std::vector<LogSinkVariable> &rVariables,
+                                              std::vector<std::pair<Node*, size_t> > &rDataIds)
+{
+    const std::set<Node*> loggedNodes(mLoggedSubNodePtrs.begin(), mLoggedSubNodePtrs.end());
+    for (int pass=0; pass<3; ++pass)
+    {
+        SubComponentMapT::iterator cit;
+        for (cit=mSubComponentMap.begin(); cit!=mSubComponentMap.end(); ++cit)
+        {
+            Component *pComponent = cit->second;
+            std::vector<Port*> ports = pComponent->getPortPtrVector();
+            for (size_t p=0; p<ports.size(); ++p)
+            {
+                // Ports with selected log only variables are added first, then write ports, so that signal variables are named after the port that produces them
+                Port *pPort = ports[p];
+                const int portPass = (mLogOnlyPorts.count(pPort) > 0) ? 0 : ((pPort->getPortType() == WritePortType) ? 1 : 2);
+                if ( (portPass != pass) || pPort->isMultiPort() || !pPort->isLoggingEnabled() )
+                {
+                    continue;
+                }
+                Node *pNode = pPort->getNodePtr();
+                if (loggedNodes.count(pNode) == 0)
+                {
+                    continue;
+                }
+
+                // Nodes with selected log only variables are in the log only map, all variables are logged in other logged nodes
+                std::map<Node*, std::vector<bool> >::const_iterator logOnlyIt = mLogOnlyDataIds.find(pNode);
+                for (size_t id=0; id<pNode->getNumDataVariables(); ++id)
+                {
+                    if ( ((logOnlyIt != mLogOnlyDataIds.end()) && !logOnlyIt->second[id]) ||
+                         !rAddedDataIds.insert(std::pair<Node*, size_t>(pNode, id)).second )
+                    {
+                        continue;
+                    }
+                    const NodeDataDescription *pDesc = pPort->getNodeDataDescription(id);
+                    LogSinkVariable variable;
+                    variable.systemHierarchy = rSystemHierarchy;
+                    variable.componentName = pComponent->getName();
+                    variable.portName = pPort->getName();
+                    variable.variableName = pDesc->name;
+                    variable.alias = pPort->getVariableAlias(int(id));
+                    variable.unit = pDesc->unit;
+                    variable.quantity = pDesc->quantity;
+                    rVariables.push_back(variable);
+                    rDataIds.push_back(std::pair<Node*, size_t>(pNode, id));
+                }
+            }
+        }
+    }
+
+    SubComponentMapT::iterator sit;
+    for (sit=mSubComponentMap.begin(); sit!=mSubComponentMap.end(); ++sit)
+    {
+        if (sit->second->isComponentSystem())
+        {
+            static_cast<ComponentSystem*>(sit->second)->collectLogSinkVariables(rSystemHierarchy+sit->first+"$", rAddedDataIds, rVariables, rDataIds);
+        }
+    }
+}
+
+//! @brief Write any remaining samples to the log sink and close it
+void ComponentSystem::closeLogSink()
+{
+    if (mLogSinkIsOpen)
+    {
+        if (mNumLogSinkChunkSamples > 0)
+        {
+            mpLogSink->writeChunk(mLogSinkTimeChunk.data(), mLogSinkValueChunk.data(), mNumLogSinkChunkSamples);
+        }
+        if (!mpLogSink->close())
+        {
+            addErrorMessage("Failed to write log sink: "+mpLogSink->getLastError());
+        }
+        mLogSinkIsOpen = false;
+    }
+    mNumLogSinkChunkSamples = 0;
+    mLogSinkDataIds.clear();
+    std::vector<double>().swap(mLogSinkTimeChunk);
+    std::vector<double>().swap(mLogSinkValueChunk);
+}
+
+
 void ComponentSystem::logTimeAndNodes(const size_t simStep)
 {
-    if (mEnableLogData)
+    if (mEnableLogData && (mLogCtr < mnLogSlots))
     {
-        if (mLogTheseTimeSteps[mLogCtr] ==  simStep)
+        // When log data is only streamed, the steps to log are calculated one chunk at a time
+        if (mLogCtr == mFirstLogTimeStepSlot+mLogTheseTimeSteps.size())
         {
-            mTimeStorage[mLogCtr] = mTime;   //We log the "real"  simulation time for the sample
+            mFirstLogTimeStepSlot = mLogCtr;
+            mLogTheseTimeSteps.clear();
+            calcNextLogTimeSteps(LogDataStore::ChunkSize);
+        }
 
-            //! @todo we should have an other vector with those nodes that should be logged, if we make individual nodes possible to disable logging
-            vector<Node*>::iterator it;
-            for (it=mSubNodePtrs.begin(); it!=mSubNodePtrs.end(); ++it)
+        if (mLogTheseTimeSteps[mLogCtr-mFirstLogTimeStepSlot] ==  simStep)
+        {
+            if (!mStreamLogDataOnly)
+            {
+                mTimeStorage[mLogCtr] = mTime;   //We log the "real"  simulation time for the sample
+                for (size_t i=0; i<mLoggedSubNodePtrs.size(); ++i)
+                {
+                    mLoggedSubNodePtrs[i]->logData(mLogCtr);
+                }
+            }
+
+            // Gather the sample for the log sink, and hand it over one chunk at a time
+            if (mLogSinkIsOpen)
             {
-                (*it)->logData(mLogCtr);
+                const size_t nVars = mLogSinkDataIds.size();
+                mLogSinkTimeChunk[mNumLogSinkChunkSamples] = mTime;
+                double *pValues = &mLogSinkValueChunk[mNumLogSinkChunkSamples*nVars];
+                for (size_t i=0; i<nVars; ++i)
+                {
+                    pValues[i] = mLogSinkDataIds[i].first->mpDataValues[mLogSinkDataIds[i].second];
+                }
+                ++mNumLogSinkChunkSamples;
+                if (mNumLogSinkChunkSamples == LogDataStore::ChunkSize)
+                {
+                    mpLogSink->writeChunk(mLogSinkTimeChunk.data(), mLogSinkValueChunk.data(), mNumLogSinkChunkSamples);
+                    mNumLogSinkChunkSamples = 0;
+                }
             }
             ++mLogCtr;
         }
@@ -1025,6 +1430,26 @@ void ComponentSystem::logTimeAndNodes(const size_t simStep)
 }
 
 
+//! @brief Write log samples that are still buffered to the log storage, in this system and all subsystems
+//! @details This is done automatically at the end of a simulation in the top level system, and in finalize().
+//! @note Must be called from the thread that logs the data, and not during a simulation
+void ComponentSystem::flushLogData()
+{
+    for (size_t i=0; i<mLoggedSubNodePtrs.size(); ++i)
+    {
+        mLoggedSubNodePtrs[i]->flushLogData();
+    }
+    SubComponentMapT::iterator it;
+    for (it=mSubComponentMap.begin(); it!=mSubComponentMap.end(); ++it)
+    {
+        if (it->second->isComponentSystem())
+        {
+            static_cast<ComponentSystem*>(it->second)->flushLogData();
+        }
+    }
+}
+
+
 //! @brief Rename a system parameter
 bool ComponentSystem::renameParameter(const HString &rOldName, const HString &rNewName)
 {
@@ -1346,6 +1771,7 @@ bool ComponentSystem::connect(Port *pPort1, Port *pPort2)
     Component* pComp1 = pPort1->getComponent();
     Component* pComp2 = pPort2->getComponent();
     bool sucess=false;
+    markStructureChanged();
 
     // Prevent connection between two multiports
     //! @todo we might want to allow this in the future, right now disconnecting two multiports is also not implemented
@@ -1497,6 +1923,7 @@ bool ComponentSystem::disconnect(Port *pPort1, Port *pPort2)
         HString msgName2 = pPort2->getComponent()->getName()+"::"+pPort2->getName();
 
         ConnectionAssistant disconnAssistant(this);
+        markStructureChanged();
         //! @todo some more advanced error handling
         if (pPort1->isConnectedTo(pPort2))
         {
@@ -1700,6 +2127,9 @@ size_t limitNumLogSlotsToLogOrSimTimeInterval(const double simStartT, const doub
 
 void ComponentSystem::setupLogSlotsAndTs(const double simStartT, const double simStopT, const double simTs)
 {
+    // Log data is only streamed if this system or the parent system streams to a sink without keeping data in memory
+    mStreamLogDataOnly = (mpLogSink && !mKeepLogDataInMemory) || mForwardedStreamLogDataOnly;
+
     mnLogSlots = limitNumLogSlotsToLogOrSimTimeInterval(simStartT, simStopT, simTs, mRequestedLogStartTime, mRequestedNumLogSamples);
     if (mnLogSlots != mRequestedNumLogSamples)
     {
@@ -1717,33 +2147,25 @@ void ComponentSystem::setupLogSlotsAndTs(const double simStartT, const double si
         mLogTimeDt = (simStopT-logStartT)/double(mnLogSlots-1);
 
         // Figure out at which samples logging should happen
-        double logT=logStartT;
-        double simT=simStartT;
-
+        // If log data is only streamed, the steps are calculated one chunk at a time while logging instead of all at once
+        mLogStartT = logStartT;
+        mLogSimStartT = simStartT;
+        mLogSimTs = simTs;
         mLogTheseTimeSteps.clear();
-        mLogTheseTimeSteps.reserve(mnLogSlots);
-
-        // Figure out the first simulation step to log (the one where simT >= logT)
-        size_t n = size_t((logT-simT)/simTs+0.5);
-        mLogTheseTimeSteps.push_back(n);
-        // Fast forward simT
-        simT += double(n)*simTs;
-
-        // Now Calculate which additional simulation steps should be logged
-        while (mLogTheseTimeSteps.size() < mnLogSlots)
+        if (mStreamLogDataOnly)
         {
-            logT += mLogTimeDt;
-            n = size_t((logT-simT)/simTs+0.5);
-            simT += double(n)*simTs;
-
-            //cout << "SimT: " << simT << " logT: " << logT << " logT-simT: " << logT-simT << endl;
-            mLogTheseTimeSteps.push_back(mLogTheseTimeSteps.back() + n);
+            std::vector<size_t>().swap(mLogTheseTimeSteps);
         }
+        mFirstLogTimeStepSlot = 0;
+        mNumCalculatedLogSlots = 0;
+        const size_t nSlotsToCalc = (mStreamLogDataOnly && (mnLogSlots > LogDataStore::ChunkSize)) ? LogDataStore::ChunkSize : mnLogSlots;
+        mLogTheseTimeSteps.reserve(nSlotsToCalc);
+        calcNextLogTimeSteps(nSlotsToCalc);
 
         //! @todo sanity check on log slots
-        if (mnLogSlots != mLogTheseTimeSteps.size())
+        if (nSlotsToCalc != mLogTheseTimeSteps.size())
         {
-            cout << "Error: mnLogSlots: " << mnLogSlots << " mLogTheseTimeSteps.size(): " << mLogTheseTimeSteps.size() << endl;
+            cout << "Error: nSlotsToCalc: " << nSlotsToCalc << " mLogTheseTimeSteps.size(): " << mLogTheseTimeSteps.size() << endl;
         }
 
         //        //cout << "n: " << n << endl;
@@ -1762,6 +2184,54 @@ void ComponentSystem::setupLogSlotsAndTs(const double simStartT, const double si
     }
 }
 
+//! @brief Calculate which simulation steps to log in the next log slots, they are appended to mLogTheseTimeSteps
+//! @param[in] numSlots The number of log slots to calculate, fewer are calculated if the last log slot is reached
+void ComponentSystem::calcNextLogTimeSteps(const size_t numSlots)
+{
+    for (size_t i=0; (i<numSlots) && (mNumCalculatedLogSlots<mnLogSlots); ++i)
+    {
+        if (mNumCalculatedLogSlots == 0)
+        {
+            // Figure out the first simulation step to log (the one where simT >= logT)
+            mLastLogT = mLogStartT;
+            mLastLogStep = size_t((mLastLogT-mLogSimStartT)/mLogSimTs+0.5);
+            // Fast forward simT
+            mLastLogSimT = mLogSimStartT + double(mLastLogStep)*mLogSimTs;
+        }
+        else
+        {
+            mLastLogT += mLogTimeDt;
+            const size_t n = size_t((mLastLogT-mLastLogSimT)/mLogSimTs+0.5);
+            mLastLogSimT += double(n)*mLogSimTs;
+            mLastLogStep += n;
+        }
+        mLogTheseTimeSteps.push_back(mLastLogStep);
+        ++mNumCalculatedLogSlots;
+    }
+}
+
+//! @brief Find the first log slot that is logged after a simulation step
+//! @details If only some log steps are calculated, the calculation is restarted or moved forward until the slot is found
+//! @param[in] simStep The simulation step
+//! @returns The log slot, or the number of log slots if no slot is logged after the step
+size_t ComponentSystem::findLogSlotAfterStep(const size_t simStep)
+{
+    if ( (mFirstLogTimeStepSlot > 0) && (mLogTheseTimeSteps.empty() || (simStep < mLogTheseTimeSteps.front())) )
+    {
+        mLogTheseTimeSteps.clear();
+        mFirstLogTimeStepSlot = 0;
+        mNumCalculatedLogSlots = 0;
+        calcNextLogTimeSteps(LogDataStore::ChunkSize);
+    }
+    while (!mLogTheseTimeSteps.empty() && (simStep >= mLogTheseTimeSteps.back()) && (mNumCalculatedLogSlots < mnLogSlots))
+    {
+        mFirstLogTimeStepSlot += mLogTheseTimeSteps.size();
+        mLogTheseTimeSteps.clear();
+        calcNextLogTimeSteps(LogDataStore::ChunkSize);
+    }
+    return mFirstLogTimeStepSlot + (std::upper_bound(mLogTheseTimeSteps.begin(), mLogTheseTimeSteps.end(), simStep) - mLogTheseTimeSteps.begin());
+}
+
 
 //! @brief Returns whether or not to keep node values instead of over writing with defaultStartValues
 bool ComponentSystem::keepsValuesAsStartValues()
@@ -1783,46 +2253,58 @@ void ComponentSystem::setKeepValuesAsStartValues(bool tf)
 //! @returns true if everything is OK, else false (simulation not permitted)
 bool ComponentSystem::checkModelBeforeSimulation()
 {
-    // Make sure that there are no components or systems with an undefined cqs_type present
-    if (mComponentUndefinedptrs.size() > 0)
-    {
-        for (size_t i=0; i<mComponentUndefinedptrs.size(); ++i)
-        {
-            addErrorMessage("The Component:  "+mComponentUndefinedptrs[i]->getName()+"  has an invalid CQS-Type:  "+mComponentUndefinedptrs[i]->getTypeCQSString());
-        }
-        return false;
-    }
+    // If the structure is unchanged since the last successful check, only the parameters need to be checked again
+    const size_t structureRevision = gModelStructureRevision;
+    const bool isWarm = isStructureUnchangedSince(mCheckedStructureRevision);
+    mCheckedStructureRevision = gNoStructureRevision;
 
-    // Check this systems own SystemPorts are connected (if required, they must be)
-    vector<Port*> ports = getPortPtrVector();
-    for (size_t i=0; i<ports.size(); ++i)
+    if (!isWarm)
     {
-        if ( ports[i]->isConnectionRequired() && !ports[i]->isConnected() )
+        // Make sure that there are no components or systems with an undefined cqs_type present
+        if (mComponentUndefinedptrs.size() > 0)
         {
-            addErrorMessage("Port:  "+ports[i]->getName()+"  on SystemComponent:  "+getName()+"  is not connected!");
+            for (size_t i=0; i<mComponentUndefinedptrs.size(); ++i)
+            {
+                addErrorMessage("The Component:  "+mComponentUndefinedptrs[i]->getName()+"  has an invalid CQS-Type:  "+mComponentUndefinedptrs[i]->getTypeCQSString());
+            }
             return false;
         }
-        else if( ports[i]->isConnected() )
+
+        // Check this systems own SystemPorts are connected (if required, they must be)
+        vector<Port*> ports = getPortPtrVector();
+        for (size_t i=0; i<ports.size(); ++i)
         {
-            if(ports[i]->getNodePtr()->getNumberOfPortsByType(PowerPortType) == 1)
+            if ( ports[i]->isConnectionRequired() && !ports[i]->isConnected() )
             {
-                addErrorMessage("Port:  "+ports[i]->getName()+"  on Component:  "+ports[i]->getComponentName()+"  is connected to a node with only one attached power port!");
+                addErrorMessage("Port:  "+ports[i]->getName()+"  on SystemComponent:  "+getName()+"  is not connected!");
                 return false;
             }
+            else if( ports[i]->isConnected() )
+            {
+                if(ports[i]->getNodePtr()->getNumberOfPortsByType(PowerPortType) == 1)
+                {
+                    addErrorMessage("Port:  "+ports[i]->getName()+"  on Component:  "+ports[i]->getComponentName()+"  is connected to a node with only one attached power port!");
+                    return false;
+                }
+            }
         }
     }
 
     // Generate a list of all system parameters (constants), to check if any are unused
+    // This is only done in full checks, so the warning is not repeated for every warm re-initialization
     std::vector<HString> unusedSysParNames;
-    const std::vector<ParameterEvaluator*> *pSysParameters = getParametersVectorPtr();
-    unusedSysParNames.reserve(pSysParameters->size());
-    for (size_t sp=0; sp<pSysParameters->size(); ++sp)
+    if (!isWarm)
     {
-        // We want to ignore those containing # as they are most likely start values in interface ports
-        const HString& rName = pSysParameters->at(sp)->getName();
-        if (!rName.containes('#'))
+        const std::vector<ParameterEvaluator*> *pSysParameters = getParametersVectorPtr();
+        unusedSysParNames.reserve(pSysParameters->size());
+        for (size_t sp=0; sp<pSysParameters->size(); ++sp)
         {
-            unusedSysParNames.push_back(rName);
+            // We want to ignore those containing # as they are most likely start values in interface ports
+            const HString& rName = pSysParameters->at(sp)->getName();
+            if (!rName.containes('#'))
+            {
+                unusedSysParNames.push_back(rName);
+            }
         }
     }
 
@@ -1835,31 +2317,34 @@ bool ComponentSystem::checkModelBeforeSimulation()
         if(pComp->isDisabled())
             continue;
 
-        // Check that ALL ports that MUST be connected are connected
-        vector<Port*> ports = pComp->getPortPtrVector();
-        for (size_t i=0; i<ports.size(); ++i)
+        // Check that ALL ports that MUST be connected are connected (unless the structure is unchanged)
+        if (!isWarm)
         {
-            if ( ports[i]->isConnectionRequired() && !ports[i]->isConnected() )
-            {
-                addErrorMessage("Port:  "+ports[i]->getName()+"  on Component:  " + pComp->getName() + "  is not connected!");
-                return false;
-            }
-            else if( ports[i]->isConnected() )
+            vector<Port*> ports = pComp->getPortPtrVector();
+            for (size_t i=0; i<ports.size(); ++i)
             {
-                size_t numPP = ports[i]->getNodePtr()->getNumberOfPortsByType(PowerPortType);
-                if (ports[i]->isInterfacePort() && ports[i]->getPortType()==PowerPortType)
+                if ( ports[i]->isConnectionRequired() && !ports[i]->isConnected() )
+                {
+                    addErrorMessage("Port:  "+ports[i]->getName()+"  on Component:  " + pComp->getName() + "  is not connected!");
+                    return false;
+                }
+                else if( ports[i]->isConnected() )
                 {
-                    if( numPP > 0 && numPP < 3)
+                    size_t numPP = ports[i]->getNodePtr()->getNumberOfPortsByType(PowerPortType);
+                    if (ports[i]->isInterfacePort() && ports[i]->getPortType()==PowerPortType)
+                    {
+                        if( numPP > 0 && numPP < 3)
+                        {
+                            addErrorMessage("InterfacePort:  "+ports[i]->getName()+"  on Component:  "+ports[i]->getComponentName()+"  is connected to a node with only two power ports!");
+                            return false;
+                        }
+                    }
+                    else if(numPP == 1)
                     {
-                        addErrorMessage("InterfacePort:  "+ports[i]->getName()+"  on Component:  "+ports[i]->getComponentName()+"  is connected to a node with only two power ports!");
+                        addErrorMessage("Port:  "+ports[i]->getName()+"  on Component:  "+ports[i]->getComponentName()+"  is connected to a node with only one power port!");
                         return false;
                     }
                 }
-                else if(numPP == 1)
-                {
-                    addErrorMessage("Port:  "+ports[i]->getName()+"  on Component:  "+ports[i]->getComponentName()+"  is connected to a node with only one power port!");
-                    return false;
-                }
             }
         }
 
@@ -1921,6 +2406,7 @@ bool ComponentSystem::checkModelBeforeSimulation()
         // Recurse testing into subsystems
         if (pComp->isComponentSystem())
         {
+            static_cast<ComponentSystem*>(pComp)->setWarmReinitialization(mWarmReinitialization);
             if (!pComp->checkModelBeforeSimulation())
             {
                 return false;
@@ -1942,6 +2428,7 @@ bool ComponentSystem::checkModelBeforeSimulation()
         addWarningMessage(ss.str().c_str());
     }
 
+    mCheckedStructureRevision = structureRevision;
     return true;
 }
 
@@ -2230,6 +2717,11 @@ bool ComponentSystem::initialize(const double startT, const double stopT)
         preInitialize();
     }
 
+    // Structural setup can be skipped if nothing but values have changed since the last initialization (preInitialize may have changed the structure)
+    const size_t structureRevision = gModelStructureRevision;
+    const bool isWarm = isStructureUnchangedSince(mInitializedStructureRevision);
+    mInitializedStructureRevision = gNoStructureRevision;
+
     mStopSimulation = false; //This variable cannot be written on below, then problem might occur with thread safety, it's a bit ugly to write on it on this row.
 
     // Set initial time
@@ -2263,14 +2755,21 @@ bool ComponentSystem::initialize(const double startT, const double stopT)
     adjustTimestep(mComponentCptrs);
     adjustTimestep(mComponentQptrs);
 
-    // Sort signal components, if they can not be sorted (algebraic loop), return with failure
-    if(!sortComponentVector(mComponentSignalptrs))
+    // The components are still sorted and the node data packed from the last initialization if the system is warm
+    if (!isWarm)
     {
-        return false;
+        // Sort signal components, if they can not be sorted (algebraic loop), return with failure
+        if(!sortComponentVector(mComponentSignalptrs))
+        {
+            return false;
+        }
+        // Sort C and Q components
+        sortComponentVector(mComponentCptrs);
+        sortComponentVector(mComponentQptrs);
+
+        // Lay out node data in simulation order, before any sub component fetch node data pointers
+        packNodeData();
     }
-    // Sort C and Q components
-    sortComponentVector(mComponentCptrs);
-    sortComponentVector(mComponentQptrs);
 
     // run top-level system initialization functions
     if (this->isTopLevelSystem())
@@ -2313,6 +2812,8 @@ bool ComponentSystem::initialize(const double startT, const double stopT)
             //! @todo should we use our own nSamples or the subsystems own ?
             static_cast<ComponentSystem*>(mComponentSignalptrs[s])->setNumLogSamples(mRequestedNumLogSamples);
             static_cast<ComponentSystem*>(mComponentSignalptrs[s])->setLogStartTime(mRequestedLogStartTime);
+            static_cast<ComponentSystem*>(mComponentSignalptrs[s])->setWarmReinitialization(mWarmReinitialization);
+            static_cast<ComponentSystem*>(mComponentSignalptrs[s])->setGroupedSimulation(mUseGroupedSimulation);
         }
 
         addCoreLogMessage("ComponentSystem::initialize() Initializing component: "+mComponentSignalptrs[s]->getName());
@@ -2338,6 +2839,8 @@ bool ComponentSystem::initialize(const double startT, const double stopT)
             //! @todo should we use our own nSamples ore the subsystems own ?
             static_cast<ComponentSystem*>(mComponentCptrs[c])->setNumLogSamples(mRequestedNumLogSamples);
             static_cast<ComponentSystem*>(mComponentCptrs[c])->setLogStartTime(mRequestedLogStartTime);
+            static_cast<ComponentSystem*>(mComponentCptrs[c])->setWarmReinitialization(mWarmReinitialization);
+            static_cast<ComponentSystem*>(mComponentCptrs[c])->setGroupedSimulation(mUseGroupedSimulation);
         }
 
         addCoreLogMessage("ComponentSystem::initialize() Initializing component: "+mComponentCptrs[c]->getName());
@@ -2363,6 +2866,8 @@ bool ComponentSystem::initialize(const double startT, const double stopT)
             //! @todo should we use our own nSamples ore the subsystems own ?
             static_cast<ComponentSystem*>(mComponentQptrs[q])->setNumLogSamples(mRequestedNumLogSamples);
             static_cast<ComponentSystem*>(mComponentQptrs[q])->setLogStartTime(mRequestedLogStartTime);
+            static_cast<ComponentSystem*>(mComponentQptrs[q])->setWarmReinitialization(mWarmReinitialization);
+            static_cast<ComponentSystem*>(mComponentQptrs[q])->setGroupedSimulation(mUseGroupedSimulation);
         }
 
         addCoreLogMessage("ComponentSystem::initialize() Initializing component: "+mComponentQptrs[q]->getName());
@@ -2378,38 +2883,301 @@ bool ComponentSystem::initialize(const double startT, const double stopT)
         return false;
     }
 
+    // Group the C and Q components by type, if grouped simulation is used
+    // The setting is latched here, since the groups are only built in initialize
+    mCSimulationGroups.clear();
+    mQSimulationGroups.clear();
+    mGroupedSimulationActive = mUseGroupedSimulation;
+    if (mGroupedSimulationActive)
+    {
+        buildSimulationGroups(mComponentCptrs, mCSimulationGroups);
+        buildSimulationGroups(mComponentQptrs, mQSimulationGroups);
+    }
+
+    // Open the log sink now that the subsystems know which of their variables to log, they are written to the same sink
+    if (mpLogSink && mEnableLogData && !openLogSink())
+    {
+        addErrorMessage("Failed to open log sink: "+mpLogSink->getLastError());
+        stopSimulation("Failed to open log sink");
+        return false;
+    }
+
     // Log the start values
     logTimeAndNodes(mTotalTakenSimulationSteps);
 
     // We seems to have initialized successfully
+    mInitializedStructureRevision = structureRevision;
     return true;
 }
 
 
-#if defined(HOPSANCORE_USEMULTITHREADING)
-void ComponentSystem::simulateMultiThreaded(const double startT, const double stopT, const size_t nDesiredThreads, const bool noChanges, const ParallelAlgorithmT algorithm)
+//! @brief Enable or disable warm re-initialization
+//! @details With warm re-initialization, initialize() and checkModelBeforeSimulation() skip the structural setup (checking connections,
+//! sorting components and laying out node data) if the model structure has not changed since the last time they succeeded.
+//! Parameters, start values, NumHop scripts and component initialization are always evaluated again. Use this when the same model is
+//! simulated many times with only changed parameter values, such as in optimizations. The setting is inherited by subsystems.
+//! Changes through the core API (adding or removing components and ports, connecting, disabling components, changing parameters that
+//! trigger reconfiguration) are detected automatically. If the structure is changed in some other way, call markStructureChanged().
+//! @param[in] warm True to enable warm re-initialization
+void ComponentSystem::setWarmReinitialization(const bool warm)
 {
-    size_t nThreads = determineActualNumberOfThreads(nDesiredThreads);      //Calculate how many threads to actually use
+    mWarmReinitialization = warm;
+}
 
-    std::stringstream ss;
-    ss << nThreads;
-    HString threadStr = ss.str().c_str();
+//! @brief Returns whether warm re-initialization is enabled
+bool ComponentSystem::isUsingWarmReinitialization() const
+{
+    return mWarmReinitialization;
+}
 
-    if(!noChanges)
-    {
-        if(algorithm != TaskStealingAlgorithm)
-        {
-            mpMultiThreadPrivates->mSplitCVector.clear();
-            mpMultiThreadPrivates->mSplitQVector.clear();
-            mpMultiThreadPrivates->mSplitSignalVector.clear();
-            mpMultiThreadPrivates->mSplitNodeVector.clear();
+//! @brief Enable or disable grouped simulation
+//! @details With grouped simulation, the single-threaded simulate() groups the C components and the Q components by type.
+//! Each group of a type that provides a batch function (see Component::getSimulateBatchFunction()) is simulated with one
+//! call, where the component simulation code can be inlined, instead of two virtual calls per component. Components in
+//! the same C or Q stage only depend on each other through signal connections, so components with connected signal ports
+//! are not grouped and the results are the same as without grouping. The setting is inherited by subsystems and takes
+//! effect at the next initialization.
+//! @param[in] grouped True to enable grouped simulation
+void ComponentSystem::setGroupedSimulation(const bool grouped)
+{
+    mUseGroupedSimulation = grouped;
+}
 
-            simulateAndMeasureTime(100);                                //Measure time
-            sortComponentVectorsByMeasuredTime();                       //Sort component vectors
+//! @brief Returns whether grouped simulation is enabled
+bool ComponentSystem::isUsingGroupedSimulation() const
+{
+    return mUseGroupedSimulation;
+}
 
-            for(size_t q=0; q<mComponentQptrs.size(); ++q)
-            {
-                addDebugMessage("Time for "+mComponentQptrs.at(q)->getName()+": "+ to_hstring(mComponentQptrs.at(q)->getMeasuredTime()));
+//! @brief Returns the number of C and Q component groups built in the last initialization, 0 if grouped simulation was not used
+size_t ComponentSystem::getNumSimulationGroups() const
+{
+    return mCSimulationGroups.size() + mQSimulationGroups.size();
+}
+
+//! @brief Group the components of one C or Q stage by their batch simulation function
+//! @details Components that can not be simulated in a batch are put in a first group, in their original order
+//! @param[in] rComponents The components in the stage
+//! @param[out] rGroups The groups
+void ComponentSystem::buildSimulationGroups(const std::vector<Component*> &rComponents, std::vector<SimulationGroupT> &rGroups) const
+{
+    rGroups.clear();
+    rGroups.push_back(SimulationGroupT());
+    rGroups.back().mpSimulateBatch = 0;
+
+    std::map<Component::SimulateBatchFunctionT, size_t> groupIndexMap;
+    for (size_t i=0; i<rComponents.size(); ++i)
+    {
+        Component *pComponent = rComponents[i];
+        Component::SimulateBatchFunctionT pSimulateBatch = 0;
+        // A batch takes exactly one step of the component timestep, so the timestep must be the same as for the system
+        if (!pComponent->isComponentSystem() && (pComponent->mTimestep == mTimestep))
+        {
+            pSimulateBatch = pComponent->getSimulateBatchFunction();
+        }
+
+        // Components connected by signals must keep their order, so they are simulated one by one
+        if (pSimulateBatch)
+        {
+            const std::vector<Port*> ports = pComponent->getPortPtrVector();
+            for (size_t p=0; p<ports.size(); ++p)
+            {
+                if ((ports[p]->getNodeType() == "NodeSignal") && ports[p]->isConnected())
+                {
+                    pSimulateBatch = 0;
+                    break;
+                }
+            }
+        }
+
+        size_t groupIndex = 0;
+        if (pSimulateBatch)
+        {
+            std::map<Component::SimulateBatchFunctionT, size_t>::iterator it = groupIndexMap.find(pSimulateBatch);
+            if (it == groupIndexMap.end())
+            {
+                groupIndex = rGroups.size();
+                groupIndexMap.insert(std::make_pair(pSimulateBatch, groupIndex));
+                rGroups.push_back(SimulationGroupT());
+                rGroups.back().mpSimulateBatch = pSimulateBatch;
+            }
+            else
+            {
+                groupIndex = it->second;
+            }
+        }
+        rGroups[groupIndex].mComponents.push_back(pComponent);
+    }
+
+    if (rGroups.front().mComponents.empty())
+    {
+        rGroups.erase(rGroups.begin());
+    }
+}
+
+//! @brief Take one time step in a number of component groups
+void ComponentSystem::simulateGroups(std::vector<SimulationGroupT> &rGroups)
+{
+    for (size_t g=0; g<rGroups.size(); ++g)
+    {
+        std::vector<Component*> &rComponents = rGroups[g].mComponents;
+        if (rGroups[g].mpSimulateBatch)
+        {
+            rGroups[g].mpSimulateBatch(&rComponents[0], rComponents.size());
+        }
+        else
+        {
+            for (size_t c=0; c<rComponents.size(); ++c)
+            {
+                rComponents[c]->simulate(mTime);
+            }
+        }
+    }
+}
+
+//! @brief Signal that the model structure has changed, the next initialization of any system will do the full structural setup
+void ComponentSystem::markStructureChanged()
+{
+    ++gModelStructureRevision;
+}
+
+//! @brief Check if warm re-initialization is enabled and the model structure is the same as at a given revision
+bool ComponentSystem::isStructureUnchangedSince(const size_t structureRevision) const
+{
+    return mWarmReinitialization && (structureRevision == gModelStructureRevision);
+}
+
+
+//! @brief Set how threads wait at the barriers in multi-threaded simulations
+//! @param [in] mode The barrier mode, used by the following calls to simulateMultiThreaded
+void ComponentSystem::setMultiThreadingBarrierMode(const BarrierModeT mode)
+{
+    mpMultiThreadPrivates->mBarrierMode = mode;
+}
+
+//! @brief Returns how threads wait at the barriers in multi-threaded simulations
+BarrierModeT ComponentSystem::getMultiThreadingBarrierMode() const
+{
+    return mpMultiThreadPrivates->mBarrierMode;
+}
+
+
+//! @brief Set the processor cores that the threads in multi-threaded simulations are pinned to
+//! @details Thread number i is pinned to core number i in the list, if there are more threads than cores the cores are
+//! reused cyclically. Thread affinity is only supported on Linux.
+//! @param [in] rCores The core indexes, if empty the operating system decides where the threads run
+void ComponentSystem::setMultiThreadingCoreAffinity(const std::vector<size_t> &rCores)
+{
+    mpMultiThreadPrivates->mThreadCores = rCores;
+}
+
+//! @brief Returns the processor cores that the threads in multi-threaded simulations are pinned to
+const std::vector<size_t> &ComponentSystem::getMultiThreadingCoreAffinity() const
+{
+    return mpMultiThreadPrivates->mThreadCores;
+}
+
+//! @brief Set if the node data of each thread should be moved to the NUMA node of the core that the thread is pinned to
+//! @details This requires a core affinity to be set, see setMultiThreadingCoreAffinity(). Only supported on Linux.
+//! @param [in] useNumaPlacement True to move the node data before the simulation threads are started
+void ComponentSystem::setMultiThreadingNumaPlacement(const bool useNumaPlacement)
+{
+    mpMultiThreadPrivates->mUseNumaPlacement = useNumaPlacement;
+}
+
+//! @brief Returns if the node data of each thread is moved to the NUMA node of its core
+bool ComponentSystem::isUsingMultiThreadingNumaPlacement() const
+{
+    return mpMultiThreadPrivates->mUseNumaPlacement;
+}
+
+#if defined(HOPSANCORE_USEMULTITHREADING)
+//! @brief Run simulation tasks in parallel in the persistent simulation thread pool, and wait for them to finish
+//! @details If there is no pool (no HopsanEssentials instance exists) a temporary pool is used
+//! @param [in] rTasks The tasks to run, each task gets a thread of its own
+//! @param [in] rCores The cores to pin the threads to, task i is pinned to core i modulo the number of cores
+//! @param [in] pSystem The system, used for warning messages
+static void runSimulationThreads(const std::vector< std::function<void()> > &rTasks, const std::vector<size_t> &rCores, const ComponentSystem *pSystem)
+{
+    SimulationThreadPool temporaryPool;
+    SimulationThreadPool *pPool = gpInternalCoreSimulationThreadPool ? gpInternalCoreSimulationThreadPool : &temporaryPool;
+    if (!pPool->run(rTasks, rCores))
+    {
+        pSystem->addWarningMessage("Could not pin all simulation threads to their cores", "threadaffinity");
+    }
+}
+
+//! @brief Move the node data used by each simulation thread to the NUMA node of the core that the thread is pinned to
+//! @details Nodes shared by components in different threads are placed with the first thread, in the order signal, C, Q.
+//! @param [in] nThreads The number of simulation threads
+void ComponentSystem::placeMultiThreadedNodeData(const size_t nThreads)
+{
+    const std::vector< std::vector<Component*> > *splitVectors[] = {&mpMultiThreadPrivates->mSplitSignalVector,
+                                                                    &mpMultiThreadPrivates->mSplitCVector,
+                                                                    &mpMultiThreadPrivates->mSplitQVector};
+    std::vector< std::vector< std::pair<const double*, size_t> > > threadData(nThreads);
+    for (size_t v=0; v<3; ++v)
+    {
+        for (size_t t=0; t<std::min(nThreads, splitVectors[v]->size()); ++t)
+        {
+            const std::vector<Component*> &rComponents = (*splitVectors[v])[t];
+            for (size_t c=0; c<rComponents.size(); ++c)
+            {
+                const std::vector<Port*> ports = rComponents[c]->getPortPtrVector();
+                for (size_t p=0; p<ports.size(); ++p)
+                {
+                    const size_t numSubPorts = ports[p]->isMultiPort() ? ports[p]->getNumPorts() : 1;
+                    for (size_t sp=0; sp<numSubPorts; ++sp)
+                    {
+                        const Node *pNode = ports[p]->getNodePtr(sp);
+                        if (pNode)
+                        {
+                            threadData[t].push_back(std::make_pair(pNode->mpDataValues, pNode->getNumDataVariables()));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    const size_t numPlacedPages = placeDataOnNumaNodes(threadData, mpMultiThreadPrivates->mThreadCores);
+    addDebugMessage("Placed "+to_hstring(numPlacedPages)+" node data pages on the NUMA nodes of the simulation threads");
+}
+
+void ComponentSystem::simulateMultiThreaded(const double startT, const double stopT, const size_t nDesiredThreads, const bool noChanges, const ParallelAlgorithmT algorithm)
+{
+    size_t nThreads = determineActualNumberOfThreads(nDesiredThreads);      //Calculate how many threads to actually use
+
+    std::stringstream ss;
+    ss << nThreads;
+    HString threadStr = ss.str().c_str();
+
+    // Reuse the schedule from the previous simulation if the model has not changed, but only if it was made for the same
+    // number of threads and algorithm
+    const bool reuseSchedule = noChanges && (mpMultiThreadPrivates->mScheduleNumThreads == nThreads) &&
+                               (mpMultiThreadPrivates->mScheduleAlgorithm == algorithm);
+    if(!reuseSchedule)
+    {
+        if(noChanges)
+        {
+            addDebugMessage("The number of threads or the algorithm has changed, creating a new schedule");
+        }
+        mpMultiThreadPrivates->mScheduleNumThreads = nThreads;
+        mpMultiThreadPrivates->mScheduleAlgorithm = algorithm;
+
+        if(algorithm != TaskStealingAlgorithm && algorithm != WorkStealingAlgorithm)
+        {
+            mpMultiThreadPrivates->mSplitCVector.clear();
+            mpMultiThreadPrivates->mSplitQVector.clear();
+            mpMultiThreadPrivates->mSplitSignalVector.clear();
+            mpMultiThreadPrivates->mSplitNodeVector.clear();
+
+            simulateAndMeasureTime(100);                                //Measure time
+            sortComponentVectorsByMeasuredTime();                       //Sort component vectors
+
+            for(size_t q=0; q<mComponentQptrs.size(); ++q)
+            {
+                addDebugMessage("Time for "+mComponentQptrs.at(q)->getName()+": "+ to_hstring(mComponentQptrs.at(q)->getMeasuredTime()));
             }
             for(size_t c=0; c<mComponentCptrs.size(); ++c)
             {
@@ -2420,8 +3188,15 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
                 addDebugMessage("Time for "+mComponentSignalptrs.at(s)->getName()+": "+to_hstring(mComponentSignalptrs.at(s)->getMeasuredTime()));
             }
 
-            distributeCcomponents(mpMultiThreadPrivates->mSplitCVector, nThreads);              //Distribute components and nodes
-            distributeQcomponents(mpMultiThreadPrivates->mSplitQVector, nThreads);
+            if(algorithm == GraphPartitioningAlgorithm)
+            {
+                partitionCQcomponents(mpMultiThreadPrivates->mSplitCVector, mpMultiThreadPrivates->mSplitQVector, nThreads);
+            }
+            else
+            {
+                distributeCcomponents(mpMultiThreadPrivates->mSplitCVector, nThreads);              //Distribute components and nodes
+                distributeQcomponents(mpMultiThreadPrivates->mSplitQVector, nThreads);
+            }
             distributeSignalcomponents(mpMultiThreadPrivates->mSplitSignalVector, nThreads);
             distributeNodePointers(mpMultiThreadPrivates->mSplitNodeVector, nThreads);
 
@@ -2469,57 +3244,66 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
 
     size_t nSteps = calcNumSimSteps(startT, stopT);
 
-    //Execute simulation
-    if(algorithm == APrioriScheduling)
-    {
-        addInfoMessage("Using a priori scheduling algorithm with "+threadStr+" threads.");
-
-        mpMultiThreadPrivates->mvTimePtrs.push_back(&mTime);
-        BarrierLock *pBarrierLock_S = new BarrierLock(nThreads);    //Create synchronization barriers
-        BarrierLock *pBarrierLock_C = new BarrierLock(nThreads);
-        BarrierLock *pBarrierLock_Q = new BarrierLock(nThreads);
-        BarrierLock *pBarrierLock_N = new BarrierLock(nThreads);
-
-        std::thread *tt = new std::thread[nThreads];
-
-        tt[0] = std::thread(simMaster,
-                            this,
-                            std::ref(mpMultiThreadPrivates->mSplitSignalVector[0]),
-                            std::ref(mpMultiThreadPrivates->mSplitCVector[0]),
-                            std::ref(mpMultiThreadPrivates->mSplitQVector[0]),             //Create master thread
-                            std::ref(mpMultiThreadPrivates->mSplitNodeVector[0]),
-                            std::ref(mpMultiThreadPrivates->mvTimePtrs),
-                            mTime,
-                            mTimestep,
-                            nSteps,
-                            pBarrierLock_S,
-                            pBarrierLock_C,
-                            pBarrierLock_Q,
-                            pBarrierLock_N);
+    // The threads in these algorithms start with a fixed set of components, place their node data close to them
+    if(mpMultiThreadPrivates->mUseNumaPlacement && !mpMultiThreadPrivates->mThreadCores.empty() &&
+       (algorithm == APrioriScheduling || algorithm == GraphPartitioningAlgorithm || algorithm == TaskStealingAlgorithm || algorithm == WorkStealingAlgorithm))
+    {
+        placeMultiThreadedNodeData(nThreads);
+    }
 
-        for (size_t t=1; t<nThreads; ++t)
+    //Execute simulation
+    if(algorithm == APrioriScheduling || algorithm == GraphPartitioningAlgorithm)
+    {
+        if(algorithm == GraphPartitioningAlgorithm)
+        {
+            addInfoMessage("Using graph partitioning scheduling algorithm with "+threadStr+" threads.");
+        }
+        else
         {
-            tt[t] = std::thread(simSlave,
-                                this,
-                                std::ref(mpMultiThreadPrivates->mSplitSignalVector[t]),
-                                std::ref(mpMultiThreadPrivates->mSplitCVector[t]),
-                                std::ref(mpMultiThreadPrivates->mSplitQVector[t]),          //Create slave threads
-                                std::ref(mpMultiThreadPrivates->mSplitNodeVector[t]),
-                                mTime,
-                                mTimestep,
-                                nSteps,
-                                pBarrierLock_S,
-                                pBarrierLock_C,
-                                pBarrierLock_Q,
-                                pBarrierLock_N);
+            addInfoMessage("Using a priori scheduling algorithm with "+threadStr+" threads.");
         }
 
-        for (size_t i = 0; i<nThreads; ++i)                 //Wait for all tasks to finish
+        mpMultiThreadPrivates->mvTimePtrs.assign(1, &mTime);
+        BarrierLock *pBarrierLock_S = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);    //Create synchronization barriers
+        BarrierLock *pBarrierLock_C = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+        BarrierLock *pBarrierLock_Q = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+        BarrierLock *pBarrierLock_N = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+
+        std::vector< std::function<void()> > tasks;
+
+        tasks.push_back(std::bind(simMaster,
+                                  this,
+                                  std::ref(mpMultiThreadPrivates->mSplitSignalVector[0]),
+                                  std::ref(mpMultiThreadPrivates->mSplitCVector[0]),
+                                  std::ref(mpMultiThreadPrivates->mSplitQVector[0]),             //Create master thread
+                                  std::ref(mpMultiThreadPrivates->mSplitNodeVector[0]),
+                                  std::ref(mpMultiThreadPrivates->mvTimePtrs),
+                                  mTime,
+                                  mTimestep,
+                                  nSteps,
+                                  pBarrierLock_S,
+                                  pBarrierLock_C,
+                                  pBarrierLock_Q,
+                                  pBarrierLock_N));
+
+        for (size_t t=1; t<nThreads; ++t)
         {
-            tt[i].join();
+            tasks.push_back(std::bind(simSlave,
+                                      this,
+                                      std::ref(mpMultiThreadPrivates->mSplitSignalVector[t]),
+                                      std::ref(mpMultiThreadPrivates->mSplitCVector[t]),
+                                      std::ref(mpMultiThreadPrivates->mSplitQVector[t]),          //Create slave threads
+                                      std::ref(mpMultiThreadPrivates->mSplitNodeVector[t]),
+                                      mTime,
+                                      mTimestep,
+                                      nSteps,
+                                      pBarrierLock_S,
+                                      pBarrierLock_C,
+                                      pBarrierLock_Q,
+                                      pBarrierLock_N));
         }
 
-        delete[] tt;
+        runSimulationThreads(tasks, mpMultiThreadPrivates->mThreadCores, this);    //Run the tasks and wait for them to finish
         delete(pBarrierLock_S);
         delete(pBarrierLock_C);
         delete(pBarrierLock_Q);
@@ -2534,90 +3318,88 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
         TaskPool *pTaskPoolC = new TaskPool(mComponentCptrs);
         TaskPool *pTaskPoolQ = new TaskPool(mComponentQptrs);
 
-        std::thread *tt = new std::thread[nThreads];
-
         std::atomic<double> *pTime = new std::atomic<double>;
         *pTime = mTime;
         std::atomic<bool> *pStop = new std::atomic<bool>;
         *pStop = false;
 
+        std::vector< std::function<void()> > tasks;
 
-        for (size_t t=0; t<nThreads-1; ++t)
-        {
-            tt[t] = std::thread(simPoolSlave,
-                                pTaskPoolC,
-                                pTaskPoolQ,
-                                pTime,
-                                pStop);
-        }
-
-        Component *pComp;
-        for(size_t i=0; i<nSteps; ++i)
+        // The master task simulates the steps, and the slave tasks help with the C and Q pools until it stops them
+        tasks.push_back([&]()
         {
-            *pTime = *pTime+mTimestep;
-
-            //S-pool
-            pTaskPoolS->open();
-            pComp = pTaskPoolS->getComponent();
-            while(pComp)
+            Component *pComp;
+            for(size_t i=0; i<nSteps; ++i)
             {
-                pComp->simulate(*pTime);
-                pTaskPoolS->reportDone();
+                *pTime = *pTime+mTimestep;
+
+                //S-pool
+                pTaskPoolS->open();
                 pComp = pTaskPoolS->getComponent();
-            }
-            while(!pTaskPoolS->isReady()) {}
-            pTaskPoolS->close();
+                while(pComp)
+                {
+                    pComp->simulate(*pTime);
+                    pTaskPoolS->reportDone();
+                    pComp = pTaskPoolS->getComponent();
+                }
+                while(!pTaskPoolS->isReady()) {}
+                pTaskPoolS->close();
 
-            //C-pool
-            pTaskPoolC->open();
-            pComp = pTaskPoolC->getComponent();
-            while(pComp)
-            {
-                pComp->simulate(*pTime);
-                pTaskPoolC->reportDone();
+                //C-pool
+                pTaskPoolC->open();
                 pComp = pTaskPoolC->getComponent();
-            }
-            while(!pTaskPoolC->isReady()) {}
-            pTaskPoolC->close();
+                while(pComp)
+                {
+                    pComp->simulate(*pTime);
+                    pTaskPoolC->reportDone();
+                    pComp = pTaskPoolC->getComponent();
+                }
+                while(!pTaskPoolC->isReady()) {}
+                pTaskPoolC->close();
 
-            //Q-pool
-            pTaskPoolQ->open();
-            pComp = pTaskPoolQ->getComponent();
-            while(pComp)
-            {
-                pComp->simulate(*pTime);
-                pTaskPoolQ->reportDone();
+                //Q-pool
+                pTaskPoolQ->open();
                 pComp = pTaskPoolQ->getComponent();
-            }
-            while(!pTaskPoolQ->isReady()) {}
-            pTaskPoolQ->close();
-
-            mTime =  *pTime;
-            logTimeAndNodes(i+1);            //Log all nodes
-        }
-        *pStop=true;
+                while(pComp)
+                {
+                    pComp->simulate(*pTime);
+                    pTaskPoolQ->reportDone();
+                    pComp = pTaskPoolQ->getComponent();
+                }
+                while(!pTaskPoolQ->isReady()) {}
+                pTaskPoolQ->close();
 
+                mTime =  *pTime;
+                logTimeAndNodes(i+1);            //Log all nodes
+            }
+            *pStop=true;
+        });
 
-        for (size_t i = 0; i<nThreads-1; ++i)                 //Wait for all tasks to finish
+        for (size_t t=0; t<nThreads-1; ++t)
         {
-            tt[i].join();
+            tasks.push_back(std::bind(simPoolSlave,
+                                      pTaskPoolC,
+                                      pTaskPoolQ,
+                                      pTime,
+                                      pStop));
         }
 
-        delete[] tt;
+        runSimulationThreads(tasks, mpMultiThreadPrivates->mThreadCores, this);    //Run the tasks and wait for them to finish
         delete(pTaskPoolS);
         delete(pTaskPoolC);
         delete(pTaskPoolQ);
+        delete(pTime);
         delete(pStop);
     }
     else if(algorithm == TaskStealingAlgorithm)
     {
         addInfoMessage("Using task-stealing algorithm with "+threadStr+" threads.");
 
-        mpMultiThreadPrivates->mvTimePtrs.push_back(&mTime);
-        BarrierLock *pBarrierLock_S = new BarrierLock(nThreads);    //Create synchronization barriers
-        BarrierLock *pBarrierLock_C = new BarrierLock(nThreads);
-        BarrierLock *pBarrierLock_Q = new BarrierLock(nThreads);
-        BarrierLock *pBarrierLock_N = new BarrierLock(nThreads);
+        mpMultiThreadPrivates->mvTimePtrs.assign(1, &mTime);
+        BarrierLock *pBarrierLock_S = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);    //Create synchronization barriers
+        BarrierLock *pBarrierLock_C = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+        BarrierLock *pBarrierLock_Q = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+        BarrierLock *pBarrierLock_N = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
 
         size_t maxSize = mComponentCptrs.size()+mComponentQptrs.size()+mComponentSignalptrs.size();
 
@@ -2633,56 +3415,120 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
             pVectorsQ->push_back(new ThreadSafeVector(mpMultiThreadPrivates->mSplitQVector[i], maxSize));
         }
 
-        std::thread *tt = new std::thread[nThreads];
-
-        tt[0] = std::thread(simStealingMaster,
-                            this,
-                            std::ref(mComponentSignalptrs),
-                            pVectorsC,
-                            pVectorsQ,             //Create master thread
-                            std::ref(mpMultiThreadPrivates->mvTimePtrs),
-                            mTime,
-                            mTimestep,
-                            nSteps,
-                            nThreads,
-                            0,
-                            pBarrierLock_S,
-                            pBarrierLock_C,
-                            pBarrierLock_Q,
-                            pBarrierLock_N,
-                            maxSize);
+        std::vector< std::function<void()> > tasks;
+
+        tasks.push_back(std::bind(simStealingMaster,
+                                  this,
+                                  std::ref(mComponentSignalptrs),
+                                  pVectorsC,
+                                  pVectorsQ,             //Create master thread
+                                  std::ref(mpMultiThreadPrivates->mvTimePtrs),
+                                  mTime,
+                                  mTimestep,
+                                  nSteps,
+                                  nThreads,
+                                  0,
+                                  pBarrierLock_S,
+                                  pBarrierLock_C,
+                                  pBarrierLock_Q,
+                                  pBarrierLock_N,
+                                  maxSize));
 
 
         for (size_t t=1; t<nThreads; ++t)
         {
-            tt[t] = std::thread(simStealingSlave,
-                                this,
-                                pVectorsC,
-                                pVectorsQ,
-                                mTime,
-                                mTimestep,
-                                nSteps,
-                                nThreads,
-                                t,
-                                pBarrierLock_S,
-                                pBarrierLock_C,
-                                pBarrierLock_Q,
-                                pBarrierLock_N,
-                                maxSize);
+            tasks.push_back(std::bind(simStealingSlave,
+                                      this,
+                                      pVectorsC,
+                                      pVectorsQ,
+                                      mTime,
+                                      mTimestep,
+                                      nSteps,
+                                      nThreads,
+                                      t,
+                                      pBarrierLock_S,
+                                      pBarrierLock_C,
+                                      pBarrierLock_Q,
+                                      pBarrierLock_N,
+                                      maxSize));
+        }
+
+        runSimulationThreads(tasks, mpMultiThreadPrivates->mThreadCores, this);    //Run the tasks and wait for them to finish
+        delete(pBarrierLock_S);
+        delete(pBarrierLock_C);
+        delete(pBarrierLock_Q);
+        delete(pBarrierLock_N);
+        delete(pVectorsC);
+        delete(pVectorsQ);
+    }
+    else if(algorithm == WorkStealingAlgorithm)
+    {
+        addInfoMessage("Using lock-free work-stealing algorithm with "+threadStr+" threads.");
+
+        mpMultiThreadPrivates->mvTimePtrs.assign(1, &mTime);
+        BarrierLock *pBarrierLock_S = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);    //Create synchronization barriers
+        BarrierLock *pBarrierLock_C = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+        BarrierLock *pBarrierLock_Q = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+        BarrierLock *pBarrierLock_N = new BarrierLock(nThreads, mpMultiThreadPrivates->mBarrierMode);
+
+        // Any thread may end up owning all components of a type, so each deque must be able to hold all of them
+        std::vector<WorkStealingDeque *> *pDequesC = new std::vector<WorkStealingDeque *>();
+        std::vector<WorkStealingDeque *> *pDequesQ = new std::vector<WorkStealingDeque *>();
+        for(size_t t=0; t<nThreads; ++t)
+        {
+            pDequesC->push_back(new WorkStealingDeque(mComponentCptrs.size()));
+            pDequesQ->push_back(new WorkStealingDeque(mComponentQptrs.size()));
         }
 
-        for (size_t i = 0; i<nThreads; ++i)                 //Wait for all tasks to finish
+        std::vector< std::function<void()> > tasks;
+
+        tasks.push_back(std::bind(simWorkStealingMaster,
+                                  this,
+                                  std::ref(mComponentSignalptrs),
+                                  mpMultiThreadPrivates->mSplitCVector[0],
+                                  mpMultiThreadPrivates->mSplitQVector[0],             //Create master thread
+                                  pDequesC,
+                                  pDequesQ,
+                                  std::ref(mpMultiThreadPrivates->mvTimePtrs),
+                                  mTime,
+                                  mTimestep,
+                                  nSteps,
+                                  0,
+                                  pBarrierLock_S,
+                                  pBarrierLock_C,
+                                  pBarrierLock_Q,
+                                  pBarrierLock_N));
+
+        for (size_t t=1; t<nThreads; ++t)
         {
-            tt[i].join();
+            tasks.push_back(std::bind(simWorkStealingSlave,
+                                      this,
+                                      mpMultiThreadPrivates->mSplitCVector[t],
+                                      mpMultiThreadPrivates->mSplitQVector[t],
+                                      pDequesC,
+                                      pDequesQ,
+                                      mTime,
+                                      mTimestep,
+                                      nSteps,
+                                      t,
+                                      pBarrierLock_S,
+                                      pBarrierLock_C,
+                                      pBarrierLock_Q,
+                                      pBarrierLock_N));
         }
 
-        delete[] tt;                                           //Clean up
+        runSimulationThreads(tasks, mpMultiThreadPrivates->mThreadCores, this);    //Run the tasks and wait for them to finish
         delete(pBarrierLock_S);
         delete(pBarrierLock_C);
         delete(pBarrierLock_Q);
         delete(pBarrierLock_N);
-        delete(pVectorsC);
-        delete(pVectorsQ);
+        for(size_t t=0; t<nThreads; ++t)
+        {
+            delete pDequesC->at(t);
+            delete pDequesQ->at(t);
+        }
+        delete(pDequesC);
+        delete(pDequesQ);
     }
     else if(algorithm == ForkJoinAlgorithm)
     {
@@ -2691,6 +3537,7 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
         // Round to nearest, we may not get exactly the stop time that we want
         size_t numSimulationSteps = calcNumSimSteps(mTime, stopT); //Here mTime is the last time step since it is not updated yet
 
+        // Use short-lived threads, the persistent thread pool would keep one idle thread alive for each task
         std::thread *tt;
 
         //Simulate
@@ -2750,6 +3597,7 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
         // Round to nearest, we may not get exactly the stop time that we want
         size_t numSimulationSteps = calcNumSimSteps(mTime, stopT); //Here mTime is the last time step since it is not updated yet
 
+        // Use short-lived threads, the persistent thread pool would keep one idle thread alive for each task
         std::thread *tt;
 
         //Simulate
@@ -2802,6 +3650,9 @@ void ComponentSystem::simulateMultiThreaded(const double startT, const double st
             logTimeAndNodes(mTotalTakenSimulationSteps);
         }
     }
+
+    // All simulation threads have been joined, write the buffered log samples in this thread
+    flushLogData();
 }
 
 
@@ -3087,6 +3938,255 @@ void ComponentSystem::distributeNodePointers(vector< vector<Node*> > &rSplitNode
     }
 }
 
+//! @brief Sums the edge weights from a component to the already assigned components in each thread
+//! @param [in] rEdges The edges of the component, mapping neighbour component index to edge weight
+//! @param [in] rAssignment The thread of each component, unassigned components have an index >= the number of threads
+//! @param [out] rConnections The summed edge weight for each thread
+static void countThreadConnections(const std::map<size_t, double> &rEdges, const std::vector<size_t> &rAssignment, std::vector<double> &rConnections)
+{
+    std::fill(rConnections.begin(), rConnections.end(), 0.0);
+    for(std::map<size_t, double>::const_iterator it=rEdges.begin(); it!=rEdges.end(); ++it)
+    {
+        if(rAssignment[it->first] < rConnections.size())
+        {
+            rConnections[rAssignment[it->first]] += it->second;
+        }
+    }
+}
+
+//! @brief Helper function that distributes C and Q components over one vector per thread by partitioning the component graph
+//! @details Components are vertices weighted by their measured time, and each node shared by two components is an edge
+//! weighted by the number of cache lines in its data. The C and Q loads are balanced separately, since they are
+//! simulated in different phases, while the data shared between threads (the cut) is minimized. Components are first
+//! assigned greedily in order of decreasing measured time, preferring threads that already have connected components.
+//! Then components are moved (or swapped) to the thread they share most data with, as long as the balance is kept.
+//! A plain load balancing start is refined the same way, and the assignment with the smallest cut is used.
+//! @param rSplitCVector Reference to vector with vectors of C components (one vector per thread)
+//! @param rSplitQVector Reference to vector with vectors of Q components (one vector per thread)
+//! @param nThreads Number of simulation threads
+void ComponentSystem::partitionCQcomponents(vector< vector<Component*> > &rSplitCVector, vector< vector<Component*> > &rSplitQVector, size_t nThreads)
+{
+    // How much above the average load a thread may be, to reduce the cut
+    const double loadTolerance = 0.05;
+    const size_t maxRefinementPasses = 10;
+    const size_t doublesPerCacheLine = NodeDataArena::CacheLineSize/sizeof(double);
+
+    // Build the vertices, the C and Q vectors are sorted by decreasing measured time
+    vector<Component*> components;
+    vector<size_t> phases;
+    vector<double> weights;
+    map<Component*, size_t> componentIndexes;
+    const vector<Component*> *phaseComponents[] = {&mComponentCptrs, &mComponentQptrs};
+    double totalWeights[2] = {0, 0};
+    double maxWeights[2] = {0, 0};
+    for(size_t ph=0; ph<2; ++ph)
+    {
+        double phaseTime = 0;
+        for(size_t c=0; c<phaseComponents[ph]->size(); ++c)
+        {
+            phaseTime += phaseComponents[ph]->at(c)->getMeasuredTime();
+        }
+        for(size_t c=0; c<phaseComponents[ph]->size(); ++c)
+        {
+            Component *pComp = phaseComponents[ph]->at(c);
+            // If nothing was measured, balance the number of components instead
+            const double weight = (phaseTime > 0) ? pComp->getMeasuredTime() : 1.0;
+            componentIndexes.insert(std::pair<Component*, size_t>(pComp, components.size()));
+            components.push_back(pComp);
+            phases.push_back(ph);
+            weights.push_back(weight);
+            totalWeights[ph] += weight;
+            maxWeights[ph] = std::max(maxWeights[ph], weight);
+        }
+    }
+
+    // Build the edges from the nodes connecting the components
+    vector< map<size_t, double> > edges(components.size());
+    for(size_t n=0; n<mSubNodePtrs.size(); ++n)
+    {
+        const Node *pNode = mSubNodePtrs[n];
+        vector<size_t> nodeComponents;
+        for(size_t p=0; p<pNode->mConnectedPorts.size(); ++p)
+        {
+            map<Component*, size_t>::const_iterator it = componentIndexes.find(pNode->mConnectedPorts[p]->getComponent());
+            if(it != componentIndexes.end())
+            {
+                nodeComponents.push_back(it->second);
+            }
+        }
+        const double edgeWeight = double((pNode->getNumDataVariables()+doublesPerCacheLine-1)/doublesPerCacheLine);
+        for(size_t i=0; i<nodeComponents.size(); ++i)
+        {
+            for(size_t j=0; j<nodeComponents.size(); ++j)
+            {
+                if(nodeComponents[i] != nodeComponents[j])
+                {
+                    edges[nodeComponents[i]][nodeComponents[j]] += edgeWeight;
+                }
+            }
+        }
+    }
+
+    double capacities[2];
+    for(size_t ph=0; ph<2; ++ph)
+    {
+        capacities[ph] = std::max(totalWeights[ph]/double(nThreads)*(1.0+loadTolerance), maxWeights[ph]);
+    }
+
+    const size_t unassigned = nThreads;
+    vector<double> connections(nThreads), otherConnections(nThreads);
+
+    vector<size_t> order(components.size());
+    for(size_t i=0; i<order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&weights](size_t a, size_t b) { return weights[a] > weights[b]; });
+
+    // Try two initial assignments, one that prefers connected threads and one that only balances the load (as
+    // distributeCcomponents), refine both and keep the one with the smallest cut
+    vector<size_t> bestAssignment;
+    vector< vector<double> > bestLoads;
+    double bestCut = 0;
+    for(size_t attempt=0; attempt<2; ++attempt)
+    {
+        const bool preferConnected = (attempt == 0);
+        vector< vector<double> > loads(2, vector<double>(nThreads, 0.0));
+        vector<size_t> assignment(components.size(), unassigned);
+
+        // Greedy assignment, C and Q components merged in order of decreasing weight
+        for(size_t o=0; o<order.size(); ++o)
+        {
+            const size_t v = order[o];
+            vector<double> &rLoads = loads[phases[v]];
+            countThreadConnections(edges[v], assignment, connections);
+            size_t bestThread = unassigned;
+            size_t leastLoadedThread = 0;
+            for(size_t t=0; t<nThreads; ++t)
+            {
+                if(rLoads[t] < rLoads[leastLoadedThread])
+                {
+                    leastLoadedThread = t;
+                }
+                if(preferConnected && (rLoads[t]+weights[v] <= capacities[phases[v]]))
+                {
+                    if((bestThread == unassigned) || (connections[t] > connections[bestThread]) ||
+                       ((connections[t] == connections[bestThread]) && (rLoads[t] < rLoads[bestThread])))
+                    {
+                        bestThread = t;
+                    }
+                }
+            }
+            if(bestThread == unassigned)
+            {
+                bestThread = leastLoadedThread;
+            }
+            assignment[v] = bestThread;
+            rLoads[bestThread] += weights[v];
+        }
+
+        // Refinement, move components to the thread they are most connected to if the balance allows it,
+        // otherwise try to swap with a component of the same type in that thread
+        for(size_t pass=0; pass<maxRefinementPasses; ++pass)
+        {
+            bool improved = false;
+            for(size_t v=0; v<components.size(); ++v)
+            {
+                vector<double> &rLoads = loads[phases[v]];
+                const double capacity = capacities[phases[v]];
+                countThreadConnections(edges[v], assignment, connections);
+                const size_t current = assignment[v];
+                size_t bestThread = current;
+                for(size_t t=0; t<nThreads; ++t)
+                {
+                    if((connections[t] > connections[bestThread]) && (rLoads[t]+weights[v] <= capacity))
+                    {
+                        bestThread = t;
+                    }
+                }
+                if(bestThread != current)
+                {
+                    rLoads[current] -= weights[v];
+                    rLoads[bestThread] += weights[v];
+                    assignment[v] = bestThread;
+                    improved = true;
+                    continue;
+                }
+
+                for(size_t u=0; u<components.size(); ++u)
+                {
+                    const size_t other = assignment[u];
+                    if((phases[u] != phases[v]) || (other == current) || (connections[other] <= connections[current]))
+                    {
+                        continue;
+                    }
+                    if((rLoads[other]-weights[u]+weights[v] > capacity) || (rLoads[current]-weights[v]+weights[u] > capacity))
+                    {
+                        continue;
+                    }
+                    countThreadConnections(edges[u], assignment, otherConnections);
+                    map<size_t, double>::const_iterator it = edges[v].find(u);
+                    const double sharedWeight = (it != edges[v].end()) ? it->second : 0.0;
+                    const double gain = (connections[other]-connections[current]) + (otherConnections[current]-otherConnections[other]) - 2.0*sharedWeight;
+                    if(gain > 0)
+                    {
+                        rLoads[current] += weights[u]-weights[v];
+                        rLoads[other] += weights[v]-weights[u];
+                        assignment[v] = other;
+                        assignment[u] = current;
+                        improved = true;
+                        break;
+                    }
+                }
+            }
+            if(!improved)
+            {
+                break;
+            }
+        }
+
+        double cut = 0;
+        for(size_t v=0; v<components.size(); ++v)
+        {
+            for(map<size_t, double>::const_iterator it=edges[v].begin(); it!=edges[v].end(); ++it)
+            {
+                if(assignment[v] != assignment[it->first])
+                {
+                    cut += it->second/2.0;
+                }
+            }
+        }
+        if(bestAssignment.empty() || (cut < bestCut))
+        {
+            bestAssignment = assignment;
+            bestLoads = loads;
+            bestCut = cut;
+        }
+    }
+    const vector<size_t> &assignment = bestAssignment;
+    const vector< vector<double> > &loads = bestLoads;
+    const double cut = bestCut;
+
+    addDebugMessage("Partitioned C and Q components, "+to_hstring(cut)+" node data cache lines are shared between threads", "partition");
+
+    // Fill the thread vectors, they are then sorted by signal dependencies in the same way as in the other distribution functions
+    rSplitCVector.resize(nThreads);
+    rSplitQVector.resize(nThreads);
+    vector< vector<Component*> > *splitVectors[] = {&rSplitCVector, &rSplitQVector};
+    for(size_t v=0; v<components.size(); ++v)
+    {
+        (*splitVectors[phases[v]])[assignment[v]].push_back(components[v]);
+    }
+
+    for(size_t i=0; i<nThreads; ++i)
+    {
+        addDebugMessage("Creating C-type thread vector, measured time = " + to_hstring(loads[0][i]*1000) + " ms", "cvector");
+        addDebugMessage("Creating Q-type thread vector, measured time = " + to_hstring(loads[1][i]*1000) + " ms", "qvector");
+        sortComponentVector(rSplitCVector[i]);
+        sortComponentVector(rSplitQVector[i]);
+    }
+}
+
 void ComponentSystem::reschedule(size_t nThreads)
 {
     mpMultiThreadPrivates->mSplitCVector.clear();
@@ -3299,6 +4399,12 @@ void ComponentSystem::distributeNodePointers(vector< vector<Node*> > &/*rSplitNo
     addWarningMessage("Called distributeNodePointers(), but multi-threading is not avaialble.");
 }
 
+
+void ComponentSystem::partitionCQcomponents(vector< vector<Component*> > &/*rSplitCVector*/, vector< vector<Component*> > &/*rSplitQVector*/, size_t /*nThreads*/)
+{
+    addWarningMessage("Called partitionCQcomponents(), but multi-threading is not avaialble.");
+}
+
 #endif
 
 
@@ -3363,22 +4469,37 @@ void ComponentSystem::simulate(const double stopT)
             mComponentSignalptrs[s]->simulate(mTime);
         }
 
-        //C components
-        for (size_t c=0; c < mComponentCptrs.size(); ++c)
+        if (mGroupedSimulationActive)
         {
-            mComponentCptrs[c]->simulate(mTime);
+            //C and Q components, grouped by type
+            simulateGroups(mCSimulationGroups);
+            simulateGroups(mQSimulationGroups);
         }
-
-        //Q components
-        for (size_t q=0; q < mComponentQptrs.size(); ++q)
+        else
         {
-            mComponentQptrs[q]->simulate(mTime);
+            //C components
+            for (size_t c=0; c < mComponentCptrs.size(); ++c)
+            {
+                mComponentCptrs[c]->simulate(mTime);
+            }
+
+            //Q components
+            for (size_t q=0; q < mComponentQptrs.size(); ++q)
+            {
+                mComponentQptrs[q]->simulate(mTime);
+            }
         }
 
         ++mTotalTakenSimulationSteps;
 
         logTimeAndNodes(mTotalTakenSimulationSteps);
     }
+
+    // Subsystems are simulated one step at a time, the top level system makes the log data readable when it is done
+    if (!mpSystemParent)
+    {
+        flushLogData();
+    }
 }
 
 bool ComponentSystem::startRealtimeSimulation(double realTimeFactor)
@@ -3434,6 +4555,166 @@ void ComponentSystem::finalize()
         mComponentSignalptrs.push_back(mDisabledSptrs.at(i));
     }
     mDisabledSptrs.clear();
+
+    // All samples have been logged, make them readable and let the log sink finish writing
+    flushLogData();
+    closeLogSink();
+}
+
+
+//! @brief Take a snapshot of the complete runtime state of the system, including all subsystems
+//! @details The snapshot can be taken at any time between initialize() and finalize(). Memory allocated by a previous
+//! snapshot in rSnapshot is reused, so taking snapshots repeatedly into the same object does not allocate.
+//! Only the internal states that components save in Component::saveState() are included.
+//! @param [out] rSnapshot The snapshot to write to, its previous contents are replaced
+void ComponentSystem::takeSnapshot(SimulationSnapshot &rSnapshot) const
+{
+    rSnapshot.clear();
+    rSnapshot.mTime = mTime;
+    writeSnapshot(rSnapshot);
+}
+
+//! @brief Restore a snapshot of the runtime state, to rewind the system or to fork a simulation into another model instance
+//! @details The system must have been initialized with the same start and stop time as the system the snapshot was
+//! taken from, and must not have been finalized. The following simulation continues exactly as it did after the
+//! snapshot was taken. Logged samples after the snapshot time are overwritten as the simulation continues, but
+//! samples that have already been handed to a log sink can not be taken back.
+//! @param [in] rSnapshot The snapshot to restore
+//! @returns False if the snapshot is empty or does not match the structure of this system, the system is unchanged
+//! unless the number of node data values or a component state does not match, in which case it must be initialized again
+bool ComponentSystem::restoreSnapshot(const SimulationSnapshot &rSnapshot)
+{
+    if (rSnapshot.isEmpty())
+    {
+        addErrorMessage("Can not restore an empty snapshot");
+        return false;
+    }
+
+    size_t nameIdx=0;
+    if (!checkSnapshotComponentNames(rSnapshot, nameIdx) || (nameIdx != rSnapshot.mComponentNames.size()))
+    {
+        addErrorMessage("The snapshot was taken from a system with other components, it can not be restored");
+        return false;
+    }
+
+    ComponentStateReader reader(&rSnapshot.mValues.getData()[0], rSnapshot.mValues.getNumValues());
+    if (!readSnapshot(reader) || !reader.isAtEnd())
+    {
+        addErrorMessage("The snapshot does not match the node data or component states of this system, it could not be restored");
+        return false;
+    }
+    return true;
+}
+
+//! @brief Append the time, step count, node data and component states of this system and its subsystems to a snapshot
+void ComponentSystem::writeSnapshot(SimulationSnapshot &rSnapshot) const
+{
+    ComponentStateWriter &rWriter = rSnapshot.mValues;
+    rWriter.write(mTime);
+    rWriter.write(mTotalTakenSimulationSteps);
+
+    rWriter.write(mSubNodePtrs.size());
+    for (size_t n=0; n<mSubNodePtrs.size(); ++n)
+    {
+        const Node *pNode = mSubNodePtrs[n];
+        rWriter.write(pNode->getNumDataVariables());
+        rWriter.write(pNode->mpDataValues, pNode->getNumDataVariables());
+    }
+
+    SubComponentMapT::const_iterator it;
+    for (it=mSubComponentMap.begin(); it!=mSubComponentMap.end(); ++it)
+    {
+        const Component *pComponent = it->second;
+        rSnapshot.mComponentNames.push_back(pComponent->getName());
+        if (pComponent->isComponentSystem())
+        {
+            static_cast<const ComponentSystem*>(pComponent)->writeSnapshot(rSnapshot);
+        }
+        else
+        {
+            rWriter.write(pComponent->mTime);
+            // The size of the state is written first, so that it can be given to restoreState() as a block of its own
+            const size_t sizeIdx = rWriter.writePlaceholder();
+            pComponent->saveState(rWriter);
+            rWriter.setValue(sizeIdx, double(rWriter.getNumValues()-sizeIdx-1));
+        }
+    }
+}
+
+//! @brief Check that the sub components of this system and its subsystems have the names stored in a snapshot
+//! @param [in] rSnapshot The snapshot to check
+//! @param [in,out] rNameIdx The index of the first name in the snapshot that belongs to this system, returns the index after the last one
+bool ComponentSystem::checkSnapshotComponentNames(const SimulationSnapshot &rSnapshot, size_t &rNameIdx) const
+{
+    SubComponentMapT::const_iterator it;
+    for (it=mSubComponentMap.begin(); it!=mSubComponentMap.end(); ++it)
+    {
+        if ((rNameIdx >= rSnapshot.mComponentNames.size()) || (rSnapshot.mComponentNames[rNameIdx] != it->first))
+        {
+            return false;
+        }
+        ++rNameIdx;
+        if (it->second->isComponentSystem() && !static_cast<const ComponentSystem*>(it->second)->checkSnapshotComponentNames(rSnapshot, rNameIdx))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! @brief Read back the values written by writeSnapshot() into this system and its subsystems
+bool ComponentSystem::readSnapshot(ComponentStateReader &rReader)
+{
+    size_t numNodes=0;
+    if (!rReader.read(mTime) || !rReader.read(mTotalTakenSimulationSteps) || !rReader.read(numNodes) || (numNodes != mSubNodePtrs.size()))
+    {
+        return false;
+    }
+
+    // The log counter follows from the step count, it is not taken from the snapshot since the log may be set up differently
+    mLogCtr = findLogSlotAfterStep(mTotalTakenSimulationSteps);
+
+    for (size_t n=0; n<mSubNodePtrs.size(); ++n)
+    {
+        Node *pNode = mSubNodePtrs[n];
+        size_t numValues=0;
+        if (!rReader.read(numValues) || (numValues != pNode->getNumDataVariables()) || !rReader.read(pNode->mpDataValues, numValues))
+        {
+            return false;
+        }
+    }
+
+    SubComponentMapT::iterator it;
+    for (it=mSubComponentMap.begin(); it!=mSubComponentMap.end(); ++it)
+    {
+        Component *pComponent = it->second;
+        if (pComponent->isComponentSystem())
+        {
+            if (!static_cast<ComponentSystem*>(pComponent)->readSnapshot(rReader))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            size_t stateSize=0;
+            if (!rReader.read(pComponent->mTime) || !rReader.read(stateSize))
+            {
+                return false;
+            }
+            ComponentStateReader stateReader = rReader.readBlock(stateSize);
+            if (!stateReader.hasFailed())
+            {
+                pComponent->restoreState(stateReader);
+            }
+            if (stateReader.hasFailed() || !stateReader.isAtEnd())
+            {
+                addErrorMessage("Could not restore the internal state of component: "+pComponent->getName());
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 ////! @brief This function will set the number of log data slots for preallocation and logDt based on a skip factor to the sample time
@@ -3493,6 +4774,9 @@ void ComponentSystem::disableLog()
     // If log disabled, then free memory if something has been previously allocated
     mTimeStorage.clear();
     mLogTheseTimeSteps.clear();
+    mFirstLogTimeStepSlot = 0;
+    mNumCalculatedLogSlots = 0;
+    mLoggedSubNodePtrs.clear();
 
     mLogTimeDt = -1.0;
     //mLastLogTime = 0.0; //Initial value should not matter, will be overwritten when selecting log amount
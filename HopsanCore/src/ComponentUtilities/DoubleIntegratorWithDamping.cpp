@@ -104,3 +104,27 @@ double DoubleIntegratorWithDamping::valueSecond()
 {
     return mDelayY;
 }
+
+//! @brief Save the integrator states, including the undo backup
+//! @param[in,out] rWriter The state writer to append to
+void DoubleIntegratorWithDamping::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mDelayU);
+    rWriter.write(mDelayY);
+    rWriter.write(mDelaySY);
+    rWriter.write(mDelayUbackup);
+    rWriter.write(mDelayYbackup);
+    rWriter.write(mDelaySYbackup);
+}
+
+//! @brief Restore integrator states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void DoubleIntegratorWithDamping::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mDelayU);
+    rReader.read(mDelayY);
+    rReader.read(mDelaySY);
+    rReader.read(mDelayUbackup);
+    rReader.read(mDelayYbackup);
+    rReader.read(mDelaySYbackup);
+}
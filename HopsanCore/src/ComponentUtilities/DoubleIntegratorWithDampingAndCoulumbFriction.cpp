@@ -171,3 +171,29 @@ double DoubleIntegratorWithDampingAndCoulombFriction::valueSecond()
 {
     return mDelayY;
 }
+
+//! @brief Save the integrator states, including the undo backup
+//! @param[in,out] rWriter The state writer to append to
+void DoubleIntegratorWithDampingAndCoulombFriction::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mDelayU);
+    rWriter.write(mDelayY);
+    rWriter.write(mDelaySY);
+    rWriter.write(mDelayUbackup);
+    rWriter.write(mDelayYbackup);
+    rWriter.write(mDelaySYbackup);
+    rWriter.write(movement);
+}
+
+//! @brief Restore integrator states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void DoubleIntegratorWithDampingAndCoulombFriction::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mDelayU);
+    rReader.read(mDelayY);
+    rReader.read(mDelaySY);
+    rReader.read(mDelayUbackup);
+    rReader.read(mDelayYbackup);
+    rReader.read(mDelaySYbackup);
+    rReader.read(movement);
+}
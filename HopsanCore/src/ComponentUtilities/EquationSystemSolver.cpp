@@ -33,6 +33,7 @@
 
 #include "ComponentUtilities/EquationSystemSolver.h"
 #include "ComponentUtilities/ludcmp.h"
+#include "ComponentUtilities/SparseLUSolver.h"
 #include "CoreUtilities/HopsanCoreMessageHandler.h"
 #include "Component.h"
 #include "ComponentUtilities/matrix.h"
@@ -622,6 +623,67 @@ static int kinsolJacobianCallback(N_Vector y, N_Vector f, SUNMatrix J, void *use
 }
 
 
+// Equation systems with at least this many variables use the sparse linear solver in Newton iterations
+static const int kinsolSparseLinearSolverMinSize = 10;
+
+
+static SUNLinearSolver_Type sparseLinearSolverGetType(SUNLinearSolver /*S*/)
+{
+    return SUNLINEARSOLVER_DIRECT;
+}
+
+
+static int sparseLinearSolverSetup(SUNLinearSolver S, SUNMatrix A)
+{
+    SparseLUSolver *pSolver = static_cast<SparseLUSolver*>(S->content);
+    if(!pSolver->factor(SM_DATA_D(A))) {
+        return SUNLS_LUFACT_FAIL;
+    }
+    return SUNLS_SUCCESS;
+}
+
+
+static int sparseLinearSolverSolve(SUNLinearSolver S, SUNMatrix /*A*/, N_Vector x, N_Vector b, realtype /*tol*/)
+{
+    SparseLUSolver *pSolver = static_cast<SparseLUSolver*>(S->content);
+    N_VScale(1.0, b, x);
+    pSolver->solve(NV_DATA_S(x));
+    return SUNLS_SUCCESS;
+}
+
+
+static int sparseLinearSolverFree(SUNLinearSolver S)
+{
+    if(S) {
+        delete static_cast<SparseLUSolver*>(S->content);
+        S->content = 0;
+        SUNLinSolFreeEmpty(S);
+    }
+    return SUNLS_SUCCESS;
+}
+
+
+//! @brief Creates a SUNDIALS direct linear solver that uses SparseLUSolver for a dense SUNMatrix
+//! @details The sparsity pattern is detected from the Jacobian, and the pivots and the factor pattern from the first
+//! decomposition are reused in later Newton iterations and time steps
+static SUNLinearSolver newSparseLinearSolver(int n)
+{
+    SUNLinearSolver S = SUNLinSolNewEmpty();
+    if(!S) {
+        return 0;
+    }
+    S->ops->gettype = sparseLinearSolverGetType;
+    S->ops->setup = sparseLinearSolverSetup;
+    S->ops->solve = sparseLinearSolverSolve;
+    S->ops->free = sparseLinearSolverFree;
+
+    SparseLUSolver *pSolver = new SparseLUSolver();
+    pSolver->setSize(n);
+    S->content = pSolver;
+    return S;
+}
+
+
 class KinsolSolver::Impl
 {
 public:
@@ -696,9 +758,15 @@ KinsolSolver::Impl::Impl(Component *pComponent, double tol, int n, SolverTypeEnu
             return;
         }
 
-        LS = SUNLinSol_Dense(y, J);
+        // Large systems are usually sparse, then only the non-zero pattern of the Jacobian is decomposed
+        if(n >= kinsolSparseLinearSolverMinSize) {
+            LS = newSparseLinearSolver(n);
+        }
+        else {
+            LS = SUNLinSol_Dense(y, J);
+        }
         if(!LS) {
-            mpComponent->stopSimulation("SUNLinSol_Dense() return null pointer.");
+            mpComponent->stopSimulation("Unable to create linear solver for KINSOL.");
             return;
         }
 
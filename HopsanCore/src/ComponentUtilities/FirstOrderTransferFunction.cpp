@@ -221,6 +221,31 @@ bool FirstOrderTransferFunction::isSaturated() const
     return mIsSaturated;
 }
 
+//! @brief Save the transfer function states and backup buffers
+//! @note The coefficients and limits are not saved, they are derived from parameters
+//! @param[in,out] rWriter The state writer to append to
+void FirstOrderTransferFunction::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mValue);
+    rWriter.write(mDelayedU);
+    rWriter.write(mDelayedY);
+    rWriter.write(mIsSaturated);
+    mBackupU.saveState(rWriter);
+    mBackupY.saveState(rWriter);
+}
+
+//! @brief Restore transfer function states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void FirstOrderTransferFunction::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mValue);
+    rReader.read(mDelayedU);
+    rReader.read(mDelayedY);
+    rReader.read(mIsSaturated);
+    mBackupU.restoreState(rReader);
+    mBackupY.restoreState(rReader);
+}
+
 
 
 
@@ -338,6 +363,24 @@ double FirstOrderTransferFunctionVariable::value()
     return mValue;
 }
 
+//! @brief Save the transfer function states
+//! @param[in,out] rWriter The state writer to append to
+void FirstOrderTransferFunctionVariable::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mValue);
+    rWriter.write(mDelayU);
+    rWriter.write(mDelayY);
+}
+
+//! @brief Restore transfer function states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void FirstOrderTransferFunctionVariable::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mValue);
+    rReader.read(mDelayU);
+    rReader.read(mDelayY);
+}
+
 
 //! @class hopsan::FirstOrderLowPassFilter
 //! @ingroup ComponentUtilityClasses
@@ -126,3 +126,19 @@ double IntegratorLimited::value()
 {
     return mDelayY;
 }
+
+//! @brief Save the integrator states
+//! @param[in,out] rWriter The state writer to append to
+void IntegratorLimited::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mDelayU);
+    rWriter.write(mDelayY);
+}
+
+//! @brief Restore integrator states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void IntegratorLimited::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mDelayU);
+    rReader.read(mDelayY);
+}
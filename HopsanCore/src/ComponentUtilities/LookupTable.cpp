@@ -32,6 +32,363 @@
 //$Id$
 
 #include "ComponentUtilities/LookupTable.h"
+#include "CoreUtilities/ModelLoadProgram.h"
+#include "CoreUtilities/MappedFile.h"
+#include "ComponentUtilities/num2string.hpp"
+
+#include <map>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <cerrno>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace hopsan;
+
+namespace {
+
+std::mutex gSharedLookupTablesMutex;
+std::map<hopsan::HString, LookupTableNDBase> gSharedLookupTables;
+
+// Tables smaller than this are parsed faster than a cache file can be looked up
+const size_t gMinCachedTableBytes = 64*1024;
+
+const char gTableCacheMagic[8] = {'H','O','P','S','A','N','L','T'};
+const uint32_t gTableCacheVersion = 1;
+
+//! @brief The header at the start of a lookup table cache file
+//! @details The header is followed by the index sizes (one uint64_t per dimension), the key text padded to
+//! a multiple of 8 bytes, the index data of each dimension and the value data. All doubles are 8-byte aligned.
+struct TableCacheFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numDims;
+    uint64_t numValues;
+    uint64_t keySize;
+};
+
+size_t paddedSize(const size_t size)
+{
+    return (size+7) & ~size_t(7);
+}
+
+HString gTableCacheDirectory;
+bool gTableCacheDirectoryIsSet = false;
+
+HString getDefaultTableCacheDirectory()
+{
+#ifdef _WIN32
+    char tempDirBuff[MAX_PATH+1];
+    if (GetTempPathA(MAX_PATH+1, tempDirBuff) == 0)
+    {
+        return HString();
+    }
+    HString tempDir(tempDirBuff);
+    return tempDir+"/Hopsan/tablecache";
+#else
+    // The temp directory is shared by all users, so each user gets a private cache directory
+    const char *pTempDir = getenv("TMPDIR");
+    HString tempDir(pTempDir ? pTempDir : "/tmp");
+    return tempDir+"/Hopsan-"+to_hstring(size_t(getuid()))+"/tablecache";
+#endif
+}
+
+//! @brief Create a directory that only the current user can access, or check an existing one
+//! @returns True if the directory exists and, except on Windows, is owned by and only accessible to the current user
+bool createPrivateDirectory(const HString &rPath)
+{
+#ifdef _WIN32
+    struct stat st;
+    if (stat(rPath.c_str(), &st) == 0)
+    {
+        return ((st.st_mode & S_IFDIR) != 0);
+    }
+    return (_mkdir(rPath.c_str()) == 0);
+#else
+    if ((mkdir(rPath.c_str(), 0700) != 0) && (errno != EEXIST))
+    {
+        return false;
+    }
+    // An existing directory could have been created by someone else, or be a link to some other place
+    struct stat st;
+    return (lstat(rPath.c_str(), &st) == 0) && S_ISDIR(st.st_mode) && (st.st_uid == getuid()) && ((st.st_mode & 0077) == 0);
+#endif
+}
+
+//! @brief Get the cache file path for a table, must be called with the mutex locked
+//! @returns The path, or an empty string if caching is disabled or the cache directory can not be created
+HString getTableCacheFilePath(const HString &rKey)
+{
+    if (!gTableCacheDirectoryIsSet)
+    {
+        gTableCacheDirectory = getDefaultTableCacheDirectory();
+        gTableCacheDirectoryIsSet = true;
+        if (!gTableCacheDirectory.empty())
+        {
+            // Create the parent directory first
+            const size_t lastSep = gTableCacheDirectory.rfind('/');
+            if (!createPrivateDirectory(gTableCacheDirectory.substr(0, lastSep)) || !createPrivateDirectory(gTableCacheDirectory))
+            {
+                gTableCacheDirectory.clear();
+            }
+        }
+    }
+    if (gTableCacheDirectory.empty())
+    {
+        return HString();
+    }
+    ModelFingerprint fingerprint;
+    fingerprint.addString(rKey);
+    char buff[32];
+    snprintf(buff, sizeof(buff), "/%016llx.hlt", static_cast<unsigned long long>(fingerprint.getValue()));
+    return gTableCacheDirectory+buff;
+}
+
+//! @brief Map a table cache file
+//! @returns The data of the file, or an empty pointer if the file does not exist or does not match
+std::shared_ptr<LookupTableData> loadTableCacheFile(const HString &rFilePath, const HString &rKey, const size_t numDims)
+{
+    std::shared_ptr<MappedFile> pFile = std::make_shared<MappedFile>();
+    if (!pFile->open(rFilePath) || (pFile->getSize() < sizeof(TableCacheFileHeader)))
+    {
+        return std::shared_ptr<LookupTableData>();
+    }
+
+    TableCacheFileHeader header;
+    memcpy(&header, pFile->getData(), sizeof(header));
+    if ((memcmp(header.magic, gTableCacheMagic, sizeof(gTableCacheMagic)) != 0) || (header.version != gTableCacheVersion) ||
+        (header.numDims != numDims) || (header.keySize != rKey.size()))
+    {
+        return std::shared_ptr<LookupTableData>();
+    }
+
+    size_t offset = sizeof(header);
+    const size_t fileSize = pFile->getSize();
+    if (offset + numDims*sizeof(uint64_t) + paddedSize(rKey.size()) > fileSize)
+    {
+        return std::shared_ptr<LookupTableData>();
+    }
+    std::vector<uint64_t> indexSizes(numDims);
+    memcpy(&indexSizes[0], pFile->getData()+offset, numDims*sizeof(uint64_t));
+    offset += numDims*sizeof(uint64_t);
+    // The file name is a hash of the key, make sure that it is actually the same key
+    if (memcmp(pFile->getData()+offset, rKey.c_str(), rKey.size()) != 0)
+    {
+        return std::shared_ptr<LookupTableData>();
+    }
+    offset += paddedSize(rKey.size());
+
+    // Check the total size before the data is accessed, the file may have been truncated
+    uint64_t numDoubles = header.numValues;
+    for (size_t d=0; d<numDims; ++d)
+    {
+        numDoubles += indexSizes[d];
+    }
+    if (offset + numDoubles*sizeof(double) != fileSize)
+    {
+        return std::shared_ptr<LookupTableData>();
+    }
+
+    std::shared_ptr<LookupTableData> pData = std::make_shared<LookupTableData>();
+    const double *pDoubles = reinterpret_cast<const double*>(pFile->getData()+offset);
+    for (size_t d=0; d<numDims; ++d)
+    {
+        pData->mMappedIndexData.push_back(pDoubles);
+        pData->mMappedIndexSizes.push_back(size_t(indexSizes[d]));
+        pDoubles += indexSizes[d];
+    }
+    pData->mpMappedValueData = pDoubles;
+    pData->mNumMappedValues = size_t(header.numValues);
+    pData->mpMappedFile = pFile;
+    return pData;
+}
+
+//! @brief Write a table cache file
+//! @details The file is written under a temporary name and then renamed, so that other processes never see a partial file
+void saveTableCacheFile(const HString &rFilePath, const HString &rKey, const LookupTableNDBase &rTable)
+{
+    TableCacheFileHeader header;
+    memcpy(header.magic, gTableCacheMagic, sizeof(gTableCacheMagic));
+    header.version = gTableCacheVersion;
+    header.numDims = uint32_t(rTable.getNumDims());
+    header.numValues = rTable.getNumValues();
+    header.keySize = rKey.size();
+
+    const HString tempFilePath = rFilePath+".tmp"+to_hstring(size_t(std::clock()))+"_"+to_hstring(reinterpret_cast<size_t>(&rTable));
+    {
+        std::ofstream file(tempFilePath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (size_t d=0; d<rTable.getNumDims(); ++d)
+        {
+            const uint64_t indexSize = rTable.getDimSize(d);
+            file.write(reinterpret_cast<const char*>(&indexSize), sizeof(indexSize));
+        }
+        const char padding[8] = {0,0,0,0,0,0,0,0};
+        file.write(rKey.c_str(), std::streamsize(rKey.size()));
+        file.write(padding, std::streamsize(paddedSize(rKey.size())-rKey.size()));
+        for (size_t d=0; d<rTable.getNumDims(); ++d)
+        {
+            file.write(reinterpret_cast<const char*>(rTable.getIndexData(d)), std::streamsize(rTable.getDimSize(d)*sizeof(double)));
+        }
+        file.write(reinterpret_cast<const char*>(rTable.getValueData()), std::streamsize(rTable.getNumValues()*sizeof(double)));
+        if (!file.good())
+        {
+            file.close();
+            std::remove(tempFilePath.c_str());
+            return;
+        }
+    }
+#ifdef _WIN32
+    std::remove(rFilePath.c_str());
+#endif
+    if (std::rename(tempFilePath.c_str(), rFilePath.c_str()) != 0)
+    {
+        std::remove(tempFilePath.c_str());
+    }
+}
+
+//! @brief Remove tables that are no longer used by any component, must be called with the mutex locked
+void removeUnusedSharedLookupTables()
+{
+    std::map<hopsan::HString, LookupTableNDBase>::iterator it = gSharedLookupTables.begin();
+    while (it != gSharedLookupTables.end())
+    {
+        if (it->second.isDataShared())
+        {
+            ++it;
+        }
+        else
+        {
+            gSharedLookupTables.erase(it++);
+        }
+    }
+}
+
+}
+
+//! @brief Get a lookup table that has already been loaded by some other component, in this or in another process
+//! @details Tables loaded in this process are shared until they are modified. Large tables are also looked up in the
+//! table cache directory, where they are memory mapped read-only so that all processes share the same physical memory.
+//! @param [in] rKey The key describing the data source and how it was loaded
+//! @param [out] rTable The table to share the data with, must have the same number of dimensions as the registered table
+//! @returns True if a table was found
+bool hopsan::getSharedLookupTable(const HString &rKey, LookupTableNDBase &rTable)
+{
+    if (rKey.empty())
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(gSharedLookupTablesMutex);
+    std::map<HString, LookupTableNDBase>::iterator it = gSharedLookupTables.find(rKey);
+    if ((it != gSharedLookupTables.end()) && (it->second.getNumDims() == rTable.getNumDims()))
+    {
+        rTable = it->second;
+        return true;
+    }
+
+    const HString cacheFilePath = getTableCacheFilePath(rKey);
+    if (!cacheFilePath.empty())
+    {
+        std::shared_ptr<LookupTableData> pData = loadTableCacheFile(cacheFilePath, rKey, rTable.getNumDims());
+        if (pData)
+        {
+            if (rTable.setSharedData(pData))
+            {
+                removeUnusedSharedLookupTables();
+                gSharedLookupTables.erase(rKey);
+                gSharedLookupTables.insert(std::pair<HString, LookupTableNDBase>(rKey, rTable));
+                return true;
+            }
+            rTable.clear();
+        }
+    }
+    return false;
+}
+
+//! @brief Make a loaded lookup table available to other components that load the same data
+//! @details The table is only kept in memory as long as some component is using its data.
+//! Large tables are also written to the table cache directory, so that other processes can map them.
+//! @param [in] rKey The key describing the data source and how it was loaded
+//! @param [in] rTable The table, its data should be sorted and checked
+void hopsan::addSharedLookupTable(const HString &rKey, const LookupTableNDBase &rTable)
+{
+    if (!rKey.empty())
+    {
+        std::lock_guard<std::mutex> lock(gSharedLookupTablesMutex);
+        removeUnusedSharedLookupTables();
+        gSharedLookupTables.erase(rKey);
+        gSharedLookupTables.insert(std::pair<HString, LookupTableNDBase>(rKey, rTable));
+
+        if (rTable.getNumValues()*sizeof(double) >= gMinCachedTableBytes)
+        {
+            const HString cacheFilePath = getTableCacheFilePath(rKey);
+            if (!cacheFilePath.empty())
+            {
+                saveTableCacheFile(cacheFilePath, rKey, rTable);
+            }
+        }
+    }
+}
+
+//! @brief Set the directory where large lookup tables are cached as memory mappable files
+//! @details The default is Hopsan/tablecache in the temp directory of the user on Windows, and Hopsan-<uid>/tablecache in the
+//! system temp directory elsewhere. The default directory is only used if it is private to the user.
+//! @param [in] rDirectory The directory, it must exist. An empty string disables the table cache files.
+void hopsan::setLookupTableCacheDirectory(const HString &rDirectory)
+{
+    std::lock_guard<std::mutex> lock(gSharedLookupTablesMutex);
+    gTableCacheDirectory = rDirectory;
+    gTableCacheDirectoryIsSet = true;
+}
+
+//! @brief Get a key identifying the contents of a lookup table data source
+//! @details Files are identified by their size and contents, since modification times are too coarse and are kept when files are copied.
+//! Hashing the contents is still much faster than parsing them.
+//! @param [in] rFilePath The data file, only used if rText is empty
+//! @param [in] rText The data text
+//! @returns The key, or an empty string if the file does not exist or can not be read
+hopsan::HString hopsan::getLookupTableSourceKey(const HString &rFilePath, const HString &rText)
+{
+    ModelFingerprint fingerprint;
+    if (!rText.empty())
+    {
+        fingerprint.addString("text:");
+        fingerprint.addString(rText);
+    }
+    else
+    {
+        struct stat st;
+        if (stat(rFilePath.c_str(), &st) != 0)
+        {
+            return HString();
+        }
+        char buff[64];
+        snprintf(buff, sizeof(buff), "file:%llu:", static_cast<unsigned long long>(st.st_size));
+        fingerprint.addString(buff);
+        if (!fingerprint.addFile(rFilePath))
+        {
+            return HString();
+        }
+    }
+    char buff[32];
+    snprintf(buff, sizeof(buff), "%016llx", static_cast<unsigned long long>(fingerprint.getValue()));
+    return HString(buff);
+}
 
 
 //LookupTable1DNonTemplate::LookupTable1DNonTemplate()
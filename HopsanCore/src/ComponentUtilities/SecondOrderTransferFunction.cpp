@@ -244,6 +244,35 @@ bool SecondOrderTransferFunction::isSaturated() const
     return mIsSaturated;
 }
 
+//! @brief Save the transfer function states and backup buffers
+//! @note The coefficients and limits are not saved, they are derived from parameters
+//! @param[in,out] rWriter The state writer to append to
+void SecondOrderTransferFunction::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mValue);
+    rWriter.write(mDelayedU);
+    rWriter.write(mDelayed2U);
+    rWriter.write(mDelayedY);
+    rWriter.write(mDelayed2Y);
+    rWriter.write(mIsSaturated);
+    mBackupU.saveState(rWriter);
+    mBackupY.saveState(rWriter);
+}
+
+//! @brief Restore transfer function states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void SecondOrderTransferFunction::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mValue);
+    rReader.read(mDelayedU);
+    rReader.read(mDelayed2U);
+    rReader.read(mDelayedY);
+    rReader.read(mDelayed2Y);
+    rReader.read(mIsSaturated);
+    mBackupU.restoreState(rReader);
+    mBackupY.restoreState(rReader);
+}
+
 
 
 
@@ -354,6 +383,24 @@ double SecondOrderTransferFunctionVariable::value()
     return mValue;
 }
 
+//! @brief Save the transfer function states
+//! @param[in,out] rWriter The state writer to append to
+void SecondOrderTransferFunctionVariable::saveState(ComponentStateWriter &rWriter) const
+{
+    rWriter.write(mValue);
+    rWriter.write(mDelayU, 2);
+    rWriter.write(mDelayY, 2);
+}
+
+//! @brief Restore transfer function states saved by saveState()
+//! @param[in,out] rReader The state reader to read from
+void SecondOrderTransferFunctionVariable::restoreState(ComponentStateReader &rReader)
+{
+    rReader.read(mValue);
+    rReader.read(mDelayU, 2);
+    rReader.read(mDelayY, 2);
+}
+
 void SecondOrderTransferFunctionVariable::recalculateCoefficients()
 {
     mCoeffU[0] = mNum[0]*(*mpTimeStep)*(*mpTimeStep) + 2.0*mNum[1]*(*mpTimeStep) + 4.0*mNum[2];
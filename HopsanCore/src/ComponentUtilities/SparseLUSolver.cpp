@@ -0,0 +1,407 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   SparseLUSolver.cpp
+//! @author FluMeS
+//!
+//! @brief Contains a sparse LU-decomposition solver for Jacobians with a fixed sparsity pattern
+//!
+//$Id$
+
+#include "ComponentUtilities/SparseLUSolver.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace hopsan;
+
+//! @class hopsan::SparseLUSolver
+//! @ingroup ComponentUtilityClasses
+//! @brief A linear equation system solver using sparse LU-decomposition, for Jacobians with a fixed sparsity pattern
+//!
+//! The matrix is given as a dense column-major array, the same format as in Component::getJacobian(). The sparsity
+//! pattern is detected from the non-zero elements and grows whenever a new non-zero element appears. A fill reducing
+//! row and column order is computed from the pattern, and the first decomposition chooses pivots and stores the
+//! pattern of the L and U factors. Later decompositions reuse the pivots and the factor pattern and only recalculate
+//! the numerical values, until a pivot becomes too small or the pattern grows.
+//! The cost of a decomposition then depends on the number of non-zeros in the factors instead of on the cube of the
+//! matrix size.
+
+
+SparseLUSolver::SparseLUSolver()
+{
+    mPivotTolerance = 0.001;
+    setSize(0);
+}
+
+
+//! @brief Set the size of the equation system, this clears the sparsity pattern
+//! @param [in] n The number of equations and variables
+void SparseLUSolver::setSize(const int n)
+{
+    mN = std::max(n, 0);
+    mHaveSymbolic = false;
+    mNumSymbolicFactorizations = 0;
+
+    // The diagonal is always included, so that pivots on the diagonal can be preferred
+    mPattern.assign(size_t(mN)*size_t(mN), 0);
+    for (int i=0; i<mN; ++i)
+    {
+        mPattern[size_t(i)*size_t(mN)+size_t(i)] = 1;
+    }
+    mWork.assign(size_t(mN), 0.0);
+    mMarks.assign(size_t(mN), -1);
+    analyzePattern();
+}
+
+
+//! @brief Returns the size of the equation system
+int SparseLUSolver::getSize() const
+{
+    return mN;
+}
+
+
+//! @brief LU-decomposes a matrix
+//! @param [in] pMatrix The matrix as a dense column-major array with size*size elements
+//! @returns False if the matrix is singular or contains elements that are not finite
+bool SparseLUSolver::factor(const double *pMatrix)
+{
+    if (addNonZerosToPattern(pMatrix))
+    {
+        analyzePattern();
+    }
+    if (mHaveSymbolic && refactor(pMatrix))
+    {
+        return true;
+    }
+    return factorWithPivoting(pMatrix);
+}
+
+
+//! @brief Solves the equation system with the latest LU-decomposition
+//! @param [in,out] pVector The right hand side, it is replaced by the solution
+void SparseLUSolver::solve(double *pVector)
+{
+    // Forward substitution with the unit lower triangular L, in elimination order
+    std::vector<double> &y = mWork;
+    for (int i=0; i<mN; ++i)
+    {
+        double sum = pVector[mRowOrder[i]];
+        for (int l=mLStart[i]; l<mLStart[i+1]; ++l)
+        {
+            sum -= mLValues[l]*y[mLSteps[l]];
+        }
+        y[i] = sum;
+    }
+
+    // Back substitution with U, the first element in each row is the pivot
+    for (int i=mN-1; i>=0; --i)
+    {
+        double sum = y[i];
+        y[i] = 0.0;
+        for (int u=mUStart[i]+1; u<mUStart[i+1]; ++u)
+        {
+            sum -= mUValues[u]*pVector[mUColumns[u]];
+        }
+        pVector[mPivotColumns[i]] = sum/mUValues[mUStart[i]];
+    }
+}
+
+
+//! @brief Returns the number of elements in the sparsity pattern of the matrix
+size_t SparseLUSolver::getNumNonZeros() const
+{
+    return mRowColumns.size();
+}
+
+
+//! @brief Returns the number of elements in the L and U factors, including fill-in
+size_t SparseLUSolver::getNumFactorNonZeros() const
+{
+    return mLSteps.size() + mUColumns.size();
+}
+
+
+//! @brief Returns how many times pivots and the factor pattern have been calculated
+size_t SparseLUSolver::getNumSymbolicFactorizations() const
+{
+    return mNumSymbolicFactorizations;
+}
+
+
+//! @brief Adds non-zero elements outside the current pattern to the pattern
+//! @returns True if the pattern has grown
+bool SparseLUSolver::addNonZerosToPattern(const double *pMatrix)
+{
+    bool added = false;
+    const size_t size = mPattern.size();
+    for (size_t i=0; i<size; ++i)
+    {
+        if (!mPattern[i] && (pMatrix[i] != 0.0))
+        {
+            mPattern[i] = 1;
+            added = true;
+        }
+    }
+    return added;
+}
+
+
+//! @brief Calculates the row lists of the pattern and a fill reducing elimination order
+//! @details The order is a minimum degree order of the symmetric pattern A+A^T, it is used for both rows and
+//! preferred pivot columns
+void SparseLUSolver::analyzePattern()
+{
+    const size_t n = size_t(mN);
+    mHaveSymbolic = false;
+
+    mRowStart.assign(n+1, 0);
+    mRowColumns.clear();
+    mRowIndexes.clear();
+    for (size_t r=0; r<n; ++r)
+    {
+        for (size_t c=0; c<n; ++c)
+        {
+            if (mPattern[c*n+r])
+            {
+                mRowColumns.push_back(int(c));
+                mRowIndexes.push_back(int(c*n+r));
+            }
+        }
+        mRowStart[r+1] = int(mRowColumns.size());
+    }
+
+    std::vector<char> graph(n*n, 0);
+    std::vector<int> degrees(n, 0);
+    for (size_t r=0; r<n; ++r)
+    {
+        for (size_t c=0; c<n; ++c)
+        {
+            if ((r != c) && (mPattern[c*n+r] || mPattern[r*n+c]))
+            {
+                graph[r*n+c] = 1;
+                ++degrees[r];
+            }
+        }
+    }
+
+    // Eliminate the node with the fewest neighbours, its neighbours become connected to each other
+    std::vector<char> eliminated(n, 0);
+    std::vector<int> neighbours;
+    mRowOrder.clear();
+    for (size_t step=0; step<n; ++step)
+    {
+        size_t v = n;
+        for (size_t i=0; i<n; ++i)
+        {
+            if (!eliminated[i] && ((v == n) || (degrees[i] < degrees[v])))
+            {
+                v = i;
+            }
+        }
+        eliminated[v] = 1;
+        mRowOrder.push_back(int(v));
+
+        neighbours.clear();
+        for (size_t i=0; i<n; ++i)
+        {
+            if (!eliminated[i] && graph[v*n+i])
+            {
+                neighbours.push_back(int(i));
+            }
+        }
+        for (size_t a=0; a<neighbours.size(); ++a)
+        {
+            const size_t na = size_t(neighbours[a]);
+            for (size_t b=0; b<neighbours.size(); ++b)
+            {
+                const size_t nb = size_t(neighbours[b]);
+                if ((na != nb) && !graph[na*n+nb])
+                {
+                    graph[na*n+nb] = 1;
+                    ++degrees[na];
+                }
+            }
+            graph[na*n+v] = 0;
+            --degrees[na];
+        }
+    }
+}
+
+
+//! @brief LU-decomposition with threshold partial pivoting, that also stores the pivots and the factor pattern
+//! @details Rows are eliminated in the fill reducing order. The diagonal element is used as pivot if it is not much
+//! smaller than the largest candidate in the row, otherwise the largest candidate is used.
+bool SparseLUSolver::factorWithPivoting(const double *pMatrix)
+{
+    const int n = mN;
+    ++mNumSymbolicFactorizations;
+    mHaveSymbolic = false;
+
+    mPivotColumns.assign(size_t(n), -1);
+    std::vector<int> pivotSteps(size_t(n), -1);
+    mLStart.assign(size_t(n)+1, 0);
+    mLSteps.clear();
+    mLValues.clear();
+    mUStart.assign(size_t(n)+1, 0);
+    mUColumns.clear();
+    mUValues.clear();
+    std::fill(mMarks.begin(), mMarks.end(), -1);
+
+    std::vector<int> columns;
+    for (int i=0; i<n; ++i)
+    {
+        const int r = mRowOrder[i];
+
+        // Scatter the row, all elements in the pattern are included even if they are zero right now
+        columns.clear();
+        for (int a=mRowStart[r]; a<mRowStart[r+1]; ++a)
+        {
+            const int c = mRowColumns[a];
+            mWork[c] = pMatrix[mRowIndexes[a]];
+            mMarks[c] = i;
+            columns.push_back(c);
+        }
+
+        // Eliminate with the previous rows in elimination order, fill-in may add later steps
+        for (int k=0; k<i; ++k)
+        {
+            const int c = mPivotColumns[k];
+            if (mMarks[c] != i)
+            {
+                continue;
+            }
+            const double l = mWork[c]/mUValues[mUStart[k]];
+            mWork[c] = 0.0;
+            mLSteps.push_back(k);
+            mLValues.push_back(l);
+            for (int u=mUStart[k]+1; u<mUStart[k+1]; ++u)
+            {
+                const int j = mUColumns[u];
+                if (mMarks[j] != i)
+                {
+                    mMarks[j] = i;
+                    mWork[j] = 0.0;
+                    columns.push_back(j);
+                }
+                mWork[j] -= l*mUValues[u];
+            }
+        }
+        mLStart[i+1] = int(mLSteps.size());
+
+        // Choose pivot among the columns that have not been used as pivot yet
+        double maxAbs = 0.0;
+        double sumAbs = 0.0;
+        int pivot = -1;
+        for (size_t a=0; a<columns.size(); ++a)
+        {
+            const int c = columns[a];
+            if ((pivotSteps[c] < 0) && (std::fabs(mWork[c]) > maxAbs))
+            {
+                maxAbs = std::fabs(mWork[c]);
+                pivot = c;
+            }
+            sumAbs += std::fabs(mWork[c]);
+        }
+        if (!(maxAbs > 0.0) || !std::isfinite(sumAbs))
+        {
+            std::fill(mWork.begin(), mWork.end(), 0.0);
+            return false;
+        }
+        if ((mMarks[r] == i) && (pivotSteps[r] < 0) && (std::fabs(mWork[r]) >= mPivotTolerance*maxAbs))
+        {
+            pivot = r;
+        }
+        mPivotColumns[i] = pivot;
+        pivotSteps[pivot] = i;
+
+        // Gather the row of U, with the pivot first
+        mUColumns.push_back(pivot);
+        mUValues.push_back(mWork[pivot]);
+        mWork[pivot] = 0.0;
+        for (size_t a=0; a<columns.size(); ++a)
+        {
+            const int c = columns[a];
+            if ((pivotSteps[c] < 0) && (c != pivot))
+            {
+                mUColumns.push_back(c);
+                mUValues.push_back(mWork[c]);
+            }
+            mWork[c] = 0.0;
+        }
+        mUStart[i+1] = int(mUColumns.size());
+    }
+
+    mHaveSymbolic = true;
+    return true;
+}
+
+
+//! @brief LU-decomposition that reuses the pivots and the factor pattern from the latest factorWithPivoting()
+//! @returns False if a pivot has become too small, then factorWithPivoting() must be used instead
+bool SparseLUSolver::refactor(const double *pMatrix)
+{
+    const int n = mN;
+    for (int i=0; i<n; ++i)
+    {
+        const int r = mRowOrder[i];
+        for (int a=mRowStart[r]; a<mRowStart[r+1]; ++a)
+        {
+            mWork[mRowColumns[a]] = pMatrix[mRowIndexes[a]];
+        }
+
+        for (int l=mLStart[i]; l<mLStart[i+1]; ++l)
+        {
+            const int k = mLSteps[l];
+            const int c = mPivotColumns[k];
+            const double value = mWork[c]/mUValues[mUStart[k]];
+            mWork[c] = 0.0;
+            mLValues[l] = value;
+            for (int u=mUStart[k]+1; u<mUStart[k+1]; ++u)
+            {
+                mWork[mUColumns[u]] -= value*mUValues[u];
+            }
+        }
+
+        // The sum is only used to detect elements that are not finite
+        double maxAbs = 0.0;
+        double sumAbs = 0.0;
+        for (int u=mUStart[i]; u<mUStart[i+1]; ++u)
+        {
+            const int c = mUColumns[u];
+            mUValues[u] = mWork[c];
+            mWork[c] = 0.0;
+            maxAbs = std::max(maxAbs, std::fabs(mUValues[u]));
+            sumAbs += std::fabs(mUValues[u]);
+        }
+        const double pivot = std::fabs(mUValues[mUStart[i]]);
+        if (!(pivot > 0.0) || !(pivot >= mPivotTolerance*maxAbs) || !std::isfinite(sumAbs))
+        {
+            std::fill(mWork.begin(), mWork.end(), 0.0);
+            return false;
+        }
+    }
+    return true;
+}
@@ -154,6 +154,7 @@ bool AliasHandler::setVariableAlias(const HString &rAlias, const HString &rCompN
                 ParamOrVariableT data = {Variable, rCompName, rPortName};
                 mAliasMap.insert(std::pair<HString, ParamOrVariableT>(rAlias, data));
                 mpSystem->reserveUniqueName(rAlias);
+                ParameterEvaluator::invalidateDependencies();
             }
             return true;
         }
@@ -249,6 +250,7 @@ bool AliasHandler::removeAlias(const HString &rAlias)
         }
         mpSystem->unReserveUniqueName(rAlias); //We must unreserve before erasing the it, since rAlias may be a reference to data in it
         mAliasMap.erase(it);
+        ParameterEvaluator::invalidateDependencies();
         return true;
     }
     return false;
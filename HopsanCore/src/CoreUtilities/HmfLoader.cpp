@@ -35,6 +35,7 @@
 #include <cassert>
 #include <cstring>
 #include "CoreUtilities/HmfLoader.h"
+#include "CoreUtilities/ModelLoadProgram.h"
 #include "CoreUtilities/HopsanCoreMessageHandler.h"
 #include "CoreUtilities/NumHopHelper.h"
 #include "ComponentUtilities/num2string.hpp"
@@ -555,8 +556,8 @@ void hopsan::autoPrependSelfToEmbeddedInitScript(ComponentSystem* pSystem) {
 }
 
 
-//! @brief This help function loads a component
-void loadComponent(rapidxml::xml_node<> *pComponentNode, ComponentSystem* pSystem, HopsanEssentials *pHopsanEssentials)
+//! @brief This help function translates a component
+void translateComponent(rapidxml::xml_node<> *pComponentNode, ModelLoadProgram &rProgram)
 {
     HString typeName = readStringAttribute(pComponentNode, "typename", "ERROR_NO_TYPE_GIVEN").c_str();
     HString subTypeName = readStringAttribute(pComponentNode, "subtypename", "").c_str();
@@ -564,79 +565,61 @@ void loadComponent(rapidxml::xml_node<> *pComponentNode, ComponentSystem* pSyste
 
     bool disabled = readBoolAttribute(pComponentNode, "disabled", false);
 
-    Component *pComp = pHopsanEssentials->createComponent(typeName.c_str());
-    if (pComp != 0)
+    rProgram.addOp(ModelLoadProgram::ComponentOp);
+    rProgram.addString(typeName);
+    rProgram.addString(subTypeName);
+    rProgram.addString(displayName);
+    rProgram.addInt(disabled);
+
+    // Load parameters
+    //! @todo should be able to load parameters and system parameters with same help function
+    rapidxml::xml_node<> *pParams = pComponentNode->first_node("parameters");
+    if (pParams)
     {
-        pComp->setName(displayName);
-        pComp->setSubTypeName(subTypeName.c_str());
-        pComp->setDisabled(disabled);
-        pSystem->addComponent(pComp);
-
-        // Load parameters
-        //! @todo should be able to load parameters and system parameters with same help function
-        rapidxml::xml_node<> *pParams = pComponentNode->first_node("parameters");
-        if (pParams)
+        const HString coreVersionOfModelFile = readStringAttribute(pComponentNode->document()->first_node(), "hopsancoreversion").c_str();
+        rapidxml::xml_node<> *pParam = pParams->first_node("parameter");
+        while (pParam != 0)
         {
-            const HString coreVersionOfModelFile = readStringAttribute(pComponentNode->document()->first_node(), "hopsancoreversion").c_str();
-            rapidxml::xml_node<> *pParam = pParams->first_node("parameter");
-            while (pParam != 0)
-            {
-                updateOldModelFileParameter(pParam, coreVersionOfModelFile);
+            updateOldModelFileParameter(pParam, coreVersionOfModelFile);
 
-                HString paramName = readStringAttribute(pParam, "name", "ERROR_NO_PARAM_NAME_GIVEN").c_str();
-                HString val = readStringAttribute(pParam, "value", "ERROR_NO_PARAM_VALUE_GIVEN").c_str();
+            HString paramName = readStringAttribute(pParam, "name", "ERROR_NO_PARAM_NAME_GIVEN").c_str();
+            HString val = readStringAttribute(pParam, "value", "ERROR_NO_PARAM_VALUE_GIVEN").c_str();
 
-                //! @todo this is a hack to update old parameters, remove at some point in the future
-                if (!pComp->hasParameter(paramName))
-                {
-                    if (paramName.find("#") == HString::npos)
-                    {
-                        paramName=paramName+"#Value";
-                    }
-                }
-
-                // We need force=true here to make sure that parameters with system variable names are set even if they can not yet be evaluated
-                //! @todo why cant they be evaluated, if everything loaded in correct order that should work
-                bool ok = pComp->setParameterValue(paramName, val, true);
-                if(!ok)
-                {
-                    pComp->addWarningMessage("Failed to set parameter: "+paramName+"="+val);
-                }
+            rProgram.addOp(ModelLoadProgram::ComponentParameterOp);
+            rProgram.addString(paramName);
+            rProgram.addString(val);
 
-                pParam = pParam->next_sibling("parameter");
-            }
+            pParam = pParam->next_sibling("parameter");
+        }
 
-            if (isVersionAGreaterThanB("2.14.0", coreVersionOfModelFile)) {
-                autoPrependSelfToParameterExpressions(pComp);
-            }
+        if (isVersionAGreaterThanB("2.14.0", coreVersionOfModelFile)) {
+            rProgram.addOp(ModelLoadProgram::PrependSelfToComponentParametersOp);
         }
+    }
 
-        // Load modifyable signal quantities
-        rapidxml::xml_node<> *pXmlPorts = pComponentNode->first_node("ports");
-        if (pXmlPorts)
+    // Load modifyable signal quantities
+    rapidxml::xml_node<> *pXmlPorts = pComponentNode->first_node("ports");
+    if (pXmlPorts)
+    {
+        rapidxml::xml_node<> *pXmlPort = pXmlPorts->first_node("port");
+        while (pXmlPort != 0)
         {
-            rapidxml::xml_node<> *pXmlPort = pXmlPorts->first_node("port");
-            while (pXmlPort != 0)
+            HString quantity = readStringAttribute(pXmlPort, "signalquantity", "").c_str();
+            if (!quantity.empty())
             {
-                HString quantity = readStringAttribute(pXmlPort, "signalquantity", "").c_str();
-                if (!quantity.empty())
-                {
-                    HString portName = readStringAttribute(pXmlPort, "name", "").c_str();
-                    Port *pPort = pComp->getPort(portName);
-                    if (pPort)
-                    {
-                        pPort->setSignalNodeQuantityOrUnit(quantity);
-                    }
-                }
-                pXmlPort = pXmlPort->next_sibling("port");
+                HString portName = readStringAttribute(pXmlPort, "name", "").c_str();
+                rProgram.addOp(ModelLoadProgram::PortQuantityOp);
+                rProgram.addString(portName);
+                rProgram.addString(quantity);
             }
+            pXmlPort = pXmlPort->next_sibling("port");
         }
     }
 }
 
 
-//! @brief This help function loads a connection
-void loadConnection(rapidxml::xml_node<> *pConnectNode, ComponentSystem* pSystem)
+//! @brief This help function translates a connection
+void translateConnection(rapidxml::xml_node<> *pConnectNode, ModelLoadProgram &rProgram)
 {
     string startcomponent = readStringAttribute(pConnectNode, "startcomponent", "ERROR_NOSTARTCOMPNAME_GIVEN");
     string startport = readStringAttribute(pConnectNode, "startport", "ERROR_NOSTARTPORTNAME_GIVEN");
@@ -648,18 +631,23 @@ void loadConnection(rapidxml::xml_node<> *pConnectNode, ComponentSystem* pSystem
     santizeName(endcomponent.c_str());
     santizeName(endport.c_str());
 
-    pSystem->connect(startcomponent.c_str(), startport.c_str(), endcomponent.c_str(), endport.c_str());
+    rProgram.addOp(ModelLoadProgram::ConnectOp);
+    rProgram.addString(startcomponent.c_str());
+    rProgram.addString(startport.c_str());
+    rProgram.addString(endcomponent.c_str());
+    rProgram.addString(endport.c_str());
 }
 
-//! @brief This help function loads a SystemPort
-void loadSystemPort(rapidxml::xml_node<> *pSysPortNode, ComponentSystem* pSystem)
+//! @brief This help function translates a SystemPort
+void translateSystemPort(rapidxml::xml_node<> *pSysPortNode, ModelLoadProgram &rProgram)
 {
     string name = readStringAttribute(pSysPortNode, "name", "ERROR_NO_NAME_GIVEN");
-    pSystem->addSystemPort(name.c_str());
+    rProgram.addOp(ModelLoadProgram::SystemPortOp);
+    rProgram.addString(name.c_str());
 }
 
-//! @brief Help function to load system parameters
-void loadSystemParameters(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem)
+//! @brief Help function to translate system parameters
+void translateSystemParameters(rapidxml::xml_node<> *pSysNode, ModelLoadProgram &rProgram)
 {
     // Load system parameters
     rapidxml::xml_node<> *pParameters = pSysNode->first_node("parameters");
@@ -679,24 +667,24 @@ void loadSystemParameters(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSyst
             string quantityORunit = readStringAttribute(pParameter, "quantity", readStringAttribute(pParameter, "unit", ""));
             string description = readStringAttribute(pParameter, "description", "");
 
-            // Here we use force=true to make sure system parameters load even if they do not evaluate
-            //! @todo if system parameters are loaded in the correct order (top to bottom) they should evaluate, why don't they?
-            bool ok = pSystem->setOrAddSystemParameter(paramName.c_str(), val.c_str(), type.c_str(), description.c_str(), quantityORunit.c_str(), internal, true);
-            if(!ok)
-            {
-                pSystem->addErrorMessage(HString("Failed to load parameter: ")+(paramName+"="+val).c_str());
-            }
+            rProgram.addOp(ModelLoadProgram::SystemParameterOp);
+            rProgram.addString(paramName.c_str());
+            rProgram.addString(val.c_str());
+            rProgram.addString(type.c_str());
+            rProgram.addString(description.c_str());
+            rProgram.addString(quantityORunit.c_str());
+            rProgram.addInt(internal);
 
             pParameter = pParameter->next_sibling("parameter");
         }
 
         if (isVersionAGreaterThanB("2.14.0", coreVersionOfModelFile)) {
-            autoPrependSelfToParameterExpressions(pSystem);
+            rProgram.addOp(ModelLoadProgram::PrependSelfToSystemParametersOp);
         }
     }
 }
 
-void loadAliases(rapidxml::xml_node<> *pAliasesNode, ComponentSystem* pSystem)
+void translateAliases(rapidxml::xml_node<> *pAliasesNode, ModelLoadProgram &rProgram)
 {
     rapidxml::xml_node<> *pAlias = pAliasesNode->first_node("alias");
     while(pAlias)
@@ -711,8 +699,11 @@ void loadAliases(rapidxml::xml_node<> *pAliasesNode, ComponentSystem* pSystem)
 
         if (type == "variable" || type == "Variable")
         {
-            //! @todo check bool and display warning if false
-            pSystem->getAliasHandler().setVariableAlias(alias.c_str(), comp.c_str(), port.c_str(), var.c_str());
+            rProgram.addOp(ModelLoadProgram::VariableAliasOp);
+            rProgram.addString(alias);
+            rProgram.addString(comp);
+            rProgram.addString(port);
+            rProgram.addString(var);
         }
 
 
@@ -720,39 +711,53 @@ void loadAliases(rapidxml::xml_node<> *pAliasesNode, ComponentSystem* pSystem)
     }
 }
 
+bool translateHopsanModelFile(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, ModelLoadProgram &rProgram, double &rStartTime, double &rStopTime);
 
-//! @brief This function loads a subsystem
-void loadSystemContents(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem, HopsanEssentials* pHopsanEssentials, const HString rootFilePath="")
+//! @brief This function translates the contents of a system
+void translateSystemContents(rapidxml::xml_node<> *pSysNode, ModelLoadProgram &rProgram, HopsanEssentials* pHopsanEssentials, const HString rootFilePath="")
 {
     string typeName = readStringAttribute(pSysNode, "typename", "ERROR_NO_TYPE_GIVEN");
     string displayName = readStringAttribute(pSysNode, "name", typeName );
-    pSystem->setName(displayName.c_str());
+    rProgram.addOp(ModelLoadProgram::SetSystemNameOp);
+    rProgram.addString(displayName.c_str());
 
     bool componentDisabled = readBoolAttribute(pSysNode, "disabled", false);
-    pSystem->setDisabled(componentDisabled);
+    rProgram.addOp(ModelLoadProgram::SetSystemDisabledOp);
+    rProgram.addInt(componentDisabled);
 
     rapidxml::xml_node<> *pSimtimeNode = pSysNode->first_node("simulationtime");
     double Ts = readDoubleAttribute(pSimtimeNode, "timestep", 0.001);
-    pSystem->setDesiredTimestep(Ts);
-    pSystem->setInheritTimestep(readBoolAttribute(pSimtimeNode,"inherit_timestep",true));
+    rProgram.addOp(ModelLoadProgram::SetTimestepOp);
+    rProgram.addDouble(Ts);
+    rProgram.addInt(readBoolAttribute(pSimtimeNode,"inherit_timestep",true));
 
-    // Load number of log samples
+    // Load number of log samples, the system keeps its current settings if they are not given
     rapidxml::xml_node<> *pLogSettingsNode = pSysNode->first_node("simulationlogsettings");
-    pSystem->setLogStartTime(readDoubleAttribute(pLogSettingsNode, "starttime", pSystem->getLogStartTime()));
-    pSystem->setNumLogSamples(readIntAttribute(pLogSettingsNode, "numsamples", pSystem->getNumLogSamples()));
+    if (hasAttribute(pLogSettingsNode, "starttime"))
+    {
+        rProgram.addOp(ModelLoadProgram::SetLogStartTimeOp);
+        rProgram.addDouble(readDoubleAttribute(pLogSettingsNode, "starttime", 0));
+    }
+    if (hasAttribute(pLogSettingsNode, "numsamples"))
+    {
+        rProgram.addOp(ModelLoadProgram::SetNumLogSamplesOp);
+        rProgram.addInt(readIntAttribute(pLogSettingsNode, "numsamples", 0));
+    }
     //! @deprecated 20131002 keep this old way of loading for a while for backwards compatibility
     if(hasAttribute(pSysNode,  "logsamples"))
     {
-        pSystem->setNumLogSamples(readIntAttribute(pSysNode, "logsamples", pSystem->getNumLogSamples()));
+        rProgram.addOp(ModelLoadProgram::SetNumLogSamplesOp);
+        rProgram.addInt(readIntAttribute(pSysNode, "logsamples", 0));
     }
 
     //! @todo we really need defines for allof these "strings"
 
     // Load system parameters (needed before objects are loaded as they may be using sys-parameters)
-    loadSystemParameters(pSysNode, pSystem);
+    translateSystemParameters(pSysNode, rProgram);
 
     // Load NumHop script
-    pSystem->setNumHopScript(readStringNodeValue(pSysNode->first_node("numhopscript"), "").c_str());
+    rProgram.addOp(ModelLoadProgram::NumHopScriptOp);
+    rProgram.addString(readStringNodeValue(pSysNode->first_node("numhopscript"), "").c_str());
 
     // Load contents
     rapidxml::xml_node<> *pObjects = pSysNode->first_node("objects");
@@ -764,30 +769,38 @@ void loadSystemContents(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem
             if (strcmp(pObject->name(), "component")==0)
             {
                 updateOldModelFileComponent(pObject, readStringAttribute(pObject->document()->first_node(), "hopsancoreversion", "").c_str());
-                loadComponent(pObject, pSystem, pHopsanEssentials);
+                translateComponent(pObject, rProgram);
             }
             else if (strcmp(pObject->name(), "system")==0)
             {
                 bool isExternal = hasAttribute(pObject, "external_path");
-                ComponentSystem* pSys;
 
                 if (isExternal)
                 {
                     double dummy1,dummy2;
                     HString externalPath = stripFilenameFromPath(rootFilePath) + readStringAttribute(pObject,"external_path","").c_str();
                     cout << "externalPath: " << externalPath.c_str() << endl;
-                    pSys = loadHopsanModelFile(externalPath, pHopsanEssentials, dummy1, dummy2);
-                    if (pSys != 0)
+                    const size_t externalStart = rProgram.getSize();
+                    if (translateHopsanModelFile(externalPath, pHopsanEssentials, rProgram, dummy1, dummy2))
                     {
                         // Add new system to parent
-                        pSystem->addComponent(pSys);
+                        rProgram.addOp(ModelLoadProgram::AddToParentSystemOp);
                         // load overwriten parameter values
-                        loadSystemParameters(pObject, pSys);
+                        translateSystemParameters(pObject, rProgram);
                         // Overwrite name
                         string displayNameExt = readStringAttribute(pObject, "name", typeName );
-                        pSys->setName(displayNameExt.c_str());
+                        rProgram.addOp(ModelLoadProgram::SetSystemNameOp);
+                        rProgram.addString(displayNameExt.c_str());
                         // Make sure system knows its an externally loaded system
-                        pSys->setExternalModelFilePath(readStringAttribute(pObject,"external_path","").c_str());
+                        rProgram.addOp(ModelLoadProgram::SetExternalPathOp);
+                        rProgram.addString(readStringAttribute(pObject,"external_path","").c_str());
+                        rProgram.addOp(ModelLoadProgram::EndSystemOp);
+                    }
+                    else
+                    {
+                        // Skip the external system, a model that is missing parts must not be cached
+                        rProgram.truncate(externalStart);
+                        rProgram.setCacheable(false);
                     }
                 }
                 else
@@ -797,11 +810,11 @@ void loadSystemContents(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem
                     // Create the appropriate subsystem
                     if (newTypeName == HOPSAN_BUILTIN_TYPENAME_CONDITIONALSUBSYSTEM)
                     {
-                        pSys = pHopsanEssentials->createConditionalComponentSystem();
+                        rProgram.addOp(ModelLoadProgram::CreateConditionalSystemOp);
                     }
                     else if (newTypeName == HOPSAN_BUILTIN_TYPENAME_SUBSYSTEM)
                     {
-                        pSys = pHopsanEssentials->createComponentSystem();
+                        rProgram.addOp(ModelLoadProgram::CreateSystemOp);
                     }
                     else
                     {
@@ -809,14 +822,15 @@ void loadSystemContents(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem
                         return;
                     }
                     // Add new system to parent
-                    pSystem->addComponent(pSys);
+                    rProgram.addOp(ModelLoadProgram::AddToParentSystemOp);
                     // Load system contents
-                    loadSystemContents(pObject, pSys, pHopsanEssentials, rootFilePath);
+                    translateSystemContents(pObject, rProgram, pHopsanEssentials, rootFilePath);
+                    rProgram.addOp(ModelLoadProgram::EndSystemOp);
                 }
             }
             else if (strcmp(pObject->name(), "systemport")==0)
             {
-                loadSystemPort(pObject,pSystem);
+                translateSystemPort(pObject, rProgram);
             }
 
             pObject = pObject->next_sibling();
@@ -832,7 +846,7 @@ void loadSystemContents(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem
         {
             if (strcmp(pConnection->name(), "connect")==0)
             {
-                loadConnection(pConnection, pSystem);
+                translateConnection(pConnection, rProgram);
             }
             pConnection = pConnection->next_sibling();
         }
@@ -840,24 +854,24 @@ void loadSystemContents(rapidxml::xml_node<> *pSysNode, ComponentSystem* pSystem
 
     // Load system parameters again in case we have c-component subsystems with startvalues
     //! @todo this is an ugly hack to be forced to load again
-    loadSystemParameters(pSysNode, pSystem);
+    translateSystemParameters(pSysNode, rProgram);
 
     // Load aliases
     rapidxml::xml_node<> *pAliases = pSysNode->first_node("aliases");
     if (pAliases)
     {
-        loadAliases(pAliases, pSystem);
+        translateAliases(pAliases, rProgram);
     }
 
     const HString coreVersionOfModelFile = readStringAttribute(pSysNode->document()->first_node(), "hopsancoreversion").c_str();
     if (isVersionAGreaterThanB("2.14.0", coreVersionOfModelFile)) {
         // Note! This will destory the formating of the script, but for load-only core simualtion that is OK
-        autoPrependSelfToEmbeddedInitScript(pSystem);
+        rProgram.addOp(ModelLoadProgram::PrependSelfToScriptOp);
     }
 }
 
-// The actual model load function
-ComponentSystem* loadHopsanModelFileActual(const rapidxml::xml_document<> &rDoc, const HString &rFilePath, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime)
+// The actual model translate function, the translated root system is left open so that the caller can modify it
+bool translateHopsanModelFileActual(const rapidxml::xml_document<> &rDoc, const HString &rFilePath, HopsanEssentials* pHopsanEssentials, ModelLoadProgram &rProgram, double &rStartTime, double &rStopTime)
 {
     try
     {
@@ -872,7 +886,7 @@ ComponentSystem* loadHopsanModelFileActual(const rapidxml::xml_document<> &rDoc,
             if (isVersionAGreaterThanB("0.6.0", savedwithcoreversion) || (isVersionAGreaterThanB(savedwithcoreversion, "0.6.x") && isVersionAGreaterThanB("0.6.x_r5500", savedwithcoreversion)))
             {
                 pHopsanEssentials->getCoreMessageHandler()->addErrorMessage("This hmf model was saved with HopsanCoreVersion: "+savedwithcoreversion+". This old version is not supported by the HopsanCore hmf loader, resave the model with HopsanGUI");
-                return 0;
+                return false;
             }
 
 
@@ -884,38 +898,312 @@ ComponentSystem* loadHopsanModelFileActual(const rapidxml::xml_document<> &rDoc,
                 rapidxml::xml_node<> *pSimtimeNode = pSysNode->first_node("simulationtime");
                 rStartTime = readDoubleAttribute(pSimtimeNode, "start", 0);
                 rStopTime = readDoubleAttribute(pSimtimeNode, "stop", 2);
-                ComponentSystem * pSys = pHopsanEssentials->createComponentSystem(); //Create root system
-                loadSystemContents(pSysNode, pSys, pHopsanEssentials, rFilePath);
+                rProgram.addOp(ModelLoadProgram::CreateSystemOp); //Create root system
+                translateSystemContents(pSysNode, rProgram, pHopsanEssentials, rFilePath);
 
-                pSys->addSearchPath(stripFilenameFromPath(rFilePath));
-                return pSys;
+                rProgram.addOp(ModelLoadProgram::AddSearchPathOp);
+                rProgram.addString(stripFilenameFromPath(rFilePath));
+                return true;
             }
             else
             {
-                addCoreLogMessage("hopsan::loadHopsanModelFileActual(): No system found in file.");
+                addCoreLogMessage("hopsan::translateHopsanModelFileActual(): No system found in file.");
                 pHopsanEssentials->getCoreMessageHandler()->addErrorMessage(rFilePath+" Has no system to load");
             }
         }
         else
         {
-            addCoreLogMessage("hopsan::loadHopsanModelFileActual(): Wrong root tag name.");
+            addCoreLogMessage("hopsan::translateHopsanModelFileActual(): Wrong root tag name.");
             pHopsanEssentials->getCoreMessageHandler()->addErrorMessage(rFilePath+" Has wrong root tag name: "+pRootNode->name());
             cout << "Not correct hmf file root node name: " << pRootNode->name() << endl;
         }
     }
     catch(std::exception &e)
     {
-        addCoreLogMessage("hopsan::loadHopsanModelFileActual(): Unable to parse xml doc.");
+        addCoreLogMessage("hopsan::translateHopsanModelFileActual(): Unable to parse xml doc.");
         pHopsanEssentials->getCoreMessageHandler()->addErrorMessage("Unable to parse xml doc");
         cout << "throws: " << e.what() << endl;
     }
 
-    addCoreLogMessage("hopsan::loadHopsanModelFileActual(): Failed.");
+    addCoreLogMessage("hopsan::translateHopsanModelFileActual(): Failed.");
+    return false;
+}
 
-    // We failed, return 0 ptr
-    return 0;
+//! @brief Translates a model file, the translated root system is left open so that the caller can modify it
+bool translateHopsanModelFile(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, ModelLoadProgram &rProgram, double &rStartTime, double &rStopTime)
+{
+    addCoreLogMessage("hopsan::translateHopsanModelFile("+rFilePath+")");
+    try
+    {
+        rapidxml::file<> hmfFile(rFilePath.c_str());
+        rapidxml::xml_document<> doc;
+        doc.parse<0>(hmfFile.data());
+
+        rProgram.addDependency(rFilePath);
+        return translateHopsanModelFileActual(doc, rFilePath, pHopsanEssentials, rProgram, rStartTime, rStopTime);
+    }
+    catch(std::exception &e)
+    {
+        addCoreLogMessage("hopsan::translateHopsanModelFile(): Unable to open file.");
+        pHopsanEssentials->getCoreMessageHandler()->addErrorMessage("Could not open file: "+rFilePath);
+        cout << "Could not open file, throws: " << e.what() << endl;
+    }
+    addCoreLogMessage("hopsan::translateHopsanModelFile(): Failed.");
+    return false;
+}
+
+//! @brief Translates a model file into a complete program that builds the root system
+bool translateRootModelFile(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, ModelLoadProgram &rProgram)
+{
+    double startTime, stopTime;
+    if (translateHopsanModelFile(rFilePath, pHopsanEssentials, rProgram, startTime, stopTime))
+    {
+        rProgram.addOp(ModelLoadProgram::EndSystemOp);
+        rProgram.setSimulationTime(startTime, stopTime);
+        return true;
+    }
+    return false;
 }
 
+//! @brief Computes the fingerprint of model files together with the core version and the loaded component libraries
+//! @returns False if any of the model files could not be read
+bool computeModelFingerprint(const std::vector<HString> &rModelFiles, HopsanEssentials* pHopsanEssentials, uint64_t &rFingerprint)
+{
+    ModelFingerprint fingerprint;
+    fingerprint.addString(pHopsanEssentials->getCoreVersion());
+    fingerprint.addString(pHopsanEssentials->getCoreBuildTime());
+
+    // The library files are included since component libraries have no version of their own
+    std::vector<HString> libPaths;
+    pHopsanEssentials->getExternalComponentLibPaths(libPaths);
+    for (size_t i=0; i<libPaths.size(); ++i)
+    {
+        fingerprint.addString(libPaths[i]);
+        fingerprint.addFile(libPaths[i]);
+    }
+
+    for (size_t i=0; i<rModelFiles.size(); ++i)
+    {
+        fingerprint.addString(rModelFiles[i]);
+        if (!fingerprint.addFile(rModelFiles[i]))
+        {
+            return false;
+        }
+    }
+    rFingerprint = fingerprint.getValue();
+    return true;
+}
+
+//! @brief Runs a model load program, building a new model
+//! @returns A pointer to the root system of the new model, or 0 if the program is invalid
+ComponentSystem* runModelLoadProgram(const ModelLoadProgram &rProgram, HopsanEssentials* pHopsanEssentials)
+{
+    std::vector<ComponentSystem*> openSystems;
+    ComponentSystem *pRootSystem = 0;
+    Component *pComp = 0;
+    bool ok = true;
+    size_t pos = 0;
+    while (ok && !rProgram.atEnd(pos))
+    {
+        const ModelLoadProgram::OpCodeT op = rProgram.readOp(pos);
+        if ((op == ModelLoadProgram::CreateSystemOp) || (op == ModelLoadProgram::CreateConditionalSystemOp))
+        {
+            if (openSystems.empty() && pRootSystem)
+            {
+                // There can only be one root system
+                ok = false;
+                break;
+            }
+            ComponentSystem *pSys;
+            if (op == ModelLoadProgram::CreateConditionalSystemOp)
+            {
+                pSys = pHopsanEssentials->createConditionalComponentSystem();
+            }
+            else
+            {
+                pSys = pHopsanEssentials->createComponentSystem();
+            }
+            if (openSystems.empty())
+            {
+                pRootSystem = pSys;
+            }
+            openSystems.push_back(pSys);
+            pComp = 0;
+            continue;
+        }
+        if (openSystems.empty())
+        {
+            ok = false;
+            break;
+        }
+
+        // All other operations work on the innermost open system or on the last created component
+        ComponentSystem *pSystem = openSystems.back();
+        switch (op)
+        {
+        case ModelLoadProgram::AddToParentSystemOp:
+            if (openSystems.size() > 1)
+            {
+                openSystems[openSystems.size()-2]->addComponent(pSystem);
+            }
+            else
+            {
+                ok = false;
+            }
+            break;
+        case ModelLoadProgram::EndSystemOp:
+            openSystems.pop_back();
+            pComp = 0;
+            break;
+        case ModelLoadProgram::SetSystemNameOp:
+            pSystem->setName(rProgram.readString(pos));
+            break;
+        case ModelLoadProgram::SetSystemDisabledOp:
+            pSystem->setDisabled(rProgram.readInt(pos) != 0);
+            break;
+        case ModelLoadProgram::SetTimestepOp:
+        {
+            const double Ts = rProgram.readDouble(pos);
+            const bool inherit = (rProgram.readInt(pos) != 0);
+            pSystem->setDesiredTimestep(Ts);
+            pSystem->setInheritTimestep(inherit);
+            break;
+        }
+        case ModelLoadProgram::SetLogStartTimeOp:
+            pSystem->setLogStartTime(rProgram.readDouble(pos));
+            break;
+        case ModelLoadProgram::SetNumLogSamplesOp:
+            pSystem->setNumLogSamples(rProgram.readInt(pos));
+            break;
+        case ModelLoadProgram::SystemParameterOp:
+        {
+            const HString &rName = rProgram.readString(pos);
+            const HString &rValue = rProgram.readString(pos);
+            const HString &rType = rProgram.readString(pos);
+            const HString &rDescription = rProgram.readString(pos);
+            const HString &rQuantityOrUnit = rProgram.readString(pos);
+            const bool internal = (rProgram.readInt(pos) != 0);
+            // Here we use force=true to make sure system parameters load even if they do not evaluate
+            //! @todo if system parameters are loaded in the correct order (top to bottom) they should evaluate, why don't they?
+            bool paramOk = pSystem->setOrAddSystemParameter(rName, rValue, rType, rDescription, rQuantityOrUnit, internal, true);
+            if(!paramOk)
+            {
+                pSystem->addErrorMessage(HString("Failed to load parameter: ")+rName+"="+rValue);
+            }
+            break;
+        }
+        case ModelLoadProgram::PrependSelfToSystemParametersOp:
+            autoPrependSelfToParameterExpressions(pSystem);
+            break;
+        case ModelLoadProgram::NumHopScriptOp:
+            pSystem->setNumHopScript(rProgram.readString(pos));
+            break;
+        case ModelLoadProgram::PrependSelfToScriptOp:
+            autoPrependSelfToEmbeddedInitScript(pSystem);
+            break;
+        case ModelLoadProgram::ComponentOp:
+        {
+            const HString &rTypeName = rProgram.readString(pos);
+            const HString &rSubTypeName = rProgram.readString(pos);
+            const HString &rDisplayName = rProgram.readString(pos);
+            const bool disabled = (rProgram.readInt(pos) != 0);
+            pComp = pHopsanEssentials->createComponent(rTypeName.c_str());
+            if (pComp != 0)
+            {
+                pComp->setName(rDisplayName);
+                pComp->setSubTypeName(rSubTypeName);
+                pComp->setDisabled(disabled);
+                pSystem->addComponent(pComp);
+            }
+            break;
+        }
+        case ModelLoadProgram::ComponentParameterOp:
+        {
+            HString paramName = rProgram.readString(pos);
+            const HString &rValue = rProgram.readString(pos);
+            if (pComp != 0)
+            {
+                //! @todo this is a hack to update old parameters, remove at some point in the future
+                if (!pComp->hasParameter(paramName))
+                {
+                    if (paramName.find("#") == HString::npos)
+                    {
+                        paramName=paramName+"#Value";
+                    }
+                }
+
+                // We need force=true here to make sure that parameters with system variable names are set even if they can not yet be evaluated
+                //! @todo why cant they be evaluated, if everything loaded in correct order that should work
+                bool paramOk = pComp->setParameterValue(paramName, rValue, true);
+                if(!paramOk)
+                {
+                    pComp->addWarningMessage("Failed to set parameter: "+paramName+"="+rValue);
+                }
+            }
+            break;
+        }
+        case ModelLoadProgram::PrependSelfToComponentParametersOp:
+            if (pComp != 0)
+            {
+                autoPrependSelfToParameterExpressions(pComp);
+            }
+            break;
+        case ModelLoadProgram::PortQuantityOp:
+        {
+            const HString &rPortName = rProgram.readString(pos);
+            const HString &rQuantity = rProgram.readString(pos);
+            Port *pPort = (pComp != 0) ? pComp->getPort(rPortName) : 0;
+            if (pPort)
+            {
+                pPort->setSignalNodeQuantityOrUnit(rQuantity);
+            }
+            break;
+        }
+        case ModelLoadProgram::SystemPortOp:
+            pSystem->addSystemPort(rProgram.readString(pos));
+            break;
+        case ModelLoadProgram::ConnectOp:
+        {
+            const HString &rStartComponent = rProgram.readString(pos);
+            const HString &rStartPort = rProgram.readString(pos);
+            const HString &rEndComponent = rProgram.readString(pos);
+            const HString &rEndPort = rProgram.readString(pos);
+            pSystem->connect(rStartComponent, rStartPort, rEndComponent, rEndPort);
+            break;
+        }
+        case ModelLoadProgram::VariableAliasOp:
+        {
+            const HString &rAlias = rProgram.readString(pos);
+            const HString &rComp = rProgram.readString(pos);
+            const HString &rPort = rProgram.readString(pos);
+            const HString &rVar = rProgram.readString(pos);
+            //! @todo check bool and display warning if false
+            pSystem->getAliasHandler().setVariableAlias(rAlias, rComp, rPort, rVar);
+            break;
+        }
+        case ModelLoadProgram::AddSearchPathOp:
+            pSystem->addSearchPath(rProgram.readString(pos));
+            break;
+        case ModelLoadProgram::SetExternalPathOp:
+            pSystem->setExternalModelFilePath(rProgram.readString(pos));
+            break;
+        default:
+            ok = false;
+        }
+    }
+
+    if (!ok || !openSystems.empty() || !pRootSystem)
+    {
+        addCoreLogMessage("hopsan::runModelLoadProgram(): Invalid program.");
+        pHopsanEssentials->getCoreMessageHandler()->addErrorMessage("Invalid model load program");
+        if (pRootSystem)
+        {
+            pHopsanEssentials->removeComponent(pRootSystem);
+        }
+        return 0;
+    }
+    return pRootSystem;
+}
 
 // vvvvvvvvvv The public function vvvvvvvvvv
 
@@ -1035,19 +1323,12 @@ int hopsan::compareHopsanVersions(const HString& versionA, const HString& versio
 ComponentSystem* hopsan::loadHopsanModelFile(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime)
 {
     addCoreLogMessage("hopsan::loadHopsanModelFile("+rFilePath+")");
-    try
+    ModelLoadProgram program;
+    if (translateRootModelFile(rFilePath, pHopsanEssentials, program))
     {
-        rapidxml::file<> hmfFile(rFilePath.c_str());
-        rapidxml::xml_document<> doc;
-        doc.parse<0>(hmfFile.data());
-
-        return loadHopsanModelFileActual(doc, rFilePath, pHopsanEssentials, rStartTime, rStopTime);
-    }
-    catch(std::exception &e)
-    {
-        addCoreLogMessage("hopsan::loadHopsanModelFile(): Unable to open file.");
-        pHopsanEssentials->getCoreMessageHandler()->addErrorMessage("Could not open file: "+rFilePath);
-        cout << "Could not open file, throws: " << e.what() << endl;
+        rStartTime = program.getStartTime();
+        rStopTime = program.getStopTime();
+        return runModelLoadProgram(program, pHopsanEssentials);
     }
     addCoreLogMessage("hopsan::loadHopsanModelFile(): Failed.");
     // We failed, return 0 ptr
@@ -1055,6 +1336,48 @@ ComponentSystem* hopsan::loadHopsanModelFile(const HString &rFilePath, HopsanEss
 }
 
 
+//! @brief This function is used to load a HMF file through a binary model cache file
+//! @details If the cache file matches the model files and the loaded component libraries, the model is built directly from
+//! the cache. Otherwise the HMF file is loaded as usual and the cache file is written, so that the next load is fast.
+//! @param [in] rFilePath The name (path) of the HMF file
+//! @param [in] rCacheFilePath The name (path) of the model cache file
+//! @param [out] rStartTime A reference to the starttime variable
+//! @param [out] rStopTime A reference to the stoptime variable
+//! @returns A pointer to the rootsystem of the loaded model
+ComponentSystem* hopsan::loadHopsanModelFileCached(const HString &rFilePath, const HString &rCacheFilePath, HopsanEssentials* pHopsanEssentials, double &rStartTime, double &rStopTime)
+{
+    addCoreLogMessage("hopsan::loadHopsanModelFileCached("+rFilePath+", "+rCacheFilePath+")");
+    ModelLoadProgram program;
+    uint64_t fingerprint=0;
+    // The first dependency is the model file itself, the rest are external subsystems
+    const bool cacheIsValid = program.load(rCacheFilePath) && !program.getDependencies().empty() &&
+                              (program.getDependencies().front() == rFilePath) &&
+                              computeModelFingerprint(program.getDependencies(), pHopsanEssentials, fingerprint) &&
+                              (fingerprint == program.getFingerprint());
+    if (!cacheIsValid)
+    {
+        addCoreLogMessage("hopsan::loadHopsanModelFileCached(): Cache is missing or stale.");
+        program.clear();
+        if (!translateRootModelFile(rFilePath, pHopsanEssentials, program))
+        {
+            addCoreLogMessage("hopsan::loadHopsanModelFileCached(): Failed.");
+            return 0;
+        }
+        if (program.isCacheable() && computeModelFingerprint(program.getDependencies(), pHopsanEssentials, fingerprint))
+        {
+            if (!program.save(rCacheFilePath, fingerprint))
+            {
+                pHopsanEssentials->getCoreMessageHandler()->addWarningMessage("Could not write model cache file: "+rCacheFilePath);
+            }
+        }
+    }
+
+    rStartTime = program.getStartTime();
+    rStopTime = program.getStopTime();
+    return runModelLoadProgram(program, pHopsanEssentials);
+}
+
+
 //! @brief This function is used to load a HMF file from model string.
 //! @param [in] xmlModel The xml representation of the model
 //! @returns A pointer to the rootsystem of the loaded model
@@ -1086,7 +1409,12 @@ ComponentSystem* hopsan::loadHopsanModel(char* xmlStr, HopsanEssentials* pHopsan
         rapidxml::xml_document<> doc;
         doc.parse<0>( xmlStr);
 
-        return loadHopsanModelFileActual(doc, "", pHopsanEssentials, rStartTime, rStopTime);
+        ModelLoadProgram program;
+        if (translateHopsanModelFileActual(doc, "", pHopsanEssentials, program, rStartTime, rStopTime))
+        {
+            program.addOp(ModelLoadProgram::EndSystemOp);
+            return runModelLoadProgram(program, pHopsanEssentials);
+        }
     }
     catch(std::exception &e)
     {
@@ -1100,6 +1428,102 @@ ComponentSystem* hopsan::loadHopsanModel(char* xmlStr, HopsanEssentials* pHopsan
 
 
 
+//! @brief This function is used to load several independent copies of a HMF file, the file is only read and parsed once
+//! @param [in] rFilePath The name (path) of the HMF file
+//! @param [in] nCopies The number of copies to create
+//! @param [out] rSystems The root systems of the copies, empty if loading failed
+//! @param [out] rStartTime A reference to the starttime variable
+//! @param [out] rStopTime A reference to the stoptime variable
+//! @returns True if all copies were loaded
+bool hopsan::loadHopsanModelFileCopies(const HString &rFilePath, HopsanEssentials* pHopsanEssentials, const size_t nCopies, std::vector<ComponentSystem*> &rSystems, double &rStartTime, double &rStopTime)
+{
+    addCoreLogMessage("hopsan::loadHopsanModelFileCopies("+rFilePath+")");
+    rSystems.clear();
+    ModelTemplate modelTemplate(pHopsanEssentials);
+    if (modelTemplate.loadFile(rFilePath))
+    {
+        rStartTime = modelTemplate.getStartTime();
+        rStopTime = modelTemplate.getStopTime();
+        for (size_t i=0; i<nCopies; ++i)
+        {
+            ComponentSystem *pSystem = modelTemplate.createInstance();
+            if (!pSystem)
+            {
+                break;
+            }
+            rSystems.push_back(pSystem);
+        }
+    }
+
+    if (rSystems.size() != nCopies)
+    {
+        addCoreLogMessage("hopsan::loadHopsanModelFileCopies(): Failed.");
+        for (size_t i=0; i<rSystems.size(); ++i)
+        {
+            pHopsanEssentials->removeComponent(rSystems[i]);
+        }
+        rSystems.clear();
+        return false;
+    }
+    return true;
+}
+
+
+ModelTemplate::ModelTemplate(HopsanEssentials *pHopsanEssentials)
+{
+    mpHopsanEssentials = pHopsanEssentials;
+    mpProgram = new ModelLoadProgram();
+}
+
+ModelTemplate::~ModelTemplate()
+{
+    delete mpProgram;
+}
+
+//! @brief Read and parse a model file, replacing any previously loaded model
+//! @param [in] rFilePath The path to the HMF file
+//! @returns True if the model could be read
+bool ModelTemplate::loadFile(const HString &rFilePath)
+{
+    addCoreLogMessage("hopsan::ModelTemplate::loadFile("+rFilePath+")");
+    delete mpProgram;
+    mpProgram = new ModelLoadProgram();
+    if (!translateRootModelFile(rFilePath, mpHopsanEssentials, *mpProgram))
+    {
+        delete mpProgram;
+        mpProgram = new ModelLoadProgram();
+        return false;
+    }
+    return true;
+}
+
+bool ModelTemplate::isLoaded() const
+{
+    return (mpProgram->getSize() > 0);
+}
+
+//! @brief Create a new independent instance of the model
+//! @returns A pointer to the root system of the new instance, or 0 if no model is loaded or the instance could not be created
+ComponentSystem* ModelTemplate::createInstance()
+{
+    if (!isLoaded())
+    {
+        return 0;
+    }
+    return runModelLoadProgram(*mpProgram, mpHopsanEssentials);
+}
+
+double ModelTemplate::getStartTime() const
+{
+    return mpProgram->getStartTime();
+}
+
+double ModelTemplate::getStopTime() const
+{
+    return mpProgram->getStopTime();
+}
+
+
 
 //! @brief This function is used to load a Hopsan Parameter File (HPF).
 //! @param [in] filePath The file path to the HPF file
@@ -325,6 +325,17 @@ void LoadExternal::getLoadedLibNames(std::vector<HString> &rLibNames)
     }
 }
 
+void LoadExternal::getLoadedLibPaths(std::vector<HString> &rLibPaths)
+{
+    rLibPaths.clear();
+    rLibPaths.reserve(mLoadedExtLibsMap.size());
+    LoadedExtLibsMapT::iterator lelit = mLoadedExtLibsMap.begin();
+    for (; lelit!=mLoadedExtLibsMap.end(); ++lelit)
+    {
+        rLibPaths.push_back(lelit->first);
+    }
+}
+
 
 //! @brief Returns library path (to dll or so file) for a component type
 //! @param [in] rTypeName Type name to look for
@@ -0,0 +1,206 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   LogDataStore.cpp
+//! @author FluMeS
+//!
+//! @brief Contains the columnar log data store class
+//!
+//$Id$
+
+#include <algorithm>
+#include <limits>
+
+#include "CoreUtilities/LogDataStore.h"
+
+using namespace hopsan;
+
+namespace {
+const size_t gNotLogged = size_t(-1);
+}
+
+LogDataStore::LogDataStore()
+{
+    mNumVariables = 0;
+    mNumSlots = 0;
+    mChunkStartSlot = 0;
+    mNumChunkSamples = 0;
+}
+
+//! @brief Allocate memory for the log columns, any previously logged data is discarded
+//! @param[in] numVariables The number of variables in each sample
+//! @param[in] numSlots The number of log slots (values per column)
+//! @param[in] rLogVariables Which variables to log (one flag per variable), if empty all variables are logged
+//! @note Throws std::bad_alloc if memory allocation fails
+void LogDataStore::allocate(const size_t numVariables, const size_t numSlots, const std::vector<bool> &rLogVariables)
+{
+    clear();
+    mColumnIndexes.resize(numVariables, gNotLogged);
+    for (size_t i=0; i<numVariables; ++i)
+    {
+        if (rLogVariables.empty() || ((i < rLogVariables.size()) && rLogVariables[i]))
+        {
+            mColumnIndexes[i] = mLoggedDataIds.size();
+            mLoggedDataIds.push_back(i);
+        }
+    }
+    mColumns.resize(mLoggedDataIds.size()*numSlots, 0);
+    // Without log slots nothing is logged, so no chunk buffer is needed either
+    mChunk.resize((numSlots > 0) ? mLoggedDataIds.size()*ChunkSize : 0, 0);
+    mNumVariables = numVariables;
+    mNumSlots = numSlots;
+}
+
+//! @brief Release all log data memory
+void LogDataStore::clear()
+{
+    // Swap with empty vectors to actually release the memory
+    std::vector<double>().swap(mColumns);
+    std::vector<double>().swap(mChunk);
+    mLoggedDataIds.clear();
+    mColumnIndexes.clear();
+    mNumVariables = 0;
+    mNumSlots = 0;
+    mChunkStartSlot = 0;
+    mNumChunkSamples = 0;
+}
+
+//! @brief Check if the store has no allocated log columns
+bool LogDataStore::empty() const
+{
+    return mColumns.empty();
+}
+
+//! @brief Returns the number of variables in each sample
+size_t LogDataStore::getNumVariables() const
+{
+    return mNumVariables;
+}
+
+//! @brief Returns the number of variables that are actually logged (the number of columns)
+size_t LogDataStore::getNumLoggedVariables() const
+{
+    return mLoggedDataIds.size();
+}
+
+//! @brief Returns the number of allocated log slots (values per column)
+size_t LogDataStore::getNumSlots() const
+{
+    return mNumSlots;
+}
+
+//! @brief Check if a variable has a log column
+//! @param[in] dataId The variable index
+bool LogDataStore::isLogged(const size_t dataId) const
+{
+    return (dataId < mColumnIndexes.size()) && (mColumnIndexes[dataId] != gNotLogged) && (mNumSlots > 0);
+}
+
+//! @brief Log one sample of all logged variables
+//! @param[in] slot The log slot to write to
+//! @param[in] pValues Pointer to the variable values, must contain getNumVariables() values
+//! @warning No bounds check is done on slot
+void LogDataStore::logSample(const size_t slot, const double *pValues)
+{
+    // Samples are expected to arrive in consecutive slots, if not write what we have and begin a new chunk
+    if ( (mNumChunkSamples > 0) && (slot != mChunkStartSlot+mNumChunkSamples) )
+    {
+        flush();
+    }
+    if (mNumChunkSamples == 0)
+    {
+        mChunkStartSlot = slot;
+    }
+
+    const size_t numLogged = mLoggedDataIds.size();
+    double *pChunkRow = &mChunk[mNumChunkSamples*numLogged];
+    if (numLogged == mNumVariables)
+    {
+        std::copy(pValues, pValues+mNumVariables, pChunkRow);
+    }
+    else
+    {
+        for (size_t c=0; c<numLogged; ++c)
+        {
+            pChunkRow[c] = pValues[mLoggedDataIds[c]];
+        }
+    }
+    ++mNumChunkSamples;
+
+    if (mNumChunkSamples == ChunkSize)
+    {
+        flush();
+    }
+}
+
+//! @brief Write pending samples in the chunk buffer to the columns
+//! @note Must be called from the thread that logs the samples
+void LogDataStore::flush()
+{
+    if (mNumChunkSamples == 0)
+    {
+        return;
+    }
+    const size_t numLogged = mLoggedDataIds.size();
+    for (size_t c=0; c<numLogged; ++c)
+    {
+        double *pColumn = &mColumns[c*mNumSlots + mChunkStartSlot];
+        const double *pChunk = &mChunk[c];
+        for (size_t s=0; s<mNumChunkSamples; ++s)
+        {
+            pColumn[s] = pChunk[s*numLogged];
+        }
+    }
+    mNumChunkSamples = 0;
+}
+
+//! @brief Returns a pointer to the log column of one variable, the column contains getNumSlots() values
+//! @param[in] dataId The variable index
+//! @returns Pointer to the column data or 0 if the variable is not logged
+//! @note Pointers remain valid until the store is reallocated or cleared
+//! @note Samples still in the chunk buffer are not included until flush() has been called
+const double *LogDataStore::getColumn(const size_t dataId) const
+{
+    if (!isLogged(dataId))
+    {
+        return 0;
+    }
+    return &mColumns[mColumnIndexes[dataId]*mNumSlots];
+}
+
+//! @brief Returns one logged value
+//! @param[in] slot The log slot
+//! @param[in] dataId The variable index
+//! @returns The value, or NaN if the variable is not logged
+//! @warning No bounds check is done on slot
+double LogDataStore::getValue(const size_t slot, const size_t dataId) const
+{
+    const double *pColumn = getColumn(dataId);
+    if (!pColumn)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return pColumn[slot];
+}
@@ -0,0 +1,346 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   LogSink.cpp
+//! @author FluMeS
+//!
+//! @brief Contains the log sink interface and the built-in log sinks
+//!
+//$Id$
+
+#include <algorithm>
+#include <cstring>
+
+#include "CoreUtilities/LogSink.h"
+#include "CoreUtilities/MultiThreadingUtilities.h"
+#include "HopsanCoreMacros.h"
+
+#if defined(HOPSANCORE_USEMULTITHREADING)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+using namespace hopsan;
+
+LogSink::~LogSink()
+{
+    // Nothing, should be implemented in derived classes if needed
+}
+
+//! @brief Returns a description of the last error
+const HString &LogSink::getLastError() const
+{
+    return mLastError;
+}
+
+
+namespace hopsan {
+
+//! @brief Thread synchronization objects used by ThreadedLogSink
+class ThreadedLogSinkPrivates
+{
+public:
+#if defined(HOPSANCORE_USEMULTITHREADING)
+    std::thread mWriterThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mBackBufferPending = false;
+    bool mStopWriter = false;
+#endif
+};
+
+}
+
+//! @brief Constructor
+//! @param[in] bufferSamples The number of samples in each of the two buffers
+ThreadedLogSink::ThreadedLogSink(const size_t bufferSamples)
+{
+    mpPrivates = new ThreadedLogSinkPrivates();
+    mBufferSamples = std::max(bufferSamples, size_t(1));
+    mNumVariables = 0;
+    mNumFrontSamples = 0;
+    mNumBackSamples = 0;
+    mIsOpen = false;
+    mOutputFailed = false;
+}
+
+ThreadedLogSink::~ThreadedLogSink()
+{
+    // Note! Derived classes must call close() in their destructor, since closeOutput() can not be called from here
+    delete mpPrivates;
+}
+
+//! @brief Open the output and start the background writer thread
+//! @param[in] rSystemName The name of the system that is logged
+//! @param[in] rVariables Descriptions of the logged variables
+//! @returns true if the output could be opened
+bool ThreadedLogSink::open(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables)
+{
+    close();
+    mLastError.clear();
+    mOutputFailed = false;
+    if (!openOutput(rSystemName, rVariables))
+    {
+        return false;
+    }
+
+    mNumVariables = rVariables.size();
+    mNumFrontSamples = 0;
+    mNumBackSamples = 0;
+    mFrontTime.resize(mBufferSamples);
+    mBackTime.resize(mBufferSamples);
+    mFrontValues.resize(mBufferSamples*mNumVariables);
+    mBackValues.resize(mBufferSamples*mNumVariables);
+
+#if defined(HOPSANCORE_USEMULTITHREADING)
+    ThreadedLogSinkPrivates *pPrivates = mpPrivates;
+    pPrivates->mBackBufferPending = false;
+    pPrivates->mStopWriter = false;
+    pPrivates->mWriterThread = std::thread([this, pPrivates]()
+    {
+        std::unique_lock<std::mutex> lock(pPrivates->mMutex);
+        while (true)
+        {
+            pPrivates->mCondition.wait(lock, [pPrivates](){ return pPrivates->mBackBufferPending || pPrivates->mStopWriter; });
+            if (pPrivates->mBackBufferPending)
+            {
+                // Write without holding the lock, the simulation thread only touches the front buffer meanwhile
+                lock.unlock();
+                writeBackBuffer();
+                lock.lock();
+                pPrivates->mBackBufferPending = false;
+                pPrivates->mCondition.notify_all();
+            }
+            else
+            {
+                break;
+            }
+        }
+    });
+#endif
+
+    mIsOpen = true;
+    return true;
+}
+
+//! @brief Append a chunk of samples to the front buffer, buffers are swapped when the front buffer is full
+//! @param[in] pTime Pointer to numSamples time values
+//! @param[in] pValues Pointer to numSamples samples, each with one value per variable
+//! @param[in] numSamples The number of samples in the chunk
+void ThreadedLogSink::writeChunk(const double *pTime, const double *pValues, const size_t numSamples)
+{
+    if (!mIsOpen)
+    {
+        return;
+    }
+
+    size_t numWritten = 0;
+    while (numWritten < numSamples)
+    {
+        const size_t n = std::min(numSamples-numWritten, mBufferSamples-mNumFrontSamples);
+        std::copy(pTime+numWritten, pTime+numWritten+n, mFrontTime.begin()+mNumFrontSamples);
+        std::copy(pValues+numWritten*mNumVariables, pValues+(numWritten+n)*mNumVariables, mFrontValues.begin()+mNumFrontSamples*mNumVariables);
+        mNumFrontSamples += n;
+        numWritten += n;
+
+        if (mNumFrontSamples == mBufferSamples)
+        {
+            swapAndWriteBuffers();
+        }
+    }
+}
+
+//! @brief Write any remaining buffered samples, stop the background thread and close the output
+//! @returns false if writing or closing the output failed since the sink was opened, use getLastError() to get the reason
+bool ThreadedLogSink::close()
+{
+    if (!mIsOpen)
+    {
+        return !mOutputFailed;
+    }
+
+    if (mNumFrontSamples > 0)
+    {
+        swapAndWriteBuffers();
+    }
+
+#if defined(HOPSANCORE_USEMULTITHREADING)
+    {
+        std::lock_guard<std::mutex> lock(mpPrivates->mMutex);
+        mpPrivates->mStopWriter = true;
+    }
+    mpPrivates->mCondition.notify_all();
+    mpPrivates->mWriterThread.join();
+#endif
+
+    // The writer thread has finished, so its failure flag and error message can be used here, the first failure is kept
+    const HString writeError = mLastError;
+    if (!closeOutput())
+    {
+        if (mOutputFailed)
+        {
+            mLastError = writeError;
+        }
+        mOutputFailed = true;
+    }
+    mIsOpen = false;
+
+    // Release buffer memory
+    std::vector<double>().swap(mFrontTime);
+    std::vector<double>().swap(mBackTime);
+    std::vector<double>().swap(mFrontValues);
+    std::vector<double>().swap(mBackValues);
+    return !mOutputFailed;
+}
+
+//! @brief Returns the number of variables in each sample
+size_t ThreadedLogSink::getNumVariables() const
+{
+    return mNumVariables;
+}
+
+//! @brief Hand the front buffer over to the writer, waits if the writer is still busy with the back buffer
+void ThreadedLogSink::swapAndWriteBuffers()
+{
+#if defined(HOPSANCORE_USEMULTITHREADING)
+    std::unique_lock<std::mutex> lock(mpPrivates->mMutex);
+    mpPrivates->mCondition.wait(lock, [this](){ return !mpPrivates->mBackBufferPending; });
+    mFrontTime.swap(mBackTime);
+    mFrontValues.swap(mBackValues);
+    mNumBackSamples = mNumFrontSamples;
+    mNumFrontSamples = 0;
+    mpPrivates->mBackBufferPending = true;
+    mpPrivates->mCondition.notify_all();
+#else
+    mFrontTime.swap(mBackTime);
+    mFrontValues.swap(mBackValues);
+    mNumBackSamples = mNumFrontSamples;
+    mNumFrontSamples = 0;
+    writeBackBuffer();
+#endif
+}
+
+//! @brief Write the back buffer to the output, the first failure is latched and later buffers are discarded
+void ThreadedLogSink::writeBackBuffer()
+{
+    if (mNumBackSamples > 0)
+    {
+        if (!mOutputFailed && !writeOutput(mBackTime.data(), mBackValues.data(), mNumBackSamples))
+        {
+            mOutputFailed = true;
+        }
+        mNumBackSamples = 0;
+    }
+}
+
+
+namespace {
+
+bool writeBinaryString(FILE *pFile, const HString &rString)
+{
+    const unsigned int size = static_cast<unsigned int>(rString.size());
+    return (fwrite(&size, sizeof(size), 1, pFile) == 1) && (fwrite(rString.c_str(), 1, size, pFile) == size);
+}
+
+}
+
+//! @brief Constructor
+//! @param[in] rFilePath The file to write, it is truncated when the sink is opened
+//! @param[in] bufferSamples The number of samples in each of the two buffers
+BinaryFileLogSink::BinaryFileLogSink(const HString &rFilePath, const size_t bufferSamples) :
+    ThreadedLogSink(bufferSamples),
+    mFilePath(rFilePath)
+{
+    mpFile = 0;
+}
+
+BinaryFileLogSink::~BinaryFileLogSink()
+{
+    close();
+}
+
+bool BinaryFileLogSink::openOutput(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables)
+{
+    HOPSAN_UNUSED(rSystemName)
+    mpFile = fopen(mFilePath.c_str(), "wb");
+    if (!mpFile)
+    {
+        mLastError = "Could not open file: "+mFilePath+" for writing";
+        return false;
+    }
+
+    const char magic[] = "HOPSANLOG";
+    bool success = (fwrite(magic, 1, strlen(magic), mpFile) == strlen(magic));
+    const unsigned int version = FormatVersion;
+    success = success && (fwrite(&version, sizeof(version), 1, mpFile) == 1);
+    const unsigned long long numVariables = rVariables.size();
+    success = success && (fwrite(&numVariables, sizeof(numVariables), 1, mpFile) == 1);
+    for (size_t i=0; success && i<rVariables.size(); ++i)
+    {
+        const LogSinkVariable &rVar = rVariables[i];
+        success = writeBinaryString(mpFile, rVar.systemHierarchy+rVar.componentName+"#"+rVar.portName+"#"+rVar.variableName) &&
+                  writeBinaryString(mpFile, rVar.unit) &&
+                  writeBinaryString(mpFile, rVar.quantity);
+    }
+    if (!success)
+    {
+        mLastError = "Could not write header to file: "+mFilePath;
+        fclose(mpFile);
+        mpFile = 0;
+    }
+    return success;
+}
+
+bool BinaryFileLogSink::writeOutput(const double *pTime, const double *pValues, const size_t numSamples)
+{
+    const size_t numVariables = getNumVariables();
+    for (size_t s=0; s<numSamples; ++s)
+    {
+        if ((fwrite(pTime+s, sizeof(double), 1, mpFile) != 1) ||
+            (fwrite(pValues+s*numVariables, sizeof(double), numVariables, mpFile) != numVariables))
+        {
+            mLastError = "Could not write samples to file: "+mFilePath;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinaryFileLogSink::closeOutput()
+{
+    bool success = true;
+    if (mpFile)
+    {
+        // Buffered data is written by fclose, so it may fail even if all fwrite calls succeeded
+        if (fclose(mpFile) != 0)
+        {
+            mLastError = "Could not write file: "+mFilePath;
+            success = false;
+        }
+        mpFile = 0;
+    }
+    return success;
+}
@@ -0,0 +1,159 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   MappedFile.cpp
+//! @author FluMeS
+//!
+//! @brief Contains a read-only memory mapped file
+//!
+//$Id$
+
+#include "CoreUtilities/MappedFile.h"
+
+#ifdef _WIN32
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0502
+#include "Windows.h"
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace hopsan;
+
+MappedFile::MappedFile()
+{
+    mpData = 0;
+    mSize = 0;
+#ifdef _WIN32
+    mpFileHandle = 0;
+    mpMappingHandle = 0;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+//! @brief Map a file into memory, any previously mapped file is closed first
+//! @param [in] rFilePath The path to the file
+//! @returns True if the file could be mapped, empty files can not be mapped
+bool MappedFile::open(const HString &rFilePath)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(rFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (size.QuadPart <= 0))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    void *pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (pData == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    mpFileHandle = file;
+    mpMappingHandle = mapping;
+    mpData = static_cast<const char*>(pData);
+    mSize = size_t(size.QuadPart);
+#else
+    int fd = ::open(rFilePath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat status;
+    if ((fstat(fd, &status) != 0) || (status.st_size <= 0))
+    {
+        ::close(fd);
+        return false;
+    }
+    void *pData = mmap(0, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (pData == MAP_FAILED)
+    {
+        return false;
+    }
+    mpData = static_cast<const char*>(pData);
+    mSize = size_t(status.st_size);
+#endif
+    return true;
+}
+
+//! @brief Unmap the file, pointers returned by getData() are no longer valid after this
+void MappedFile::close()
+{
+    if (mpData)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(mpData);
+        CloseHandle(static_cast<HANDLE>(mpMappingHandle));
+        CloseHandle(static_cast<HANDLE>(mpFileHandle));
+        mpMappingHandle = 0;
+        mpFileHandle = 0;
+#else
+        munmap(const_cast<char*>(mpData), mSize);
+#endif
+        mpData = 0;
+        mSize = 0;
+    }
+}
+
+//! @brief Check if a file is mapped
+bool MappedFile::isOpen() const
+{
+    return (mpData != 0);
+}
+
+//! @brief Returns a pointer to the first byte of the mapped file, or 0 if no file is mapped
+const char *MappedFile::getData() const
+{
+    return mpData;
+}
+
+//! @brief Returns the size of the mapped file in bytes
+size_t MappedFile::getSize() const
+{
+    return mSize;
+}
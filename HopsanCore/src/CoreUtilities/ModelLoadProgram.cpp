@@ -0,0 +1,469 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   ModelLoadProgram.cpp
+//! @author FluMeS
+//!
+//! @brief Contains the model load program and the binary model cache file
+//!
+//$Id$
+
+#include "CoreUtilities/ModelLoadProgram.h"
+#include "CoreUtilities/MappedFile.h"
+#include "ComponentUtilities/num2string.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <algorithm>
+
+using namespace hopsan;
+
+/*
+ * Model cache file, version 1
+ *
+ * All fields are stored in native byte order, the cache is only meant to be read on the machine that wrote it.
+ *
+ * File header (80 bytes)
+ * Magic "HOPSANMC"  Version  HeaderSize  Fingerprint  PayloadChecksum  NumStrings  NumDependencies  NumCodeWords
+ * 8 bytes           uint32   uint32      uint64       uint64           uint64      uint64           uint64
+ * StartTime  StopTime
+ * double     double
+ *
+ * Payload
+ * NumStrings strings, each stored as a uint32 length followed by the characters
+ * NumDependencies uint32 string indices, the model files that the program was translated from
+ * NumCodeWords uint32 code words, op codes followed by their arguments, strings are referenced by index
+ *
+ * */
+
+namespace {
+
+const char gModelCacheMagic[8] = {'H','O','P','S','A','N','M','C'};
+const uint32_t gModelCacheVersion = 1;
+
+struct ModelCacheFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t fingerprint;
+    uint64_t payloadChecksum;
+    uint64_t numStrings;
+    uint64_t numDependencies;
+    uint64_t numCodeWords;
+    double startTime;
+    double stopTime;
+};
+
+const uint64_t gHashSeed = 0xcbf29ce484222325ULL;
+
+//! @brief Hashes 8 bytes at the time, the result depends on the byte order of the machine
+uint64_t hashBytes(uint64_t hash, const char *pData, const size_t size)
+{
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+    size_t i=0;
+    for (; i+8<=size; i+=8)
+    {
+        uint64_t word;
+        memcpy(&word, pData+i, 8);
+        hash = (hash ^ word)*multiplier;
+        hash ^= hash >> 29;
+    }
+    uint64_t tail=0;
+    if (i < size)
+    {
+        memcpy(&tail, pData+i, size-i);
+    }
+    hash = (hash ^ tail ^ (uint64_t(size) << 56))*multiplier;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+template<typename T>
+void appendValue(std::vector<char> &rBuffer, const T value)
+{
+    const char *pValue = reinterpret_cast<const char*>(&value);
+    rBuffer.insert(rBuffer.end(), pValue, pValue+sizeof(T));
+}
+
+template<typename T>
+bool readValue(const char *pData, const size_t size, size_t &rPos, T &rValue)
+{
+    if (size-rPos < sizeof(T))
+    {
+        return false;
+    }
+    memcpy(&rValue, pData+rPos, sizeof(T));
+    rPos += sizeof(T);
+    return true;
+}
+
+}
+
+
+ModelLoadProgram::ModelLoadProgram()
+{
+    clear();
+}
+
+void ModelLoadProgram::clear()
+{
+    mCode.clear();
+    mStrings.clear();
+    mStringIndices.clear();
+    mDependencies.clear();
+    mStartTime = 0;
+    mStopTime = 0;
+    mFingerprint = 0;
+    mIsCacheable = true;
+}
+
+void ModelLoadProgram::addOp(const OpCodeT op)
+{
+    mCode.push_back(uint32_t(op));
+}
+
+//! @brief Add a string argument, equal strings are only stored once
+void ModelLoadProgram::addString(const HString &rString)
+{
+    mCode.push_back(getStringIndex(rString));
+}
+
+void ModelLoadProgram::addDouble(const double value)
+{
+    uint32_t words[2];
+    memcpy(words, &value, sizeof(value));
+    mCode.push_back(words[0]);
+    mCode.push_back(words[1]);
+}
+
+void ModelLoadProgram::addInt(const int value)
+{
+    mCode.push_back(uint32_t(value));
+}
+
+//! @brief Returns the number of code words in the program
+size_t ModelLoadProgram::getSize() const
+{
+    return mCode.size();
+}
+
+//! @brief Remove the code words after size, used to roll back a partially translated part of a model
+void ModelLoadProgram::truncate(const size_t size)
+{
+    if (size < mCode.size())
+    {
+        mCode.resize(size);
+    }
+}
+
+bool ModelLoadProgram::atEnd(const size_t pos) const
+{
+    return pos >= mCode.size();
+}
+
+ModelLoadProgram::OpCodeT ModelLoadProgram::readOp(size_t &rPos) const
+{
+    if ((rPos < mCode.size()) && (mCode[rPos] < uint32_t(NumOpCodes)))
+    {
+        return OpCodeT(mCode[rPos++]);
+    }
+    rPos = mCode.size();
+    return InvalidOp;
+}
+
+const HString &ModelLoadProgram::readString(size_t &rPos) const
+{
+    static const HString empty;
+    if ((rPos < mCode.size()) && (mCode[rPos] < mStrings.size()))
+    {
+        return mStrings[mCode[rPos++]];
+    }
+    rPos = mCode.size();
+    return empty;
+}
+
+double ModelLoadProgram::readDouble(size_t &rPos) const
+{
+    double value=0;
+    if (mCode.size()-rPos >= 2)
+    {
+        memcpy(&value, &mCode[rPos], sizeof(value));
+        rPos += 2;
+    }
+    else
+    {
+        rPos = mCode.size();
+    }
+    return value;
+}
+
+int ModelLoadProgram::readInt(size_t &rPos) const
+{
+    if (rPos < mCode.size())
+    {
+        return int(mCode[rPos++]);
+    }
+    return 0;
+}
+
+void ModelLoadProgram::setSimulationTime(const double startTime, const double stopTime)
+{
+    mStartTime = startTime;
+    mStopTime = stopTime;
+}
+
+double ModelLoadProgram::getStartTime() const
+{
+    return mStartTime;
+}
+
+double ModelLoadProgram::getStopTime() const
+{
+    return mStopTime;
+}
+
+//! @brief Add a file that the program was translated from, changes to it make a saved model cache stale
+void ModelLoadProgram::addDependency(const HString &rFilePath)
+{
+    getStringIndex(rFilePath);
+    mDependencies.push_back(rFilePath);
+}
+
+const std::vector<HString> &ModelLoadProgram::getDependencies() const
+{
+    return mDependencies;
+}
+
+//! @brief Set if the program can be saved as a model cache
+//! @details Programs from models that could only be partially translated, for example because an external subsystem
+//! file was missing, should not be cached as the cache would hide the problem
+void ModelLoadProgram::setCacheable(const bool cacheable)
+{
+    mIsCacheable = cacheable;
+}
+
+bool ModelLoadProgram::isCacheable() const
+{
+    return mIsCacheable;
+}
+
+//! @brief Save the program as a model cache file
+//! @details The file is written to a temporary file which is then renamed, so that concurrent readers never see a partial file
+//! @param [in] rFilePath The cache file to write
+//! @param [in] fingerprint The fingerprint of the model files and libraries that the program was translated with
+//! @returns True if the cache file was written
+bool ModelLoadProgram::save(const HString &rFilePath, const uint64_t fingerprint) const
+{
+    std::vector<char> payload;
+    for (size_t i=0; i<mStrings.size(); ++i)
+    {
+        appendValue(payload, uint32_t(mStrings[i].size()));
+        payload.insert(payload.end(), mStrings[i].c_str(), mStrings[i].c_str()+mStrings[i].size());
+    }
+    for (size_t i=0; i<mDependencies.size(); ++i)
+    {
+        std::map<HString, uint32_t>::const_iterator it = mStringIndices.find(mDependencies[i]);
+        if (it == mStringIndices.end())
+        {
+            // The string indices are only kept while translating, a loaded program can not be saved again
+            return false;
+        }
+        appendValue(payload, it->second);
+    }
+    if (!mCode.empty())
+    {
+        const char *pCode = reinterpret_cast<const char*>(&mCode[0]);
+        payload.insert(payload.end(), pCode, pCode+mCode.size()*sizeof(uint32_t));
+    }
+
+    ModelCacheFileHeader header;
+    memcpy(header.magic, gModelCacheMagic, sizeof(gModelCacheMagic));
+    header.version = gModelCacheVersion;
+    header.headerSize = sizeof(header);
+    header.fingerprint = fingerprint;
+    header.payloadChecksum = hashBytes(gHashSeed, payload.empty() ? 0 : &payload[0], payload.size());
+    header.numStrings = mStrings.size();
+    header.numDependencies = mDependencies.size();
+    header.numCodeWords = mCode.size();
+    header.startTime = mStartTime;
+    header.stopTime = mStopTime;
+
+    const HString tempFilePath = rFilePath+".tmp"+to_hstring(size_t(std::clock()))+"_"+to_hstring(reinterpret_cast<size_t>(this));
+    {
+        std::ofstream file(tempFilePath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!payload.empty())
+        {
+            file.write(&payload[0], std::streamsize(payload.size()));
+        }
+        if (!file.good())
+        {
+            file.close();
+            std::remove(tempFilePath.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(rFilePath.c_str());
+#endif
+    if (std::rename(tempFilePath.c_str(), rFilePath.c_str()) != 0)
+    {
+        std::remove(tempFilePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+//! @brief Load a program from a model cache file
+//! @details The fingerprint is not checked here, compare getFingerprint() with the fingerprint of the current files
+//! @param [in] rFilePath The cache file to load
+//! @returns False if the file could not be read, is corrupt or is of an other version
+bool ModelLoadProgram::load(const HString &rFilePath)
+{
+    clear();
+    MappedFile file;
+    if (!file.open(rFilePath))
+    {
+        return false;
+    }
+
+    const char *pData = file.getData();
+    const size_t size = file.getSize();
+    ModelCacheFileHeader header;
+    if ((size < sizeof(header)) || (memcmp(pData, gModelCacheMagic, sizeof(gModelCacheMagic)) != 0))
+    {
+        return false;
+    }
+    memcpy(&header, pData, sizeof(header));
+    if ((header.version != gModelCacheVersion) || (header.headerSize < sizeof(header)) || (header.headerSize > size) ||
+        (hashBytes(gHashSeed, pData+header.headerSize, size-header.headerSize) != header.payloadChecksum))
+    {
+        return false;
+    }
+
+    bool ok = true;
+    size_t pos = header.headerSize;
+    mStrings.reserve(size_t(std::min<uint64_t>(header.numStrings, size)));
+    for (uint64_t i=0; ok && (i<header.numStrings); ++i)
+    {
+        uint32_t length=0;
+        ok = readValue(pData, size, pos, length) && (size-pos >= length);
+        if (ok)
+        {
+            mStrings.push_back(HString(pData+pos, length));
+            pos += length;
+        }
+    }
+    for (uint64_t i=0; ok && (i<header.numDependencies); ++i)
+    {
+        uint32_t idx=0;
+        ok = readValue(pData, size, pos, idx) && (idx < mStrings.size());
+        if (ok)
+        {
+            mDependencies.push_back(mStrings[idx]);
+        }
+    }
+    if (ok && ((size-pos)/sizeof(uint32_t) == header.numCodeWords) && ((size-pos)%sizeof(uint32_t) == 0))
+    {
+        mCode.resize(size_t(header.numCodeWords));
+        if (!mCode.empty())
+        {
+            memcpy(&mCode[0], pData+pos, mCode.size()*sizeof(uint32_t));
+        }
+    }
+    else
+    {
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        clear();
+        return false;
+    }
+    mFingerprint = header.fingerprint;
+    mStartTime = header.startTime;
+    mStopTime = header.stopTime;
+    return true;
+}
+
+//! @brief Returns the index of a string in the string table, adding the string if it is new
+uint32_t ModelLoadProgram::getStringIndex(const HString &rString)
+{
+    std::map<HString, uint32_t>::iterator it = mStringIndices.find(rString);
+    if (it == mStringIndices.end())
+    {
+        it = mStringIndices.insert(std::make_pair(rString, uint32_t(mStrings.size()))).first;
+        mStrings.push_back(rString);
+    }
+    return it->second;
+}
+
+//! @brief Returns the fingerprint stored in the loaded model cache file
+uint64_t ModelLoadProgram::getFingerprint() const
+{
+    return mFingerprint;
+}
+
+
+ModelFingerprint::ModelFingerprint()
+{
+    mValue = gHashSeed;
+}
+
+void ModelFingerprint::addString(const HString &rString)
+{
+    addBytes(rString.c_str(), rString.size());
+}
+
+//! @brief Add the contents of a file to the fingerprint
+//! @returns False if the file could not be read
+bool ModelFingerprint::addFile(const HString &rFilePath)
+{
+    MappedFile file;
+    if (!file.open(rFilePath))
+    {
+        return false;
+    }
+    addBytes(file.getData(), file.getSize());
+    return true;
+}
+
+uint64_t ModelFingerprint::getValue() const
+{
+    return mValue;
+}
+
+void ModelFingerprint::addBytes(const char *pData, const size_t size)
+{
+    mValue = hashBytes(mValue, pData, size);
+}
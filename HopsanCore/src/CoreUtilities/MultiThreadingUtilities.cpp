@@ -36,6 +36,14 @@
 #include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
 #if __cplusplus >= 201103L
 #include <mutex>
 #include <chrono>
@@ -46,6 +54,8 @@
 #include "CoreUtilities/MultiThreadingUtilities.h"
 #include "ComponentSystem.h"
 
+#include <map>
+
 namespace hopsan {
 
 //! @brief Helper function that decides how many thread to use.
@@ -86,6 +96,435 @@ size_t determineActualNumberOfThreads(const size_t nDesiredThreads)
 
 #if defined(HOPSANCORE_USEMULTITHREADING)
 
+//! @brief Pin a thread to a processor core
+//! @param rThread The thread to pin
+//! @param core The index of the core
+//! @returns True if successful, thread affinity is only supported on Linux
+bool setThreadCoreAffinity(std::thread &rThread, const size_t core)
+{
+#if defined(__linux__)
+    if (core >= CPU_SETSIZE)
+    {
+        return false;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    return (pthread_setaffinity_np(rThread.native_handle(), sizeof(cpu_set_t), &cpuSet) == 0);
+#else
+    (void)rThread;
+    (void)core;
+    return false;
+#endif
+}
+
+//! @brief Allow a thread to run on all processor cores again
+//! @param rThread The thread to unpin
+//! @returns True if successful, thread affinity is only supported on Linux
+bool clearThreadCoreAffinity(std::thread &rThread)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (size_t core=0; core<CPU_SETSIZE; ++core)
+    {
+        CPU_SET(core, &cpuSet);
+    }
+    return (pthread_setaffinity_np(rThread.native_handle(), sizeof(cpu_set_t), &cpuSet) == 0);
+#else
+    (void)rThread;
+    return false;
+#endif
+}
+
+//! @brief Find the NUMA node that a processor core belongs to
+//! @param core The index of the core
+//! @returns The index of the NUMA node, or -1 if it can not be determined
+int getNumaNodeOfCore(const size_t core)
+{
+    int numaNode = -1;
+#if defined(__linux__)
+    // The core directory in sysfs contains a link named nodeN for the NUMA node that it belongs to
+    const std::string cpuDir = "/sys/devices/system/cpu/cpu"+std::to_string(core);
+    DIR *pDir = opendir(cpuDir.c_str());
+    if (pDir)
+    {
+        struct dirent *pEntry;
+        while ((pEntry = readdir(pDir)) != 0)
+        {
+            const std::string name = pEntry->d_name;
+            if ((name.size() > 4) && (name.compare(0, 4, "node") == 0) && (name.find_first_not_of("0123456789", 4) == std::string::npos))
+            {
+                numaNode = atoi(name.c_str()+4);
+                break;
+            }
+        }
+        closedir(pDir);
+    }
+#else
+    (void)core;
+#endif
+    return numaNode;
+}
+
+//! @brief Move the data used by each thread to the NUMA node of the core that the thread runs on
+//! @details A memory page may contain data used by several threads, such pages are placed on the NUMA node of the
+//! first thread that uses them. Page migration is only supported on Linux.
+//! @param rThreadData The data ranges (pointer and number of values) used by each thread
+//! @param rThreadCores The core of each thread, if there are more threads than cores the cores are reused cyclically
+//! @returns The number of pages that are now on the desired NUMA node
+size_t placeDataOnNumaNodes(const std::vector< std::vector< std::pair<const double*, size_t> > > &rThreadData, const std::vector<size_t> &rThreadCores)
+{
+    size_t numPlacedPages = 0;
+#if defined(__linux__) && defined(SYS_move_pages)
+    if (rThreadCores.empty())
+    {
+        return 0;
+    }
+
+    const uintptr_t pageSize = uintptr_t(sysconf(_SC_PAGESIZE));
+    std::map<uintptr_t, int> pageNumaNodes;
+    for (size_t t=0; t<rThreadData.size(); ++t)
+    {
+        const int numaNode = getNumaNodeOfCore(rThreadCores[t % rThreadCores.size()]);
+        if (numaNode < 0)
+        {
+            continue;
+        }
+        for (size_t d=0; d<rThreadData[t].size(); ++d)
+        {
+            if (rThreadData[t][d].second > 0)
+            {
+                const uintptr_t first = reinterpret_cast<uintptr_t>(rThreadData[t][d].first);
+                const uintptr_t last = first + rThreadData[t][d].second*sizeof(double) - 1;
+                for (uintptr_t page = first - first % pageSize; page <= last; page += pageSize)
+                {
+                    pageNumaNodes.insert(std::make_pair(page, numaNode));
+                }
+            }
+        }
+    }
+
+    std::vector<void*> pages;
+    std::vector<int> numaNodes, status(pageNumaNodes.size(), -1);
+    pages.reserve(pageNumaNodes.size());
+    numaNodes.reserve(pageNumaNodes.size());
+    for (std::map<uintptr_t, int>::const_iterator it=pageNumaNodes.begin(); it!=pageNumaNodes.end(); ++it)
+    {
+        pages.push_back(reinterpret_cast<void*>(it->first));
+        numaNodes.push_back(it->second);
+    }
+
+    if (!pages.empty() && (syscall(SYS_move_pages, 0, pages.size(), &pages[0], &numaNodes[0], &status[0], MPOL_MF_MOVE) == 0))
+    {
+        for (size_t i=0; i<status.size(); ++i)
+        {
+            if (status[i] == numaNodes[i])
+            {
+                ++numPlacedPages;
+            }
+        }
+    }
+#else
+    (void)rThreadData;
+    (void)rThreadCores;
+#endif
+    return numPlacedPages;
+}
+
+
+SimulationThreadPool *gpInternalCoreSimulationThreadPool=0; // Do not use this pointer outside of HopsanCore
+
+namespace {
+
+//! @brief Keeps track of the tasks in one SimulationThreadPool::run() that have not finished yet
+class SimulationThreadPoolRun
+{
+public:
+    SimulationThreadPoolRun(size_t nTasks) : mnRemaining(nTasks) {}
+
+    size_t mnRemaining;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+};
+
+}
+
+//! @brief A worker thread in the simulation thread pool
+//! @details The task members are protected by the worker mutex, the busy and pinning members by the pool mutex.
+class SimulationThreadPool::Worker
+{
+public:
+    Worker() : mHasTask(false), mStop(false), mpRun(0), mBusy(false), mIsPinned(false), mCore(0) {}
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::function<void()> mTask;
+    bool mHasTask;
+    bool mStop;
+    SimulationThreadPoolRun *mpRun;
+
+    bool mBusy;
+    bool mIsPinned;
+    size_t mCore;
+};
+
+//! @brief Constructor, no threads are created until they are needed
+SimulationThreadPool::SimulationThreadPool()
+{
+}
+
+//! @brief Destructor, stops and joins all worker threads
+//! @note No simulation may be using the pool when it is destroyed
+SimulationThreadPool::~SimulationThreadPool()
+{
+    std::lock_guard<std::mutex> poolLock(mMutex);
+    for(size_t w=0; w<mWorkers.size(); ++w)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mWorkers[w]->mMutex);
+            mWorkers[w]->mStop = true;
+        }
+        mWorkers[w]->mCondition.notify_one();
+    }
+    for(size_t w=0; w<mWorkers.size(); ++w)
+    {
+        mWorkers[w]->mThread.join();
+        delete mWorkers[w];
+    }
+    mWorkers.clear();
+}
+
+//! @brief Run tasks in parallel, one task per worker thread, and wait for all of them to finish
+//! @param rTasks The tasks to run
+//! @param rCores The cores to pin the threads to (task i is pinned to core i modulo the number of cores), if empty the threads are not pinned
+//! @returns False if some thread could not be pinned to its core, all tasks are run anyway
+bool SimulationThreadPool::run(const std::vector< std::function<void()> > &rTasks, const std::vector<size_t> &rCores)
+{
+    if(rTasks.empty())
+    {
+        return true;
+    }
+
+    SimulationThreadPoolRun poolRun(rTasks.size());
+    std::vector<Worker*> workers;
+    bool allPinned = true;
+    {
+        std::lock_guard<std::mutex> poolLock(mMutex);
+        for(size_t w=0; (w<mWorkers.size()) && (workers.size()<rTasks.size()); ++w)
+        {
+            if(!mWorkers[w]->mBusy)
+            {
+                workers.push_back(mWorkers[w]);
+            }
+        }
+        while(workers.size() < rTasks.size())
+        {
+            Worker *pWorker = new Worker();
+            pWorker->mThread = std::thread(workerLoop, pWorker);
+            mWorkers.push_back(pWorker);
+            workers.push_back(pWorker);
+        }
+
+        for(size_t t=0; t<workers.size(); ++t)
+        {
+            Worker *pWorker = workers[t];
+            pWorker->mBusy = true;
+            // Only change the affinity when needed, threads are usually pinned to the same cores as in the previous run
+            if(!rCores.empty())
+            {
+                const size_t core = rCores[t % rCores.size()];
+                if(!pWorker->mIsPinned || (pWorker->mCore != core))
+                {
+                    pWorker->mIsPinned = setThreadCoreAffinity(pWorker->mThread, core);
+                    pWorker->mCore = core;
+                    if(!pWorker->mIsPinned)
+                    {
+                        clearThreadCoreAffinity(pWorker->mThread);
+                        allPinned = false;
+                    }
+                }
+            }
+            else if(pWorker->mIsPinned)
+            {
+                clearThreadCoreAffinity(pWorker->mThread);
+                pWorker->mIsPinned = false;
+            }
+        }
+    }
+
+    for(size_t t=0; t<workers.size(); ++t)
+    {
+        {
+            std::lock_guard<std::mutex> lock(workers[t]->mMutex);
+            workers[t]->mTask = rTasks[t];
+            workers[t]->mpRun = &poolRun;
+            workers[t]->mHasTask = true;
+        }
+        workers[t]->mCondition.notify_one();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(poolRun.mMutex);
+        poolRun.mCondition.wait(lock, [&poolRun]() { return poolRun.mnRemaining == 0; });
+    }
+
+    std::lock_guard<std::mutex> poolLock(mMutex);
+    for(size_t t=0; t<workers.size(); ++t)
+    {
+        workers[t]->mBusy = false;
+    }
+    return allPinned;
+}
+
+//! @brief Returns the number of worker threads that have been created
+size_t SimulationThreadPool::getNumThreads()
+{
+    std::lock_guard<std::mutex> poolLock(mMutex);
+    return mWorkers.size();
+}
+
+//! @brief The loop of a worker thread, waits for tasks and runs them until the pool is destroyed
+//! @param pWorker The worker
+void SimulationThreadPool::workerLoop(Worker *pWorker)
+{
+    while(true)
+    {
+        std::function<void()> task;
+        SimulationThreadPoolRun *pRun;
+        {
+            std::unique_lock<std::mutex> lock(pWorker->mMutex);
+            pWorker->mCondition.wait(lock, [pWorker]() { return pWorker->mHasTask || pWorker->mStop; });
+            if(!pWorker->mHasTask)
+            {
+                return;
+            }
+            task.swap(pWorker->mTask);
+            pRun = pWorker->mpRun;
+            pWorker->mHasTask = false;
+        }
+
+        task();
+
+        // Notify while holding the lock, the run object is destroyed as soon as the waiting thread returns
+        std::lock_guard<std::mutex> lock(pRun->mMutex);
+        if(--pRun->mnRemaining == 0)
+        {
+            pRun->mCondition.notify_all();
+        }
+    }
+}
+
+
+//! @brief Wait until a condition is fulfilled, how to wait is decided by the barrier mode
+//! @details First spin for a bounded number of iterations, then yield for a bounded time and finally block on the
+//! condition variable. The blocking wait times out regularly, so that conditions that are changed without
+//! notification (such as an aborted simulation) are still detected.
+//! @param isDone The condition to wait for
+//! @param mode The barrier mode
+//! @param spinIterations The number of iterations to spin before yielding
+//! @param yieldMicroSeconds The time to yield before blocking
+//! @param rMutex The mutex for the condition variable
+//! @param rCondition The condition variable that is notified when the condition may have changed
+//! @param rnBlocked Counter for the number of blocked threads, so that the notifier knows if it needs to notify
+template<typename ConditionT>
+static void adaptiveWait(ConditionT isDone, const BarrierModeT mode, const size_t spinIterations, const int yieldMicroSeconds,
+                         std::mutex &rMutex, std::condition_variable &rCondition, std::atomic<int> &rnBlocked)
+{
+    if(mode == SpinningBarrier)
+    {
+        while(!isDone()) {}
+        return;
+    }
+
+    for(size_t i=0; i<spinIterations; ++i)
+    {
+        if(isDone())
+        {
+            return;
+        }
+    }
+
+    const std::chrono::steady_clock::time_point yieldEnd = std::chrono::steady_clock::now()+std::chrono::microseconds(yieldMicroSeconds);
+    while(!isDone())
+    {
+        if((mode == BlockingBarrier) && (std::chrono::steady_clock::now() > yieldEnd))
+        {
+            // The blocked counter must be incremented before the condition is checked again, so that a notifier
+            // either sees the counter or the waiting thread sees the changed condition
+            std::unique_lock<std::mutex> lock(rMutex);
+            ++rnBlocked;
+            while(!isDone())
+            {
+                rCondition.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            --rnBlocked;
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+
+void BarrierLock::arriveAndWait()
+{
+    const unsigned int generation = mGeneration.load();
+    ++mCounter;
+    if(mnBlockedMasters.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMasterCondition.notify_one();
+    }
+    adaptiveWait([&]() { return (mGeneration.load() != generation) || mAborted.load(); },
+                 mMode, SpinIterations, YieldMicroSeconds, mMutex, mSlaveCondition, mnBlockedSlaves);
+}
+
+bool BarrierLock::waitForAllArrived(ComponentSystem *pSystem)
+{
+    adaptiveWait([&]() { return allArrived() || pSystem->wasSimulationAborted(); },
+                 mMode, SpinIterations, YieldMicroSeconds, mMutex, mMasterCondition, mnBlockedMasters);
+    return allArrived();
+}
+
+void BarrierLock::release()
+{
+    // Reset the counter before flipping the generation, a slave can not arrive again before it has seen the new generation
+    mCounter.store(0);
+    ++mGeneration;
+    if(mnBlockedSlaves.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSlaveCondition.notify_all();
+    }
+}
+
+void BarrierLock::abort()
+{
+    mAborted.store(true);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSlaveCondition.notify_all();
+    mMasterCondition.notify_all();
+}
+
+
+//! @brief Wait for all slave threads to arrive at a barrier, then release them
+//! @returns False if the simulation was aborted, then all barriers are aborted so that no slave thread is left waiting
+static bool masterWaitAtBarrier(ComponentSystem *pSystem, BarrierLock *pBarrier, BarrierLock *pBarrier_S,
+                                BarrierLock *pBarrier_C, BarrierLock *pBarrier_Q, BarrierLock *pBarrier_N)
+{
+    if(!pBarrier->waitForAllArrived(pSystem))
+    {
+        pBarrier_S->abort();
+        pBarrier_C->abort();
+        pBarrier_Q->abort();
+        pBarrier_N->abort();
+        return false;
+    }
+    pBarrier->release();
+    return true;
+}
+
 //! @brief Constructor for slave simulation thread function.
 //! @param pSystem Pointer to top level component system
 //! @param sVector Vector with signal components executed from this thread
@@ -122,8 +561,7 @@ void simSlave(ComponentSystem *pSystem,
 
         //! Signal Components !//
 
-        pBarrier_S->increment();
-        while(pBarrier_S->isLocked()){}                         //Wait at S barrier
+        pBarrier_S->arriveAndWait();                         //Wait at S barrier
         if(pSystem->wasSimulationAborted()) break;
 
         for(size_t i=0; i<sVector.size(); ++i)
@@ -134,8 +572,7 @@ void simSlave(ComponentSystem *pSystem,
 
         //! C Components !//
 
-        pBarrier_C->increment();
-        while(pBarrier_C->isLocked()){}                         //Wait at C barrier
+        pBarrier_C->arriveAndWait();                         //Wait at C barrier
         if(pSystem->wasSimulationAborted()) break;
 
         for(size_t i=0; i<cVector.size(); ++i)
@@ -146,8 +583,7 @@ void simSlave(ComponentSystem *pSystem,
 
         //! Q Components !//
 
-        pBarrier_Q->increment();
-        while(pBarrier_Q->isLocked()){}                         //Wait at Q barrier
+        pBarrier_Q->arriveAndWait();                         //Wait at Q barrier
         if(pSystem->wasSimulationAborted()) break;
 
         for(size_t i=0; i<qVector.size(); ++i)
@@ -157,8 +593,7 @@ void simSlave(ComponentSystem *pSystem,
 
         //! Log Nodes !//
 
-        pBarrier_N->increment();
-        while(pBarrier_N->isLocked()){}                         //Wait at N barrier
+        pBarrier_N->arriveAndWait();                         //Wait at N barrier
         if(pSystem->wasSimulationAborted()) break;
         //! @todo Temporary hack by Peter, after rewriting how node data and time is logged this no longer works, now master thread loags all nodes, need to come up with something smart
         //            for(size_t i=0; i<mVectorN.size(); ++i)
@@ -198,26 +633,7 @@ void simMaster(ComponentSystem *pSystem, std::vector<Component *> &sVector, std:
         time += timeStep;
 
         //! Signal Components !//
-        bool stop=false;
-        while(!pBarrier_S->allArrived())   //Wait for all other threads to arrive at signal barrier
-        {
-            if(pSystem->wasSimulationAborted())
-            {
-                stop=true;
-                break;
-            }
-
-        }
-        if(stop)
-        {
-            pBarrier_S->unlock();
-            pBarrier_C->unlock();
-            pBarrier_Q->unlock();
-            pBarrier_N->unlock();
-            break;
-        }
-        pBarrier_C->lock();                    //Lock next barrier (must be done before unlocking this one, to prevent deadlocks)
-        pBarrier_S->unlock();                  //Unlock signal barrier
+        if(!masterWaitAtBarrier(pSystem, pBarrier_S, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         for(size_t i=0; i<sVector.size(); ++i)
         {
@@ -225,25 +641,7 @@ void simMaster(ComponentSystem *pSystem, std::vector<Component *> &sVector, std:
         }
 
         //! C Components !//
-        stop=false;
-        while(!pBarrier_C->allArrived())   //C barrier
-        {
-            if(pSystem->wasSimulationAborted())
-            {
-                stop=true;
-                break;
-            }
-        }
-        if(stop)
-        {
-            pBarrier_S->unlock();
-            pBarrier_C->unlock();
-            pBarrier_Q->unlock();
-            pBarrier_N->unlock();
-            break;
-        }
-        pBarrier_Q->lock();
-        pBarrier_C->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_C, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         for(size_t i=0; i<cVector.size(); ++i)
         {
@@ -251,25 +649,8 @@ void simMaster(ComponentSystem *pSystem, std::vector<Component *> &sVector, std:
         }
 
         //! Q Components !//
-        stop=false;
-        while(!pBarrier_Q->allArrived()) //Q barrier
-        {
-            if(pSystem->wasSimulationAborted())
-            {
-                stop=true;
-                break;
-            }
-        }
-        if(stop)
-        {
-            pBarrier_S->unlock();
-            pBarrier_C->unlock();
-            pBarrier_Q->unlock();
-            pBarrier_N->unlock();
-            break;
-        }
-        pBarrier_N->lock();
-        pBarrier_Q->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_Q, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
+
         for(size_t i=0; i<qVector.size(); ++i)
         {
             qVector[i]->simulate(time);
@@ -279,26 +660,7 @@ void simMaster(ComponentSystem *pSystem, std::vector<Component *> &sVector, std:
             *pSimTimes[i] = time;     //Update time in component system, so that progress bar can use it
 
         //! Log Nodes !//
-        stop=false;
-        while(!pBarrier_N->allArrived()) //N barrier
-        {
-            if(pSystem->wasSimulationAborted())
-            {
-                stop=true;
-                break;
-            }
-
-        }
-        if(stop)
-        {
-            pBarrier_S->unlock();
-            pBarrier_C->unlock();
-            pBarrier_Q->unlock();
-            pBarrier_N->unlock();
-            break;
-        }
-        pBarrier_S->lock();
-        pBarrier_N->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_N, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         //! @todo Temporary hack by Peter, after rewriting how node data and time is logged this no longer works, now master thread loags all nodes, need to come up with something smart
         //            for(size_t i=0; i<mVectorN.size(); ++i)
@@ -373,15 +735,11 @@ void simStealingMaster(ComponentSystem *pSystem,
 
     for(size_t s=0; s<numSimSteps; ++s)
     {
-        if(pSystem->wasSimulationAborted()) break;
-
         time += timeStep;
 
         //! Signal Components !//
 
-        while(!pBarrier_S->allArrived()) {}
-        pBarrier_C->lock();
-        pBarrier_S->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_S, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         //Simulate signal components
         for(size_t i=0; i<sVector.size(); ++i)
@@ -391,9 +749,7 @@ void simStealingMaster(ComponentSystem *pSystem,
 
         //! C Components !//
 
-        while(!pBarrier_C->allArrived()) {}    //C barrier
-        pBarrier_Q->lock();
-        pBarrier_C->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_C, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         //SIMULATE C
 
@@ -429,9 +785,7 @@ void simStealingMaster(ComponentSystem *pSystem,
 
         //! Q Components !//
 
-        while(!pBarrier_Q->allArrived()) {}    //Q barrier
-        pBarrier_N->lock();
-        pBarrier_Q->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_Q, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         //SIMULATE Q
 
@@ -470,9 +824,7 @@ void simStealingMaster(ComponentSystem *pSystem,
 
         //! Log Nodes !//
 
-        while(!pBarrier_N->allArrived()) {}    //N barrier
-        pBarrier_S->lock();
-        pBarrier_N->unlock();
+        if(!masterWaitAtBarrier(pSystem, pBarrier_N, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
 
         pSystem->logTimeAndNodes(s+1);
     }
@@ -512,13 +864,11 @@ void simStealingSlave(ComponentSystem *pSystem,
 
         //! Signal Components !//
 
-        pBarrier_S->increment();
-        while(pBarrier_S->isLocked()){}                         //Wait at S barrier
+        pBarrier_S->arriveAndWait();                         //Wait at S barrier
 
         //! C Components !//
 
-        pBarrier_C->increment();
-        while(pBarrier_C->isLocked()){}                         //Wait at C barrier
+        pBarrier_C->arriveAndWait();                         //Wait at C barrier
 
         //C-COMPONENTS
 
@@ -554,8 +904,7 @@ void simStealingSlave(ComponentSystem *pSystem,
 
         //! Q Components !//
 
-        pBarrier_Q->increment();
-        while(pBarrier_Q->isLocked()){}                         //Wait at Q barrier
+        pBarrier_Q->arriveAndWait();                         //Wait at Q barrier
 
         //Q-COMPONENTS
 
@@ -591,8 +940,186 @@ void simStealingSlave(ComponentSystem *pSystem,
 
         //! Log Nodes !//
 
-        pBarrier_N->increment();
-        while(pBarrier_N->isLocked()){}                         //Wait at N barrier
+        pBarrier_N->arriveAndWait();                         //Wait at N barrier
+    }
+}
+
+//! @brief Push the components owned by a thread to its work-stealing deque
+//! @details The components are pushed in reverse order, so that the owner pops them in their original order
+//! @param [in,out] rOwnComponents The components owned by the thread, the vector is cleared
+//! @param pDeque The deque of the thread
+static void fillWorkStealingDeque(std::vector<Component*> &rOwnComponents, WorkStealingDeque *pDeque)
+{
+    for(size_t i=rOwnComponents.size(); i>0; --i)
+    {
+        pDeque->push(rOwnComponents[i-1]);
+    }
+    rOwnComponents.clear();
+}
+
+//! @brief Simulate the components in the own deque, then steal from the other threads until all deques are empty
+//! @details Every component that a thread simulates, including stolen ones, is owned by that thread in the next time step
+//! @param [out] rOwnComponents The components simulated by this thread
+//! @param pDeques The deques of all threads
+//! @param threadID The index of this thread
+//! @param time The time to simulate to
+static void simWorkStealingStep(std::vector<Component*> &rOwnComponents, std::vector<WorkStealingDeque*> *pDeques, const size_t threadID, const double time)
+{
+    Component *pComp = pDeques->at(threadID)->pop();
+    while(pComp)
+    {
+        pComp->simulate(time);
+        rOwnComponents.push_back(pComp);
+        pComp = pDeques->at(threadID)->pop();
+    }
+
+    const size_t nThreads = pDeques->size();
+    bool foundWork = true;
+    while(foundWork)
+    {
+        foundWork = false;
+        for(size_t i=1; i<nThreads; ++i)
+        {
+            pComp = pDeques->at((threadID+i)%nThreads)->steal();
+            if(pComp)
+            {
+                pComp->simulate(time);
+                rOwnComponents.push_back(pComp);
+                foundWork = true;
+            }
+        }
+    }
+}
+
+//! @brief Function for the master simulation thread using lock-free work-stealing
+//! @param pSystem Pointer to the top level component system
+//! @param sVector Vector with all signal components, they are executed from this thread
+//! @param cVector Vector with C-type components initially owned by this thread
+//! @param qVector Vector with Q-type components initially owned by this thread
+//! @param pDequesC Pointer to the C-type work-stealing deques of all threads
+//! @param pDequesQ Pointer to the Q-type work-stealing deques of all threads
+//! @param pSimTimes Pointer to the simulation time variables in the component systems
+//! @param startTime Start time of simulation
+//! @param timeStep Step time of simulation
+//! @param numSimSteps Number of steps to simulate
+//! @param threadID The index of this thread
+//! @param *pBarrier_S Pointer to barrier before signal components
+//! @param *pBarrier_C Pointer to barrier before C-type components
+//! @param *pBarrier_Q Pointer to barrier before Q-type components
+//! @param *pBarrier_N Pointer to barrier before node logging
+void simWorkStealingMaster(ComponentSystem *pSystem,
+                           std::vector<Component *> &sVector,
+                           std::vector<Component *> cVector,
+                           std::vector<Component *> qVector,
+                           std::vector<WorkStealingDeque *> *pDequesC,
+                           std::vector<WorkStealingDeque *> *pDequesQ,
+                           std::vector<double *> &pSimTimes,
+                           double startTime,
+                           double timeStep,
+                           size_t numSimSteps,
+                           size_t threadID,
+                           BarrierLock *pBarrier_S,
+                           BarrierLock *pBarrier_C,
+                           BarrierLock *pBarrier_Q,
+                           BarrierLock *pBarrier_N)
+{
+    double time = startTime;
+    fillWorkStealingDeque(cVector, pDequesC->at(threadID));
+
+    for(size_t s=0; s<numSimSteps; ++s)
+    {
+        time += timeStep;
+
+        //! Signal Components !//
+
+        if(!masterWaitAtBarrier(pSystem, pBarrier_S, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
+
+        // All Q components from the previous step are finished, so the Q deque can be refilled
+        fillWorkStealingDeque(qVector, pDequesQ->at(threadID));
+
+        for(size_t i=0; i<sVector.size(); ++i)
+        {
+            sVector[i]->simulate(time);
+        }
+
+        //! C Components !//
+
+        if(!masterWaitAtBarrier(pSystem, pBarrier_C, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
+
+        simWorkStealingStep(cVector, pDequesC, threadID, time);
+
+        //! Q Components !//
+
+        if(!masterWaitAtBarrier(pSystem, pBarrier_Q, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
+
+        // All C components are finished, so the C deque can be refilled for the next step
+        fillWorkStealingDeque(cVector, pDequesC->at(threadID));
+
+        simWorkStealingStep(qVector, pDequesQ, threadID, time);
+
+        for(size_t i=0; i<pSimTimes.size(); ++i)
+            *pSimTimes[i] = time;     //Update time in component system, so that progress bar can use it
+
+        //! Log Nodes !//
+
+        if(!masterWaitAtBarrier(pSystem, pBarrier_N, pBarrier_S, pBarrier_C, pBarrier_Q, pBarrier_N)) break;
+
+        pSystem->logTimeAndNodes(s+1);
+    }
+}
+
+//! @brief Function for slave simulation threads using lock-free work-stealing
+//! @see simWorkStealingMaster
+void simWorkStealingSlave(ComponentSystem *pSystem,
+                          std::vector<Component *> cVector,
+                          std::vector<Component *> qVector,
+                          std::vector<WorkStealingDeque *> *pDequesC,
+                          std::vector<WorkStealingDeque *> *pDequesQ,
+                          double startTime,
+                          double timeStep,
+                          size_t numSimSteps,
+                          size_t threadID,
+                          BarrierLock *pBarrier_S,
+                          BarrierLock *pBarrier_C,
+                          BarrierLock *pBarrier_Q,
+                          BarrierLock *pBarrier_N)
+{
+    double time = startTime;
+    fillWorkStealingDeque(cVector, pDequesC->at(threadID));
+
+    for(size_t s=0; s<numSimSteps; ++s)
+    {
+        time += timeStep;
+
+        //! Signal Components !//
+
+        pBarrier_S->arriveAndWait();                         //Wait at S barrier
+        if(pSystem->wasSimulationAborted()) break;
+
+        // All Q components from the previous step are finished, so the Q deque can be refilled
+        fillWorkStealingDeque(qVector, pDequesQ->at(threadID));
+
+        //! C Components !//
+
+        pBarrier_C->arriveAndWait();                         //Wait at C barrier
+        if(pSystem->wasSimulationAborted()) break;
+
+        simWorkStealingStep(cVector, pDequesC, threadID, time);
+
+        //! Q Components !//
+
+        pBarrier_Q->arriveAndWait();                         //Wait at Q barrier
+        if(pSystem->wasSimulationAborted()) break;
+
+        // All C components are finished, so the C deque can be refilled for the next step
+        fillWorkStealingDeque(cVector, pDequesC->at(threadID));
+
+        simWorkStealingStep(qVector, pDequesQ, threadID, time);
+
+        //! Log Nodes !//
+
+        pBarrier_N->arriveAndWait();                         //Wait at N barrier
+        if(pSystem->wasSimulationAborted()) break;
     }
 }
 
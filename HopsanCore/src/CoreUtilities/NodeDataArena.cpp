@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   NodeDataArena.cpp
+//! @author FluMeS
+//!
+//! @brief Contains the node data arena help class
+//!
+//$Id$
+
+#include <cstdint>
+
+#include "CoreUtilities/NodeDataArena.h"
+#include "Node.h"
+
+using namespace hopsan;
+
+namespace {
+const size_t gDoublesPerCacheLine = NodeDataArena::CacheLineSize/sizeof(double);
+
+//! @brief Calculate the arena offset for a node, avoid straddling cache lines if the node data fits in one
+size_t alignedNodeOffset(const size_t offset, const size_t numValues)
+{
+    const size_t lineOffset = offset % gDoublesPerCacheLine;
+    if ( (numValues <= gDoublesPerCacheLine) && (lineOffset + numValues > gDoublesPerCacheLine) )
+    {
+        return offset + gDoublesPerCacheLine - lineOffset;
+    }
+    return offset;
+}
+}
+
+NodeDataArena::NodeDataArena()
+{
+    mpAllocation = 0;
+    mpData = 0;
+    mNumDataValues = 0;
+}
+
+NodeDataArena::~NodeDataArena()
+{
+    // Note! The owner must unpack all nodes before the arena is destroyed
+    deallocate();
+}
+
+//! @brief Pack the data values of the given nodes into one contiguous memory block
+//! @details The given nodes are first moved back to their local storage, node data values are preserved.
+//! Every node previously packed in this arena must be included (or have been unpacked), since the old memory is released.
+//! Pointers to node data retrieved before packing will no longer be valid.
+//! @param[in] rNodes The nodes to pack, in the order they should appear in memory
+void NodeDataArena::pack(const std::vector<Node*> &rNodes)
+{
+    unpack(rNodes);
+    deallocate();
+
+    // Calculate the required size
+    size_t numValues = 0;
+    for (size_t i=0; i<rNodes.size(); ++i)
+    {
+        const size_t n = rNodes[i]->getNumDataVariables();
+        numValues = alignedNodeOffset(numValues, n) + n;
+    }
+    if (numValues == 0)
+    {
+        return;
+    }
+
+    // Allocate and align the data to the beginning of a cache line
+    mpAllocation = new char[numValues*sizeof(double) + CacheLineSize];
+    const size_t misalignment = reinterpret_cast<uintptr_t>(mpAllocation) % CacheLineSize;
+    mpData = reinterpret_cast<double*>(mpAllocation + (misalignment ? CacheLineSize-misalignment : 0));
+    mNumDataValues = numValues;
+
+    // Move the node data values into the arena
+    size_t offset = 0;
+    for (size_t i=0; i<rNodes.size(); ++i)
+    {
+        const size_t n = rNodes[i]->getNumDataVariables();
+        offset = alignedNodeOffset(offset, n);
+        rNodes[i]->relocateDataValues(mpData+offset);
+        offset += n;
+    }
+}
+
+//! @brief Move the data values of the given nodes back to their local storage, if they are packed in this arena
+//! @param[in] rNodes The nodes to unpack
+void NodeDataArena::unpack(const std::vector<Node*> &rNodes)
+{
+    for (size_t i=0; i<rNodes.size(); ++i)
+    {
+        unpackNode(rNodes[i]);
+    }
+}
+
+//! @brief Move the data values of one node back to its local storage, if it is packed in this arena
+//! @param[in] pNode The node to unpack
+void NodeDataArena::unpackNode(Node *pNode)
+{
+    if (contains(pNode))
+    {
+        pNode->relocateDataValues(0);
+    }
+}
+
+//! @brief Check if the data values of a node are currently stored in this arena
+//! @param[in] pNode The node to check
+bool NodeDataArena::contains(const Node *pNode) const
+{
+    return mpData && !pNode->hasLocalDataValues() &&
+           (pNode->mpDataValues >= mpData) && (pNode->mpDataValues < mpData+mNumDataValues);
+}
+
+//! @brief Returns the total number of values in the arena, including cache line padding
+size_t NodeDataArena::getNumDataValues() const
+{
+    return mNumDataValues;
+}
+
+void NodeDataArena::deallocate()
+{
+    delete[] mpAllocation;
+    mpAllocation = 0;
+    mpData = 0;
+    mNumDataValues = 0;
+}
@@ -22,6 +22,12 @@
 
 -----------------------------------------------------------------------------*/
 
+//!
+//! @file   SaveRestoreSimulationPoint.cpp
+//! @author FluMeS
+//!
+//! @brief Contains functions for saving and restoring simulation points (checkpoints) and in-memory snapshots
+//!
 //$Id$
 
 #include "CoreUtilities/SaveRestoreSimulationPoint.h"
@@ -31,188 +37,515 @@
 #include <vector>
 #include <fstream>
 #include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <stdint.h>
 
 using namespace hopsan;
 
 /*
- * Port head
+ * Simulation point file, version 1
  *
- * DataIdentifier   FullNameLength  NumDataElements (double)
- * 2-byte           2-byte          2-byte
+ * All fields are stored in native byte order. Every record starts at an 8-byte aligned offset, so the values can
+ * be read in place as doubles from a memory mapping of the file.
+ *
+ * File header (32 bytes)
+ * Magic "HOPSANSP"  Version   HeaderSize  NumRecords  Time
+ * 8 bytes           uint32    uint32      uint64      double
+ *
+ * Record header (16 bytes), followed by the name padded with zeros to a multiple of 8 bytes and then the values
+ * Type      NameLength  NumValues
+ * uint32    uint32      uint64
+ *
+ * Port records (type 1) hold the node data of a port, named by the full path /system/component/port
+ * Component state records (type 2) hold the data saved by Component::saveState(), named by /system/component
+ * Readers skip record types that they do not know
  *
  *
+ * Legacy format (version 0), node data only, read but no longer written
+ *
+ * DataIdentifier   FullNameLength  NumDataElements (double)
+ * 2-byte           2-byte          2-byte
  *
  * */
 
-#define TIMEIDENTIFIER 0x02
-#define PORTIDENTIFIER 0x03
+#define LEGACYTIMEIDENTIFIER 0x02
+#define LEGACYPORTIDENTIFIER 0x03
+
+namespace {
+
+const char gSimulationPointMagic[8] = {'H','O','P','S','A','N','S','P'};
+const uint32_t gSimulationPointVersion = 1;
+
+struct SimulationPointFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t numRecords;
+    double time;
+};
+
+struct SimulationPointRecordHeader
+{
+    uint32_t type;
+    uint32_t nameLength;
+    uint64_t numValues;
+};
+
+inline size_t paddedLength(const size_t length)
+{
+    return (length+7) & ~size_t(7);
+}
+
+void writeRecord(const uint32_t type, const HString &rName, const double *pValues, const size_t numValues, std::ofstream &rFile)
+{
+    SimulationPointRecordHeader header;
+    header.type = type;
+    header.nameLength = uint32_t(rName.size());
+    header.numValues = numValues;
+    rFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    rFile.write(rName.c_str(), rName.size());
+    const char padding[8] = {0,0,0,0,0,0,0,0};
+    rFile.write(padding, paddedLength(rName.size())-rName.size());
+    rFile.write(reinterpret_cast<const char*>(pValues), numValues*sizeof(double));
+}
 
-void writePortData(Port *pPort, const HString &namePrefix, std::ofstream &rFile)
+size_t saveSimulationPointInternal(ComponentSystem *pSystem, const HString &rNamePrefix, ComponentStateWriter &rStateWriter, std::ofstream &rFile)
 {
-    // Generate full name
-    HString fullName = namePrefix+pPort->getName();
-    std::vector<double> *pDataVector = pPort->getDataVectorPtr();
-    // OK great, if we have a data vector, lets dump it to file
-    if (pDataVector)
+    size_t numRecords=0;
+    std::vector<Component*> subcomps = pSystem->getSubComponents();
+    for (size_t c=0; c<subcomps.size(); ++c)
     {
-        // Write port identifier
-        size_t identifier = PORTIDENTIFIER;
-        rFile.write(reinterpret_cast<char*>(&identifier), 2);
-        size_t namelen = fullName.size();
-        rFile.write(reinterpret_cast<char*>(&namelen), 2);
-        size_t datalen = pDataVector->size();
-        rFile.write(reinterpret_cast<char*>(&datalen), 2);
-        rFile.write(fullName.c_str(), namelen);
-        rFile.write(reinterpret_cast<char*>(pDataVector->data()), datalen*sizeof(double));
+        Component *pComp = subcomps[c];
+        const HString compPath = rNamePrefix+pComp->getName();
+
+        std::vector<Port*> ports = pComp->getPortPtrVector();
+        for (size_t p=0; p<ports.size(); ++p)
+        {
+            double *pDataVector = ports[p]->getDataVectorPtr();
+            if (pDataVector)
+            {
+                writeRecord(1, compPath+'/'+ports[p]->getName(), pDataVector, ports[p]->getNumDataVariables(), rFile);
+                ++numRecords;
+            }
+        }
+
+        rStateWriter.clear();
+        pComp->saveState(rStateWriter);
+        if (rStateWriter.getNumValues() > 0)
+        {
+            writeRecord(2, compPath, &rStateWriter.getData()[0], rStateWriter.getNumValues(), rFile);
+            ++numRecords;
+        }
+
+        if (pComp->isComponentSystem())
+        {
+            numRecords += saveSimulationPointInternal(static_cast<ComponentSystem*>(pComp), compPath+'/', rStateWriter, rFile);
+        }
     }
+    return numRecords;
 }
 
-void writeTimeData(double time, std::ofstream &rFile)
+//! @brief Find a component from its full path, such as /subsystem/component
+Component *findComponent(ComponentSystem *pRootSystem, const HString &rPath)
 {
-    // Write port identifier
-    size_t identifier = TIMEIDENTIFIER;
-    rFile.write(reinterpret_cast<char*>(&identifier), 2);
-    rFile.write(reinterpret_cast<char*>(&time), sizeof(double));
+    Component *pComponent = pRootSystem;
+    HVector<HString> names = rPath.split('/');
+    for (size_t i=0; i<names.size(); ++i)
+    {
+        if (names[i].empty())
+        {
+            continue;
+        }
+        if (!pComponent || !pComponent->isComponentSystem())
+        {
+            return 0;
+        }
+        pComponent = static_cast<ComponentSystem*>(pComponent)->getSubComponent(names[i]);
+    }
+    return pComponent;
+}
+
+//! @brief Find a port from its full path, such as /subsystem/component/port
+Port *findPort(ComponentSystem *pRootSystem, const HString &rPath)
+{
+    const size_t e = rPath.rfind('/');
+    if (e == HString::npos)
+    {
+        return 0;
+    }
+    Component *pComponent = findComponent(pRootSystem, rPath.substr(0, e));
+    if (pComponent && (pComponent != pRootSystem))
+    {
+        return pComponent->getPort(rPath.substr(e+1));
+    }
+    return 0;
+}
+
 }
 
-size_t readIdentifier(std::ifstream &rFile)
+
+SimulationPoint::SimulationPoint()
 {
-    size_t identifier=0;
-    rFile.read(reinterpret_cast<char*>(&identifier), 2);
-    return identifier;
+    mpValues = 0;
+    mVersion = 0;
+    mTime = 0;
 }
 
-void readPortData(std::ifstream &rFile, ComponentSystem *pRootSystem)
+//! @brief Load a simulation point file
+//! @param [in] rFileName The file to load
+//! @returns False if the file could not be read, is corrupt or is of a newer version
+bool SimulationPoint::load(const HString &rFileName)
 {
-    // Read rest of header
-    size_t namelength=0, datalength=0;
-    rFile.read(reinterpret_cast<char*>(&namelength), 2);
-    rFile.read(reinterpret_cast<char*>(&datalength), 2);
+    clear();
+    if (!mFile.open(rFileName))
+    {
+        return false;
+    }
 
-    // Read full name
-    char *pNameBuffer = new char[namelength+1];
-    rFile.read(pNameBuffer, namelength);
-    pNameBuffer[namelength] = '\0';
-    HString fullName;
-    fullName.append(pNameBuffer);
-    delete[] pNameBuffer;
+    const char *pData = mFile.getData();
+    const size_t size = mFile.getSize();
+    if ((size < sizeof(SimulationPointFileHeader)) || (memcmp(pData, gSimulationPointMagic, sizeof(gSimulationPointMagic)) != 0))
+    {
+        mFile.close();
+        return loadLegacy(rFileName);
+    }
 
-    // Read data
-    double *pDataBuffer = new double[datalength];
-    rFile.read(reinterpret_cast<char*>(pDataBuffer), datalength*sizeof(double));
+    SimulationPointFileHeader header;
+    memcpy(&header, pData, sizeof(header));
+    if ((header.version < 1) || (header.version > gSimulationPointVersion) ||
+        (header.headerSize < sizeof(header)) || (header.headerSize > size) || (header.headerSize%8 != 0))
+    {
+        clear();
+        return false;
+    }
 
-    // Parse fullName and find port to write into
-    ComponentSystem *pSystem=pRootSystem;
-    Component* pComponent=0;
-    size_t b,e;
-    b = fullName.find_first_of('/');
-    while (true)
+    size_t pos = header.headerSize;
+    for (uint64_t r=0; r<header.numRecords; ++r)
     {
-        e = fullName.find_first_of('/', b+1);
-        // We did not find a component, then treat as port
-        if (e == HString::npos)
+        SimulationPointRecordHeader recordHeader;
+        if (size-pos < sizeof(recordHeader))
         {
-            HString pname = fullName.substr(b+1,e);
-            if (pComponent)
+            clear();
+            return false;
+        }
+        memcpy(&recordHeader, pData+pos, sizeof(recordHeader));
+        pos += sizeof(recordHeader);
+
+        const size_t nameSize = paddedLength(recordHeader.nameLength);
+        if ((size-pos < nameSize) || ((size-pos-nameSize)/sizeof(double) < recordHeader.numValues))
+        {
+            clear();
+            return false;
+        }
+
+        if ((recordHeader.type == PortRecord) || (recordHeader.type == ComponentStateRecord))
+        {
+            Record record;
+            record.type = RecordTypeT(recordHeader.type);
+            record.name = HString(pData+pos, recordHeader.nameLength);
+            record.valueIdx = (pos+nameSize)/sizeof(double);
+            record.numValues = size_t(recordHeader.numValues);
+            mRecords.push_back(record);
+        }
+        pos += nameSize+size_t(recordHeader.numValues)*sizeof(double);
+    }
+
+    mpValues = reinterpret_cast<const double*>(pData);
+    mVersion = header.version;
+    mTime = header.time;
+    return true;
+}
+
+//! @brief Load a file in the legacy format, which only contains node data
+bool SimulationPoint::loadLegacy(const HString &rFileName)
+{
+    std::ifstream file(rFileName.c_str(), std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    bool haveTime=false;
+    size_t pos=0;
+    while (buffer.size()-pos >= 2)
+    {
+        uint16_t identifier=0;
+        memcpy(&identifier, &buffer[pos], 2);
+        pos += 2;
+        if ((identifier == LEGACYTIMEIDENTIFIER) && (buffer.size()-pos >= sizeof(double)))
+        {
+            // Sub systems repeat the time, the first one belongs to the root system
+            if (!haveTime)
             {
-                Port* pPort = pComponent->getPort(pname);
-                if (pPort)
-                {
-                    std::vector<double> *pData = pPort->getDataVectorPtr();
-                    for (size_t d=0; d<std::min(datalength, pData->size()); ++d)
-                    {
-                        pData->at(d) = pDataBuffer[d];
-                    }
-                }
+                memcpy(&mTime, &buffer[pos], sizeof(double));
+                haveTime = true;
             }
+            pos += sizeof(double);
         }
-        // We have found a component name
-        else if (e < fullName.size()-1)
+        else if ((identifier == LEGACYPORTIDENTIFIER) && (buffer.size()-pos >= 4))
         {
-            HString cname = fullName.substr(b+1,e-1);
-            pComponent = pSystem->getSubComponent(cname);
-            if (pComponent && pComponent->isComponentSystem())
+            uint16_t nameLength=0, numValues=0;
+            memcpy(&nameLength, &buffer[pos], 2);
+            memcpy(&numValues, &buffer[pos+2], 2);
+            pos += 4;
+            if (buffer.size()-pos < nameLength+numValues*sizeof(double))
             {
-                pSystem = dynamic_cast<ComponentSystem*>(pComponent);
+                break;
             }
-            b=e;
-        }
 
-        // Exit loop when we are done
-        if (e == HString::npos)
+            Record record;
+            record.type = PortRecord;
+            record.name = HString(&buffer[pos], nameLength);
+            record.valueIdx = mLegacyValues.size();
+            record.numValues = numValues;
+            mRecords.push_back(record);
+            pos += nameLength;
+
+            mLegacyValues.resize(mLegacyValues.size()+numValues);
+            if (numValues > 0)
+            {
+                memcpy(&mLegacyValues[record.valueIdx], &buffer[pos], numValues*sizeof(double));
+            }
+            pos += numValues*sizeof(double);
+        }
+        else
         {
             break;
         }
     }
 
-    //! @todo need lots of error handling in code above
+    if (!haveTime && mRecords.empty())
+    {
+        clear();
+        return false;
+    }
+    mpValues = mLegacyValues.empty() ? 0 : &mLegacyValues[0];
+    mVersion = 0;
+    return true;
 }
 
-double readTimeData(std::ifstream &rFile)
+//! @brief Unload the simulation point
+void SimulationPoint::clear()
 {
-    // Read time
-    double time=0;
-    rFile.read(reinterpret_cast<char*>(&time), sizeof(double));
-    return time;
+    mRecords.clear();
+    mLegacyValues.clear();
+    mFile.close();
+    mpValues = 0;
+    mVersion = 0;
+    mTime = 0;
 }
 
+//! @brief Check if a simulation point has been loaded
+bool SimulationPoint::isLoaded() const
+{
+    return mFile.isOpen() || !mRecords.empty();
+}
 
-void saveSimulationPointInternal(ComponentSystem *pRootSystem, const HString &namePrefix, std::ofstream &rFile)
+//! @brief Returns the file format version, 0 means the legacy format without component states
+unsigned int SimulationPoint::getVersion() const
 {
-    //! @todo not sure if we should actually save/load the simulation time
-    writeTimeData(pRootSystem->getTime(), rFile);
-    std::vector<Component*> subcomps = pRootSystem->getSubComponents();
-    for (size_t c=0; c<subcomps.size(); ++c)
-    {
-        Component *pComp = subcomps[c];
+    return mVersion;
+}
 
-        std::vector<Port*> ports = pComp->getPortPtrVector();
-        for (size_t p=0; p<ports.size(); ++p)
+//! @brief Returns the simulation time of the root system when the simulation point was saved
+double SimulationPoint::getTime() const
+{
+    return mTime;
+}
+
+const double *SimulationPoint::getValues(const Record &rRecord) const
+{
+    return mpValues+rRecord.valueIdx;
+}
+
+//! @brief Write the saved node data into the ports of a model
+//! @details Ports that do not exist in the model are ignored. If the number of values differs, as many values as
+//! possible are written.
+//! @param [in] pRootSystem The root system of the model
+//! @returns The number of ports that were written
+size_t SimulationPoint::restoreNodeData(ComponentSystem *pRootSystem) const
+{
+    size_t numRestored=0;
+    for (size_t r=0; r<mRecords.size(); ++r)
+    {
+        const Record &rRecord = mRecords[r];
+        if (rRecord.type == PortRecord)
         {
-            writePortData(ports[p], namePrefix+pComp->getName()+'/', rFile);
+            Port *pPort = findPort(pRootSystem, rRecord.name);
+            double *pData = pPort ? pPort->getDataVectorPtr() : 0;
+            if (pData)
+            {
+                const double *pValues = getValues(rRecord);
+                const size_t n = std::min(rRecord.numValues, pPort->getNumDataVariables());
+                for (size_t d=0; d<n; ++d)
+                {
+                    pData[d] = pValues[d];
+                }
+                ++numRestored;
+            }
         }
+    }
+    return numRestored;
+}
 
-        if (pComp->isComponentSystem())
+//! @brief Restore the saved internal states of the components in a model
+//! @details This must be called after the model has been initialized, since initialization resets the states.
+//! If a component can not restore its state, it keeps its previous state and a warning is given.
+//! @param [in] pRootSystem The root system of the model
+//! @returns The number of components whose state was restored
+size_t SimulationPoint::restoreComponentStates(ComponentSystem *pRootSystem) const
+{
+    size_t numRestored=0;
+    ComponentStateWriter previousState;
+    for (size_t r=0; r<mRecords.size(); ++r)
+    {
+        const Record &rRecord = mRecords[r];
+        if (rRecord.type == ComponentStateRecord)
         {
-            saveSimulationPointInternal(dynamic_cast<ComponentSystem*>(pComp), namePrefix+pComp->getName()+'/', rFile);
+            Component *pComponent = findComponent(pRootSystem, rRecord.name);
+            if (!pComponent || (pComponent == pRootSystem))
+            {
+                pRootSystem->addWarningMessage("Could not find component: "+rRecord.name+" when restoring simulation point");
+                continue;
+            }
+
+            previousState.clear();
+            pComponent->saveState(previousState);
+
+            ComponentStateReader reader(getValues(rRecord), rRecord.numValues);
+            pComponent->restoreState(reader);
+            if (reader.hasFailed() || !reader.isAtEnd())
+            {
+                ComponentStateReader previousReader(previousState.getData().empty() ? 0 : &previousState.getData()[0], previousState.getNumValues());
+                pComponent->restoreState(previousReader);
+                pRootSystem->addWarningMessage("Could not restore the internal state of component: "+rRecord.name);
+            }
+            else
+            {
+                ++numRestored;
+            }
         }
     }
+    return numRestored;
 }
 
+//! @brief Continue a simulation from the simulation point
+//! @details The model must have been initialized with getTime() as start time. The node data and the internal
+//! component states are then restored, so that the following simulation continues as if it had never stopped.
+//! The start values logged during initialization are not changed.
+//! @param [in] pRootSystem The initialized root system of the model
+//! @returns False if nothing is loaded
+bool SimulationPoint::resume(ComponentSystem *pRootSystem) const
+{
+    if (!isLoaded())
+    {
+        return false;
+    }
+    if (pRootSystem->getTime() != mTime)
+    {
+        pRootSystem->addWarningMessage("The model was not initialized at the time of the simulation point, the restored simulation will not continue exactly");
+    }
+    restoreNodeData(pRootSystem);
+    restoreComponentStates(pRootSystem);
+    return true;
+}
+
+
+SimulationSnapshot::SimulationSnapshot()
+{
+    mTime = 0;
+}
 
-void hopsan::saveSimulationPoint(HString fileName, ComponentSystem *pRootSystem)
+//! @brief Remove the contents of the snapshot, the allocated memory is kept for the next snapshot
+void SimulationSnapshot::clear()
 {
-    std::ofstream file;
-    file.open(fileName.c_str());
-    if (file.is_open())
+    mComponentNames.clear();
+    mValues.clear();
+    mTime = 0;
+}
+
+//! @brief Check if the snapshot is empty, that is if no snapshot has been taken
+bool SimulationSnapshot::isEmpty() const
+{
+    return mValues.getNumValues() == 0;
+}
+
+//! @brief Returns the simulation time of the system the snapshot was taken from
+double SimulationSnapshot::getTime() const
+{
+    return mTime;
+}
+
+//! @brief Returns the number of values stored in the snapshot
+size_t SimulationSnapshot::getNumValues() const
+{
+    return mValues.getNumValues();
+}
+
+
+//! @brief Save a simulation point with node data and internal component states
+//! @param [in] fileName The file to write
+//! @param [in] pRootSystem The root system of the model
+//! @returns False if the file could not be written
+bool hopsan::saveSimulationPoint(HString fileName, ComponentSystem *pRootSystem)
+{
+    std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
     {
-        saveSimulationPointInternal(pRootSystem, "/", file);
+        return false;
     }
+
+    SimulationPointFileHeader header;
+    memcpy(header.magic, gSimulationPointMagic, sizeof(header.magic));
+    header.version = gSimulationPointVersion;
+    header.headerSize = sizeof(header);
+    header.numRecords = 0;
+    header.time = pRootSystem->getTime();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    ComponentStateWriter stateWriter;
+    header.numRecords = saveSimulationPointInternal(pRootSystem, "/", stateWriter, file);
+
+    // Rewrite the header now that the number of records is known
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
     file.close();
+    return !file.fail();
 }
 
-void hopsan::restoreSimulationPoint(HString fileName, ComponentSystem *pRootSystem, double &rTimeOffset)
+//! @brief Restore the node data of a simulation point, to be used as start values
+//! @details Call this before initialization and set the system to keep its values as start values.
+//! Internal component states are not restored, use resumeSimulationPoint() after initialization for that.
+//! @param [in] fileName The file to read
+//! @param [in] pRootSystem The root system of the model
+//! @param [out] rTimeOffset The simulation time when the simulation point was saved
+//! @returns False if the file could not be read
+bool hopsan::restoreSimulationPoint(HString fileName, ComponentSystem *pRootSystem, double &rTimeOffset)
 {
-    std::ifstream file;
-    file.open(fileName.c_str());
-    if (file.is_open())
+    SimulationPoint simulationPoint;
+    if (!simulationPoint.load(fileName))
     {
-        while (!file.eof())
-        {
-            // Read identifier from next package
-            size_t id = readIdentifier(file);
-            switch (id)
-            {
-            case TIMEIDENTIFIER:
-                rTimeOffset = readTimeData(file);
-                break;
-            case PORTIDENTIFIER:
-                readPortData(file, pRootSystem);
-                break;
-            default:
-                break;
-            }
-        }
+        return false;
     }
-    file.close();
+    rTimeOffset = simulationPoint.getTime();
+    simulationPoint.restoreNodeData(pRootSystem);
+    return true;
+}
+
+//! @brief Restore node data and internal component states of a simulation point into an initialized model
+//! @param [in] fileName The file to read
+//! @param [in] pRootSystem The root system of the model, initialized with the simulation point time as start time
+//! @returns False if the file could not be read
+//! @see SimulationPoint::resume
+bool hopsan::resumeSimulationPoint(HString fileName, ComponentSystem *pRootSystem)
+{
+    SimulationPoint simulationPoint;
+    if (!simulationPoint.load(fileName))
+    {
+        return false;
+    }
+    return simulationPoint.resume(pRootSystem);
 }
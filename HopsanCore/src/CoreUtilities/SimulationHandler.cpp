@@ -35,13 +35,227 @@
 #include "CoreUtilities/MultiThreadingUtilities.h"
 #include "ComponentSystem.h"
 
+#include <new>
+
 #if defined(HOPSANCORE_USEMULTITHREADING)
 #include <thread>
+#include <atomic>
 #endif
 
 using namespace hopsan;
 using namespace std;
 
+namespace hopsan {
+
+//! @brief Log sink that writes the results of one batch simulation instance to its columns in the shared result buffer
+class BatchLogSink : public LogSink
+{
+public:
+    BatchLogSink(BatchSimulationResults *pResults, const size_t instance) : mpResults(pResults), mInstance(instance) {}
+
+    bool open(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables)
+    {
+        HOPSAN_UNUSED(rSystemName)
+        if (!mpResults->setVariables(rVariables))
+        {
+            mLastError = "The batch instances do not log the same variables, or the result buffer could not be allocated";
+            return false;
+        }
+        mpResults->mNumSamples[mInstance] = 0;
+        return true;
+    }
+
+    void writeChunk(const double *pTime, const double *pValues, const size_t numSamples)
+    {
+        const size_t nVars = mpResults->getNumVariables();
+        size_t &rNumSamples = mpResults->mNumSamples[mInstance];
+        const size_t nWrite = std::min(numSamples, mpResults->getSampleCapacity()-rNumSamples);
+        double *pTimeColumn = mpResults->getColumnPtr(mInstance, 0);
+        for (size_t s=0; s<nWrite; ++s)
+        {
+            pTimeColumn[rNumSamples+s] = pTime[s];
+        }
+        for (size_t v=0; v<nVars; ++v)
+        {
+            double *pColumn = mpResults->getColumnPtr(mInstance, 1+v);
+            for (size_t s=0; s<nWrite; ++s)
+            {
+                pColumn[rNumSamples+s] = pValues[s*nVars+v];
+            }
+        }
+        rNumSamples += nWrite;
+    }
+
+    bool close() { return true; }
+
+private:
+    BatchSimulationResults *mpResults;
+    size_t mInstance;
+};
+
+}
+
+namespace {
+
+//! @brief Set a parameter value in a system or in one of its components, see BatchParameterValuesT for the name format
+//! @param[in] pSystem The root system
+//! @param[in] rName The full parameter name
+//! @param[in] rValue The new value
+//! @returns True if the parameter was found and set
+bool setBatchParameterValue(ComponentSystem *pSystem, const HString &rName, const HString &rValue)
+{
+    const size_t hashPos = rName.find('#');
+    if (hashPos == HString::npos)
+    {
+        return pSystem->setParameterValue(rName, rValue);
+    }
+
+    HString componentName = rName.substr(0, hashPos);
+    const HString parameterName = rName.substr(hashPos+1);
+    if (componentName == "self")
+    {
+        return pSystem->setParameterValue(parameterName, rValue);
+    }
+
+    // Search into subsystems
+    ComponentSystem *pCurrentSystem = pSystem;
+    size_t dollarPos = componentName.find('$');
+    while (dollarPos != HString::npos)
+    {
+        pCurrentSystem = pCurrentSystem->getSubComponentSystem(componentName.substr(0, dollarPos));
+        if (!pCurrentSystem)
+        {
+            return false;
+        }
+        componentName = componentName.substr(dollarPos+1);
+        dollarPos = componentName.find('$');
+    }
+    Component *pComponent = pCurrentSystem->getSubComponent(componentName);
+    return pComponent && pComponent->setParameterValue(parameterName, rValue);
+}
+
+}
+
+BatchSimulationResults::BatchSimulationResults()
+{
+    reset(0, 0);
+}
+
+//! @brief Returns the number of batch instances
+size_t BatchSimulationResults::getNumInstances() const
+{
+    return mNumInstances;
+}
+
+//! @brief Returns the number of logged variables in each instance (not counting the time)
+size_t BatchSimulationResults::getNumVariables() const
+{
+    return mVariables.size();
+}
+
+//! @brief Returns the length of each column, the largest number of log samples that an instance can have
+size_t BatchSimulationResults::getSampleCapacity() const
+{
+    return mSampleCapacity;
+}
+
+//! @brief Returns descriptions of the logged variables, in column order
+const std::vector<LogSinkVariable> &BatchSimulationResults::getVariables() const
+{
+    return mVariables;
+}
+
+//! @brief Returns the number of valid log samples for an instance
+size_t BatchSimulationResults::getNumSamples(const size_t instance) const
+{
+    return mNumSamples[instance];
+}
+
+//! @brief Returns whether the parameter values could be set and the instance was initialized and simulated without being aborted
+bool BatchSimulationResults::wasSuccessful(const size_t instance) const
+{
+    return mSuccessful[instance] != 0;
+}
+
+//! @brief Returns the time column of an instance, or 0 if there is no data
+const double *BatchSimulationResults::getTimeColumn(const size_t instance) const
+{
+    if (mData.empty() || (instance >= mNumInstances))
+    {
+        return 0;
+    }
+    return &mData[instance*(1+mVariables.size())*mSampleCapacity];
+}
+
+//! @brief Returns the column of a variable in an instance, or 0 if there is no data
+//! @param[in] instance The instance index
+//! @param[in] variable The variable index, in the order of getVariables()
+const double *BatchSimulationResults::getColumn(const size_t instance, const size_t variable) const
+{
+    if (mData.empty() || (instance >= mNumInstances) || (variable >= mVariables.size()))
+    {
+        return 0;
+    }
+    return &mData[(instance*(1+mVariables.size())+1+variable)*mSampleCapacity];
+}
+
+//! @brief Returns the whole buffer, see the class description for the layout
+const std::vector<double> &BatchSimulationResults::getData() const
+{
+    return mData;
+}
+
+//! @brief Clear the results, the buffer is allocated when the variables are known
+void BatchSimulationResults::reset(const size_t numInstances, const size_t sampleCapacity)
+{
+    mNumInstances = numInstances;
+    mSampleCapacity = sampleCapacity;
+    mHaveVariables = false;
+    mVariables.clear();
+    std::vector<double>().swap(mData);
+    mNumSamples.assign(numInstances, 0);
+    mSuccessful.assign(numInstances, 0);
+}
+
+//! @brief Set the variables logged by each instance, the first call allocates the buffer and later calls must give the same variables
+//! @returns False if the variables differ from the first call or if the buffer could not be allocated
+bool BatchSimulationResults::setVariables(const std::vector<LogSinkVariable> &rVariables)
+{
+    if (!mHaveVariables)
+    {
+        try
+        {
+            mData.resize(mNumInstances*(1+rVariables.size())*mSampleCapacity, 0.0);
+        }
+        catch (std::bad_alloc &)
+        {
+            return false;
+        }
+        mVariables = rVariables;
+        mHaveVariables = true;
+        return true;
+    }
+
+    if (rVariables.size() != mVariables.size())
+    {
+        return false;
+    }
+    for (size_t v=0; v<rVariables.size(); ++v)
+    {
+        if ((rVariables[v].systemHierarchy != mVariables[v].systemHierarchy) || (rVariables[v].componentName != mVariables[v].componentName) ||
+            (rVariables[v].portName != mVariables[v].portName) || (rVariables[v].variableName != mVariables[v].variableName))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double *BatchSimulationResults::getColumnPtr(const size_t instance, const size_t column)
+{
+    return &mData[(instance*(1+mVariables.size())+column)*mSampleCapacity];
+}
+
 bool SimulationHandler::initializeSystem(const double startT, const double stopT, ComponentSystem* pSystem)
 {
     if (pSystem->checkModelBeforeSimulation())
@@ -126,6 +340,97 @@ void SimulationHandler::finalizeSystem(std::vector<ComponentSystem*> &rSystemVec
     }
 }
 
+//! @brief Simulates independent systems in parallel, each with its own parameter values, and gathers the results in a shared buffer
+//! @details Intended for parameter sweeps and Monte-Carlo runs, where the systems are copies of the same model created by
+//! HopsanEssentials::loadHMFModelFileCopies(). The parameter values are set and the systems are initialized one at a time, then the
+//! threads in the simulation thread pool simulate them, each thread taking the next system that has not been simulated yet.
+//! Logged data is written to the result buffer instead of being kept in the systems, use ComponentSystem::setLogOnlyVariables()
+//! to limit the amount of data. The systems are finalized afterwards.
+//! @param[in] startT Start time for all systems
+//! @param[in] stopT Stop time for all systems
+//! @param[in] nDesiredThreads Desired number of threads, 0 means one per processor core
+//! @param[in] rSystemVector The systems to simulate
+//! @param[in] rParameterValues Parameter values for each system, systems without an entry use the values from the model
+//! @param[out] rResults The results, one instance per system
+//! @returns True if all systems were simulated successfully
+bool SimulationHandler::simulateBatch(const double startT, const double stopT, const size_t nDesiredThreads, std::vector<ComponentSystem*> &rSystemVector,
+                                      const std::vector<BatchParameterValuesT> &rParameterValues, BatchSimulationResults &rResults)
+{
+    const size_t nSystems = rSystemVector.size();
+    size_t sampleCapacity = 0;
+    for (size_t i=0; i<nSystems; ++i)
+    {
+        sampleCapacity = max(sampleCapacity, rSystemVector[i]->getNumLogSamples());
+    }
+    rResults.reset(nSystems, sampleCapacity);
+
+    // Set parameters and initialize, one system at a time
+    std::vector<BatchLogSink*> sinks(nSystems);
+    std::vector<char> initialized(nSystems, 0);
+    for (size_t i=0; i<nSystems; ++i)
+    {
+        ComponentSystem *pSystem = rSystemVector[i];
+        bool parametersOk = true;
+        if (i < rParameterValues.size())
+        {
+            for (size_t p=0; p<rParameterValues[i].size(); ++p)
+            {
+                if (!setBatchParameterValue(pSystem, rParameterValues[i][p].first, rParameterValues[i][p].second))
+                {
+                    pSystem->addErrorMessage("Could not set batch parameter: "+rParameterValues[i][p].first);
+                    parametersOk = false;
+                }
+            }
+        }
+        sinks[i] = new BatchLogSink(&rResults, i);
+        pSystem->setLogSink(sinks[i], false);
+        initialized[i] = parametersOk && initializeSystem(startT, stopT, pSystem);
+    }
+
+    // Simulate
+#if defined(HOPSANCORE_USEMULTITHREADING)
+    const size_t nThreads = min(determineActualNumberOfThreads(nDesiredThreads), nSystems);
+    std::atomic<size_t> nextSystem(0);
+    std::vector< std::function<void()> > tasks(nThreads, [&]()
+    {
+        for (size_t i=nextSystem++; i<nSystems; i=nextSystem++)
+        {
+            if (initialized[i])
+            {
+                rSystemVector[i]->simulate(stopT);
+            }
+        }
+    });
+
+    SimulationThreadPool temporaryPool;
+    SimulationThreadPool *pPool = gpInternalCoreSimulationThreadPool ? gpInternalCoreSimulationThreadPool : &temporaryPool;
+    pPool->run(tasks);
+#else
+    HOPSAN_UNUSED(nDesiredThreads)
+    for (size_t i=0; i<nSystems; ++i)
+    {
+        if (initialized[i])
+        {
+            rSystemVector[i]->simulate(stopT);
+        }
+    }
+#endif
+
+    // Finalize, this writes the remaining log data
+    bool allOk = true;
+    for (size_t i=0; i<nSystems; ++i)
+    {
+        ComponentSystem *pSystem = rSystemVector[i];
+        const bool ok = initialized[i] && !pSystem->wasSimulationAborted();
+        pSystem->finalize();
+        pSystem->setLogSink(0);
+        delete sinks[i];
+        rResults.mSuccessful[i] = ok;
+        allOk = allOk && ok;
+    }
+    return allOk;
+}
+
 //! @brief Distributes component system pointers evenly over one vector per thread, depending on their simulation time
 //! @param[in] rSystemVector Vector to distribute
 //! @param[in] nThreads Number of threads to distribute for
@@ -184,7 +489,16 @@ bool SimulationHandler::simulateMultipleSystemsMultiThreaded(const double startT
 #if defined(HOPSANCORE_USEMULTITHREADING)
     size_t nThreads = determineActualNumberOfThreads(nDesiredThreads);              //Calculate how many threads to actually use
 
-    if(!noChanges)
+    // Reuse the distribution from the previous simulation if the systems have not changed and the number of threads is the same
+    size_t nDistributedSystems = 0;
+    for(size_t t=0; t<mSplitSystemVector.size(); ++t)
+    {
+        nDistributedSystems += mSplitSystemVector[t].size();
+    }
+    const bool reuseDistribution = noChanges && (nDistributedSystems == tempSystemVector.size()) &&
+                                   (mSplitSystemVector.size() == min(nThreads, tempSystemVector.size()));
+
+    if(!reuseDistribution)
     {
         mSplitSystemVector.clear();
         for(size_t i=0; i<tempSystemVector.size(); ++i)                     //Loop through the systems, set start time, log nodes and measure simulation time
@@ -196,19 +510,18 @@ bool SimulationHandler::simulateMultipleSystemsMultiThreaded(const double startT
         mSplitSystemVector = distributeSystems(tempSystemVector, nThreads); //Distribute systems evenly over split vectors
     }
 
-
-    std::thread *tt = new std::thread[nThreads];  //Create simulation threads
-    for (size_t t=0; t<nThreads; ++t)             //Execute simulation
-    {
-        tt[t] = std::thread(simWholeSystems,
-                            mSplitSystemVector[t],
-                            stopT);
-    }
-    for(size_t c=0; c<nThreads; ++c)              //Wait for all tasks to finish
+    std::vector< std::function<void()> > tasks;     //Create simulation tasks, one per split vector
+    for (size_t t=0; t<mSplitSystemVector.size(); ++t)
     {
-        tt[c].join();
+        tasks.push_back(std::bind(simWholeSystems,
+                                  mSplitSystemVector[t],
+                                  stopT));
     }
-    delete[] tt;                                                 //Clean up
+
+    // Run the tasks in the persistent simulation threads, or in temporary threads if there is no thread pool
+    SimulationThreadPool temporaryPool;
+    SimulationThreadPool *pPool = gpInternalCoreSimulationThreadPool ? gpInternalCoreSimulationThreadPool : &temporaryPool;
+    pPool->run(tasks);
 
     bool aborted=false;
     for(size_t i=0; i<tempSystemVector.size(); ++i)
@@ -28,9 +28,59 @@
 #include <cstring>
 #include <string>
 #include <limits>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <algorithm>
 
 using namespace hopsan;
 
+namespace {
+
+//! @brief The header in front of the characters in an HString buffer
+//! @details Copies of a string share the same buffer, it is copied before it is modified (copy-on-write).
+//! A buffer that has handed out a non-const character reference is no longer shared, since that reference
+//! could be used to modify the text of all copies.
+struct BufferHeader
+{
+    std::atomic<size_t> refCount;
+    bool shareable;
+};
+
+// Keeps the characters 8-byte aligned
+const size_t gHeaderSize = (sizeof(BufferHeader)+7) & ~size_t(7);
+
+inline BufferHeader *getHeader(const char *pData)
+{
+    return reinterpret_cast<BufferHeader*>(const_cast<char*>(pData)-gHeaderSize);
+}
+
+//! @brief Allocates a buffer for len characters and the terminating null
+char *allocateBuffer(const size_t len)
+{
+    char *pMemory = static_cast<char*>(malloc(gHeaderSize+len+1));
+    BufferHeader *pHeader = new (pMemory) BufferHeader;
+    pHeader->refCount = 1;
+    pHeader->shareable = true;
+    return pMemory+gHeaderSize;
+}
+
+void releaseBuffer(char *pData)
+{
+    if (pData)
+    {
+        BufferHeader *pHeader = getHeader(pData);
+        if (pHeader->refCount.fetch_sub(1) == 1)
+        {
+            pHeader->~BufferHeader();
+            free(pHeader);
+        }
+    }
+}
+
+}
+
 const size_t hopsan::HString::npos = std::numeric_limits<size_t>::max();
 
 HString::HString()
@@ -76,12 +126,12 @@ HString::HString(const int value)
     //! @todo maybe support constructing HString directly from int, long int / double and such types
 }
 
-//! @brief Copy constructor
+//! @brief Copy constructor, the copy shares the buffer with rOther until one of them is modified
 HString::HString(const HString &rOther)
 {
     mpDataBuffer=0;
     mSize=0;
-    setString(rOther.c_str());
+    *this = rOther;
 }
 
 HString::HString(const HString &rOther, size_t pos, size_t len)
@@ -107,11 +157,14 @@ HString::HString(const HString &rOther, size_t pos, size_t len)
         len = rOther.size()-pos;
     }
 
-    // Reallocate memory and copy string
-    mpDataBuffer = static_cast<char*>(realloc(mpDataBuffer,len+1));
-    mSize = len;
-    strncpy(mpDataBuffer, rOther.c_str()+pos, len);
-    mpDataBuffer[mSize] = '\0';
+    if (len == rOther.size())
+    {
+        *this = rOther;
+    }
+    else
+    {
+        setString(rOther.c_str()+pos, len);
+    }
 }
 
 //! @brief Set the string by copying const char*
@@ -128,8 +181,12 @@ void HString::setString(const char *str, const size_t len)
 {
     if (len>0)
     {
-        mpDataBuffer = static_cast<char*>(realloc(mpDataBuffer,len+1));
-        strcpy(mpDataBuffer, str);
+        // Copy to a new buffer first, str may point into the current buffer
+        char *pNewBuffer = allocateBuffer(len);
+        memcpy(pNewBuffer, str, len);
+        pNewBuffer[len] = '\0';
+        releaseBuffer(mpDataBuffer);
+        mpDataBuffer = pNewBuffer;
         mSize = len;
     }
     else
@@ -140,23 +197,28 @@ void HString::setString(const char *str, const size_t len)
 
 HString &HString::append(const char *str)
 {
-    size_t s = strlen(str);
+    const size_t s = strlen(str);
     if (s>0)
     {
-        s += size();
-        mpDataBuffer = static_cast<char*>(realloc(mpDataBuffer,s+1));
-        strcpy(mpDataBuffer+size(), str);
-        mSize = s;
+        if (mpDataBuffer && (str >= mpDataBuffer) && (str <= mpDataBuffer+mSize))
+        {
+            // Appending a part of itself, the buffer may move when it is resized
+            const HString copy(str, s);
+            return append(copy.c_str());
+        }
+        const size_t oldSize = mSize;
+        makeUniqueWithSize(oldSize+s);
+        memcpy(mpDataBuffer+oldSize, str, s+1);
     }
     return *this;
 }
 
 HString &HString::append(const char chr)
 {
-    mpDataBuffer = static_cast<char*>(realloc(mpDataBuffer,size()+2));
-    mpDataBuffer[mSize] = chr;
-    mSize = mSize+1;
-    mpDataBuffer[mSize] = '\0';
+    const size_t oldSize = mSize;
+    makeUniqueWithSize(oldSize+1);
+    mpDataBuffer[oldSize] = chr;
+    mpDataBuffer[oldSize+1] = '\0';
 
     return *this;
 }
@@ -396,6 +458,7 @@ char HString::front() const
 
 char &HString::front()
 {
+    makeUnshareable();
     return mpDataBuffer[0];
 }
 
@@ -406,6 +469,7 @@ char HString::back() const
 
 char &HString::back()
 {
+    makeUnshareable();
     return mpDataBuffer[mSize-1];
 }
 
@@ -451,6 +515,7 @@ HString &HString::operator +=(const char rhs)
 
 char &HString::operator [](const size_t idx)
 {
+    makeUnshareable();
     return mpDataBuffer[idx];
 }
 
@@ -467,34 +532,81 @@ HString &HString::operator =(const char *rhs)
 
 HString &HString::operator =(const char rhs)
 {
-    setString(" ");
-    mpDataBuffer[0]=rhs;
+    setString(&rhs, 1);
     return *this;
 }
 
+//! @brief Assignment, shares the buffer with rhs until one of them is modified
 HString& HString::operator=(const HString &rhs)
 {
-    setString(rhs.c_str());
+    if (rhs.mpDataBuffer != mpDataBuffer)
+    {
+        if (rhs.mpDataBuffer && getHeader(rhs.mpDataBuffer)->shareable)
+        {
+            getHeader(rhs.mpDataBuffer)->refCount.fetch_add(1);
+            releaseBuffer(mpDataBuffer);
+            mpDataBuffer = rhs.mpDataBuffer;
+            mSize = rhs.mSize;
+        }
+        else
+        {
+            setString(rhs.c_str(), rhs.size());
+        }
+    }
     return *this;
 }
 
 //! @brief Clear the string
 void HString::clear()
 {
-    if (mpDataBuffer)
-    {
-        free(mpDataBuffer);
-        mSize = 0;
-        mpDataBuffer=0;
-    }
+    releaseBuffer(mpDataBuffer);
+    mSize = 0;
+    mpDataBuffer=0;
 }
 
 void HString::replace(const size_t pos, const size_t len, const char *str)
 {
     //! @todo do this properly without using local string
-    std::string temp = mpDataBuffer;
+    std::string temp = c_str();
     temp.replace(pos, len, str);
-    this->setString(temp.c_str());
+    this->setString(temp.c_str(), temp.size());
+}
+
+//! @brief Make sure that the buffer is not shared and can hold newSize characters, the size is set to newSize
+//! @details The contents up to the smallest of the old and new size is kept, the terminating null is not written
+void HString::makeUniqueWithSize(const size_t newSize)
+{
+    if (mpDataBuffer && (getHeader(mpDataBuffer)->refCount.load() == 1))
+    {
+        char *pMemory = static_cast<char*>(realloc(getHeader(mpDataBuffer), gHeaderSize+newSize+1));
+        mpDataBuffer = pMemory+gHeaderSize;
+    }
+    else
+    {
+        char *pNewBuffer = allocateBuffer(newSize);
+        if (mpDataBuffer)
+        {
+            memcpy(pNewBuffer, mpDataBuffer, std::min(mSize, newSize)+1);
+        }
+        releaseBuffer(mpDataBuffer);
+        mpDataBuffer = pNewBuffer;
+    }
+    getHeader(mpDataBuffer)->shareable = true;
+    mSize = newSize;
+}
+
+//! @brief Stop sharing the buffer, used before a non-const character reference is handed out
+void HString::makeUnshareable()
+{
+    if (mpDataBuffer)
+    {
+        if (getHeader(mpDataBuffer)->refCount.load() > 1)
+        {
+            makeUniqueWithSize(mSize);
+            mpDataBuffer[mSize] = '\0';
+        }
+        getHeader(mpDataBuffer)->shareable = false;
+    }
 }
 
 HString &HString::replace(const char *oldstr, const char *newstr)
@@ -539,3 +651,42 @@ HVector<HString> HString::split(const char delim) const
   }
   return parts;
 }
+
+
+//! @brief Returns a copy of the string that shares its buffer with all other interned copies of the same text
+//! @details Used for text that is repeated in every instance of a component type, such as descriptions and units,
+//! so that it is only stored once no matter how many components or model instances that are created.
+//! Strings that are only referenced by the pool are released when the pool has doubled in size since it was last pruned.
+//! @param [in] rString The string to intern
+//! @returns A copy of the interned string
+HString hopsan::internString(const HString &rString)
+{
+    if (rString.empty())
+    {
+        return HString();
+    }
+    static std::mutex poolMutex;
+    static std::set<HString> pool;
+    static size_t pruneSize = 1024;
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    // A buffer that is only referenced by the pool can not be referenced again except through the pool, so it is safe to release it here
+    if (pool.size() >= pruneSize)
+    {
+        std::set<HString>::iterator it = pool.begin();
+        while (it != pool.end())
+        {
+            if (getHeader(it->c_str())->refCount.load() == 1)
+            {
+                it = pool.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        pruneSize = std::max(size_t(1024), 2*pool.size());
+    }
+
+    return *pool.insert(rString).first;
+}
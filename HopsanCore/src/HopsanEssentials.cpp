@@ -37,6 +37,7 @@
 #include "CoreUtilities/HmfLoader.h"
 #include "CoreUtilities/LoadExternal.h"
 #include "CoreUtilities/HopsanCoreMessageHandler.h"
+#include "CoreUtilities/MultiThreadingUtilities.h"
 #include "Quantities.h"
 #include <string.h>
 #include <stdio.h>
@@ -92,6 +93,10 @@ HopsanEssentials::HopsanEssentials()
     {
         mpQuantityRegister = new QuantityRegister;
         gpInternalCoreQuantityRegister = mpQuantityRegister;
+#if defined(HOPSANCORE_USEMULTITHREADING)
+        // The simulation threads are shared by all instances and kept until the last instance is destroyed
+        gpInternalCoreSimulationThreadPool = new SimulationThreadPool;
+#endif
     }
     else
     {
@@ -156,6 +161,10 @@ HopsanEssentials::~HopsanEssentials()
     {
         delete mpQuantityRegister;
         gpInternalCoreQuantityRegister = 0;
+#if defined(HOPSANCORE_USEMULTITHREADING)
+        delete gpInternalCoreSimulationThreadPool;
+        gpInternalCoreSimulationThreadPool = 0;
+#endif
         closeCoreLogFile();
     }
 
@@ -336,6 +345,19 @@ ComponentSystem* HopsanEssentials::loadHMFModelFile(const char *filePath, double
     return loadHopsanModelFile(filePath, this, rStartTime, rStopTime);
 }
 
+//! @brief This function is used to load a HMF model file through a binary model cache file
+//! @details The cache is used if it is up to date with the model file and the loaded libraries, otherwise the model file
+//! is loaded and the cache file is rewritten
+//! @param [in] filePath The path to the HMF file
+//! @param [in] cacheFilePath The path to the model cache file
+//! @param [out] rStartTime A reference to the starttime variable
+//! @param [out] rStopTime A reference to the stoptime variable
+//! @returns A pointer to the root system of the loaded model
+ComponentSystem* HopsanEssentials::loadHMFModelFileCached(const char *filePath, const char *cacheFilePath, double &rStartTime, double &rStopTime)
+{
+    return loadHopsanModelFileCached(filePath, cacheFilePath, this, rStartTime, rStopTime);
+}
+
 ComponentSystem* HopsanEssentials::loadHMFModel(const std::vector<unsigned char> xmlVector)
 {
     return loadHopsanModel(xmlVector, this);
@@ -351,6 +373,19 @@ ComponentSystem* HopsanEssentials::loadHMFModel(const char *xmlString, double &r
     return loadHopsanModel(xmlString, this, rStartTime, rStopTime);
 }
 
+//! @brief This function is used to load several independent copies of a HMF model file, for example for batch simulation
+//! @details The file is only read and parsed once, and each copy is built from the parsed model
+//! @param [in] filePath The path to the HMF file
+//! @param [in] nCopies The number of copies to create
+//! @param [out] rSystems The root systems of the copies, empty if loading failed
+//! @param [out] rStartTime A reference to the starttime variable
+//! @param [out] rStopTime A reference to the stoptime variable
+//! @returns True if all copies were loaded
+bool HopsanEssentials::loadHMFModelFileCopies(const char *filePath, const size_t nCopies, std::vector<ComponentSystem*> &rSystems, double &rStartTime, double &rStopTime)
+{
+    return loadHopsanModelFileCopies(filePath, this, nCopies, rSystems, rStartTime, rStopTime);
+}
+
 SimulationHandler *HopsanEssentials::getSimulationHandler()
 {
     return &mSimulationHandler;
@@ -425,6 +460,13 @@ void HopsanEssentials::getExternalComponentLibNames(std::vector<HString> &rLibNa
     mpExternalLoader->getLoadedLibNames(rLibNames);
 }
 
+//! @brief Returns the file paths of the loaded external libraries
+//! @param [out] rLibPaths Reference to vector that will contain the lib paths
+void HopsanEssentials::getExternalComponentLibPaths(std::vector<HString> &rLibPaths)
+{
+    mpExternalLoader->getLoadedLibPaths(rLibPaths);
+}
+
 //! @brief Returns the path to the library file from where specified component is loaded
 //! @param rTypeName Type name of component
 //! @param rLibPath Reference string where path is stored
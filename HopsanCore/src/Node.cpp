@@ -39,6 +39,7 @@
 #include <cassert>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include "Node.h"
 #include "CoreUtilities/HopsanCoreMessageHandler.h"
 #include "Port.h"
@@ -67,8 +68,8 @@ using namespace hopsan;
 Node::Node(const size_t datalength)
 {
     // Make sure clear (should not really be needed)
-    mDataValues.clear();
-    mDataStorage.clear();
+    mLocalDataValues.clear();
+    mLogDataStore.clear();
     mConnectedPorts.clear();
 
     // Init pointer
@@ -79,7 +80,8 @@ Node::Node(const size_t datalength)
 
     // Resize
     mDataDescriptions.resize(datalength);
-    mDataValues.resize(datalength,0.0);
+    mLocalDataValues.resize(datalength,0.0);
+    mpDataValues = mLocalDataValues.data();
 
     // Default disabled logging
     setDoLogIfEnabled(false);
@@ -108,19 +110,54 @@ const HString &Node::getNodeType() const
 //! @brief Returns the total number of variables in a node
 size_t Node::getNumDataVariables() const
 {
-    return mDataValues.size();
+    return mLocalDataValues.size();
 }
 
 
 double *Node::getDataPtr(const size_t data_type)
 {
-    return &mDataValues[data_type];
+    return &mpDataValues[data_type];
+}
+
+
+//! @brief Change the number of data variables in the node
+//! @details If the data values have been packed into a system node data arena they are first moved back to local storage,
+//! they will be packed again the next time the owner system is initialized
+//! @param [in] numValues The new number of data values
+void Node::resizeDataValues(const size_t numValues)
+{
+    relocateDataValues(0);
+    mLocalDataValues.resize(numValues, 0.0);
+    mpDataValues = mLocalDataValues.data();
+}
+
+
+//! @brief Move the node data values to new storage, the current values are copied
+//! @param [in] pStorage The new storage (must fit all data values), or 0 to move back to the node local storage
+void Node::relocateDataValues(double *pStorage)
+{
+    if (!pStorage)
+    {
+        pStorage = mLocalDataValues.data();
+    }
+    if (pStorage != mpDataValues)
+    {
+        std::copy(mpDataValues, mpDataValues+mLocalDataValues.size(), pStorage);
+        mpDataValues = pStorage;
+    }
+}
+
+
+//! @brief Check if the node data values are kept in the node local storage (not in a system node data arena)
+bool Node::hasLocalDataValues() const
+{
+    return (mpDataValues == mLocalDataValues.data());
 }
 
 
 void Node::setNiceName(const HString &rNicename)
 {
-    mNiceName = rNicename;
+    mNiceName = internString(rNicename);
 }
 
 
@@ -139,8 +176,8 @@ const HString &Node::getNiceName() const
 void Node::setDataCharacteristics(const size_t id, const HString &rName, const HString &rShortname, const HString &rQuantityOrUnit, const NodeDataVariableTypeEnumT vartype)
 {
     mDataDescriptions[id].id = id;
-    mDataDescriptions[id].name = rName;
-    mDataDescriptions[id].shortname = rShortname;
+    mDataDescriptions[id].name = internString(rName);
+    mDataDescriptions[id].shortname = internString(rShortname);
     mDataDescriptions[id].varType = vartype;
     mDataDescriptions[id].userModifiableQuantity = false;
 
@@ -148,13 +185,13 @@ void Node::setDataCharacteristics(const size_t id, const HString &rName, const H
     // If bu empty then, rUnit was not a quantity
     if (bu.empty())
     {
-        mDataDescriptions[id].unit = rQuantityOrUnit;
+        mDataDescriptions[id].unit = internString(rQuantityOrUnit);
     }
     // Else rUnit was actually a valid Quantity
     else
     {
-        mDataDescriptions[id].quantity = rQuantityOrUnit;
-        mDataDescriptions[id].unit = bu;
+        mDataDescriptions[id].quantity = internString(rQuantityOrUnit);
+        mDataDescriptions[id].unit = internString(bu);
     }
 }
 
@@ -234,7 +271,7 @@ void Node::copyNodeDataValuesTo(Node *pOtherNode) const
         for(size_t i=0; i<pOtherNode->getNumDataVariables(); ++i)
         {
             //! @todo look over if all vector positions should be set or not.
-            pOtherNode->mDataValues[i] = mDataValues[i];
+            pOtherNode->mpDataValues[i] = mpDataValues[i];
         }
         setTLMNodeDataValuesTo(pOtherNode); //Handles Wave, imp variables and similar
     }
@@ -259,27 +296,37 @@ void Node::setTLMNodeDataValuesTo(Node* /*pOtherNode*/) const
 
 
 //! @brief Pre allocate memory for the needed amount of log data
-void Node::preAllocateLogSpace(const size_t nLogSlots)
+//! @param[in] nLogSlots The number of log slots
+//! @param[in] rLogDataIds Which data ids to log (one flag per data id), if empty all data ids are logged
+void Node::preAllocateLogSpace(const size_t nLogSlots, const std::vector<bool> &rLogDataIds)
 {
     // Don't try to allocate if we are not going to log
     if (mDoLog)
     {
-        mDataStorage.resize(nLogSlots, vector<double>(mDataValues.size()));
+        mLogDataStore.allocate(mLocalDataValues.size(), nLogSlots, rLogDataIds);
     }
 }
 
 
-//! @brief Copy current data vector into log storage at given logslot
+//! @brief Copy current data values into log storage at given logslot
 //! @warning No bounds check is done
 void Node::logData(const size_t logSlot)
 {
     if (mDoLog)
     {
-        mDataStorage[logSlot] = mDataValues;
+        mLogDataStore.logSample(logSlot, mpDataValues);
     }
 }
 
 
+//! @brief Write log samples that are still buffered to the log storage
+//! @note Must be called from the thread that logs the data
+void Node::flushLogData()
+{
+    mLogDataStore.flush();
+}
+
+
 //! @brief Returns a pointer to the component with the write port in the node.
 //! If connection is ok, any node can only have one write port. If no write port exists, a null pointer is returned.
 Component *Node::getWritePortComponentPtr() const
@@ -377,7 +424,7 @@ void Node::setDoLogIfEnabled(bool doLog)
     else
     {
         mDoLog = false;
-        mDataStorage.clear();
+        mLogDataStore.clear();
     }
 }
 
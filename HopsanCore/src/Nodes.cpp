@@ -93,7 +93,7 @@ void NodeSignalND::setSignalNumDimensions(size_t numDims)
 {
     // Resize
     mDataDescriptions.resize(numDims);
-    mDataValues.resize(numDims,0.0);
+    resizeDataValues(numDims);
 
     // Set name
     HString nicename = "signal"+to_hstring(numDims)+"d";
@@ -42,10 +42,23 @@
 #include <sstream>
 #include <algorithm>
 #include <iostream>
+#include <atomic>
 
 using namespace hopsan;
 using namespace std;
 
+namespace {
+
+//! @brief Revision of the parameter structure, changed when any parameter is added, removed or renamed or a component changes system
+//! @details References to other parameters are resolved by name, so any of these changes may change what a name refers to.
+//! Cached parameter values that were evaluated under another revision are evaluated again.
+std::atomic<size_t> gParameterStructureRevision(0);
+
+//! @brief The parameter that is being evaluated in this thread, other parameters that are evaluated meanwhile are its dependencies
+thread_local ParameterEvaluator *tpEvaluatingParameter = 0;
+
+}
+
 //! @class hopsan::Parameter
 //! @brief The Parameter class implements the parameter used in the container class Parameters
 //!
@@ -66,20 +79,36 @@ ParameterEvaluator::ParameterEvaluator(const HString &rName, const HString &rVal
                                        const HString &rType, const bool internal, void* pDataPtr, ParameterEvaluatorHandler* pParameterEvalHandler)
 {
     mDepthCounter=0;
-    mParameterName = rName;
+    // Texts that are the same for all instances of a component type are interned, so that they are only stored once
+    mParameterName = internString(rName);
     mParameterValue = rValue;
-    mDescription = rDescription;
-    mType = rType;
-    mQuantity = rQuantity;
-    mUnit = rUnit;
+    mDescription = internString(rDescription);
+    setType(rType);
+    mQuantity = internString(rQuantity);
+    mUnit = internString(rUnit);
     mTriggersReconfiguration = false;
     mInternal = internal;
 
+    mpExpression = 0;
+    mExpressionOK = false;
+    mIsCached = false;
+    mCachedSuccess = false;
+    mCachedDouble = 0;
+    mCachedInt = 0;
+    mCachedBool = false;
+    mRevision = 0;
+    mDependencyRevision = 0;
+
     mpData = pDataPtr;
     mpParameterEvaluatorHandler = pParameterEvalHandler;
     evaluate();
 }
 
+ParameterEvaluator::~ParameterEvaluator()
+{
+    delete mpExpression;
+}
+
 
 //! @brief Returns a pointer directly to the parameter data variable
 //! @warning Don't use this function unless YOU REALLY KNOW WHAT YOU ARE DOING
@@ -99,19 +128,19 @@ bool ParameterEvaluator::setParameter(const HString &rValue, const HString &rDes
     bool oldInternal = mInternal;
     if(!rDescription.empty())
     {
-        mDescription = rDescription;
+        mDescription = internString(rDescription);
     }
     if (!rQuantity.empty())
     {
-        mQuantity = rQuantity;
+        mQuantity = internString(rQuantity);
     }
     if(!rUnit.empty())
     {
-        mUnit = rUnit;
+        mUnit = internString(rUnit);
     }
     if(!rType.empty())
     {
-        mType = rType;
+        setType(rType);
     }
     mInternal = internal;
     success = setParameterValue(rValue, pNeedEvaluation);
@@ -119,6 +148,7 @@ bool ParameterEvaluator::setParameter(const HString &rValue, const HString &rDes
     {
         *pNeedEvaluation = this;
         mParameterValue = rValue;
+        invalidate();
     }
     else if(!success)
     {
@@ -126,8 +156,9 @@ bool ParameterEvaluator::setParameter(const HString &rValue, const HString &rDes
         mDescription = oldDescription;
         mQuantity = oldQuantity;
         mUnit = oldUnit;
-        mType = oldType;
+        setType(oldType);
         mInternal = oldInternal;
+        invalidate();
     }
     return success;
 }
@@ -144,11 +175,13 @@ bool ParameterEvaluator::setParameterValue(const HString &rValue, ParameterEvalu
 
     HString oldValue = mParameterValue;
     mParameterValue = rValue;
+    invalidate();
     HString evalResult = rValue;
     success = evaluate(evalResult);
     if(!success && !force)
     {
         mParameterValue = oldValue;
+        invalidate();
     }
 
     if (ppNeedEvaluation) {
@@ -180,8 +213,7 @@ const HString &ParameterEvaluator::getType() const
 //! @see evaluate(HString &result)
 bool ParameterEvaluator::evaluate()
 {
-    HString dummy;
-    return evaluate(dummy);
+    return evaluateCached(0);
 }
 
 bool ParameterEvaluator::refreshParameterValueText()
@@ -189,19 +221,19 @@ bool ParameterEvaluator::refreshParameterValueText()
     if (mpData)
     {
         stringstream ss;
-        if(mType=="double")
+        if(mTypeId==DoubleType)
         {
             ss << *static_cast<double*>(mpData);
         }
-        else if(mType=="integer")
+        else if(mTypeId==IntegerType)
         {
             ss << *static_cast<int*>(mpData);
         }
-        else if(mType=="conditional")
+        else if(mTypeId==ConditionalType)
         {
             ss << *static_cast<int*>(mpData);//mConditions[*static_cast<int*>(mpData)];
         }
-        else if(mType=="bool")
+        else if(mTypeId==BoolType)
         {
             if (*static_cast<bool*>(mpData))
             {
@@ -212,7 +244,7 @@ bool ParameterEvaluator::refreshParameterValueText()
                 ss << "false";
             }
         }
-        else if(mType=="string" || mType=="textblock" || mType=="filepath")
+        else if(mTypeId==StringType)
         {
             ss << *static_cast<string*>(mpData);
         }
@@ -221,6 +253,7 @@ bool ParameterEvaluator::refreshParameterValueText()
             return false;
         }
         mParameterValue = ss.str().c_str();
+        invalidate();
         return true;
     }
     return false;
@@ -234,6 +267,130 @@ bool ParameterEvaluator::refreshParameterValueText()
 //! This function is used by Parameters
 //! @see evaluate()
 bool ParameterEvaluator::evaluate(HString &rResult)
+{
+    return evaluateCached(&rResult);
+}
+
+//! @brief Evaluate the parameter, reusing the result of the last evaluation if neither the parameter nor anything it depends on has changed
+//! @details The parameters that are used during an evaluation are recorded as dependencies, together with their revisions. Together
+//! they form a dependency graph that is evaluated depth first, so when a system parameter changes only the parameters that depend on it are
+//! evaluated again. The others only write their cached typed value to the data variable.
+//! @param [out] pResult The result of the evaluation, may be 0
+//! @return true if success, otherwise false
+bool ParameterEvaluator::evaluateCached(HString *pResult)
+{
+    ParameterEvaluator *pDependent = tpEvaluatingParameter;
+    if (isUpToDate())
+    {
+        writeCachedValue();
+    }
+    else
+    {
+        mIsCached = false;
+        mDependencies.clear();
+        mDependencyRevision = gParameterStructureRevision;
+        tpEvaluatingParameter = this;
+        HString result;
+        const bool success = evaluateValue(result);
+        tpEvaluatingParameter = pDependent;
+
+        if ((success != mCachedSuccess) || (result != mCachedResult))
+        {
+            ++mRevision;
+        }
+        mCachedSuccess = success;
+        mCachedResult = result;
+        // Failed evaluations are not cached, they are retried every time as before
+        mIsCached = success;
+    }
+
+    if (pDependent && (pDependent != this))
+    {
+        pDependent->mDependencies.push_back(Dependency(this, mRevision));
+    }
+    if (pResult)
+    {
+        *pResult = mCachedResult;
+    }
+    return mCachedSuccess;
+}
+
+//! @brief Check if the cached value is still valid, parameters that it depends on are brought up to date first
+bool ParameterEvaluator::isUpToDate()
+{
+    if (!mIsCached || (mDependencyRevision != gParameterStructureRevision))
+    {
+        return false;
+    }
+
+    // The dependencies are evaluated on their own, they should not be recorded as dependencies of some other parameter being evaluated
+    ParameterEvaluator *pDependent = tpEvaluatingParameter;
+    tpEvaluatingParameter = 0;
+    bool upToDate = true;
+    for (size_t d=0; d<mDependencies.size(); ++d)
+    {
+        ParameterEvaluator *pParameter = mDependencies[d].mpParameter;
+        pParameter->evaluateCached(0);
+        if (pParameter->mRevision != mDependencies[d].mRevision)
+        {
+            upToDate = false;
+            break;
+        }
+    }
+    tpEvaluatingParameter = pDependent;
+    return upToDate;
+}
+
+//! @brief Write the cached value to the data variable
+void ParameterEvaluator::writeCachedValue()
+{
+    if (mpData)
+    {
+        switch (mTypeId)
+        {
+        case DoubleType:
+            *static_cast<double*>(mpData) = mCachedDouble;
+            break;
+        case IntegerType:
+        case ConditionalType:
+            *static_cast<int*>(mpData) = mCachedInt;
+            break;
+        case BoolType:
+            *static_cast<bool*>(mpData) = mCachedBool;
+            break;
+        case StringType:
+            static_cast<HString*>(mpData)->setString(mCachedResult.c_str());
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+//! @brief Evaluate the value as a numhop expression
+//! @details The expression is interpreted once and kept until the value changes, only the evaluation is repeated
+bool ParameterEvaluator::evaluateExpression(HString &rResult)
+{
+    HString dummy;
+    if (!mpExpression)
+    {
+        mpExpression = new NumHopHelper();
+        mpExpression->setComponent(mpParameterEvaluatorHandler->getComponent());
+        mExpressionOK = mpExpression->interpretNumHopScript(mParameterValue, false, dummy);
+    }
+    double value;
+    if (mExpressionOK && mpExpression->eval(value, false, dummy))
+    {
+        rResult = to_hstring(value);
+        return true;
+    }
+    return false;
+}
+
+//! @brief Evaluate the parameter value text and write the result to the data variable
+//! @param [out] rResult The result of the evaluation
+//! @return true if success, otherwise false
+bool ParameterEvaluator::evaluateValue(HString &rResult)
 {
 
 // These values are arejust a guess, there is no easy way of kowing how long it will take until the stack overflow
@@ -256,7 +413,7 @@ bool ParameterEvaluator::evaluate(HString &rResult)
         return false;
     }
 
-    if(!((mType=="double") || (mType=="integer") || (mType=="bool") || (mType=="string") || (mType=="textblock") || (mType=="filepath") || (mType=="conditional")))
+    if(mTypeId==UnknownType)
     {
         mpParameterEvaluatorHandler->getComponent()->addErrorMessage("Parameter could not be evaluated, unknown type: " + mType);
     }
@@ -267,22 +424,22 @@ bool ParameterEvaluator::evaluate(HString &rResult)
     // Determine if we should look for parameter among other parameters and system parameters
     bool doCheckOthers=false;
     //! @todo handle conditional also
-    if (mType=="double" || mType=="integer")
+    if (mTypeId==DoubleType || mTypeId==IntegerType)
     {
         doCheckOthers = !mParameterValue.isNummeric();
     }
-    else if (mType=="bool")
+    else if (mTypeId==BoolType)
     {
         doCheckOthers = !mParameterValue.isBool();
     }
-    else if ((mType=="string") || (mType=="textblock") || (mType=="filepath"))
+    else if (mTypeId==StringType)
     {
         doCheckOthers = true;
     }
 
     // Check parent system parameters
     //! @todo Use numhop to evaluate integer and bool expressions, possibly by converting to double and back
-    if (doCheckOthers && (mType=="integer"))
+    if (doCheckOthers && (mTypeId==IntegerType))
     {
         // Strip + or - from name in case we want to take a negative value of a system parameter
         HString signPrefix, parameterValueWithoutSign;
@@ -302,7 +459,7 @@ bool ParameterEvaluator::evaluate(HString &rResult)
             evaluatedParameterValue = mParameterValue;
         }
     }
-    else if (doCheckOthers && (mType=="string" || mType=="textblock" || mType=="filepath" || mType=="bool")) {
+    else if (doCheckOthers && (mTypeId==StringType || mTypeId==BoolType)) {
 
         const HString& possibleNameOfOtherParameter = mParameterValue;
         const bool isSelfParameter = possibleNameOfOtherParameter.startsWith("self.");
@@ -320,7 +477,7 @@ bool ParameterEvaluator::evaluate(HString &rResult)
     // Use numhop expression evaluation for doubles
     else if (doCheckOthers)
     {
-        if (mpParameterEvaluatorHandler->evaluateParameterExpression(mParameterValue, evaluatedParameterValue)) {
+        if (evaluateExpression(evaluatedParameterValue)) {
             //evaluatedParameterValue = evaluatedParameterValue;  No point is self assignment, but comment left here for clarity
         }
         else {
@@ -333,12 +490,13 @@ bool ParameterEvaluator::evaluate(HString &rResult)
     }
 
     // Now try to evaluate the actual parameter value based on type
-    if(mType=="double")
+    if(mTypeId==DoubleType)
     {
         bool isOK;
         double v = evaluatedParameterValue.toDouble(&isOK);
         if(isOK)
         {
+            mCachedDouble = v;
             // If a data pointer has been set, then write evaluated value to data variable
             if(mpData)
             {
@@ -350,12 +508,13 @@ bool ParameterEvaluator::evaluate(HString &rResult)
             success = false;
         }
     }
-    else if(mType=="integer")
+    else if(mTypeId==IntegerType)
     {
         int tmpParameterValue;
         istringstream is(evaluatedParameterValue.c_str());
         if(is >> tmpParameterValue)
         {
+            mCachedInt = tmpParameterValue;
             // If a data pointer has been set, then write evaluated value to data variable
             if(mpData)
             {
@@ -367,12 +526,13 @@ bool ParameterEvaluator::evaluate(HString &rResult)
             success = false;
         }
     }
-    else if(mType=="conditional")
+    else if(mTypeId==ConditionalType)
     {
         int tmpParameterValue;
         istringstream is(evaluatedParameterValue.c_str());
         if((is >> tmpParameterValue) && (tmpParameterValue >= 0) && (tmpParameterValue < int(this->mConditions.size())))
         {
+            mCachedInt = tmpParameterValue;
             // If a data pointer has been set, then write evaluated value to data variable
             if(mpData)
             {
@@ -384,12 +544,13 @@ bool ParameterEvaluator::evaluate(HString &rResult)
             success = false;
         }
     }
-    else if(mType=="bool")
+    else if(mTypeId==BoolType)
     {
         bool tmpParameterValue;
         istringstream is(evaluatedParameterValue.c_str());
         if(is >> tmpParameterValue)
         {
+            mCachedBool = tmpParameterValue;
             // If a data pointer has been set, then write evaluated value to data variable
             if(mpData)
             {
@@ -398,6 +559,7 @@ bool ParameterEvaluator::evaluate(HString &rResult)
         }
         else if((evaluatedParameterValue == "false") || (evaluatedParameterValue == "0"))
         {
+            mCachedBool = false;
             // If a data pointer has been set, then write evaluated value to data variable
             if(mpData)
             {
@@ -406,6 +568,7 @@ bool ParameterEvaluator::evaluate(HString &rResult)
         }
         else if((evaluatedParameterValue == "true") || (evaluatedParameterValue == "1"))
         {
+            mCachedBool = true;
             // If a data pointer has been set, then write evaluated value to data variable
             if(mpData)
             {
@@ -417,7 +580,7 @@ bool ParameterEvaluator::evaluate(HString &rResult)
             success = false;
         }
     }
-    else if(mType=="string" || mType=="textblock" || mType=="filepath")
+    else if(mTypeId==StringType)
     {
         // If a data pointer has been set, then write evaluated value to data variable
         if(mpData)
@@ -480,6 +643,56 @@ bool ParameterEvaluator::triggersReconfiguration()
     return mTriggersReconfiguration;
 }
 
+//! @brief Invalidate the cached values of all parameters that depend on other parameters
+//! @details Call this when the parameter structure changes, so that references by name may refer to other parameters
+void ParameterEvaluator::invalidateDependencies()
+{
+    ++gParameterStructureRevision;
+}
+
+void ParameterEvaluator::setType(const HString &rType)
+{
+    // The type decides how other parameters referring to this one are evaluated, so their cached values are invalid if it changes
+    if (rType != mType)
+    {
+        ParameterEvaluator::invalidateDependencies();
+    }
+    mType = internString(rType);
+    if (mType=="double")
+    {
+        mTypeId = DoubleType;
+    }
+    else if (mType=="integer")
+    {
+        mTypeId = IntegerType;
+    }
+    else if (mType=="bool")
+    {
+        mTypeId = BoolType;
+    }
+    else if ((mType=="string") || (mType=="textblock") || (mType=="filepath"))
+    {
+        mTypeId = StringType;
+    }
+    else if (mType=="conditional")
+    {
+        mTypeId = ConditionalType;
+    }
+    else
+    {
+        mTypeId = UnknownType;
+    }
+}
+
+//! @brief Discard the cached value and compiled expression, call this when the value text or type has changed
+void ParameterEvaluator::invalidate()
+{
+    mIsCached = false;
+    delete mpExpression;
+    mpExpression = 0;
+    ++mRevision;
+}
+
 void ParameterEvaluator::resolveSignPrefix(HString &rSignPrefix) const
 {
     // Resolve prefix, check num -, ignore +
@@ -543,6 +756,7 @@ ParameterEvaluatorHandler::~ParameterEvaluatorHandler()
     {
         delete mParameters[i];
     }
+    ParameterEvaluator::invalidateDependencies();
 }
 
 
@@ -569,11 +783,13 @@ bool ParameterEvaluatorHandler::addParameter(const HString &rName, const HString
             if(rType == "conditional")
             {
                 newParameter->mConditions = conditions;
+                newParameter->invalidate();
             }
             success = newParameter && newParameter->evaluate(); //! @todo here we evaluate again (why?)
             if(success || force)
             {
                 mParameters.push_back(newParameter);
+                ParameterEvaluator::invalidateDependencies();
                 success = true;
             }
             else
@@ -610,6 +826,7 @@ void ParameterEvaluatorHandler::deleteParameter(const HString &rName)
 
             delete *parIt;
             mParameters.erase(parIt);
+            ParameterEvaluator::invalidateDependencies();
 
             // We can return now, since there should never be multiple parameters with same name
             return;
@@ -629,6 +846,7 @@ bool ParameterEvaluatorHandler::renameParameter(const HString &rOldName, const H
             if( rOldName == (*parIt)->getName() )
             {
                 (*parIt)->mParameterName = rNewName;
+                ParameterEvaluator::invalidateDependencies();
                 return true;
             }
         }
@@ -51,8 +51,8 @@ using namespace hopsan;
 //! @brief Port base class constructor
 Port::Port(const HString &rNodeType, const HString &rPortName, Component *pParentComponent, Port *pParentPort)
 {
-    mPortName = rPortName;
-    mNodeType = rNodeType;
+    mPortName = internString(rPortName);
+    mNodeType = internString(rNodeType);
     mpComponent = pParentComponent;
     mpParentPort = pParentPort; //Only used by subports in multiports
     mConnectionRequired = true;
@@ -199,7 +199,7 @@ double Port::readNodeSafe(const size_t idx, const size_t subPortIdx) const
 
     if (idx < mpNode->getNumDataVariables())
     {
-        return mpNode->mDataValues[idx];
+        return mpNode->mpDataValues[idx];
     }
     getComponent()->addErrorMessage("data idx out of range in Port::readNodeSafe()");
     return -1;
@@ -217,7 +217,7 @@ void Port::writeNodeSafe(const size_t idx, const double value, const size_t subP
     HOPSAN_UNUSED(subPortIdx)
     if (idx < mpNode->getNumDataVariables())
     {
-        mpNode->mDataValues[idx] = value;
+        mpNode->mpDataValues[idx] = value;
     }
     else
     {
@@ -424,7 +424,7 @@ bool Port::haveLogData(const size_t subPortIdx)
     if (mpNode)
     {
         // Here we assume that timevector DOES exist. If simulation code is correct it should exist
-        return !mpNode->mDataStorage.empty();
+        return !mpNode->mLogDataStore.empty();
     }
     return false;
 }
@@ -569,24 +569,13 @@ vector<double> *Port::getLogTimeVectorPtr(const size_t subPortIdx)
     return 0; //Nothing found return 0
 }
 
+//! @brief Returns a pointer to the columnar log data of the connected node
 //! @param [in] subPortIdx Ignored on non multi ports
-vector<vector<double> > *Port::getLogDataVectorPtr(size_t subPortIdx)
+const LogDataStore *Port::getLogDataStorePtr(const size_t subPortIdx) const
 {
-    // TODO use const cast maybe
     HOPSAN_UNUSED(subPortIdx)
     if (mpNode != 0) {
-        return &(mpNode->mDataStorage);
-    }
-    else {
-        return 0;
-    }
-}
-
-const std::vector<std::vector<double> > *Port::getLogDataVectorPtr(size_t subPortIdx) const
-{
-    HOPSAN_UNUSED(subPortIdx)
-    if (mpNode != 0) {
-        return &(mpNode->mDataStorage);
+        return &(mpNode->mLogDataStore);
     }
     else {
         return 0;
@@ -598,13 +587,14 @@ bool Port::isInterfacePort() const
     return getComponent()->isComponentSystem();
 }
 
+//! @brief Returns a pointer to the node data values, use getNumDataVariables() to get the number of values
 //! @param [in] subPortIdx Ignored on non multi ports
-vector<double> *Port::getDataVectorPtr(const size_t subPortIdx)
+double *Port::getDataVectorPtr(const size_t subPortIdx)
 {
     HOPSAN_UNUSED(subPortIdx)
     if(mpNode != 0)
     {
-        return &(mpNode->mDataValues);
+        return mpNode->mpDataValues;
     }
     else
     {
@@ -764,6 +754,10 @@ SortHintEnumT Port::getSortHint() const
 
 void Port::setSortHint(SortHintEnumT hint)
 {
+    if (hint != mSortHint)
+    {
+        ComponentSystem::markStructureChanged();
+    }
     mSortHint = hint;
 }
 
@@ -797,7 +791,7 @@ const HString &Port::getDescription() const
 //! @param [in] rDescription The new description
 void Port::setDescription(const HString &rDescription)
 {
-    mDescription = rDescription;
+    mDescription = internString(rDescription);
 }
 
 
@@ -948,8 +942,9 @@ void ReadPort::writeNodeSafe(const size_t idx, const double value, const size_t
 
 void ReadPort::setSortHint(SortHintEnumT hint)
 {
-    if (hint == Destination || hint == IndependentDestination)
+    if ((hint == Destination || hint == IndependentDestination) && (hint != mSortHint))
     {
+        ComponentSystem::markStructureChanged();
         mSortHint = hint;
     }
 }
@@ -1139,19 +1134,10 @@ std::vector<double> *MultiPort::getLogTimeVectorPtr(const size_t subPortIdx)
     return 0;
 }
 
-std::vector<std::vector<double> > *MultiPort::getLogDataVectorPtr(const size_t subPortIdx)
-{
-    if (isConnected())
-    {
-        return mSubPortsVector[subPortIdx]->getLogDataVectorPtr();
-    }
-    return 0;
-}
-
-const std::vector<std::vector<double> > *MultiPort::getLogDataVectorPtr(size_t subPortIdx) const
+const LogDataStore *MultiPort::getLogDataStorePtr(const size_t subPortIdx) const
 {
     if (isConnected()) {
-        return mSubPortsVector[subPortIdx]->getLogDataVectorPtr();
+        return mSubPortsVector[subPortIdx]->getLogDataStorePtr();
     }
     return 0;
 }
@@ -1163,7 +1149,7 @@ void MultiPort::setEnableLogging(const bool enableLog)
 }
 
 
-std::vector<double> *MultiPort::getDataVectorPtr(const size_t subPortIdx)
+double *MultiPort::getDataVectorPtr(const size_t subPortIdx)
 {
     if (isConnected())
     {
@@ -1330,8 +1316,9 @@ ReadMultiPort::ReadMultiPort(const HString &rNodeType, const HString &rPortName,
 
 void ReadMultiPort::setSortHint(SortHintEnumT hint)
 {
-    if (hint == Destination || hint == IndependentDestination)
+    if ((hint == Destination || hint == IndependentDestination) && (hint != mSortHint))
     {
+        ComponentSystem::markStructureChanged();
         mSortHint = hint;
     }
 }
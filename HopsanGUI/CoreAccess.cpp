@@ -901,29 +901,32 @@ void CoreSystemAccess::getPlotData(const QString compname, const QString portnam
         dataId = pPort->getNodeDataIdFromName(dataname.toStdString().c_str());
         if (dataId > -1)
         {
-            std::vector< std::vector<double> > *pData = pPort->getLogDataVectorPtr();
+            const hopsan::LogDataStore *pData = pPort->getLogDataStorePtr();
             rpTimeVector = pPort->getLogTimeVectorPtr();
 
-            // Instead of pData.size() lets ask for latest logsample, this way we can avoid coping log slots that have not bee written and contains junk
+            // Instead of the number of log slots lets ask for latest logsample, this way we can avoid coping log slots that have not bee written and contains junk
             // This is useful when a simulation has been aborted
             size_t nElements;
             if (pPort->getNodePtr())
             {
-                nElements = qMin(pPort->getNodePtr()->getOwnerSystem()->getNumActuallyLoggedSamples(), pData->size());
+                nElements = qMin(pPort->getNodePtr()->getOwnerSystem()->getNumActuallyLoggedSamples(), pData->getNumSlots());
             }
             else
             {
                 // this should never happen i think
-                nElements = qMin(pData->size(), rpTimeVector->size());
+                nElements = qMin(pData->getNumSlots(), rpTimeVector->size());
             }
-            //size_t nElements = min(pPort->getNodegetComponent()->getSystemParent()->getNumActuallyLoggedSamples(), pData->size());
-            //qDebug() << "pData.size(): " << pData->size() << " nElements: " << nElements;
 
-            //Ok lets copy all of the data to a Qt vector
-            rData.resize(nElements); //Allocate memory for data
-            for (size_t i=0; i<nElements; ++i)
+            //Ok lets copy all of the data to a Qt vector, the log column is contiguous so this is a straight copy
+            const double *pColumn = pData->getColumn(size_t(dataId));
+            if (!pColumn)
             {
-                rData[i] = pData->at(i).at(dataId);
+                nElements = 0; // Variable is not logged
+            }
+            rData.resize(int(nElements)); //Allocate memory for data
+            if (nElements > 0)
+            {
+                std::copy(pColumn, pColumn+nElements, rData.begin());
             }
         }
     }
@@ -971,8 +974,8 @@ bool CoreSystemAccess::getLastNodeData(const QString compname, const QString por
 
         if (dataId >= 0)
         {
-            std::vector<double> *pData = pPort->getDataVectorPtr();
-            rData = pData->at(dataId);
+            double *pData = pPort->getDataVectorPtr();
+            rData = pData[dataId];
             return true;
         }
     }
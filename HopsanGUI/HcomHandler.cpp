@@ -4269,6 +4269,12 @@ void HcomHandler::executeGetCommand(const QString cmd)
         case hopsan::ClusteredForkJoinAlgorithm :
             output.append("clustered fork-join scheduling");
             break;
+        case hopsan::WorkStealingAlgorithm :
+            output.append("lock-free work-stealing");
+            break;
+        case hopsan::GraphPartitioningAlgorithm :
+            output.append("graph partitioning scheduling");
+            break;
         default :
             output.append("unknown ("+QString::number(getConfigPtr()->getParallelAlgorithm())+")");
             break;
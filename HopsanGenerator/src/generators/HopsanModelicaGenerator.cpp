@@ -893,7 +893,7 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
     }
 
     //Identify system equations containing only one unknown (can be resolved before the rest of the system)
-    QStringList preAlgorithms;
+    QList<Expression> preAlgorithms;
     bool didSomething = true;
     while(didSomething) {
         didSomething = false;
@@ -931,7 +931,7 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
                     printMessage("Moving the following equations to intial algorithm section:");
                     printMessage("  "+algorithm.toString());
 
-                    preAlgorithms.append(algorithm.toString());
+                    preAlgorithms.append(algorithm);
                     systemEquations.removeAt(e);
                     --e;
                     unknowns.removeAll(usedUnknowns[0]);
@@ -943,7 +943,7 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
 
 
     //Identify system equations containing a unique variable (can be resolved after the rest of the system)
-    QStringList finalAlgorithms;
+    QList<Expression> finalAlgorithms;
     for(int u=0; u<unknowns.size(); ++u) {
         size_t count=0;
         int lastFound=-1;
@@ -979,7 +979,7 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
                 printMessage("Moving the following equations to final algorithms:");
                 printMessage("  "+algExpr.toString());
                 algExpr.expandPowers();
-                finalAlgorithms.prepend(algExpr.toString());
+                finalAlgorithms.prepend(algExpr);
                 systemEquations.removeAt(lastFound);
                 unknowns.removeAt(u);
                 u = 0;  //Restart checking
@@ -1027,9 +1027,54 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
     logStream << "\n--- Final Algorithms ---\n";
     printMessage("Final algorithms:");
     for(int i=0; i<finalAlgorithms.size(); ++i) {
-        printMessage("  "+finalAlgorithms[i]);
-        logStream << finalAlgorithms[i] << "\n";
+        printMessage("  "+finalAlgorithms[i].toString());
+        logStream << finalAlgorithms[i].toString() << "\n";
+    }
+
+    //Only compute Jacobian elements that are non-zero for best performance
+    QList<Expression> jacobianElements;
+    QStringList jacobianTargets;
+    for(int i=0; i<jacobian.size(); ++i) {
+        for(int j=0; j<jacobian[i].size(); ++j) {
+            if(jacobian[i][j] != Expression(0)) {
+                jacobianElements << jacobian[i][j];
+                jacobianTargets << QString("J[%2*%3+%1]").arg(i).arg(j).arg(unknowns.size());
+            }
+        }
+    }
+
+    //Optimize expressions for performance: replace expensive operations by cheaper ones, compute
+    //expressions that only depend on parameters once at initialization, and compute common
+    //subexpressions in the residual and Jacobian functions only once per call
+    QStringList constants;
+    for(const auto &parameter : parameters) {
+        constants << parameter.name;
+    }
+    constants << "mTimestep";
+    QList<Expression> constantDefinitions, residualTemporaries, jacobianTemporaries;
+    QList<QList<Expression>*> optimizedExpressions = QList<QList<Expression>*>() << &systemEquations << &jacobianElements << &preAlgorithms << &finalAlgorithms;
+    OperationCount opsBefore, opsAfter;
+    for(QList<Expression> *pExpressions : optimizedExpressions) {
+        opsBefore += countOperations(*pExpressions);
+        for(Expression &expr : *pExpressions) {
+            expr.reduceStrength();
+        }
+        foldConstants(*pExpressions, constants, constantDefinitions, "mCseConst");
+    }
+    eliminateCommonSubexpressions(systemEquations, residualTemporaries, "cseTmp");
+    eliminateCommonSubexpressions(jacobianElements, jacobianTemporaries, "cseTmp");
+    for(QList<Expression> *pExpressions : optimizedExpressions) {
+        opsAfter += countOperations(*pExpressions);
     }
+    opsAfter += countOperations(residualTemporaries);
+    opsAfter += countOperations(jacobianTemporaries);
+
+    logStream << "\n--- Operation Count ---\n";
+    logStream << "Before optimization: " << opsBefore.toString() << "\n";
+    logStream << "After optimization: " << opsAfter.toString() << "\n";
+    logStream << "At initialization: " << countOperations(constantDefinitions).toString() << "\n";
+    printMessage("Operation count before optimization: "+opsBefore.toString());
+    printMessage("Operation count after optimization: "+opsAfter.toString());
 
     //Generate component specification object
 
@@ -1070,6 +1115,12 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
         comp.utilityNames << "mDelay"+QString::number(i);
     }
 
+    for(const auto &definition : constantDefinitions)
+    {
+        comp.utilities << "double";
+        comp.utilityNames << definition.getLeft()->toString();
+    }
+
     for(int i=0; i<variables.size(); ++i)
     {
         comp.varNames.append(variables[i].name);
@@ -1101,6 +1152,14 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
         }
     }
 
+    if(!constantDefinitions.isEmpty()) {
+        comp.initEquations << "";
+        comp.initEquations << "//Constant subexpressions";
+        for(const auto &definition : constantDefinitions) {
+            comp.initEquations << definition.toString()+";";
+        }
+    }
+
     if(!cavitationChecks.isEmpty()) {
         comp.simEquations << "while(true) {";
         comp.simEquations << "";
@@ -1111,7 +1170,7 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
         comp.simEquations << "//Pre-algorithm section";
         for(int i=0; i<preAlgorithms.size(); ++i)
         {
-            comp.simEquations << preAlgorithms[i]+";";
+            comp.simEquations << preAlgorithms[i].toString()+";";
         }
         comp.simEquations << "";
     }
@@ -1136,7 +1195,7 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
         comp.simEquations << "//Final algorithm section";
         for(int i=0; i<finalAlgorithms.size(); ++i)
         {
-            comp.simEquations << finalAlgorithms[i]+";";
+            comp.simEquations << finalAlgorithms[i].toString()+";";
         }
         comp.simEquations << "";
     }
@@ -1202,6 +1261,9 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
         for(int u=0; u<unknowns.size(); ++u) {
             comp.auxiliaryFunctions << "    double "+unknowns[u].toString()+" = y["+QString::number(u)+"];";
         }
+        for(const auto &temporary : residualTemporaries) {
+            comp.auxiliaryFunctions << "    double "+temporary.toString()+";";
+        }
         comp.auxiliaryFunctions << "    ";
         for(int e=0; e<systemEquations.size(); ++e) {
             comp.auxiliaryFunctions << "    res["+QString::number(e)+"] = "+systemEquations[e].toString()+";";
@@ -1218,15 +1280,12 @@ bool HopsanModelicaGenerator::generateComponentObject(ComponentSpecification &co
         for(int u=0; u<unknowns.size(); ++u) {
             comp.auxiliaryFunctions << "    double "+unknowns[u].toString()+" = y["+QString::number(u)+"];";
         }
+        for(const auto &temporary : jacobianTemporaries) {
+            comp.auxiliaryFunctions << "    double "+temporary.toString()+";";
+        }
         comp.auxiliaryFunctions << "    ";
-
-        //Only compute Jacobian elements that are non-zero for best performance
-        for(int i=0; i<jacobian.size(); ++i) {
-            for(int j=0; j<jacobian[i].size(); ++j) {
-                if(jacobian[i][j] != Expression(0)) {
-                    comp.auxiliaryFunctions << QString("    J[%2*%3+%1] = ").arg(i).arg(j).arg(unknowns.size()) + jacobian[i][j].toString() + ";";
-                }
-            }
+        for(int i=0; i<jacobianElements.size(); ++i) {
+            comp.auxiliaryFunctions << "    "+jacobianTargets[i]+" = "+jacobianElements[i].toString()+";";
         }
         comp.auxiliaryFunctions << "}";
     }
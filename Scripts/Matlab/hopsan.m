@@ -45,6 +45,10 @@ classdef hopsan
             calllib('hopsanc','loadModel',path);
             obj.checkMessages();
         end
+        function loadModelCached(obj,path,cachePath)
+            calllib('hopsanc','loadModelCached',path,cachePath);
+            obj.checkMessages();
+        end
         function loadLibrary(obj,path)
             calllib('hopsanc','loadLibrary',path);
             obj.checkMessages();
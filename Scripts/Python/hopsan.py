@@ -15,6 +15,9 @@ class hopsan:
     def loadModel(self, path):
         self.hdll.loadModel(path.encode())
 
+    def loadModelCached(self, path, cachePath):
+        self.hdll.loadModelCached(path.encode(), cachePath.encode())
+
     def simulate(self):
         self.hdll.simulate()
 
@@ -56,3 +59,6 @@ class hopsan:
         import ctypes
         self.hdll.setNumberOfLogSamples.argtypes = [ctypes.c_int]
         self.hdll.setNumberOfLogSamples(value)
+
+    def setLogOnly(self, names):
+        self.hdll.setLogOnlyVariables(",".join(names).encode())
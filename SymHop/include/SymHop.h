@@ -37,6 +37,7 @@
 #include <QString>
 #include <QList>
 #include <QStringList>
+#include <QVector>
 #include <QDebug>
 #include "symhop_win32dll.h"
 
@@ -61,6 +62,21 @@ namespace SymHop {
 typedef double (*FunctionPtr)(QString, bool&); // function pointer type
 static QStringList gSymHopMessages;
 
+//! @brief Number of arithmetic operations and function calls needed to compute one or more expressions
+class SYMHOP_DLLAPI OperationCount
+{
+public:
+    OperationCount();
+    int total() const;
+    QString toString() const;
+    OperationCount &operator+=(const OperationCount &other);
+
+    int additions;
+    int multiplications;
+    int divisions;
+    int functionCalls;
+};
+
 class SYMHOP_DLLAPI Expression
 {
 public:
@@ -151,6 +167,7 @@ public:
 
     void expand(const ExpressionSimplificationT simplifications=FullSimplification);
     void expandPowers();
+    void reduceStrength();
     void linearize();
 
     void toLeftSided();
@@ -167,6 +184,7 @@ public:
     void removeTerm(const Expression &term);
     Expression removeNumericalFactors() const;
     double getNumericalFactor() const;
+    void countOperations(OperationCount &rCount) const;
 
     static QStringList splitWithRespectToParentheses(const QString str, const QChar c);
     static bool verifyParantheses(const QString str);
@@ -194,6 +212,48 @@ private:
     QStringList reservedSymbols;
 };
 
+
+//! @brief Expression compiled to register based byte code, for fast repeated evaluation
+//! Variables are bound to indexes in an array of values at compile time, so evaluation does not look up any
+//! strings or allocate any memory. Custom functions (SymHopFunctionoid) are not supported.
+//! @note Evaluation uses internal registers, so one object must not be evaluated from several threads at once
+class SYMHOP_DLLAPI CompiledExpression
+{
+public:
+    CompiledExpression();
+    CompiledExpression(const Expression &expr, const QStringList &variables);
+
+    bool compile(const Expression &expr, const QStringList &variables);
+    bool isValid() const;
+    QStringList getVariables() const;
+    int getNumInstructions() const;
+
+    double evaluate(const double *pVariables) const;
+    void evaluate(const double * const *ppVariables, double *pResults, const int numSamples) const;
+
+private:
+    enum OperationT {Constant, Variable, Add, Multiply, Divide, Negate, Power, Function1, Function2, Limit, Equal};
+    class Instruction
+    {
+    public:
+        OperationT operation;
+        int dst, arg1, arg2, arg3;
+        double value;
+        double (*pFunction1)(double);
+        double (*pFunction2)(double, double);
+    };
+
+    bool compileRecursive(const Expression &expr, const int dst);
+    void addInstruction(const OperationT operation, const int dst, const int arg1=0, const int arg2=0, const int arg3=0);
+
+    QStringList mVariables;
+    QVector<Instruction> mInstructions;
+    int mNumRegisters;
+    bool mIsValid;
+    mutable QVector<double> mRegisters;
+    mutable QVector<double> mBlockRegisters;
+};
+
 QString SYMHOP_DLLAPI getFunctionDerivative(const QString &key);
 QStringList SYMHOP_DLLAPI getSupportedFunctionsList();
 QStringList SYMHOP_DLLAPI getCustomFunctionList();
@@ -202,6 +262,10 @@ bool SYMHOP_DLLAPI findPath(QList<int> &order, QList<QList<int> > dependencies,
 bool SYMHOP_DLLAPI sortEquationSystem(QList<Expression> &equations, QList<QList<Expression> > &jacobian, QList<Expression> stateVars, QList<int> &limitedVariableEquations, QList<int> &limitedDerivativeEquations, QList<int> preferredOrder);
 void SYMHOP_DLLAPI removeDuplicates(QList<Expression> &rSet);
 
+OperationCount SYMHOP_DLLAPI countOperations(const QList<Expression> &expressions);
+void SYMHOP_DLLAPI foldConstants(QList<Expression> &rExpressions, const QStringList &constants, QList<Expression> &rDefinitions, const QString &prefix);
+void SYMHOP_DLLAPI eliminateCommonSubexpressions(QList<Expression> &rExpressions, QList<Expression> &rDefinitions, const QString &prefix);
+
 bool SYMHOP_DLLAPI isWhole(const double value);
 
 SymHop::Expression::InlineTransformT SYMHOP_DLLAPI strToTransform(const QString &str);
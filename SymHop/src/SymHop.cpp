@@ -1207,7 +1207,7 @@ QString Expression::toString() const
         if(mDivisors.size() > 1) { ret.append("("); }
         for(const Expression &divisor : mDivisors) {
             QString divString = divisor.toString();
-            if(divisor.isAdd())
+            if(divisor.isAdd() || (divisor.isMultiplyOrDivide() && mDivisors.size() == 1))
             {
                 divString.prepend("(");
                 divString.append(")");
@@ -2689,6 +2689,102 @@ void Expression::expandPowers()
 }
 
 
+//! @brief Replaces expensive operations with cheaper equivalent ones, to improve performance in generated code
+//! Small integer powers are replaced by products (or reciprocal products), square roots by sqrt() and divisions
+//! by powers of two by multiplications. Results may differ from the original expression by rounding errors.
+void Expression::reduceStrength()
+{
+    if(this->isEquation()) {
+        mpLeft->reduceStrength();
+        mpRight->reduceStrength();
+        return;
+    }
+
+    for(auto &term : mTerms) {
+        term.reduceStrength();
+    }
+    for(auto &factor : mFactors) {
+        factor.reduceStrength();
+    }
+    for(auto &divisor : mDivisors) {
+        divisor.reduceStrength();
+    }
+    for(auto &arg : mArguments) {
+        arg.reduceStrength();
+    }
+    if(this->isPower()) {
+        mpBase->reduceStrength();
+        mpPower->reduceStrength();
+    }
+
+    if(this->isFunction() && mFunction == "pow" && mArguments.size() == 2) {
+        this->replaceByCopy(Expression::fromBasePower(mArguments[0], mArguments[1]));
+    }
+
+    if(this->isPower()) {
+        bool ok;
+        const double power = mpPower->toDouble(&ok);
+        const Expression base = (*mpBase);
+        if(ok && power == 0) {
+            this->replaceBy(Expression("1"));
+        }
+        else if(ok && fabs(power) <= 8 && isWhole(power)) {
+            QList<Expression> factors;
+            for(int i=0; i<int(fabs(power)); ++i) {
+                factors << base;
+            }
+            if(power > 0) {
+                this->replaceBy(Expression::fromFactorsDivisors(factors, QList<Expression>()));
+            }
+            else {
+                this->replaceBy(Expression::fromFactorsDivisors(QList<Expression>() << Expression("1"), factors));
+            }
+        }
+        else if(ok && power == 0.5) {
+            this->replaceBy(Expression::fromFunctionArgument("sqrt", base));
+        }
+        else if(ok && power == -0.5) {
+            this->replaceBy(Expression::fromFactorDivisor(Expression("1"), Expression::fromFunctionArgument("sqrt", base)));
+        }
+        else if(ok && power == 1.5) {
+            this->replaceBy(Expression::fromTwoFactors(base, Expression::fromFunctionArgument("sqrt", base)));
+        }
+    }
+
+    if(this->isMultiplyOrDivide()) {
+        //Merge reciprocals ("1/x") into this expression, and replace division by powers of two with multiplication
+        QList<Expression> factors, divisors;
+        for(const Expression &factor : mFactors) {
+            if(factor.isMultiplyOrDivide() && factor.getFactors().size() == 1 && factor.getFactors().first() == Expression("1")) {
+                divisors.append(factor.getDivisors());
+            }
+            else {
+                factors.append(factor);
+            }
+        }
+        for(const Expression &divisor : mDivisors) {
+            int exponent;
+            if(divisor.isMultiplyOrDivide() && divisor.getFactors().size() == 1 && divisor.getFactors().first() == Expression("1")) {
+                factors.append(divisor.getDivisors());
+            }
+            else if(divisor.isNumericalSymbol() && divisor.toDouble() > 0 && frexp(divisor.toDouble(), &exponent) == 0.5 && exponent <= 21) {
+                factors.append(Expression(1.0/divisor.toDouble()));
+            }
+            else {
+                divisors.append(divisor);
+            }
+        }
+        while(factors.size() > 1 && factors.contains(Expression("1"))) {
+            factors.removeOne(Expression("1"));
+        }
+        if(factors.isEmpty()) {
+            factors.append(Expression("1"));
+        }
+        this->replaceBy(Expression::fromFactorsDivisors(factors, divisors));
+    }
+}
+
+
 //! @brief Linearizes the expression by multiplying with all divisors until no divisors remains
 //! @note Should only be used on equations (obviously)
 void Expression::linearize()
@@ -3728,6 +3824,54 @@ double Expression::getNumericalFactor() const
 }
 
 
+//! @brief Adds the number of operations needed to compute the expression to a counter
+//! Negations are not counted, since they are merged into adjacent additions or multiplications.
+//! @param rCount Reference to operation counter
+void Expression::countOperations(OperationCount &rCount) const
+{
+    if(this->isEquation()) {
+        mpLeft->countOperations(rCount);
+        mpRight->countOperations(rCount);
+    }
+    else if(this->isFunction()) {
+        ++rCount.functionCalls;
+        for(const Expression &arg : mArguments) {
+            arg.countOperations(rCount);
+        }
+    }
+    else if(this->isPower()) {
+        ++rCount.functionCalls;
+        mpBase->countOperations(rCount);
+        mpPower->countOperations(rCount);
+    }
+    else if(this->isAdd()) {
+        rCount.additions += mTerms.size()-1;
+        for(const Expression &term : mTerms) {
+            term.countOperations(rCount);
+        }
+    }
+    else if(this->isMultiplyOrDivide()) {
+        int nFactors=0;
+        for(const Expression &factor : mFactors) {
+            if(!(factor.isNumericalSymbol() && fabs(factor.toDouble()) == 1)) {
+                ++nFactors;
+            }
+            factor.countOperations(rCount);
+        }
+        if(nFactors > 1) {
+            rCount.multiplications += nFactors-1;
+        }
+        if(!mDivisors.isEmpty()) {
+            rCount.multiplications += mDivisors.size()-1;
+            ++rCount.divisions;
+        }
+        for(const Expression &divisor : mDivisors) {
+            divisor.countOperations(rCount);
+        }
+    }
+}
+
+
 //! @brief Returns derivative to specified function, or an empty string if function is not supported
 QString SymHop::getFunctionDerivative(const QString &key)
 {
@@ -3902,6 +4046,409 @@ void SymHop::removeDuplicates(QList<Expression> &rSet)
 }
 
 
+//! @brief Constructor for an empty operation counter
+OperationCount::OperationCount()
+{
+    additions = 0;
+    multiplications = 0;
+    divisions = 0;
+    functionCalls = 0;
+}
+
+
+//! @brief Returns the total number of operations
+int OperationCount::total() const
+{
+    return additions+multiplications+divisions+functionCalls;
+}
+
+
+//! @brief Returns a human readable summary of the operation count
+QString OperationCount::toString() const
+{
+    return QString::number(additions)+" additions, "+QString::number(multiplications)+" multiplications, "+
+           QString::number(divisions)+" divisions, "+QString::number(functionCalls)+" function calls";
+}
+
+
+OperationCount &OperationCount::operator+=(const OperationCount &other)
+{
+    additions += other.additions;
+    multiplications += other.multiplications;
+    divisions += other.divisions;
+    functionCalls += other.functionCalls;
+    return *this;
+}
+
+
+//! @brief Returns the number of operations needed to compute a list of expressions
+//! @param expressions List of expressions
+OperationCount SymHop::countOperations(const QList<Expression> &expressions)
+{
+    OperationCount count;
+    for(const Expression &expr : expressions) {
+        expr.countOperations(count);
+    }
+    return count;
+}
+
+
+//! @brief Tells whether or not an expression only depends on numbers and specified constants
+static bool isConstantExpression(const Expression &expr, const QStringList &constants)
+{
+    if(expr.isNumericalSymbol()) {
+        return true;
+    }
+    else if(expr.isVariable()) {
+        return constants.contains(expr.getSymbolName());
+    }
+    else if(expr.isFunction()) {
+        //Functions with side effects or memory can not be moved
+        if(expr.getFunctionName() == "der" || expr.getFunctionName() == "delay" || !getSupportedFunctionsList().contains(expr.getFunctionName())) {
+            return false;
+        }
+        for(const Expression &arg : expr.getArguments()) {
+            if(!isConstantExpression(arg, constants)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    else if(expr.isPower()) {
+        return isConstantExpression(*expr.getBase(), constants) && isConstantExpression(*expr.getPower(), constants);
+    }
+    else if(expr.isAdd() || expr.isMultiplyOrDivide()) {
+        for(const Expression &child : expr.mTerms+expr.mFactors+expr.mDivisors) {
+            if(!isConstantExpression(child, constants)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+
+//! @brief Returns a symbol for a constant expression, and adds a definition for it unless one already exists
+static Expression getConstantSymbol(const Expression &expr, QList<Expression> &rDefinitions, const QString &prefix)
+{
+    for(const Expression &definition : rDefinitions) {
+        if(*definition.getRight() == expr) {
+            return *definition.getLeft();
+        }
+    }
+    Expression symbol(prefix+QString::number(rDefinitions.size()));
+    rDefinitions.append(Expression::fromEquation(symbol, expr));
+    return symbol;
+}
+
+
+static void foldConstantsRecursive(Expression &rExpr, const QStringList &constants, QList<Expression> &rDefinitions, const QString &prefix)
+{
+    if(rExpr.isEquation()) {
+        if(!rExpr.isAssignment()) {
+            foldConstantsRecursive(*rExpr.getLeft(), constants, rDefinitions, prefix);
+        }
+        foldConstantsRecursive(*rExpr.getRight(), constants, rDefinitions, prefix);
+        return;
+    }
+
+    OperationCount count;
+    rExpr.countOperations(count);
+    if(count.total() == 0) {
+        return;
+    }
+
+    if(isConstantExpression(rExpr, constants)) {
+        rExpr = getConstantSymbol(rExpr, rDefinitions, prefix);
+    }
+    else if(rExpr.isAdd()) {
+        //Replace all constant terms by one symbol
+        QList<Expression> terms, constantTerms;
+        for(const Expression &term : rExpr.getTerms()) {
+            if(isConstantExpression(term, constants)) {
+                constantTerms.append(term);
+            }
+            else {
+                terms.append(term);
+                foldConstantsRecursive(terms.last(), constants, rDefinitions, prefix);
+            }
+        }
+        if(constantTerms.size() > 1) {
+            terms.append(getConstantSymbol(Expression::fromTerms(constantTerms), rDefinitions, prefix));
+        }
+        else {
+            for(Expression &term : constantTerms) {
+                foldConstantsRecursive(term, constants, rDefinitions, prefix);
+            }
+            terms.append(constantTerms);
+        }
+        rExpr = Expression::fromTerms(terms);
+    }
+    else if(rExpr.isMultiplyOrDivide()) {
+        //Replace all constant factors and divisors by one symbol, but keep the sign where it is
+        QList<Expression> factors, divisors, constantFactors, constantDivisors;
+        for(const Expression &factor : rExpr.getFactors()) {
+            if(factor != Expression("-1") && isConstantExpression(factor, constants)) {
+                constantFactors.append(factor);
+            }
+            else {
+                factors.append(factor);
+                foldConstantsRecursive(factors.last(), constants, rDefinitions, prefix);
+            }
+        }
+        for(const Expression &divisor : rExpr.getDivisors()) {
+            if(isConstantExpression(divisor, constants)) {
+                constantDivisors.append(divisor);
+            }
+            else {
+                divisors.append(divisor);
+                foldConstantsRecursive(divisors.last(), constants, rDefinitions, prefix);
+            }
+        }
+        if(constantFactors.size()+constantDivisors.size() > 1 || !constantDivisors.isEmpty()) {
+            if(constantFactors.isEmpty()) {
+                constantFactors.append(Expression("1"));
+            }
+            factors.prepend(getConstantSymbol(Expression::fromFactorsDivisors(constantFactors, constantDivisors), rDefinitions, prefix));
+        }
+        else {
+            for(Expression &factor : constantFactors) {
+                foldConstantsRecursive(factor, constants, rDefinitions, prefix);
+            }
+            factors = constantFactors+factors;
+        }
+        rExpr = Expression::fromFactorsDivisors(factors, divisors);
+    }
+    else if(rExpr.isPower()) {
+        foldConstantsRecursive(*rExpr.getBase(), constants, rDefinitions, prefix);
+        foldConstantsRecursive(*rExpr.getPower(), constants, rDefinitions, prefix);
+    }
+    else if(rExpr.isFunction()) {
+        for(Expression &arg : rExpr.mArguments) {
+            foldConstantsRecursive(arg, constants, rDefinitions, prefix);
+        }
+    }
+}
+
+
+//! @brief Replaces subexpressions that only depend on constants (e.g. parameters) by new symbols
+//! The new symbols are defined by assignments in the definitions list, that only need to be evaluated once.
+//! Identical constant subexpressions share the same symbol. Left-hand sides of assignments are not modified.
+//! @param rExpressions Reference to list of expressions to modify
+//! @param constants Names of variables that are constant
+//! @param rDefinitions Reference to list where definitions of new symbols are appended
+//! @param prefix Prefix for names of new symbols
+void SymHop::foldConstants(QList<Expression> &rExpressions, const QStringList &constants, QList<Expression> &rDefinitions, const QString &prefix)
+{
+    for(Expression &expr : rExpressions) {
+        foldConstantsRecursive(expr, constants, rDefinitions, prefix);
+    }
+}
+
+
+namespace {
+
+class SubexpressionCandidate
+{
+public:
+    SubexpressionCandidate() : count(0), operations(0) {}
+    Expression expr;
+    int count;
+    int operations;
+};
+
+}
+
+
+//! @brief Returns the expression without a negative sign, so that "x" and "-x" can be treated as the same subexpression
+static Expression removeSign(const Expression &expr, bool &rNegative)
+{
+    Expression ret = expr;
+    rNegative = (expr.isMultiplyOrDivide() && expr.isNegative());
+    if(rNegative) {
+        ret.changeSign();
+    }
+    return ret;
+}
+
+
+static void collectSubexpressions(const Expression &expr, QMap<QString, SubexpressionCandidate> &rCandidates)
+{
+    if(expr.isEquation()) {
+        collectSubexpressions(*expr.getLeft(), rCandidates);
+        collectSubexpressions(*expr.getRight(), rCandidates);
+        return;
+    }
+    if(expr.getFunctionName() == "der") {
+        return;
+    }
+
+    bool negative;
+    Expression positive = removeSign(expr, negative);
+    OperationCount count;
+    positive.countOperations(count);
+    if(count.total() == 0) {
+        return;
+    }
+    SubexpressionCandidate &candidate = rCandidates[positive.toString()];
+    if(candidate.count == 0) {
+        candidate.expr = positive;
+        candidate.operations = count.total();
+    }
+    ++candidate.count;
+
+    //Children of the expression without sign, so that e.g. "x*y" in "-x*y" is not counted twice
+    for(const Expression &child : positive.mTerms+positive.mFactors+positive.mDivisors+positive.mArguments) {
+        collectSubexpressions(child, rCandidates);
+    }
+    if(positive.isPower()) {
+        collectSubexpressions(*positive.getBase(), rCandidates);
+        collectSubexpressions(*positive.getPower(), rCandidates);
+    }
+}
+
+
+static void replaceSubexpressions(Expression &rExpr, const QMap<QString, QString> &replacements)
+{
+    if(rExpr.isEquation()) {
+        replaceSubexpressions(*rExpr.getLeft(), replacements);
+        replaceSubexpressions(*rExpr.getRight(), replacements);
+        return;
+    }
+    if(rExpr.getFunctionName() == "der") {
+        return;
+    }
+
+    bool negative;
+    const QString key = removeSign(rExpr, negative).toString();
+    if(replacements.contains(key)) {
+        Expression symbol(replacements.find(key).value());
+        if(negative) {
+            symbol.changeSign();
+        }
+        rExpr = symbol;
+        return;
+    }
+
+    for(Expression &term : rExpr.mTerms) {
+        replaceSubexpressions(term, replacements);
+    }
+    for(Expression &factor : rExpr.mFactors) {
+        replaceSubexpressions(factor, replacements);
+    }
+    for(Expression &divisor : rExpr.mDivisors) {
+        replaceSubexpressions(divisor, replacements);
+    }
+    for(Expression &arg : rExpr.mArguments) {
+        replaceSubexpressions(arg, replacements);
+    }
+    if(rExpr.isPower()) {
+        replaceSubexpressions(*rExpr.getBase(), replacements);
+        replaceSubexpressions(*rExpr.getPower(), replacements);
+    }
+}
+
+
+//! @brief Returns the number of occurrences of a symbol in an expression
+static int countSymbol(const Expression &expr, const QString &name)
+{
+    if(expr.isSymbol()) {
+        return (expr.getSymbolName() == name) ? 1 : 0;
+    }
+    int count=0;
+    for(const Expression &child : expr.mTerms+expr.mFactors+expr.mDivisors+expr.mArguments) {
+        count += countSymbol(child, name);
+    }
+    if(expr.isPower()) {
+        count += countSymbol(*expr.getBase(), name) + countSymbol(*expr.getPower(), name);
+    }
+    if(expr.isEquation()) {
+        count += countSymbol(*expr.getLeft(), name) + countSymbol(*expr.getRight(), name);
+    }
+    return count;
+}
+
+
+//! @brief Replaces subexpressions that occur more than once by temporary symbols
+//! Subexpressions are compared by their string representation, and negated subexpressions are considered equal.
+//! The innermost subexpressions are replaced first, so that the definitions can be evaluated in the order they
+//! are appended. All expressions must be evaluated with the same variable values.
+//! @param rExpressions Reference to list of expressions to modify
+//! @param rDefinitions Reference to list where definitions of temporary symbols are appended
+//! @param prefix Prefix for names of temporary symbols
+void SymHop::eliminateCommonSubexpressions(QList<Expression> &rExpressions, QList<Expression> &rDefinitions, const QString &prefix)
+{
+    const int firstDefinition = rDefinitions.size();
+    while(true) {
+        QMap<QString, SubexpressionCandidate> candidates;
+        for(const Expression &expr : rExpressions) {
+            collectSubexpressions(expr, candidates);
+        }
+
+        //Find the cheapest repeated subexpressions, these can not contain each other
+        int minOperations = -1;
+        for(const SubexpressionCandidate &candidate : candidates) {
+            if(candidate.count > 1 && (minOperations < 0 || candidate.operations < minOperations)) {
+                minOperations = candidate.operations;
+            }
+        }
+        if(minOperations < 0) {
+            break;
+        }
+
+        QMap<QString, QString> replacements;
+        for(auto it=candidates.begin(); it!=candidates.end(); ++it) {
+            if(it.value().count > 1 && it.value().operations == minOperations) {
+                QString name = prefix+QString::number(rDefinitions.size());
+                rDefinitions.append(Expression::fromEquation(Expression(name), it.value().expr));
+                replacements.insert(it.key(), name);
+            }
+        }
+        for(Expression &expr : rExpressions) {
+            replaceSubexpressions(expr, replacements);
+        }
+    }
+
+    //Put back temporary symbols that are only used once (inside larger subexpressions)
+    for(int i=firstDefinition; i<rDefinitions.size(); ++i) {
+        const Expression symbol = *rDefinitions[i].getLeft();
+        int uses=0;
+        for(int j=i+1; j<rDefinitions.size(); ++j) {
+            uses += countSymbol(rDefinitions[j], symbol.getSymbolName());
+        }
+        for(const Expression &expr : rExpressions) {
+            uses += countSymbol(expr, symbol.getSymbolName());
+        }
+        if(uses == 1) {
+            const Expression definition = *rDefinitions[i].getRight();
+            for(int j=i+1; j<rDefinitions.size(); ++j) {
+                rDefinitions[j].getRight()->replace(symbol, definition);
+            }
+            for(Expression &expr : rExpressions) {
+                expr.replace(symbol, definition);
+            }
+            rDefinitions.removeAt(i);
+            --i;
+        }
+    }
+
+    //Number the remaining temporary symbols in order
+    for(int i=firstDefinition; i<rDefinitions.size(); ++i) {
+        const Expression oldSymbol = *rDefinitions[i].getLeft();
+        const Expression newSymbol(prefix+QString::number(i));
+        if(oldSymbol != newSymbol) {
+            for(int j=i; j<rDefinitions.size(); ++j) {
+                rDefinitions[j].replace(oldSymbol, newSymbol);
+            }
+            for(Expression &expr : rExpressions) {
+                expr.replace(oldSymbol, newSymbol);
+            }
+        }
+    }
+}
+
+
 bool SymHop::isWhole(const double value)
 {
     return (static_cast<int>(value) == value);
@@ -4007,3 +4554,372 @@ Expression::InlineTransformT SymHop::strToTransform(const QString &str)
         return Expression::UndefinedTransform;
     }
 }
+
+
+//! @brief Returns a pointer to a function with one argument, or nullptr if not supported
+static double (*getCompiledFunction1(const QString &name))(double)
+{
+    if(name == "sin") { return [](double x) { return sin(x); }; }
+    if(name == "cos") { return [](double x) { return cos(x); }; }
+    if(name == "tan") { return [](double x) { return tan(x); }; }
+    if(name == "asin") { return [](double x) { return asin(x); }; }
+    if(name == "acos") { return [](double x) { return acos(x); }; }
+    if(name == "atan") { return [](double x) { return atan(x); }; }
+    if(name == "sinh") { return [](double x) { return sinh(x); }; }
+    if(name == "cosh") { return [](double x) { return cosh(x); }; }
+    if(name == "tanh") { return [](double x) { return tanh(x); }; }
+    if(name == "log") { return [](double x) { return log(x); }; }
+    if(name == "exp") { return [](double x) { return exp(x); }; }
+    if(name == "sqrt") { return [](double x) { return sqrt(x); }; }
+    if(name == "abs") { return [](double x) { return fabs(x); }; }
+    if(name == "integer") { return [](double x) { return double(int(x)); }; }
+    if(name == "floor") { return [](double x) { return floor(x); }; }
+    if(name == "ceil") { return [](double x) { return ceil(x); }; }
+    if(name == "round") { return [](double x) { return round(x); }; }
+    if(name == "r2d") { return [](double x) { return x*180.0/M_PI; }; }
+    if(name == "d2r") { return [](double x) { return x*M_PI/180.0; }; }
+    if(name == "sign") { return [](double x) { return (x >= 0.0) ? 1.0 : -1.0; }; }
+    return nullptr;
+}
+
+
+//! @brief Returns a pointer to a function with two arguments, or nullptr if not supported
+static double (*getCompiledFunction2(const QString &name))(double, double)
+{
+    if(name == "min") { return [](double x, double y) { return fmin(x, y); }; }
+    if(name == "max") { return [](double x, double y) { return fmax(x, y); }; }
+    if(name == "rem" || name == "mod") { return [](double x, double y) { return fmod(x, y); }; }
+    if(name == "div") { return [](double x, double y) { return x/y; }; }
+    if(name == "atan2") { return [](double x, double y) { return atan2(x, y); }; }
+    if(name == "pow") { return [](double x, double y) { return pow(x, y); }; }
+    if(name == "equal" || name == "eq") { return [](double x, double y) { return (x == y) ? 1.0 : 0.0; }; }
+    if(name == "notEqual") { return [](double x, double y) { return (x == y) ? 0.0 : 1.0; }; }
+    if(name == "logicalOr") { return [](double x, double y) { return (x != 0.0 || y != 0.0) ? 1.0 : 0.0; }; }
+    if(name == "logicalAnd") { return [](double x, double y) { return (x != 0.0 && y != 0.0) ? 1.0 : 0.0; }; }
+    if(name == "greaterThan") { return [](double x, double y) { return (x > y) ? 1.0 : 0.0; }; }
+    if(name == "greaterThanOrEqual") { return [](double x, double y) { return (x >= y) ? 1.0 : 0.0; }; }
+    if(name == "smallerThan") { return [](double x, double y) { return (x < y) ? 1.0 : 0.0; }; }
+    if(name == "smallerThanOrEqual") { return [](double x, double y) { return (x <= y) ? 1.0 : 0.0; }; }
+    return nullptr;
+}
+
+
+//! @brief Number of samples evaluated together by each instruction in batch evaluation
+static const int compiledExpressionBlockSize = 64;
+
+
+//! @brief Constructor for an empty (invalid) compiled expression
+CompiledExpression::CompiledExpression()
+{
+    mNumRegisters = 0;
+    mIsValid = false;
+}
+
+
+//! @brief Constructor that compiles an expression
+//! @param expr Expression to compile
+//! @param variables Names of variables, in the same order as values are given when evaluating
+CompiledExpression::CompiledExpression(const Expression &expr, const QStringList &variables)
+{
+    compile(expr, variables);
+}
+
+
+//! @brief Compiles an expression to byte code
+//! Compilation fails for expressions that Expression::evaluate() can not evaluate with the specified variables,
+//! and for expressions with custom functions.
+//! @param expr Expression to compile
+//! @param variables Names of variables, in the same order as values are given when evaluating
+//! @returns True if successful, otherwise false
+bool CompiledExpression::compile(const Expression &expr, const QStringList &variables)
+{
+    mVariables = variables;
+    mInstructions.clear();
+    mNumRegisters = 0;
+    mIsValid = compileRecursive(expr, 0);
+    if(!mIsValid) {
+        mInstructions.clear();
+    }
+    mRegisters.resize(mNumRegisters);
+    mBlockRegisters.resize(mNumRegisters*compiledExpressionBlockSize);
+    return mIsValid;
+}
+
+
+//! @brief Tells whether or not the expression was successfully compiled
+bool CompiledExpression::isValid() const
+{
+    return mIsValid;
+}
+
+
+//! @brief Returns the variable names, in the order values are expected when evaluating
+QStringList CompiledExpression::getVariables() const
+{
+    return mVariables;
+}
+
+
+//! @brief Returns the number of byte code instructions
+int CompiledExpression::getNumInstructions() const
+{
+    return mInstructions.size();
+}
+
+
+//! @brief Evaluates the compiled expression
+//! Operations are performed in the same order as in Expression::evaluate().
+//! @param pVariables Array with variable values, in the order specified when compiling
+//! @returns Value of the expression, or zero if the expression is not valid
+double CompiledExpression::evaluate(const double *pVariables) const
+{
+    if(!mIsValid) {
+        return 0;
+    }
+
+    double *r = mRegisters.data();
+    for(const Instruction &ins : mInstructions) {
+        switch(ins.operation) {
+        case Constant:
+            r[ins.dst] = ins.value;
+            break;
+        case Variable:
+            r[ins.dst] = pVariables[ins.arg1];
+            break;
+        case Add:
+            r[ins.dst] = r[ins.arg1] + r[ins.arg2];
+            break;
+        case Multiply:
+            r[ins.dst] = r[ins.arg1] * r[ins.arg2];
+            break;
+        case Divide:
+            r[ins.dst] = r[ins.arg1] / r[ins.arg2];
+            break;
+        case Negate:
+            r[ins.dst] = -r[ins.arg1];
+            break;
+        case Power:
+            r[ins.dst] = pow(r[ins.arg1], r[ins.arg2]);
+            break;
+        case Function1:
+            r[ins.dst] = ins.pFunction1(r[ins.arg1]);
+            break;
+        case Function2:
+            r[ins.dst] = ins.pFunction2(r[ins.arg1], r[ins.arg2]);
+            break;
+        case Limit:
+            if(r[ins.arg1] > r[ins.arg3]) { r[ins.dst] = r[ins.arg3]; }
+            else if(r[ins.arg1] < r[ins.arg2]) { r[ins.dst] = r[ins.arg2]; }
+            else { r[ins.dst] = r[ins.arg1]; }
+            break;
+        case Equal:
+            r[ins.dst] = (r[ins.arg1] == r[ins.arg2]) ? 1 : 0;
+            break;
+        }
+    }
+    return r[0];
+}
+
+
+//! @brief Evaluates the compiled expression for many samples
+//! Each instruction is applied to a block of samples at a time, which is much faster than evaluating each sample separately.
+//! @param ppVariables Array with one array of samples for each variable, in the order specified when compiling
+//! @param pResults Array where the results are written
+//! @param numSamples Number of samples to evaluate
+void CompiledExpression::evaluate(const double * const *ppVariables, double *pResults, const int numSamples) const
+{
+    const int bs = compiledExpressionBlockSize;
+    double *r = mBlockRegisters.data();
+    for(int start=0; start<numSamples; start+=bs) {
+        const int n = min(bs, numSamples-start);
+        if(!mIsValid) {
+            for(int i=0; i<n; ++i) { pResults[start+i] = 0; }
+            continue;
+        }
+        for(const Instruction &ins : mInstructions) {
+            double *pDst = r+ins.dst*bs;
+            const double *p1 = r+ins.arg1*bs;
+            const double *p2 = r+ins.arg2*bs;
+            const double *p3 = r+ins.arg3*bs;
+            switch(ins.operation) {
+            case Constant:
+                for(int i=0; i<n; ++i) { pDst[i] = ins.value; }
+                break;
+            case Variable:
+                p1 = ppVariables[ins.arg1]+start;
+                for(int i=0; i<n; ++i) { pDst[i] = p1[i]; }
+                break;
+            case Add:
+                for(int i=0; i<n; ++i) { pDst[i] = p1[i] + p2[i]; }
+                break;
+            case Multiply:
+                for(int i=0; i<n; ++i) { pDst[i] = p1[i] * p2[i]; }
+                break;
+            case Divide:
+                for(int i=0; i<n; ++i) { pDst[i] = p1[i] / p2[i]; }
+                break;
+            case Negate:
+                for(int i=0; i<n; ++i) { pDst[i] = -p1[i]; }
+                break;
+            case Power:
+                for(int i=0; i<n; ++i) { pDst[i] = pow(p1[i], p2[i]); }
+                break;
+            case Function1:
+                for(int i=0; i<n; ++i) { pDst[i] = ins.pFunction1(p1[i]); }
+                break;
+            case Function2:
+                for(int i=0; i<n; ++i) { pDst[i] = ins.pFunction2(p1[i], p2[i]); }
+                break;
+            case Limit:
+                for(int i=0; i<n; ++i) {
+                    if(p1[i] > p3[i]) { pDst[i] = p3[i]; }
+                    else if(p1[i] < p2[i]) { pDst[i] = p2[i]; }
+                    else { pDst[i] = p1[i]; }
+                }
+                break;
+            case Equal:
+                for(int i=0; i<n; ++i) { pDst[i] = (p1[i] == p2[i]) ? 1 : 0; }
+                break;
+            }
+        }
+        for(int i=0; i<n; ++i) {
+            pResults[start+i] = r[i];
+        }
+    }
+}
+
+
+//! @brief Compiles an expression so that its value ends up in the specified register
+//! Registers above the destination register are used for intermediate results.
+//! @param expr Expression to compile
+//! @param dst Destination register
+//! @returns True if successful, otherwise false
+bool CompiledExpression::compileRecursive(const Expression &expr, const int dst)
+{
+    if(dst+3 > mNumRegisters) {
+        mNumRegisters = dst+3;
+    }
+
+    if(expr.isAdd()) {
+        for(int t=0; t<expr.mTerms.size(); ++t) {
+            if(!compileRecursive(expr.mTerms[t], (t == 0) ? dst : dst+1)) {
+                return false;
+            }
+            if(t > 0) {
+                addInstruction(Add, dst, dst, dst+1);
+            }
+        }
+        return true;
+    }
+    else if(expr.isMultiplyOrDivide()) {
+        for(int f=0; f<expr.mFactors.size(); ++f) {
+            if(f > 0 && expr.mFactors[f] == Expression("-1")) {
+                addInstruction(Negate, dst, dst);
+                continue;
+            }
+            if(!compileRecursive(expr.mFactors[f], (f == 0) ? dst : dst+1)) {
+                return false;
+            }
+            if(f > 0) {
+                addInstruction(Multiply, dst, dst, dst+1);
+            }
+        }
+        for(const Expression &divisor : expr.mDivisors) {
+            if(!compileRecursive(divisor, dst+1)) {
+                return false;
+            }
+            addInstruction(Divide, dst, dst, dst+1);
+        }
+        return true;
+    }
+    else if(expr.isPower()) {
+        if(!compileRecursive(*expr.getBase(), dst) || !compileRecursive(*expr.getPower(), dst+1)) {
+            return false;
+        }
+        addInstruction(Power, dst, dst, dst+1);
+        return true;
+    }
+    else if(expr.isFunction()) {
+        const QString &name = expr.mFunction;
+        const QList<Expression> &args = expr.mArguments;
+        double (*pFunction1)(double) = getCompiledFunction1(name);
+        double (*pFunction2)(double, double) = getCompiledFunction2(name);
+        if(name == "der") {
+            addInstruction(Constant, dst);
+            return true;
+        }
+        else if(args.size() == 0 && name == "pi") {
+            addInstruction(Constant, dst);
+            mInstructions.last().value = M_PI;
+            return true;
+        }
+        else if(args.size() == 1 && pFunction1) {
+            if(!compileRecursive(args[0], dst)) {
+                return false;
+            }
+            addInstruction(Function1, dst, dst);
+            mInstructions.last().pFunction1 = pFunction1;
+            return true;
+        }
+        else if(args.size() == 2 && pFunction2) {
+            if(!compileRecursive(args[0], dst) || !compileRecursive(args[1], dst+1)) {
+                return false;
+            }
+            addInstruction(Function2, dst, dst, dst+1);
+            mInstructions.last().pFunction2 = pFunction2;
+            return true;
+        }
+        else if(args.size() == 3 && name == "limit") {
+            if(!compileRecursive(args[0], dst) || !compileRecursive(args[1], dst+1) || !compileRecursive(args[2], dst+2)) {
+                return false;
+            }
+            addInstruction(Limit, dst, dst, dst+1, dst+2);
+            return true;
+        }
+        else if(args.size() > 0 && args.size() <= 3 && mVariables.contains(expr.toString())) {
+            addInstruction(Variable, dst, mVariables.indexOf(expr.toString()));
+            return true;
+        }
+        gSymHopMessages << "In CompiledExpression::compile(): Unsupported function: "+expr.toString();
+        return false;
+    }
+    else if(expr.isNumericalSymbol()) {
+        addInstruction(Constant, dst);
+        mInstructions.last().value = expr.toDouble();
+        return true;
+    }
+    else if(expr.isVariable()) {
+        const int idx = mVariables.indexOf(expr.getSymbolName());
+        if(idx < 0) {
+            gSymHopMessages << "In CompiledExpression::compile(): Unknown variable: "+expr.getSymbolName();
+            return false;
+        }
+        addInstruction(Variable, dst, idx);
+        return true;
+    }
+    else if(expr.isEquation()) {
+        if(!compileRecursive(*expr.getLeft(), dst) || !compileRecursive(*expr.getRight(), dst+1)) {
+            return false;
+        }
+        addInstruction(Equal, dst, dst, dst+1);
+        return true;
+    }
+
+    gSymHopMessages << "In CompiledExpression::compile(): Unable to compile expression: "+expr.toString();
+    return false;
+}
+
+
+void CompiledExpression::addInstruction(const OperationT operation, const int dst, const int arg1, const int arg2, const int arg3)
+{
+    Instruction ins;
+    ins.operation = operation;
+    ins.dst = dst;
+    ins.arg1 = arg1;
+    ins.arg2 = arg2;
+    ins.arg3 = arg3;
+    ins.value = 0;
+    ins.pFunction1 = nullptr;
+    ins.pFunction2 = nullptr;
+    mInstructions.append(ins);
+}
@@ -437,10 +437,10 @@ private slots:
         pSystem->connect(pPort1, pPort2);
         pSystem->initialize(0, 100);
         pSystem->simulate(0.01);
-        std::vector<double> *pInData = pPort1->getDataVectorPtr();
-        std::vector<double> *pOutData = pPort3->getDataVectorPtr();
+        double *pInData = pPort1->getDataVectorPtr();
+        double *pOutData = pPort3->getDataVectorPtr();
         bool ok = true;
-        for(size_t i=0; i<pInData->size(); ++i) {
+        for(size_t i=0; i<pPort1->getNumDataVariables(); ++i) {
             if(pInData[i] != pOutData[i]) {
                 ok = false;
             }
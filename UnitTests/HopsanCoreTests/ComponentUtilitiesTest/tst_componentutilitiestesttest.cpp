@@ -539,6 +539,199 @@ private Q_SLOTS:
         QTest::newRow("5") << tempVec << 0.001 << 1.0 << -1000000000.0 << 2.0 << 2.0;
     }
 
+    void TLM_Line_Segments()
+    {
+        const double Zc = 1e9;
+        const double alpha = 0.3;
+        const double Ts = 0.001;
+
+        // A single segment must behave exactly as the wave equations in HydraulicTLMlossless
+        TLMLineSegments line;
+        line.initialize(1, 0.005, Ts, Zc, 1e5, 1e-4, 2e5, -1e-4);
+        double c1 = 2e5 + Zc*-1e-4;
+        double c2 = 1e5 + Zc*1e-4;
+        Delay delayedC1, delayedC2;
+        delayedC1.initialize(0.005-Ts, Ts, c1);
+        delayedC2.initialize(0.005-Ts, Ts, c2);
+        QCOMPARE(line.getDelaySteps(), delayedC1.getSize());
+        for (int i=0; i<1000; ++i)
+        {
+            const double p1 = 1e5 + 1e4*sin(0.1*i);
+            const double q1 = 1e-4*cos(0.3*i);
+            const double p2 = 2e5 + 1e4*sin(0.05*i);
+            const double q2 = -1e-4*cos(0.2*i);
+            line.update(p1, q1, p2, q2, Zc, alpha);
+            c1 = delayedC1.update(alpha*c1 + (1.0-alpha)*(p2 + Zc*q2));
+            c2 = delayedC2.update(alpha*c2 + (1.0-alpha)*(p1 + Zc*q1));
+            QCOMPARE(line.c1(), c1);
+            QCOMPARE(line.c2(), c2);
+        }
+
+        // Without filtering, lossless segments must behave as one line with the total delay
+        TLMLineSegments segments, whole;
+        segments.initialize(8, size_t(2), Zc, 1e5, 0.0, 1e5, 0.0);
+        whole.initialize(1, size_t(8*3-1), Zc, 1e5, 0.0, 1e5, 0.0);
+        for (int i=0; i<1000; ++i)
+        {
+            const double p1 = 1e5 + 1e4*sin(0.1*i);
+            const double q1 = 1e-4*cos(0.3*i);
+            const double p2 = 1e5 + 1e4*sin(0.05*i);
+            const double q2 = -1e-4*cos(0.2*i);
+            segments.update(p1, q1, p2, q2, Zc, 0.0);
+            whole.update(p1, q1, p2, q2, Zc, 0.0);
+            QCOMPARE(segments.c1(), whole.c1());
+            QCOMPARE(segments.c2(), whole.c2());
+        }
+
+        // A restored copy must continue exactly as the original
+        ComponentStateWriter writer;
+        segments.saveState(writer);
+        TLMLineSegments restored;
+        restored.initialize(8, size_t(2), Zc, 0.0, 0.0, 0.0, 0.0);
+        ComponentStateReader reader(writer.getData().data(), writer.getNumValues());
+        restored.restoreState(reader);
+        QVERIFY(!reader.hasFailed() && reader.isAtEnd());
+        for (int i=0; i<100; ++i)
+        {
+            segments.update(1e5, 1e-5*i, 1e5, 0.0, Zc, alpha);
+            restored.update(1e5, 1e-5*i, 1e5, 0.0, Zc, alpha);
+            QCOMPARE(restored.c1(), segments.c1());
+            QCOMPARE(restored.c2(), segments.c2());
+        }
+    }
+
+    void Fixed_Size_Equation_System_Solver()
+    {
+        // The fixed size solver must give exactly the same Newton steps as ludcmp() and solvlu()
+        const double weights[4] = {1.0, 0.67, 0.5, 0.5};
+        FixedSizeEquationSystemSolver<5> solver(0);
+        Matrix jacobian(5,5), referenceJacobian(5,5);
+        Vec equations(5), stateVars(5), referenceStateVars(5), delta(5);
+        int order[5];
+        for (int i=0; i<5; ++i)
+        {
+            stateVars[i] = referenceStateVars[i] = 0.1*i;
+        }
+        for (int iter=1; iter<=4; ++iter)
+        {
+            for (int i=0; i<5; ++i)
+            {
+                for (int j=0; j<5; ++j)
+                {
+                    jacobian[i][j] = referenceJacobian[i][j] = sin(1.0+i+3.0*j+iter);
+                }
+                equations[i] = cos(0.5*i+iter);
+            }
+            solver.solve(jacobian, equations, stateVars, iter);
+            ludcmp(referenceJacobian, order);
+            solvlu(referenceJacobian, equations, delta, order);
+            for (int i=0; i<5; ++i)
+            {
+                referenceStateVars[i] -= weights[iter-1]*delta[i];
+                QCOMPARE(stateVars[i], referenceStateVars[i]);
+            }
+        }
+
+        // With Jacobian reuse the iterations must still follow a slowly changing solution, x^2 = a and x*y = 1
+        FixedSizeEquationSystemSolver<2> reuseSolver(0);
+        reuseSolver.setJacobianReuse(true);
+        double x[2] = {1.0, 1.0};
+        double a = 1.0;
+        int numJacobians = 0;
+        for (int step=0; step<200; ++step)
+        {
+            a = 2.0 + 0.5*sin(0.01*step);
+            for (int iter=1; iter<=2; ++iter)
+            {
+                double jac[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+                if (reuseSolver.needsJacobian())
+                {
+                    jac[0][0] = 2.0*x[0];
+                    jac[1][0] = x[1];
+                    jac[1][1] = x[0];
+                    ++numJacobians;
+                }
+                const double eq[2] = {x[0]*x[0]-a, x[0]*x[1]-1.0};
+                reuseSolver.solve(jac, eq, x, iter);
+            }
+        }
+        QVERIFY(fabs(x[0]-sqrt(a)) < 1e-6);
+        QVERIFY(fabs(x[1]-1.0/sqrt(a)) < 1e-6);
+        QVERIFY(numJacobians < 400);
+    }
+
+    void Sparse_LU_Solver()
+    {
+        // A chain with a coupling between the first and last variable, column-major as in Component::getJacobian()
+        const int n = 30;
+        std::vector<double> jacobian(n*n, 0.0);
+        for (int i=0; i<n; ++i)
+        {
+            jacobian[i*n+i] = 4.0+sin(1.0*i);
+            if (i > 0)
+            {
+                jacobian[(i-1)*n+i] = cos(2.0*i);
+            }
+            if (i+1 < n)
+            {
+                jacobian[(i+1)*n+i] = sin(3.0*i+1.0);
+            }
+        }
+        jacobian[(n-1)*n+0] = 0.5;
+
+        SparseLUSolver solver;
+        solver.setSize(n);
+        for (int step=0; step<10; ++step)
+        {
+            for (int i=0; i<n; ++i)
+            {
+                jacobian[i*n+i] += 0.1;
+            }
+            std::vector<double> x(n);
+            for (int i=0; i<n; ++i)
+            {
+                x[i] = cos(1.0*i);
+            }
+            const std::vector<double> b = x;
+            QVERIFY(solver.factor(jacobian.data()));
+            solver.solve(x.data());
+            for (int r=0; r<n; ++r)
+            {
+                double sum = 0.0;
+                for (int c=0; c<n; ++c)
+                {
+                    sum += jacobian[c*n+r]*x[c];
+                }
+                QVERIFY(fabs(sum-b[r]) < 1e-12);
+            }
+        }
+
+        // Pivots and factor pattern must be reused, and the factors must stay sparse
+        QCOMPARE(solver.getNumSymbolicFactorizations(), size_t(1));
+        QCOMPARE(solver.getNumNonZeros(), size_t(3*n-1));
+        QVERIFY(solver.getNumFactorNonZeros() < size_t(5*n));
+
+        // A new non-zero element extends the pattern
+        jacobian[0*n+(n/2)] = 1.0;
+        QVERIFY(solver.factor(jacobian.data()));
+        QCOMPARE(solver.getNumNonZeros(), size_t(3*n));
+        QCOMPARE(solver.getNumSymbolicFactorizations(), size_t(2));
+
+        // Zero diagonal elements require pivoting outside the diagonal
+        SparseLUSolver swapSolver;
+        swapSolver.setSize(2);
+        const double swapMatrix[4] = {0.0, 2.0, 3.0, 0.0};
+        QVERIFY(swapSolver.factor(swapMatrix));
+        double swapVector[2] = {6.0, 4.0};
+        swapSolver.solve(swapVector);
+        QCOMPARE(swapVector[0], 2.0);
+        QCOMPARE(swapVector[1], 2.0);
+
+        // A singular matrix must be detected
+        const double singularMatrix[4] = {1.0, 2.0, 2.0, 4.0};
+        QVERIFY(!swapSolver.factor(singularMatrix));
+    }
+
     void ploParser()
     {
         QFETCH( QString, ploData);
@@ -468,6 +468,20 @@ private Q_SLOTS:
         QTest::newRow("hopsan,empty") << HString("hopsan") << HString("") << true;
         QTest::newRow("empty,hopsan") << HString("") << HString("hopsan") << false;
     }
+
+    void HString_internString()
+    {
+        HString kept = internString(HString("kept text"));
+
+        // Enough strings that are released directly to make the pool prune itself
+        for (int i=0; i<10000; ++i)
+        {
+            internString(HString("released text ")+HString(i));
+        }
+
+        QCOMPARE(QString(kept.c_str()), QString("kept text"));
+        QVERIFY2(internString(HString("kept text")).c_str() == kept.c_str(), "A string that is still used was released from the pool!");
+    }
 };
 
 QTEST_APPLESS_MAIN(HStringTests)
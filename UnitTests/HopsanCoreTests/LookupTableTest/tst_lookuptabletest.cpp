@@ -27,6 +27,8 @@
 #include <QPointF>
 #include <QtTest>
 #include <QTextStream>
+#include <QTemporaryDir>
+#include <QDir>
 
 
 #include "ComponentUtilities/LookupTable.h"
@@ -114,6 +116,9 @@ private Q_SLOTS:
     void lookup2D_data();
     void lookup3D();
     void lookup3D_data();
+    void sharedTable();
+    void findIndex();
+    void interpolateBatchND();
 };
 
 LookupTableTest::LookupTableTest()
@@ -480,6 +485,148 @@ void LookupTableTest::lookup3D_data()
 
 }
 
+void LookupTableTest::sharedTable()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    hopsan::setLookupTableCacheDirectory(qPrintable(cacheDir.path()));
+
+    LookupTable1D table;
+    for (size_t i=0; i<20000; ++i)
+    {
+        table.getIndexDataRef().push_back(double(i));
+        table.getValueDataRef().push_back(2.0*i);
+    }
+    QVERIFY(table.isDataOK());
+    hopsan::addSharedLookupTable("sharedTable", table);
+    QVERIFY2(QDir(cacheDir.path()).entryList(QDir::Files).size() == 1, "Large table was not written to the table cache!");
+
+    // A table loaded with the same key shares the data
+    LookupTable1D sharedTable;
+    QVERIFY(hopsan::getSharedLookupTable("sharedTable", sharedTable));
+    QVERIFY(sharedTable.getValueData() == table.getValueData());
+    QVERIFY(fc(sharedTable.interpolate(100.5), 201.0));
+
+    // Modifying one of the tables must not affect the other
+    sharedTable.getValueDataRef()[100] = 0;
+    QVERIFY(sharedTable.getValueData() != table.getValueData());
+    QVERIFY(fc(sharedTable.interpolate(100.0), 0.0));
+    QVERIFY(fc(table.interpolate(100.0), 200.0));
+
+    // Tables with another number of dimensions are not shared
+    LookupTable2D table2D;
+    QVERIFY(!hopsan::getSharedLookupTable("sharedTable", table2D));
+
+    // Data files are identified by their contents, a file rewritten with the same size gets a new key
+    QFile sourceFile(QDir(cacheDir.path()).filePath("table.csv"));
+    QVERIFY(sourceFile.open(QIODevice::WriteOnly));
+    sourceFile.write("1,2\n3,4\n");
+    sourceFile.close();
+    const hopsan::HString sourceKey = hopsan::getLookupTableSourceKey(qPrintable(sourceFile.fileName()), "");
+    QVERIFY(!sourceKey.empty());
+    QVERIFY(sourceFile.open(QIODevice::WriteOnly));
+    sourceFile.write("1,2\n3,5\n");
+    sourceFile.close();
+    QVERIFY2(hopsan::getLookupTableSourceKey(qPrintable(sourceFile.fileName()), "") != sourceKey, "Changed data file got the same key!");
+    hopsan::setLookupTableCacheDirectory("");
+}
+
+void LookupTableTest::findIndex()
+{
+    for (int uniform=0; uniform<2; ++uniform)
+    {
+        LookupTable1D table;
+        double x = -1.0;
+        for (size_t i=0; i<50; ++i)
+        {
+            table.getIndexDataRef().push_back(x);
+            table.getValueDataRef().push_back(x*x);
+            x += uniform ? 0.1 : 0.05+0.001*double(i*i);
+        }
+        QVERIFY(table.isDataOK());
+        QCOMPARE(table.isIndexUniform(0), bool(uniform));
+
+        // The interval must be the one a full search would find, for any order of lookups
+        const double *pIndex = table.getIndexData(0);
+        const size_t n = table.getDimSize(0);
+        QVector<double> queries;
+        for (size_t i=0; i<n; ++i)
+        {
+            queries << pIndex[i] << pIndex[i]+1e-12 << pIndex[i]-1e-12;
+        }
+        for (size_t i=0; i<n; ++i)
+        {
+            queries << pIndex[(i*17)%n] << 0.5*(pIndex[(i*31)%(n-1)]+pIndex[(i*31)%(n-1)+1]);
+        }
+        foreach(const double q, queries)
+        {
+            size_t expected = 0;
+            while ((expected+2 < n) && (q > pIndex[expected+1]))
+            {
+                ++expected;
+            }
+            QCOMPARE(table.findIndexAlongDim(0, q), expected);
+        }
+    }
+}
+
+void LookupTableTest::interpolateBatchND()
+{
+    // Build the same non-uniform 3D data in a 3D table and in an N-D table
+    LookupTable3D table3d;
+    LookupTableND tableNd(3);
+    const size_t dimSizes[3] = {5, 4, 3};
+    for (size_t d=0; d<3; ++d)
+    {
+        for (size_t i=0; i<dimSizes[d]; ++i)
+        {
+            const double x = double(d) + 0.5*double(i) + 0.01*double(i*i);
+            table3d.getIndexDataRef(d).push_back(x);
+            tableNd.getIndexDataRef(d).push_back(x);
+        }
+    }
+    for (size_t i=0; i<dimSizes[0]*dimSizes[1]*dimSizes[2]; ++i)
+    {
+        const double v = std::sin(double(i));
+        table3d.getValueDataRef().push_back(v);
+        tableNd.getValueDataRef().push_back(v);
+    }
+    QVERIFY(table3d.isDataOK());
+    QVERIFY(tableNd.isDataOK());
+
+    // Query points, both inside and outside of the index range
+    const size_t n = 200;
+    QVector<double> r, c, p, coordinates;
+    for (size_t i=0; i<n; ++i)
+    {
+        r << -0.5 + 0.0137*double((i*7)%n);
+        c << 0.5 + 0.0113*double((i*13)%n);
+        p << 1.5 + 0.0097*double((i*29)%n);
+        coordinates << r.back() << c.back() << p.back();
+    }
+
+    QVector<double> out3d(n), outNd(n);
+    table3d.interpolateBatch(r.constData(), c.constData(), p.constData(), out3d.data(), n);
+    tableNd.interpolateBatch(coordinates.constData(), outNd.data(), n);
+    for (size_t i=0; i<n; ++i)
+    {
+        QCOMPARE(out3d[i], table3d.interpolate(r[i], c[i], p[i]));
+        QCOMPARE(outNd[i], out3d[i]);
+    }
+
+    // The 1D batch must give the same result as the scalar lookup
+    LookupTable1D table1d;
+    table1d.getIndexDataRef() = table3d.getIndexDataRef(0);
+    table1d.getValueDataRef().assign(table3d.getValueData(), table3d.getValueData()+dimSizes[0]);
+    QVERIFY(table1d.isDataOK());
+    QVector<double> out1d(n);
+    table1d.interpolateBatch(r.constData(), out1d.data(), n);
+    for (size_t i=0; i<n; ++i)
+    {
+        QCOMPARE(out1d[i], table1d.interpolate(r[i]));
+    }
+}
+
 QTEST_APPLESS_MAIN(LookupTableTest)
 
 #include "tst_lookuptabletest.moc"
@@ -26,8 +26,11 @@
 
 #include "HopsanEssentials.h"
 #include "HopsanCoreVersion.h"
+#include "Nodes.h"
 #include "CoreUtilities/HopsanCoreMessageHandler.h"
 #include "CoreUtilities/HmfLoader.h"
+#include "CoreUtilities/LogSink.h"
+#include "CoreUtilities/SaveRestoreSimulationPoint.h"
 
 #include <assert.h>
 #include <algorithm>
@@ -54,6 +57,49 @@ Q_DECLARE_METATYPE(HString)
 Q_DECLARE_METATYPE(Component*)
 Q_DECLARE_METATYPE(Port*)
 Q_DECLARE_METATYPE(Node*)
+Q_DECLARE_METATYPE(ParallelAlgorithmT)
+Q_DECLARE_METATYPE(BarrierModeT)
+
+//! @brief Log sink that counts the samples it receives, used to test log streaming
+class CountingLogSink : public LogSink
+{
+public:
+    size_t mNumVariables = 0;
+    size_t mNumSamples = 0;
+    bool mIsOpen = false;
+    bool mFailOnClose = false;
+    std::vector<HString> mSystemHierarchies;
+
+    bool open(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables) override
+    {
+        HOPSAN_UNUSED(rSystemName)
+        mNumVariables = rVariables.size();
+        mSystemHierarchies.clear();
+        for (const LogSinkVariable &rVariable : rVariables) {
+            mSystemHierarchies.push_back(rVariable.systemHierarchy);
+        }
+        mNumSamples = 0;
+        mIsOpen = true;
+        return true;
+    }
+
+    void writeChunk(const double *pTime, const double *pValues, const size_t numSamples) override
+    {
+        HOPSAN_UNUSED(pTime)
+        HOPSAN_UNUSED(pValues)
+        mNumSamples += numSamples;
+    }
+
+    bool close() override
+    {
+        mIsOpen = false;
+        if (mFailOnClose) {
+            mLastError = "Simulated write failure";
+            return false;
+        }
+        return true;
+    }
+};
 
 
 class SimulationTests : public QObject
@@ -1078,18 +1124,431 @@ private slots:
         QVERIFY2(mpSystemFromFile->getLogTimeVector()->size() == 2048, "Failed to simulate system!");
         QVERIFY2(mpSystemFromFile->getNumActuallyLoggedSamples() == 2048, "Failed to simulate system!");
 
-        std::vector<double> multiResults1 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataVectorPtr()->at(0);
-        std::vector<double> multiResults2 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataVectorPtr()->at(511);
-        std::vector<double> multiResults3 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataVectorPtr()->at(1023);
+        double multiResults1 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr()->getValue(0, 0);
+        double multiResults2 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr()->getValue(511, 0);
+        double multiResults3 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr()->getValue(1023, 0);
         mpSystemFromFile->simulate(10.0);
-        std::vector<double> singleResults1 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataVectorPtr()->at(0);
-        std::vector<double> singleResults2 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataVectorPtr()->at(511);
-        std::vector<double> singleResults3 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataVectorPtr()->at(1023);
+        double singleResults1 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr()->getValue(0, 0);
+        double singleResults2 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr()->getValue(511, 0);
+        double singleResults3 = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr()->getValue(1023, 0);
         QVERIFY2(multiResults1 == singleResults1, "Single-threaded and multi-threaded simulation gave different results!");
         QVERIFY2(multiResults2 == singleResults2, "Single-threaded and multi-threaded simulation gave different results!");
         QVERIFY2(multiResults3 == singleResults3, "Single-threaded and multi-threaded simulation gave different results!");
     }
 
+    void System_Simulate_Multicore_Compare()
+    {
+        QFETCH(ParallelAlgorithmT, algorithm);
+        QFETCH(BarrierModeT, barrierMode);
+        QFETCH(bool, reuseSchedule);
+
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        mpSystemFromFile->simulate(10.0);
+        const LogDataStore *pLog = mpSystemFromFile->getSubComponent("TestOrifice1")->getPort("P1")->getLogDataStorePtr();
+        const std::vector<double> singleResults(pLog->getColumn(0), pLog->getColumn(0)+pLog->getNumSlots());
+
+        mpSystemFromFile->setMultiThreadingBarrierMode(barrierMode);
+        if (reuseSchedule) {
+            // Create the schedule in the persistent simulation threads, the simulation below reuses it
+            QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+            mpSystemFromFile->simulateMultiThreaded(0, 10.0, 4, false, algorithm);
+        }
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        mpSystemFromFile->simulateMultiThreaded(0, 10.0, 4, reuseSchedule, algorithm);
+        mpSystemFromFile->setMultiThreadingBarrierMode(SpinningBarrier);
+        QVERIFY2(mpSystemFromFile->getNumActuallyLoggedSamples() == 2048, "Failed to simulate system!");
+        pLog = mpSystemFromFile->getSubComponent("TestOrifice1")->getPort("P1")->getLogDataStorePtr();
+        const std::vector<double> multiResults(pLog->getColumn(0), pLog->getColumn(0)+pLog->getNumSlots());
+        QVERIFY2(multiResults == singleResults, "Single-threaded and multi-threaded simulation gave different results!");
+    }
+
+    void System_Simulate_Multicore_Compare_data()
+    {
+        QTest::addColumn<ParallelAlgorithmT>("algorithm");
+        QTest::addColumn<BarrierModeT>("barrierMode");
+        QTest::addColumn<bool>("reuseSchedule");
+        QTest::newRow("work stealing") << WorkStealingAlgorithm << SpinningBarrier << false;
+        QTest::newRow("graph partitioning") << GraphPartitioningAlgorithm << SpinningBarrier << false;
+        QTest::newRow("reuse schedule") << APrioriScheduling << SpinningBarrier << true;
+        QTest::newRow("blocking barrier") << APrioriScheduling << BlockingBarrier << false;
+    }
+
+    void System_Simulate_Batch()
+    {
+        double startT, stopT;
+        std::vector<ComponentSystem*> systems;
+        QVERIFY2(mHopsanCore.loadHMFModelFileCopies(TEST_DATA_ROOT "unittestmodel.hmf", 3, systems, startT, stopT), "Could not load model copies!");
+
+        std::vector<BatchParameterValuesT> parameters(systems.size());
+        for(size_t i=0; i<systems.size(); ++i)
+        {
+            systems[i]->setLogOnlyVariables(std::vector<HString>(1, "TestStep#out#Value"));
+            parameters[i].push_back(std::pair<HString, HString>("TestStep#y_A#Value", HString(std::to_string(i+1).c_str())));
+        }
+
+        BatchSimulationResults results;
+        QVERIFY2(mHopsanCore.getSimulationHandler()->simulateBatch(0, 10.0, 0, systems, parameters, results), "Batch simulation failed!");
+        QVERIFY(results.getNumInstances() == systems.size());
+
+        size_t stepVariable = results.getNumVariables();
+        for(size_t v=0; v<results.getNumVariables(); ++v)
+        {
+            if(results.getVariables()[v].componentName == "TestStep")
+            {
+                stepVariable = v;
+            }
+        }
+        QVERIFY2(stepVariable < results.getNumVariables(), "Selected variable was not logged!");
+
+        for(size_t i=0; i<systems.size(); ++i)
+        {
+            QVERIFY(results.wasSuccessful(i));
+            const size_t nSamples = results.getNumSamples(i);
+            QVERIFY(nSamples > 0);
+            QCOMPARE(results.getTimeColumn(i)[nSamples-1], 10.0);
+            QCOMPARE(results.getColumn(i, stepVariable)[nSamples-1], -5.0+double(i+1));
+            mHopsanCore.removeComponent(systems[i]);
+        }
+    }
+
+    void System_Save_Resume_Simulation_Point()
+    {
+        const HString filePath = qPrintable(QDir::temp().filePath("hopsan_unittest_simulationpoint.hsp"));
+        double startT, stopT;
+        ComponentSystem *pSystems[2];
+        for(size_t i=0; i<2; ++i)
+        {
+            pSystems[i] = mHopsanCore.loadHMFModelFile(TEST_DATA_ROOT "unittestmodel.hmf", startT, stopT);
+            QVERIFY(pSystems[i]);
+            // A low-pass filter keeps states that are not stored in node data
+            Component *pFilter = mHopsanCore.createComponent("SignalFirstOrderTransferFunction");
+            pFilter->setName("TestFilter");
+            pSystems[i]->addComponent(pFilter);
+            QVERIFY(pFilter->setParameterValue("a_1", "0"));
+            QVERIFY(pSystems[i]->connect("TestStep", "out", "TestFilter", "in"));
+        }
+
+        // Take the simulation point after the step, while the filter is still settling
+        QVERIFY(pSystems[0]->initialize(0, 10.0));
+        pSystems[0]->simulate(8.0);
+        QVERIFY2(saveSimulationPoint(filePath, pSystems[0]), "Could not save simulation point!");
+        pSystems[0]->simulate(10.0);
+
+        SimulationPoint simulationPoint;
+        QVERIFY2(simulationPoint.load(filePath), "Could not load simulation point!");
+        QCOMPARE(simulationPoint.getVersion(), 1u);
+        QVERIFY(qFuzzyCompare(simulationPoint.getTime(), 8.0));
+        QVERIFY(pSystems[1]->initialize(simulationPoint.getTime(), 10.0));
+        QVERIFY(simulationPoint.resume(pSystems[1]));
+        pSystems[1]->simulate(10.0);
+
+        QCOMPARE(pSystems[1]->getTime(), pSystems[0]->getTime());
+        const double *pResumed = pSystems[1]->getSubComponent("TestFilter")->getPort("out")->getDataVectorPtr();
+        const double *pOriginal = pSystems[0]->getSubComponent("TestFilter")->getPort("out")->getDataVectorPtr();
+        QVERIFY2(pResumed[0] == pOriginal[0], "Resumed simulation did not continue exactly where the simulation point was taken!");
+
+        simulationPoint.clear();
+        QFile::remove(QString::fromUtf8(filePath.c_str()));
+        mHopsanCore.removeComponent(pSystems[0]);
+        mHopsanCore.removeComponent(pSystems[1]);
+    }
+
+    void System_Snapshot_Rewind_And_Fork()
+    {
+        double startT, stopT;
+        std::vector<ComponentSystem*> systems;
+        QVERIFY2(mHopsanCore.loadHMFModelFileCopies(TEST_DATA_ROOT "unittestmodel.hmf", 2, systems, startT, stopT), "Could not load model copies!");
+        for(size_t i=0; i<systems.size(); ++i)
+        {
+            Component *pFilter = mHopsanCore.createComponent("SignalFirstOrderTransferFunction");
+            pFilter->setName("TestFilter");
+            systems[i]->addComponent(pFilter);
+            QVERIFY(pFilter->setParameterValue("a_1", "0"));
+            QVERIFY(systems[i]->connect("TestStep", "out", "TestFilter", "in"));
+            QVERIFY(systems[i]->initialize(0, 10.0));
+        }
+
+        // Take the snapshot after the step, while the filter is still settling
+        systems[0]->simulate(8.0);
+        SimulationSnapshot snapshot;
+        systems[0]->takeSnapshot(snapshot);
+        QVERIFY(!snapshot.isEmpty());
+        QCOMPARE(snapshot.getTime(), systems[0]->getTime());
+        systems[0]->simulate(10.0);
+        const double *pOriginal = systems[0]->getSubComponent("TestFilter")->getPort("out")->getDataVectorPtr();
+        const double original = pOriginal[0];
+        const size_t numLoggedSamples = systems[0]->getNumActuallyLoggedSamples();
+
+        // Rewind the same system
+        QVERIFY2(systems[0]->restoreSnapshot(snapshot), "Could not rewind to snapshot!");
+        QCOMPARE(systems[0]->getTime(), snapshot.getTime());
+        systems[0]->simulate(10.0);
+        QVERIFY2(pOriginal[0] == original, "Rewound simulation did not continue exactly where the snapshot was taken!");
+        QCOMPARE(systems[0]->getNumActuallyLoggedSamples(), numLoggedSamples);
+
+        // Fork into the other copy
+        QVERIFY2(systems[1]->restoreSnapshot(snapshot), "Could not restore snapshot in model copy!");
+        systems[1]->simulate(10.0);
+        const double *pForked = systems[1]->getSubComponent("TestFilter")->getPort("out")->getDataVectorPtr();
+        QVERIFY2(pForked[0] == original, "Forked simulation did not continue exactly where the snapshot was taken!");
+
+        // A snapshot can not be restored into a system with other components
+        systems[1]->removeSubComponent("TestFilter", true);
+        QVERIFY(!systems[1]->restoreSnapshot(snapshot));
+
+        mHopsanCore.removeComponent(systems[0]);
+        mHopsanCore.removeComponent(systems[1]);
+    }
+
+    void System_Warm_Reinitialize()
+    {
+        double startT, stopT;
+        ComponentSystem *pSystem = mHopsanCore.loadHMFModelFile(TEST_DATA_ROOT "unittestmodel.hmf", startT, stopT);
+        QVERIFY(pSystem);
+        pSystem->setWarmReinitialization(true);
+        Component *pStep = pSystem->getSubComponent("TestStep");
+
+        // Only values change, the second initialization skips the structural setup
+        for (int y_A=1; y_A<=3; y_A+=2)
+        {
+            QVERIFY(pStep->setParameterValue("y_A#Value", HString(std::to_string(y_A).c_str())));
+            QVERIFY(pSystem->checkModelBeforeSimulation());
+            QVERIFY(pSystem->initialize(0, 10.0));
+            pSystem->simulate(10.0);
+            pSystem->finalize();
+            QCOMPARE(pStep->getPort("out")->getDataVectorPtr()[0], -5.0+y_A);
+        }
+
+        // Structural changes are detected and force a full initialization
+        Component *pFilter = mHopsanCore.createComponent("SignalFirstOrderTransferFunction");
+        pFilter->setName("TestFilter");
+        pSystem->addComponent(pFilter);
+        QVERIFY(pFilter->setParameterValue("a_1", "0"));
+        QVERIFY(pSystem->connect("TestStep", "out", "TestFilter", "in"));
+        QVERIFY(pSystem->checkModelBeforeSimulation());
+        QVERIFY(pSystem->initialize(0, 10.0));
+        pSystem->simulate(10.0);
+        pSystem->finalize();
+        const double warmFilterOut = pFilter->getPort("out")->getDataVectorPtr()[0];
+
+        pSystem->setWarmReinitialization(false);
+        QVERIFY(pSystem->checkModelBeforeSimulation());
+        QVERIFY(pSystem->initialize(0, 10.0));
+        pSystem->simulate(10.0);
+        pSystem->finalize();
+        QCOMPARE(pFilter->getPort("out")->getDataVectorPtr()[0], warmFilterOut);
+
+        mHopsanCore.removeComponent(pSystem);
+    }
+
+    void System_Grouped_Simulation()
+    {
+        // A chain of orifices and volumes, most C and Q components are of the same type
+        ComponentSystem *pSystem = mHopsanCore.createComponentSystem();
+        pSystem->setDesiredTimestep(0.001);
+        Component *pSource = mHopsanCore.createComponent("HydraulicPressureSourceC");
+        pSystem->addComponent(pSource);
+        QVERIFY(pSource->setParameterValue("p#Value", "1e7"));
+        std::vector<Component*> volumes;
+        HString prevName = pSource->getName(), prevPort = "P1";
+        for (size_t i=0; i<20; ++i)
+        {
+            Component *pOrifice = mHopsanCore.createComponent((i%2) ? "HydraulicLaminarOrifice" : "HydraulicTurbulentOrifice");
+            Component *pVolume = mHopsanCore.createComponent("HydraulicVolume");
+            pSystem->addComponent(pOrifice);
+            pSystem->addComponent(pVolume);
+            QVERIFY(pSystem->connect(prevName, prevPort, pOrifice->getName(), "P1"));
+            QVERIFY(pSystem->connect(pOrifice->getName(), "P2", pVolume->getName(), "P1"));
+            volumes.push_back(pVolume);
+            prevName = pVolume->getName();
+            prevPort = "P2";
+        }
+        Component *pOrifice = mHopsanCore.createComponent("HydraulicLaminarOrifice");
+        Component *pTank = mHopsanCore.createComponent("HydraulicTankC");
+        pSystem->addComponent(pOrifice);
+        pSystem->addComponent(pTank);
+        QVERIFY(pSystem->connect(prevName, prevPort, pOrifice->getName(), "P1"));
+        QVERIFY(pSystem->connect(pOrifice->getName(), "P2", pTank->getName(), "P1"));
+
+        // Grouped simulation must give exactly the same results as ordinary simulation
+        // In the last run grouping is enabled after initialize, so it only takes effect at the next initialization
+        std::vector<double> pressures[3];
+        for (int run=0; run<3; ++run)
+        {
+            const bool grouped = (run == 1);
+            pSystem->setGroupedSimulation(grouped);
+            QCOMPARE(pSystem->isUsingGroupedSimulation(), grouped);
+            QVERIFY(pSystem->checkModelBeforeSimulation());
+            QVERIFY(pSystem->initialize(0, 1.0));
+            if (run == 2)
+            {
+                pSystem->setGroupedSimulation(true);
+            }
+            pSystem->simulate(1.0);
+            pSystem->finalize();
+            QCOMPARE(pSystem->getTime(), 1.0);
+            if (grouped)
+            {
+                // 42 C and Q components of five types, one group per type and one group per stage for components that are not batched
+                QVERIFY2((pSystem->getNumSimulationGroups() > 0) && (pSystem->getNumSimulationGroups() <= 7), "Components were not grouped!");
+            }
+            else
+            {
+                QCOMPARE(pSystem->getNumSimulationGroups(), size_t(0));
+            }
+            for (size_t i=0; i<volumes.size(); ++i)
+            {
+                pressures[run].push_back(volumes[i]->getPort("P1")->getDataVectorPtr()[NodeHydraulic::Pressure]);
+            }
+        }
+        QVERIFY(pressures[0].back() > 0);
+        for (size_t i=0; i<volumes.size(); ++i)
+        {
+            QCOMPARE(pressures[1][i], pressures[0][i]);
+            QCOMPARE(pressures[2][i], pressures[0][i]);
+        }
+
+        mHopsanCore.removeComponent(pSystem);
+    }
+
+    void System_Load_Model_Cache()
+    {
+        const QString cachePath = QDir::temp().filePath("hopsan_unittest_modelcache.hmc");
+        // A corrupt cache file is ignored and rewritten
+        QFile corruptCache(cachePath);
+        QVERIFY(corruptCache.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        const qint64 corruptCacheSize = corruptCache.write("not a model cache");
+        corruptCache.close();
+
+        double startT, stopT;
+        ComponentSystem *pSystems[3];
+        pSystems[0] = mHopsanCore.loadHMFModelFile(TEST_DATA_ROOT "unittestmodel.hmf", startT, stopT);
+        QVERIFY(pSystems[0]);
+        // The first cached load writes the cache, the second one builds the model from it
+        for(size_t i=1; i<3; ++i)
+        {
+            double cachedStartT, cachedStopT;
+            pSystems[i] = mHopsanCore.loadHMFModelFileCached(TEST_DATA_ROOT "unittestmodel.hmf", qPrintable(cachePath), cachedStartT, cachedStopT);
+            QVERIFY2(pSystems[i], "Could not load model through the model cache!");
+            QCOMPARE(cachedStartT, startT);
+            QCOMPARE(cachedStopT, stopT);
+            QVERIFY2(QFileInfo(cachePath).size() > corruptCacheSize, "Model cache file was not written!");
+        }
+
+        for(size_t i=0; i<3; ++i)
+        {
+            QCOMPARE(pSystems[i]->getSubComponentNames().size(), pSystems[0]->getSubComponentNames().size());
+            QVERIFY(pSystems[i]->checkModelBeforeSimulation());
+            QVERIFY(pSystems[i]->initialize(0, 10.0));
+            pSystems[i]->simulate(10.0);
+            pSystems[i]->finalize();
+            QCOMPARE(pSystems[i]->getSubComponent("TestOrifice1")->getPort("P1")->getDataVectorPtr()[NodeHydraulic::Pressure],
+                     pSystems[0]->getSubComponent("TestOrifice1")->getPort("P1")->getDataVectorPtr()[NodeHydraulic::Pressure]);
+        }
+
+        QFile::remove(cachePath);
+        for(size_t i=0; i<3; ++i)
+        {
+            mHopsanCore.removeComponent(pSystems[i]);
+        }
+    }
+
+    void System_Model_Template()
+    {
+        ModelTemplate modelTemplate(&mHopsanCore);
+        QVERIFY(!modelTemplate.isLoaded());
+        QVERIFY(modelTemplate.createInstance() == 0);
+        QVERIFY2(modelTemplate.loadFile(TEST_DATA_ROOT "unittestmodel.hmf"), "Could not load model template!");
+
+        ComponentSystem *pSystems[2];
+        for(size_t i=0; i<2; ++i)
+        {
+            pSystems[i] = modelTemplate.createInstance();
+            QVERIFY2(pSystems[i], "Could not create model instance from template!");
+        }
+        QVERIFY(pSystems[0] != pSystems[1]);
+
+        // Changing a parameter in one instance must not affect the other
+        HString value;
+        QVERIFY(pSystems[0]->getSubComponent("TestOrifice1")->setParameterValue("Kc#Value", "0.2e-11"));
+        pSystems[0]->getSubComponent("TestOrifice1")->getParameterValue("Kc#Value", value);
+        QCOMPARE(QString(value.c_str()), QString("0.2e-11"));
+        pSystems[1]->getSubComponent("TestOrifice1")->getParameterValue("Kc#Value", value);
+        QCOMPARE(QString(value.c_str()), QString("0.1e-11"));
+
+        // Copies of strings share text until one of them is modified
+        HString original("shared text");
+        HString copy(original);
+        QVERIFY(copy.c_str() == original.c_str());
+        copy[0] = 'S';
+        QCOMPARE(QString(original.c_str()), QString("shared text"));
+        QCOMPARE(QString(copy.c_str()), QString("Shared text"));
+        QVERIFY(internString(original).c_str() == internString(HString("shared text")).c_str());
+
+        for(size_t i=0; i<2; ++i)
+        {
+            mHopsanCore.removeComponent(pSystems[i]);
+        }
+    }
+
+    void System_Log_Only_Variables()
+    {
+        mpSystemFromFile->setLogOnlyVariables(std::vector<HString>(1, "TestStep#out"));
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        mpSystemFromFile->simulate(10.0);
+        const LogDataStore *pStepLog = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr();
+        const LogDataStore *pOrificeLog = mpSystemFromFile->getSubComponent("TestOrifice1")->getPort("P1")->getLogDataStorePtr();
+        QVERIFY2(pStepLog->isLogged(0), "Selected variable was not logged!");
+        QVERIFY2(!pOrificeLog || !pOrificeLog->isLogged(0), "Variable that was not selected was logged!");
+
+        mpSystemFromFile->clearLogOnlyVariables();
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        mpSystemFromFile->simulate(10.0);
+        QVERIFY2(!pOrificeLog || pOrificeLog->isLogged(0), "Variable was not logged after clearing log only variables!");
+
+        // A selection made directly in a subsystem is kept, and logged together with the selection forwarded from the parent
+        ComponentSystem *pSubsystem = static_cast<ComponentSystem*>(mpSystemFromFile->getSubComponent("Subsystem"));
+        pSubsystem->setLogOnlyVariables(std::vector<HString>(1, "Gain#out"));
+        mpSystemFromFile->setLogOnlyVariables(std::vector<HString>(1, "TestStep#out"));
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        QVERIFY2(pSubsystem->isUsingLogOnlyVariables() && (pSubsystem->getLogOnlyVariables().size() == 1), "Subsystem log only variables were changed by the parent system!");
+        QVERIFY2(pSubsystem->getSubComponent("Gain")->getPort("out")->getLogDataStorePtr()->isLogged(0), "Variable selected in subsystem was not logged!");
+        mpSystemFromFile->clearLogOnlyVariables();
+        pSubsystem->clearLogOnlyVariables();
+    }
+
+    void System_Log_Sink()
+    {
+        CountingLogSink sink;
+        mpSystemFromFile->setLogOnlyVariables({"TestStep#out", "Subsystem$Gain#out"});
+        mpSystemFromFile->setLogSink(&sink, false);
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        QVERIFY(sink.mIsOpen);
+        mpSystemFromFile->simulate(10.0);
+        mpSystemFromFile->finalize();
+        QVERIFY2(!sink.mIsOpen, "Log sink was not closed in finalize!");
+        QCOMPARE(sink.mNumVariables, size_t(2));
+        QVERIFY2(sink.mSystemHierarchies.back() == "Subsystem$", "Subsystem variable was not streamed!");
+        QCOMPARE(sink.mNumSamples, mpSystemFromFile->getNumActuallyLoggedSamples());
+        const LogDataStore *pStepLog = mpSystemFromFile->getSubComponent("TestStep")->getPort("out")->getLogDataStorePtr();
+        QVERIFY2(!pStepLog || pStepLog->empty(), "Data was kept in memory when only streaming!");
+        ComponentSystem *pSubsystem = dynamic_cast<ComponentSystem*>(mpSystemFromFile->getSubComponent("Subsystem"));
+        const LogDataStore *pGainLog = pSubsystem->getSubComponent("Gain")->getPort("out")->getLogDataStorePtr();
+        QVERIFY2(!pGainLog || pGainLog->empty(), "Subsystem data was kept in memory when only streaming!");
+        QVERIFY2(mpSystemFromFile->getLogTimeVector()->empty(), "Log time was kept in memory when only streaming!");
+
+        // A sink that fails to write its output must be reported when the system is finalized
+        sink.mFailOnClose = true;
+        QVERIFY(mpSystemFromFile->initialize(0, 10.0));
+        mpSystemFromFile->simulate(10.0);
+        const size_t numErrors = mHopsanCore.getNumErrorMessages();
+        mpSystemFromFile->finalize();
+        QVERIFY2(mHopsanCore.getNumErrorMessages() == numErrors+1, "Log sink write failure was not reported in finalize!");
+
+        mpSystemFromFile->setLogSink(nullptr);
+        mpSystemFromFile->clearLogOnlyVariables();
+    }
+
     void Component_Set_Parameter()
     {
         QFETCH(QString, compName);
@@ -1288,6 +1747,28 @@ private slots:
         QTest::newRow("20") << HString("Subsystem$Subsubsystem$1DLookupTable_1") << HString("comment") << HString("string") << HString("K") << HString("K");
     }
 
+    void Component_Reevaluate_Changed_System_Parameter()
+    {
+        // Parameter values are cached, make sure that changes in the system parameters they depend on are picked up
+        Component *pGain = nullptr, *pGain1 = nullptr;
+        getComponent("Subsystem$Gain", &pGain);
+        getComponent("Subsystem$Gain_1", &pGain1);
+        HString value;
+        bool isOK;
+        QVERIFY(pGain->evaluateParameter("k#Value", value, "double"));
+        QCOMPARE(value.toDouble(&isOK), 3.0);
+
+        QVERIFY(mpSystemFromFile->setParameterValue("main_a", "5"));
+        QVERIFY(pGain->evaluateParameter("k#Value", value, "double"));
+        QCOMPARE(value.toDouble(&isOK), 7.0);
+        QVERIFY(pGain1->evaluateParameter("k#Value", value, "double"));
+        QCOMPARE(value.toDouble(&isOK), 7.0);
+
+        QVERIFY(mpSystemFromFile->setParameterValue("main_a", "1"));
+        QVERIFY(pGain->evaluateParameter("k#Value", value, "double"));
+        QCOMPARE(value.toDouble(&isOK), 3.0);
+    }
+
     void Component_Get_CQS()
     {
         QFETCH(Component*, comp);
@@ -29,6 +29,8 @@
 #include "CoreUtilities/HopsanCoreMessageHandler.h"
 #include "CoreUtilities/StringUtilities.h"
 #include "CoreUtilities/MultiThreadingUtilities.h"
+#include "CoreUtilities/LogDataStore.h"
+#include <cmath>
 
 using namespace hopsan;
 
@@ -222,6 +224,54 @@ private Q_SLOTS:
         QTest::newRow("7") << 8;
         QTest::newRow("8") << 9;
     }
+
+    void Log_Data_Store()
+    {
+        QFETCH(int, numSlots);
+        QFETCH(int, numLogged);
+
+        const size_t numVars = 3;
+        LogDataStore store;
+        store.allocate(numVars, size_t(numSlots));
+        QVERIFY2(store.getNumSlots() == size_t(numSlots), "LogDataStore allocated wrong number of slots!");
+
+        double values[numVars];
+        for (size_t s=0; s<size_t(numLogged); ++s)
+        {
+            for (size_t v=0; v<numVars; ++v)
+            {
+                values[v] = double(s*10+v);
+            }
+            store.logSample(s, values);
+        }
+
+        // Every logged sample must be readable from the columns after flushing the chunk buffer
+        store.flush();
+        for (size_t v=0; v<numVars; ++v)
+        {
+            const double *pColumn = store.getColumn(v);
+            for (size_t s=0; s<size_t(numLogged); ++s)
+            {
+                QVERIFY2(pColumn[s] == double(s*10+v), "LogDataStore returned wrong value!");
+            }
+        }
+
+        QVERIFY2(std::isnan(store.getValue(0, numVars)), "LogDataStore returned a value for a variable that is not logged!");
+
+        store.clear();
+        QVERIFY2(store.empty() && (store.getColumn(0) == 0), "LogDataStore was not cleared!");
+    }
+
+    void Log_Data_Store_data()
+    {
+        QTest::addColumn<int>("numSlots");
+        QTest::addColumn<int>("numLogged");
+
+        QTest::newRow("0") << 10 << 10;
+        QTest::newRow("1") << 1000 << 1000;
+        QTest::newRow("2") << 1000 << 130;
+        QTest::newRow("3") << int(LogDataStore::ChunkSize) << int(LogDataStore::ChunkSize);
+    }
 };
 QTEST_APPLESS_MAIN(UtilitiesTestTest)
 
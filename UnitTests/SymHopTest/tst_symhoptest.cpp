@@ -908,6 +908,141 @@ private Q_SLOTS:
 
 
 
+    void SymHop_Reduce_Strength()
+    {
+        QFETCH(Expression, expr);
+        QFETCH(stringDoubleMap, vars);
+        QFETCH(int, functionCalls);
+        Expression reduced = expr;
+        reduced.reduceStrength();
+        OperationCount count;
+        reduced.countOperations(count);
+        QString failmsg1("Failure! reduceStrength() changed the value of "+expr.toString()+" to "+reduced.toString()+".");
+        QVERIFY2(fuzzyEqual(reduced.evaluate(vars), expr.evaluate(vars)), failmsg1.toStdString().c_str());
+        QString failmsg2("Failure! Wrong number of function calls in "+reduced.toString()+": "+QString::number(count.functionCalls)+" != "+QString::number(functionCalls));
+        QVERIFY2(count.functionCalls == functionCalls, failmsg2.toStdString().c_str());
+    }
+
+    void SymHop_Reduce_Strength_data()
+    {
+        QTest::addColumn<Expression>("expr");
+        QTest::addColumn<stringDoubleMap>("vars");
+        QTest::addColumn<int>("functionCalls");
+        stringDoubleMap variables;
+        variables.insert("x", 1.3);
+        variables.insert("y", -0.7);
+        QTest::newRow("0") << Expression("y*x^2") << variables << 0;
+        QTest::newRow("1") << Expression("y/x^3") << variables << 0;
+        QTest::newRow("2") << Expression("x^0.5") << variables << 1;
+        QTest::newRow("3") << Expression("y*x^-0.5") << variables << 1;
+        QTest::newRow("4") << Expression("x^y") << variables << 1;
+        QTest::newRow("5") << Expression("sin(x^2)") << variables << 1;
+    }
+
+    void SymHop_Optimize_Expressions()
+    {
+        QFETCH(QList<Expression>, exprs);
+        QFETCH(QStringList, constants);
+        QFETCH(stringDoubleMap, vars);
+        QFETCH(int, operations);
+        QList<Expression> optimized = exprs;
+        QList<Expression> constantDefinitions, temporaries;
+        foldConstants(optimized, constants, constantDefinitions, "c");
+        eliminateCommonSubexpressions(optimized, temporaries, "tmp");
+
+        //Evaluate definitions in order, the same way as generated code
+        stringDoubleMap optimizedVars = vars;
+        for(const Expression &definition : constantDefinitions+temporaries) {
+            optimizedVars.insert(definition.getLeft()->toString(), definition.getRight()->evaluate(optimizedVars));
+        }
+        for(int i=0; i<exprs.size(); ++i) {
+            QString failmsg("Failure! Optimization changed the value of "+exprs[i].toString()+" to "+optimized[i].toString()+".");
+            QVERIFY2(fuzzyEqual(optimized[i].evaluate(optimizedVars), exprs[i].evaluate(vars)), failmsg.toStdString().c_str());
+        }
+
+        OperationCount count = countOperations(optimized);
+        count += countOperations(temporaries);
+        QString failmsg("Failure! Wrong number of operations after optimization: "+count.toString());
+        QVERIFY2(count.total() == operations && count.total() < countOperations(exprs).total(), failmsg.toStdString().c_str());
+    }
+
+    void SymHop_Optimize_Expressions_data()
+    {
+        QTest::addColumn<QList<Expression> >("exprs");
+        QTest::addColumn<QStringList>("constants");
+        QTest::addColumn<stringDoubleMap>("vars");
+        QTest::addColumn<int>("operations");
+        stringDoubleMap variables;
+        variables.insert("x", 1.3);
+        variables.insert("y", -0.7);
+        variables.insert("z", 2.1);
+        variables.insert("k", 3.5);
+        variables.insert("m", 0.25);
+        variables.insert("mTimestep", 0.001);
+        QTest::newRow("0") << (QList<Expression>() << Expression("sin(x*y)*z+x*y-cos(x*y)") << Expression("sqrt(x*y+z)*sin(x*y)-3*z") << Expression("(x*y+z)/k")) << (QStringList() << "k") << variables << 12;
+        QTest::newRow("1") << (QList<Expression>() << Expression("k*m*x+k/m*y") << Expression("k*m*y-2*x/(k*mTimestep)")) << (QStringList() << "k" << "m" << "mTimestep") << variables << 6;
+    }
+
+    void SymHop_Compiled_Evaluate()
+    {
+        QFETCH(Expression, expr);
+        QFETCH(stringDoubleMap, vars);
+        QFETCH(bool, valid);
+        CompiledExpression compiled(expr, vars.keys());
+        QString failmsg1("Failure! Compilation of "+expr.toString()+" returned wrong validity.");
+        QVERIFY2(compiled.isValid() == valid, failmsg1.toStdString().c_str());
+        if(!valid) {
+            return;
+        }
+
+        //Evaluate a single sample, and a batch of samples with different values of the first variable
+        QVector<double> values;
+        for(const QString &name : compiled.getVariables()) {
+            values.append(vars.value(name));
+        }
+        QString failmsg2("Failure! Compiled evaluation of "+expr.toString()+" does not match evaluate().");
+        QVERIFY2(fuzzyEqual(compiled.evaluate(values.data()), expr.evaluate(vars)), failmsg2.toStdString().c_str());
+
+        const int numSamples = 100;
+        QVector<QVector<double> > columns;
+        QVector<const double*> pColumns;
+        for(const double value : values) {
+            columns.append(QVector<double>(numSamples, value));
+        }
+        for(int i=0; i<numSamples; ++i) {
+            columns[0][i] = values[0]+0.01*i;
+        }
+        for(const QVector<double> &column : columns) {
+            pColumns.append(column.data());
+        }
+        QVector<double> results(numSamples);
+        compiled.evaluate(pColumns.data(), results.data(), numSamples);
+        for(int i=0; i<numSamples; ++i) {
+            stringDoubleMap sampleVars = vars;
+            sampleVars.insert(compiled.getVariables().first(), columns[0][i]);
+            QString failmsg3("Failure! Batch evaluation of "+expr.toString()+" does not match evaluate() in sample "+QString::number(i)+".");
+            QVERIFY2(fuzzyEqual(results[i], expr.evaluate(sampleVars)), failmsg3.toStdString().c_str());
+        }
+    }
+
+    void SymHop_Compiled_Evaluate_data()
+    {
+        QTest::addColumn<Expression>("expr");
+        QTest::addColumn<stringDoubleMap>("vars");
+        QTest::addColumn<bool>("valid");
+        stringDoubleMap variables;
+        variables.insert("x", 0.3);
+        variables.insert("y", -0.7);
+        variables.insert("z", 2.1);
+        QTest::newRow("0") << Expression("x*y-z/(x+y)^2") << variables << true;
+        QTest::newRow("1") << Expression("-sin(x)*cos(y)+exp(-z)*sqrt(z)") << variables << true;
+        QTest::newRow("2") << Expression("limit(x*z,y,0.5)+sign(y)+max(x,y)-atan2(y,z)") << variables << true;
+        QTest::newRow("3") << Expression("greaterThan(x,0.5)*z+smallerThan(x,y)-pi()") << variables << true;
+        QTest::newRow("4") << Expression("x^y^2+3*mod(z,x)") << variables << true;
+        QTest::newRow("5") << Expression("x*w") << variables << false;
+        QTest::newRow("6") << Expression("unknownFunction(x)") << variables << false;
+    }
+
     void SymHop_Creator_Verification()
     {
         QFETCH(QString, str);
@@ -159,6 +159,7 @@ HEADERS +=  \
  $${PWD}/Hydraulic/Volumes&Lines/HydraulicAckumulator.hpp \ 
  $${PWD}/Hydraulic/Volumes&Lines/HydraulicHose.hpp \ 
  $${PWD}/Hydraulic/Volumes&Lines/HydraulicPistonAckumulator.hpp \ 
+ $${PWD}/Hydraulic/Volumes&Lines/HydraulicTLMDistributedLine.hpp \ 
  $${PWD}/Hydraulic/Volumes&Lines/HydraulicTLMlossless.hpp \ 
  $${PWD}/Hydraulic/Volumes&Lines/HydraulicVolume.hpp \ 
  $${PWD}/Hydraulic/Volumes&Lines/HydraulicVolumeMultiPort.hpp \ 
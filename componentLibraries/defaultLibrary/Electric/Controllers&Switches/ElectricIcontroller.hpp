@@ -107,7 +107,7 @@ private:
      Delay mDelayedPart10;
      Delay mDelayedPart11;
      Delay mDelayedPart20;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<4> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -151,7 +151,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,4);
+        mpSolver = new FixedSizeEquationSystemSolver<4>(this);
      }
 
     void initialize()
@@ -311,5 +311,35 @@ uel2,umin,umax));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(iel1);
+        rWriter.write(iel2);
+        rWriter.write(uel1);
+        rWriter.write(uel2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(iel1);
+        rReader.read(iel2);
+        rReader.read(uel1);
+        rReader.read(uel2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+    }
 };
 #endif // ELECTRICICONTROLLER_HPP_INCLUDED
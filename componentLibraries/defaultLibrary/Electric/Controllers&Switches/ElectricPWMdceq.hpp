@@ -106,7 +106,7 @@ private:
      Delay mDelayedPart10;
      Delay mDelayedPart20;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<5> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -149,7 +149,7 @@ on)","",1.,&mptfac);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,5);
+        mpSolver = new FixedSizeEquationSystemSolver<5>(this);
      }
 
     void initialize()
@@ -309,5 +309,37 @@ limit(uel2,umin,umax)/limit(uel10,umin,umax);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(uel2);
+        rWriter.write(uel10);
+        rWriter.write(iel1);
+        rWriter.write(uel1);
+        rWriter.write(iel2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(uel2);
+        rReader.read(uel10);
+        rReader.read(iel1);
+        rReader.read(uel1);
+        rReader.read(iel2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // ELECTRICPWMDCEQ_HPP_INCLUDED
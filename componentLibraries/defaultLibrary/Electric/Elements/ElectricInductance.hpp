@@ -94,7 +94,7 @@ private:
      //outputVariables pointers
      Delay mDelayedPart10;
      Delay mDelayedPart11;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -129,7 +129,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -258,5 +258,31 @@ mTimestep*uel2)/(2.*Induct);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(iel2);
+        rWriter.write(uel1);
+        rWriter.write(uel2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(iel2);
+        rReader.read(uel1);
+        rReader.read(uel2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+    }
 };
 #endif // ELECTRICINDUCTANCE_HPP_INCLUDED
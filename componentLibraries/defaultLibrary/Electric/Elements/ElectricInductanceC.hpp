@@ -226,5 +226,21 @@ s)/V",0.,&mpCp);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(cel2);
+        rWriter.write(Zcel2);
+        rWriter.write(cel1);
+        rWriter.write(Zcel1);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(cel2);
+        rReader.read(Zcel2);
+        rReader.read(cel1);
+        rReader.read(Zcel1);
+    }
 };
 #endif // ELECTRICINDUCTANCEC_HPP_INCLUDED
@@ -139,7 +139,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart21;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<6> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -191,7 +191,7 @@ angle","rad",0.,&mpgslip);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,6);
+        mpSolver = new FixedSizeEquationSystemSolver<6>(this);
      }
 
     void initialize()
@@ -499,5 +499,43 @@ Bm*Power(freq,2)*Power(gmax,2)*mTimestep + 2*freq*gmax*iel2*Ke*mTimestep*Np - \
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(wmr1);
+        rWriter.write(thetamr1);
+        rWriter.write(iel2);
+        rWriter.write(uel1);
+        rWriter.write(uel2);
+        rWriter.write(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(wmr1);
+        rReader.read(thetamr1);
+        rReader.read(iel2);
+        rReader.read(uel1);
+        rReader.read(uel2);
+        rReader.read(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // ELECTRICACMACHINE_HPP_INCLUDED
@@ -151,7 +151,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart21;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<6> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -216,7 +216,7 @@ torque","Nm",0.,&mptormg);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,6);
+        mpSolver = new FixedSizeEquationSystemSolver<6>(this);
      }
 
     void initialize()
@@ -588,5 +588,45 @@ Bm*Power(gearRatio,2)*mTimestep*Power(pitch,2));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(thetamr1);
+        rWriter.write(wmr1);
+        rWriter.write(iel2);
+        rWriter.write(uel1);
+        rWriter.write(uel2);
+        rWriter.write(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart12.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(thetamr1);
+        rReader.read(wmr1);
+        rReader.read(iel2);
+        rReader.read(uel1);
+        rReader.read(uel2);
+        rReader.read(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart12.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // ELECTRICMOTORGEARSCREWLINK_HPP_INCLUDED
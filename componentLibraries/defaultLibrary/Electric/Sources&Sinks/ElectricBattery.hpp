@@ -97,7 +97,7 @@ private:
      Delay mDelayedPart11;
      Delay mDelayedPart20;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<4> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -139,7 +139,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,4);
+        mpSolver = new FixedSizeEquationSystemSolver<4>(this);
      }
 
     void initialize()
@@ -282,5 +282,37 @@ kappa)*Power(e,(10*soc)/kappa)*unom*Power(asin(limit(soc,1.e-9,0.9999)),kappa\
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(soc);
+        rWriter.write(iel1);
+        rWriter.write(ubatt);
+        rWriter.write(uel1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(soc);
+        rReader.read(iel1);
+        rReader.read(ubatt);
+        rReader.read(uel1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // ELECTRICBATTERY_HPP_INCLUDED
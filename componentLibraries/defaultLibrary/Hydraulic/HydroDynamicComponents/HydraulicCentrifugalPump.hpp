@@ -127,7 +127,7 @@ private:
      double *mpPout;
      Delay mDelayedPart10;
      Delay mDelayedPart20;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<4> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -176,7 +176,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,4);
+        mpSolver = new FixedSizeEquationSystemSolver<4>(this);
      }
 
     void initialize()
@@ -373,5 +373,33 @@ onPositive(p1),0,1))/(b*kl);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(q2);
+        rWriter.write(torp);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(q2);
+        rReader.read(torp);
+        rReader.read(p1);
+        rReader.read(p2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICCENTRIFUGALPUMP_HPP_INCLUDED
@@ -142,7 +142,7 @@ private:
      Delay mDelayedPart10;
      Delay mDelayedPart20;
      Delay mDelayedPart21;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<5> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -192,7 +192,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,5);
+        mpSolver = new FixedSizeEquationSystemSolver<5>(this);
      }
 
     void initialize()
@@ -471,5 +471,39 @@ onPositive(p1),0,1))/(kl*rho);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(q2e);
+        rWriter.write(wmr1);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        rWriter.write(tormr1);
+        rWriter.write(q2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(q2e);
+        rReader.read(wmr1);
+        rReader.read(p1);
+        rReader.read(p2);
+        rReader.read(tormr1);
+        rReader.read(q2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICCENTRIFUGALPUMPJ_HPP_INCLUDED
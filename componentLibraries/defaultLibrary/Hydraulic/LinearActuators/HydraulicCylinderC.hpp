@@ -349,6 +349,21 @@ class HydraulicCylinderC : public ComponentC
             (*mpQLeak) = qLeak;
         }
 
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            rWriter.write(ci1);
+            rWriter.write(cl1);
+            rWriter.write(ci2);
+            rWriter.write(cl2);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            rReader.read(ci1);
+            rReader.read(cl1);
+            rReader.read(ci2);
+            rReader.read(cl2);
+        }
 
         //This function was translated from old HOPSAN using F2C. A few manual adjustments were necessary.
 
@@ -255,6 +255,18 @@ namespace hopsan {
             (*mpP3_x) = x3;
             (*mpP3_v) = v3;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mPositionTF.saveState(rWriter);
+            mVelocityTF.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mPositionTF.restoreState(rReader);
+            mVelocityTF.restoreState(rReader);
+        }
     };
 }
 
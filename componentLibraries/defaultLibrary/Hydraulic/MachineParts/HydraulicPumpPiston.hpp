@@ -200,6 +200,18 @@ class HydraulicPumpPiston : public ComponentC
             (*mpP3_c) = c3;
             (*mpP3_Zx) = Zx3;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            rWriter.write(ci1);
+            rWriter.write(cl1);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            rReader.read(ci1);
+            rReader.read(cl1);
+        }
     };
 }
 
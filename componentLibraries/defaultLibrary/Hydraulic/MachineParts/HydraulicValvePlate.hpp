@@ -221,6 +221,16 @@ namespace hopsan {
             (*mpND_qb) = qb;
         }
 
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
+
 
 //        double groove(double x, double start, double sep, double dAlpha, double precL1, double precW1, double precL2, double precW2)
 //        {
@@ -161,6 +161,16 @@ namespace hopsan {
                 (*mvpND_v1[i]) = v1[i];
             }
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
@@ -159,6 +159,16 @@ namespace hopsan {
             (*mpND_a3) = a3;
             (*mpND_w3) = w3;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
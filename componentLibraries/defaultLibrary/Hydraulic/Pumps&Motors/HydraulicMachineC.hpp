@@ -272,6 +272,30 @@ namespace hopsan {
             (*mpND_c3) = c3;
             (*mpND_Zx3) = Zx3;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mDelayedC1.saveState(rWriter);
+            mDelayedC2.saveState(rWriter);
+            mDelayedCp1.saveState(rWriter);
+            mDelayedCp2.saveState(rWriter);
+            mDelayedCp1e.saveState(rWriter);
+            mDelayedCp2e.saveState(rWriter);
+            rWriter.write(cp1);
+            rWriter.write(cp2);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mDelayedC1.restoreState(rReader);
+            mDelayedC2.restoreState(rReader);
+            mDelayedCp1.restoreState(rReader);
+            mDelayedCp2.restoreState(rReader);
+            mDelayedCp1e.restoreState(rReader);
+            mDelayedCp2e.restoreState(rReader);
+            rReader.read(cp1);
+            rReader.read(cp2);
+        }
     };
 }
 
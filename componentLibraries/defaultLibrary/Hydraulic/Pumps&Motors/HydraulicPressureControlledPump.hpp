@@ -221,6 +221,27 @@ namespace hopsan {
             (*mpA) += movement*mTimestep;
         }
 
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            rWriter.write(y1);
+            rWriter.write(y2);
+            rWriter.write(u1);
+            rWriter.write(u2);
+            rWriter.write(ud);
+            rWriter.write(vd);
+            rWriter.write(yd);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            rReader.read(y1);
+            rReader.read(y2);
+            rReader.read(u1);
+            rReader.read(u2);
+            rReader.read(ud);
+            rReader.read(vd);
+            rReader.read(yd);
+        }
 
         //High pass filter times an integration, with separate minimum and maximum values for input and output variables. Converted from old Hopsan.
 
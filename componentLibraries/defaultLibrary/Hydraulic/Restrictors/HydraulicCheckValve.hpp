@@ -87,6 +87,11 @@ namespace hopsan {
         }
 
 
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicCheckValve>();
+        }
+
         void simulateOneTimestep()
         {
             //Get variable values from nodes
@@ -70,6 +70,11 @@ namespace hopsan {
         }
 
 
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicLaminarOrifice>();
+        }
+
         void simulateOneTimestep()
         {
             double p1, q1, c1, Zc1, p2, q2, c2, Zc2;
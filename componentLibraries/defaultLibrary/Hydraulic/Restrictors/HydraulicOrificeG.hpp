@@ -122,7 +122,7 @@ private:
      double *mpDRL;
      double *mpCd;
      Delay mDelayedPart10;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -171,7 +171,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -353,5 +353,29 @@ p2))/(Power(Ao,2)*Power(Cdt,2)*Power(del,4)*Power(dh,4)),1.5));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(q2);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(q2);
+        rReader.read(p1);
+        rReader.read(p2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICORIFICEG_HPP_INCLUDED
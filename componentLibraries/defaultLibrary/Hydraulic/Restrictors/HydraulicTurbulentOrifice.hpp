@@ -85,6 +85,11 @@ namespace hopsan {
         }
 
 
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicTurbulentOrifice>();
+        }
+
         void simulateOneTimestep()
         {
             double p1,q1, p2, q2, c1, Zc1, c2, Zc2;
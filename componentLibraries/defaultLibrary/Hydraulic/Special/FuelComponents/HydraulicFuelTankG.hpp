@@ -100,7 +100,7 @@ private:
      double *mpconsfuel;
      Delay mDelayedPart10;
      Delay mDelayedPart11;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<1> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -144,7 +144,7 @@ mass","kg",0.,&mpconsfuel);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,1);
+        mpSolver = new FixedSizeEquationSystemSolver<1>(this);
      }
 
     void initialize()
@@ -256,5 +256,27 @@ delayedPart[1][1],0.,0.0001 + massfuel0);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(consfuel);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(consfuel);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICFUELTANKG_HPP_INCLUDED
@@ -130,7 +130,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart21;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<6> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -170,7 +170,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,6);
+        mpSolver = new FixedSizeEquationSystemSolver<6>(this);
      }
 
     void initialize()
@@ -410,5 +410,45 @@ Bm*mTimestep*wm1)/(2.*Jm + Bm*mTimestep);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(thetam1);
+        rWriter.write(wm1);
+        rWriter.write(q2);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        rWriter.write(torm1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart12.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(thetam1);
+        rReader.read(wm1);
+        rReader.read(q2);
+        rReader.read(p1);
+        rReader.read(p2);
+        rReader.read(torm1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart12.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICMOTORJLOAD_HPP_INCLUDED
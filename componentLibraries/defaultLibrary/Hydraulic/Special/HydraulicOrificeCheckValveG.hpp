@@ -124,7 +124,7 @@ private:
      double *mpDRL;
      double *mpCd;
      Delay mDelayedPart10;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -173,7 +173,7 @@ diameter","m",0.3,&mpdh);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -354,5 +354,29 @@ pp))/(Power(Cdt,2)*Power(del,4)*Power(dh,4)),1.5));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qp);
+        rWriter.write(pp);
+        rWriter.write(pc);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qp);
+        rReader.read(pp);
+        rReader.read(pc);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICORIFICECHECKVALVEG_HPP_INCLUDED
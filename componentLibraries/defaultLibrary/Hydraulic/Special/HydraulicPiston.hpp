@@ -336,5 +336,29 @@ NodeMechanic::EquivalentMass);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(cp1);
+        rWriter.write(cp2);
+        rWriter.write(c1);
+        rWriter.write(c2);
+        rWriter.write(c1f);
+        rWriter.write(cp1f);
+        rWriter.write(c2f);
+        rWriter.write(cp2f);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(cp1);
+        rReader.read(cp2);
+        rReader.read(c1);
+        rReader.read(c2);
+        rReader.read(c1f);
+        rReader.read(cp1f);
+        rReader.read(c2f);
+        rReader.read(cp2f);
+    }
 };
 #endif // HYDRAULICPISTON_HPP_INCLUDED
@@ -145,7 +145,7 @@ private:
      Delay mDelayedPart21;
      Delay mDelayedPart30;
      Delay mDelayedPart40;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<7> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -195,7 +195,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,7);
+        mpSolver = new FixedSizeEquationSystemSolver<7>(this);
      }
 
     void initialize()
@@ -478,5 +478,49 @@ bL*mTimestep + bp*mTimestep + mTimestep*Zcmp);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(xmp);
+        rWriter.write(vmp);
+        rWriter.write(q1);
+        rWriter.write(q2);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        rWriter.write(fmp);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart12.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(xmp);
+        rReader.read(vmp);
+        rReader.read(q1);
+        rReader.read(q2);
+        rReader.read(p1);
+        rReader.read(p2);
+        rReader.read(fmp);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart12.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICPISTONMLOAD_HPP_INCLUDED
@@ -159,7 +159,7 @@ private:
      Delay mDelayedPart10;
      Delay mDelayedPart11;
      Delay mDelayedPart20;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<4> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -209,7 +209,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,4);
+        mpSolver = new FixedSizeEquationSystemSolver<4>(this);
      }
 
     void initialize()
@@ -447,5 +447,35 @@ p2)*Cos(phi))/(2*Bv + ks*mTimestep + 2*Cq*mTimestep*w*Abs(p1 - p2)*Cos(phi));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(xv);
+        rWriter.write(q2);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(xv);
+        rReader.read(q2);
+        rReader.read(p1);
+        rReader.read(p2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICPRESSURECONTROLVALVEG_HPP_INCLUDED
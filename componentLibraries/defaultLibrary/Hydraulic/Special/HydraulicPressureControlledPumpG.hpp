@@ -166,7 +166,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart21;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<5> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -225,7 +225,7 @@ change","m^3/s^2",0.,&mpdqp);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,5);
+        mpSolver = new FixedSizeEquationSystemSolver<5>(this);
      }
 
     void initialize()
@@ -500,5 +500,47 @@ Power(mTimestep,2)*Rpe*wp1e + 4*Lpe*tauv*wp1e + 2*mTimestep*Rpe*tauv*wp1e);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(p2);
+        rWriter.write(dqp);
+        rWriter.write(qp);
+        rWriter.write(q2);
+        rWriter.write(p1);
+        rWriter.write(p3);
+        rWriter.write(q1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart12.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(p2);
+        rReader.read(dqp);
+        rReader.read(qp);
+        rReader.read(q2);
+        rReader.read(p1);
+        rReader.read(p3);
+        rReader.read(q1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart12.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICPRESSURECONTROLLEDPUMPG_HPP_INCLUDED
@@ -137,7 +137,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart21;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<5> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -185,7 +185,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,5);
+        mpSolver = new FixedSizeEquationSystemSolver<5>(this);
      }
 
     void initialize()
@@ -423,5 +423,43 @@ Av*mTimestep*p2 + Av*mTimestep*pref + ke*mTimestep*xv)/(Bv*mTimestep + 2*Mv);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(p1);
+        rWriter.write(p2);
+        rWriter.write(xv);
+        rWriter.write(dxv);
+        rWriter.write(q2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart12.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(p1);
+        rReader.read(p2);
+        rReader.read(xv);
+        rReader.read(dxv);
+        rReader.read(q2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart12.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICPRESSURERELIEF2VALVEG_HPP_INCLUDED
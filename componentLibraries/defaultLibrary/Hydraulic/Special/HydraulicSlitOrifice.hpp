@@ -123,7 +123,7 @@ private:
      double *mpDRL;
      double *mpCde;
      Delay mDelayedPart10;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -175,7 +175,7 @@ coeff","",0.611,&mpCde);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -373,5 +373,31 @@ q2*Zc2*onPositive(p2),0)*onPositive(p2));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(q2);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        rWriter.write(q1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(q2);
+        rReader.read(p1);
+        rReader.read(p2);
+        rReader.read(q1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICSLITORIFICE_HPP_INCLUDED
@@ -142,7 +142,7 @@ private:
      Delay mDelayedPart10;
      Delay mDelayedPart20;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<6> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -189,7 +189,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,6);
+        mpSolver = new FixedSizeEquationSystemSolver<6>(this);
      }
 
     void initialize()
@@ -407,5 +407,39 @@ qa*Zca*onPositive(pa),0)*onPositive(pa));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qp);
+        rWriter.write(qt);
+        rWriter.write(qa);
+        rWriter.write(pp);
+        rWriter.write(pt);
+        rWriter.write(pa);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qp);
+        rReader.read(qt);
+        rReader.read(qa);
+        rReader.read(pp);
+        rReader.read(pt);
+        rReader.read(pa);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICVALVE33_HPP_INCLUDED
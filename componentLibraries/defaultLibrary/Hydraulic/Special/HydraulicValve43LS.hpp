@@ -201,7 +201,7 @@ private:
      Delay mDelayedPart30;
      Delay mDelayedPart40;
      Delay mDelayedPart50;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<10> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -265,7 +265,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,10);
+        mpSolver = new FixedSizeEquationSystemSolver<10>(this);
      }
 
     void initialize()
@@ -641,5 +641,51 @@ qls*Zcls*onPositive(pls),0)*onPositive(pls));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qp);
+        rWriter.write(qt);
+        rWriter.write(qa);
+        rWriter.write(qb);
+        rWriter.write(qls);
+        rWriter.write(pp);
+        rWriter.write(pt);
+        rWriter.write(pa);
+        rWriter.write(pb);
+        rWriter.write(pls);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+        mDelayedPart50.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qp);
+        rReader.read(qt);
+        rReader.read(qa);
+        rReader.read(qb);
+        rReader.read(qls);
+        rReader.read(pp);
+        rReader.read(pt);
+        rReader.read(pa);
+        rReader.read(pb);
+        rReader.read(pls);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+        mDelayedPart50.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICVALVE43LS_HPP_INCLUDED
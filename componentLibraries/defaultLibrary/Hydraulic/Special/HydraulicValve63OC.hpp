@@ -210,7 +210,7 @@ private:
      Delay mDelayedPart30;
      Delay mDelayedPart40;
      Delay mDelayedPart50;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<11> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -270,7 +270,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,11);
+        mpSolver = new FixedSizeEquationSystemSolver<11>(this);
      }
 
     void initialize()
@@ -688,5 +688,55 @@ qoct*Zcoct*onPositive(poct),0)*onPositive(poct));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qp);
+        rWriter.write(qt);
+        rWriter.write(qa);
+        rWriter.write(qb);
+        rWriter.write(qoct);
+        rWriter.write(pp);
+        rWriter.write(pt);
+        rWriter.write(pa);
+        rWriter.write(pb);
+        rWriter.write(pocp);
+        rWriter.write(poct);
+        rWriter.write(qocp);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+        mDelayedPart50.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qp);
+        rReader.read(qt);
+        rReader.read(qa);
+        rReader.read(qb);
+        rReader.read(qoct);
+        rReader.read(pp);
+        rReader.read(pt);
+        rReader.read(pa);
+        rReader.read(pb);
+        rReader.read(pocp);
+        rReader.read(poct);
+        rReader.read(qocp);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+        mDelayedPart50.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICVALVE63OC_HPP_INCLUDED
@@ -202,6 +202,16 @@ namespace hopsan {
             (*mpP2_p) = P2_p;
             (*mpOut) = outnom;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mValveSpoolPosFilter.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mValveSpoolPosFilter.restoreState(rReader);
+        }
     };
 }
 
@@ -188,6 +188,16 @@ namespace hopsan {
             (*mpP2_q) = q2;
             (*mpOut_xv) = xnom;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mValveSpoolPosFilter.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mValveSpoolPosFilter.restoreState(rReader);
+        }
     };
 }
 
@@ -216,6 +216,16 @@ namespace hopsan {
             (*mpPT_q) = qt;
             (*mpXv) = xv;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mSpoolPosTF.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mSpoolPosTF.restoreState(rReader);
+        }
     };
 }
 
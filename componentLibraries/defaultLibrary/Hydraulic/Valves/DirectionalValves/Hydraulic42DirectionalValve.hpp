@@ -246,6 +246,16 @@ namespace hopsan {
             (*mpPB_q) = qb;
             (*mpXv) = xv;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mSpoolPosTF.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mSpoolPosTF.restoreState(rReader);
+        }
     };
 }
 
@@ -186,6 +186,16 @@ namespace hopsan {
             (*mpPA_q) = qa;
             (*mpOut_xv) = xv;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            filter.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            filter.restoreState(rReader);
+        }
     };
 }
 
@@ -279,6 +279,16 @@ namespace hopsan {
             }
             (*mpXv) = xv;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mSpoolPosTF.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mSpoolPosTF.restoreState(rReader);
+        }
     };
 }
 
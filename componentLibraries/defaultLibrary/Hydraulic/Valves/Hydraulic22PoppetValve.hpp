@@ -209,6 +209,16 @@ namespace hopsan {
             (*mpAC_q) = qAC;
             (*mpXvout) = xIntegrator.value();
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            xIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            xIntegrator.restoreState(rReader);
+        }
     };
 }
 
@@ -215,6 +215,16 @@ namespace hopsan {
             (*mpPT_q) = qt;
             (*mpXvout) = xv;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            xIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            xIntegrator.restoreState(rReader);
+        }
     };
 }
 
@@ -170,7 +170,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart30;
      Delay mDelayedPart40;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<7> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -225,7 +225,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,7);
+        mpSolver = new FixedSizeEquationSystemSolver<7>(this);
      }
 
     void initialize()
@@ -558,5 +558,45 @@ p3)*Cos(phi)*onPositive(limit(Xap0 + xv,0.,Xap0 + Xvmax)));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(xv);
+        rWriter.write(q1);
+        rWriter.write(q2);
+        rWriter.write(q3);
+        rWriter.write(p1);
+        rWriter.write(p2);
+        rWriter.write(p3);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(xv);
+        rReader.read(q1);
+        rReader.read(q2);
+        rReader.read(q3);
+        rReader.read(p1);
+        rReader.read(p2);
+        rReader.read(p3);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICPRESSURECONTROLVALVE33_HPP_INCLUDED
@@ -176,7 +176,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart30;
      Delay mDelayedPart40;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<8> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -233,7 +233,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,8);
+        mpSolver = new FixedSizeEquationSystemSolver<8>(this);
      }
 
     void initialize()
@@ -532,5 +532,45 @@ qb*Zcb*onPositive(pb),0)*onPositive(pb));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qp);
+        rWriter.write(qt);
+        rWriter.write(qa);
+        rWriter.write(qb);
+        rWriter.write(pp);
+        rWriter.write(pt);
+        rWriter.write(pa);
+        rWriter.write(pb);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qp);
+        rReader.read(qt);
+        rReader.read(qa);
+        rReader.read(qb);
+        rReader.read(pp);
+        rReader.read(pt);
+        rReader.read(pa);
+        rReader.read(pb);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+    }
 };
 #endif // HYDRAULICVALVE416_HPP_INCLUDED
@@ -184,6 +184,18 @@ namespace hopsan {
             (*mpPControl_p) = p_control;
             (*mpXv) = x0;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterLP.saveState(rWriter);
+            rWriter.write(mPrevX0);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterLP.restoreState(rReader);
+            rReader.read(mPrevX0);
+        }
     };
 }
 
@@ -192,6 +192,18 @@ namespace hopsan {
             (*mpPClose_p) = p_close;
             (*mpXv) = x0;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterLP.saveState(rWriter);
+            rWriter.write(mPrevX0);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterLP.restoreState(rReader);
+            rReader.read(mPrevX0);
+        }
     };
 }
 
@@ -193,6 +193,18 @@ namespace hopsan {
 
             (*mpX0) = x0;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterLP.saveState(rWriter);
+            rWriter.write(mPrevX0);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterLP.restoreState(rReader);
+            rReader.read(mPrevX0);
+        }
     };
 }
 
@@ -234,6 +234,18 @@ namespace hopsan {
             (*mpP2_q) = q2;
             (*mpXv) = x0;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterLP.saveState(rWriter);
+            rWriter.write(mPrevX0);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterLP.restoreState(rReader);
+            rReader.read(mPrevX0);
+        }
     };
 }
 
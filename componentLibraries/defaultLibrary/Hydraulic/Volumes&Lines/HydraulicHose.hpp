@@ -197,6 +197,11 @@ namespace hopsan {
         }
 
 
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicHose>();
+        }
+
         void simulateOneTimestep()
         {
                 //Declare local variables
@@ -307,6 +312,52 @@ namespace hopsan {
 
         }
 
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            rWriter.write(NTIME);
+            rWriter.write(NTMAX);
+            rWriter.write(mpC1i+1, size_t(NTMAX));
+            rWriter.write(mpC2i+1, size_t(NTMAX));
+            rWriter.write(RL1);
+            rWriter.write(RL2);
+            rWriter.write(RL1d);
+            rWriter.write(RL2d);
+            rWriter.write(RQF1D);
+            rWriter.write(RQF2D);
+            rWriter.write(RQEF1D);
+            rWriter.write(RQEF2D);
+            FilterC1F.saveState(rWriter);
+            FilterC2F.saveState(rWriter);
+            FilterC1F1.saveState(rWriter);
+            FilterC2F1.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            // The cyclic memory length depends on the time step, it must match the current allocation
+            int ntmax=0;
+            rReader.read(NTIME);
+            if (!rReader.read(ntmax) || (ntmax != NTMAX))
+            {
+                rReader.setFailed();
+                return;
+            }
+            rReader.read(mpC1i+1, size_t(NTMAX));
+            rReader.read(mpC2i+1, size_t(NTMAX));
+            rReader.read(RL1);
+            rReader.read(RL2);
+            rReader.read(RL1d);
+            rReader.read(RL2d);
+            rReader.read(RQF1D);
+            rReader.read(RQF2D);
+            rReader.read(RQEF1D);
+            rReader.read(RQEF2D);
+            FilterC1F.restoreState(rReader);
+            FilterC2F.restoreState(rReader);
+            FilterC1F1.restoreState(rReader);
+            FilterC2F1.restoreState(rReader);
+        }
+
         void finalize()
         {
             if (mpC1i && mpC2i)
@@ -0,0 +1,161 @@
+/*-----------------------------------------------------------------------------
+
+ Copyright 2017 Hopsan Group
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+ The full license is available in the file LICENSE.
+ For details about the 'Hopsan Group' or information about Authors and
+ Contributors see the HOPSANGROUP and AUTHORS files that are located in
+ the Hopsan source code root directory.
+
+-----------------------------------------------------------------------------*/
+
+//!
+//! @file   HydraulicTLMDistributedLine.hpp
+//! @author FluMeS
+//!
+//! @brief Contains a Hydraulic Lossless Transmission Line Component, divided into segments
+//!
+//$Id$
+
+#ifndef HYDRAULICTLMDISTRIBUTEDLINE_HPP_INCLUDED
+#define HYDRAULICTLMDISTRIBUTEDLINE_HPP_INCLUDED
+
+#include "ComponentEssentials.h"
+#include "ComponentUtilities.h"
+
+namespace hopsan {
+
+    //!
+    //! @brief A lossless transmission line divided into segments, with the wave filter applied in each segment
+    //! @details The segments are joined without capacitance, so the line is one time delay where the wave filter is applied
+    //! once per segment. It does not model the volumes of a chain of HydraulicTLMlossless and HydraulicVolume components.
+    //! All segments are stored and updated together.
+    //! @ingroup HydraulicComponents
+    //!
+    class HydraulicTLMDistributedLine : public ComponentC
+    {
+
+    private:
+        double mTimeDelay;
+        int mNumSegments;
+        double *mpAlpha, *mpZc;
+
+        double *mpP1_p, *mpP1_q, *mpP1_c, *mpP1_Zc, *mpP2_p, *mpP2_q, *mpP2_c, *mpP2_Zc;
+
+        TLMLineSegments mSegments;
+        Port *mpP1, *mpP2;
+
+    public:
+        static Component *Creator()
+        {
+            return new HydraulicTLMDistributedLine();
+        }
+
+        void configure()
+        {
+            mpP1 = addPowerPort("P1", "NodeHydraulic");
+            mpP2 = addPowerPort("P2", "NodeHydraulic");
+
+            addInputVariable("alpha", "Low pass coefficient", "-", 0.0, &mpAlpha);
+            addInputVariable("Z_c", "Impedance of each segment", "Pa s/m^3",  1.0e9, &mpZc);
+
+            addConstant("deltat", "Total time delay", "s",   0.1, mTimeDelay);
+            addConstant("n_seg", "Number of segments", "-", 10, mNumSegments);
+
+            disableStartValue(mpP1, NodeHydraulic::WaveVariable);
+            disableStartValue(mpP1, NodeHydraulic::CharImpedance);
+            disableStartValue(mpP2, NodeHydraulic::WaveVariable);
+            disableStartValue(mpP2, NodeHydraulic::CharImpedance);
+        }
+
+
+        void initialize()
+        {
+            mpP1_p = getSafeNodeDataPtr(mpP1, NodeHydraulic::Pressure);
+            mpP1_q = getSafeNodeDataPtr(mpP1, NodeHydraulic::Flow);
+            mpP1_c = getSafeNodeDataPtr(mpP1, NodeHydraulic::WaveVariable);
+            mpP1_Zc = getSafeNodeDataPtr(mpP1, NodeHydraulic::CharImpedance);
+
+            mpP2_p = getSafeNodeDataPtr(mpP2, NodeHydraulic::Pressure);
+            mpP2_q = getSafeNodeDataPtr(mpP2, NodeHydraulic::Flow);
+            mpP2_c = getSafeNodeDataPtr(mpP2, NodeHydraulic::WaveVariable);
+            mpP2_Zc = getSafeNodeDataPtr(mpP2, NodeHydraulic::CharImpedance);
+
+            if (mNumSegments < 1)
+            {
+                addErrorMessage("The number of segments must be >= 1");
+                stopSimulation();
+                return;
+            }
+
+            const double segmentTimeDelay = mTimeDelay/double(mNumSegments);
+            if (segmentTimeDelay-mTimestep < 0)
+            {
+                addWarningMessage("TimeDelay/n_seg must be >= Ts");
+            }
+
+            const double Zc = (*mpZc);
+            const double p1 = getDefaultStartValue(mpP1,NodeHydraulic::Pressure);
+            const double q1 = getDefaultStartValue(mpP1,NodeHydraulic::Flow);
+            const double p2 = getDefaultStartValue(mpP2,NodeHydraulic::Pressure);
+            const double q2 = getDefaultStartValue(mpP2,NodeHydraulic::Flow);
+
+            // Initialize segments, each segment has one time step delay built in
+            mSegments.initialize(size_t(mNumSegments), segmentTimeDelay, mTimestep, Zc, p1, q1, p2, q2);
+
+            //Write to nodes
+            (*mpP1_q) = q1;
+            (*mpP1_p) = p1;
+            (*mpP1_c) = mSegments.c1();
+            (*mpP1_Zc) = Zc;
+            (*mpP2_q) = q2;
+            (*mpP2_p) = p2;
+            (*mpP2_c) = mSegments.c2();
+            (*mpP2_Zc) = Zc;
+        }
+
+
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicTLMDistributedLine>();
+        }
+
+        void simulateOneTimestep()
+        {
+            const double Zc = (*mpZc);
+
+            mSegments.update((*mpP1_p), (*mpP1_q), (*mpP2_p), (*mpP2_q), Zc, (*mpAlpha));
+
+            //Write new values to nodes
+            (*mpP1_c) = mSegments.c1();
+            (*mpP1_Zc) = Zc;
+            (*mpP2_c) = mSegments.c2();
+            (*mpP2_Zc) = Zc;
+        }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mSegments.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mSegments.restoreState(rReader);
+        }
+    };
+}
+
+#endif // HYDRAULICTLMDISTRIBUTEDLINE_HPP_INCLUDED
@@ -118,6 +118,11 @@ namespace hopsan {
         }
 
 
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicTLMlossless>();
+        }
+
         void simulateOneTimestep()
         {
             //Declare local variables
@@ -146,6 +151,18 @@ namespace hopsan {
             (*mpP2_Zc) = Zc;
 
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mDelayedC1.saveState(rWriter);
+            mDelayedC2.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mDelayedC1.restoreState(rReader);
+            mDelayedC2.restoreState(rReader);
+        }
     };
 }
 
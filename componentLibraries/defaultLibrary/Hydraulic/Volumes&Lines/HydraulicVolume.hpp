@@ -108,6 +108,11 @@ namespace hopsan {
         }
 
 
+        SimulateBatchFunctionT getSimulateBatchFunction() const
+        {
+            return getSimulateBatchFunctionFor<HydraulicVolume>();
+        }
+
         void simulateOneTimestep()
         {
             //Declare local variables
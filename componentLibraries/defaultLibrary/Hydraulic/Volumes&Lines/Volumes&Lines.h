@@ -26,6 +26,7 @@
 #include "HydraulicAckumulator.hpp"
 #include "HydraulicHose.hpp"
 #include "HydraulicPistonAckumulator.hpp"
+#include "HydraulicTLMDistributedLine.hpp"
 #include "HydraulicTLMlossless.hpp"
 #include "HydraulicVolume.hpp"
 #include "HydraulicVolumeMultiPort.hpp"
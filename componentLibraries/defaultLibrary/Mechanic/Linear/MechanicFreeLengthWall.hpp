@@ -140,6 +140,18 @@ public:
         (*mpP1_x) = x1;
         (*mpP1_v) = v1;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        mFilterX.saveState(rWriter);
+        mFilterV.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        mFilterX.restoreState(rReader);
+        mFilterV.restoreState(rReader);
+    }
 };
 }
 
@@ -150,7 +150,7 @@ private:
      Delay mDelayedPart51;
      Delay mDelayedPart60;
      Delay mDelayedPart61;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<9> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -197,7 +197,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,9);
+        mpSolver = new FixedSizeEquationSystemSolver<9>(this);
      }
 
     void initialize()
@@ -580,5 +580,61 @@ m2)*mTimestep),-fc,fc))/(4.*m1*m2);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(vm1);
+        rWriter.write(vm2);
+        rWriter.write(vm3);
+        rWriter.write(xm3);
+        rWriter.write(vt);
+        rWriter.write(xt);
+        rWriter.write(fm1);
+        rWriter.write(fm2);
+        rWriter.write(fm3);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart31.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+        mDelayedPart41.saveState(rWriter);
+        mDelayedPart42.saveState(rWriter);
+        mDelayedPart50.saveState(rWriter);
+        mDelayedPart51.saveState(rWriter);
+        mDelayedPart60.saveState(rWriter);
+        mDelayedPart61.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(vm1);
+        rReader.read(vm2);
+        rReader.read(vm3);
+        rReader.read(xm3);
+        rReader.read(vt);
+        rReader.read(xt);
+        rReader.read(fm1);
+        rReader.read(fm2);
+        rReader.read(fm3);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart31.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+        mDelayedPart41.restoreState(rReader);
+        mDelayedPart42.restoreState(rReader);
+        mDelayedPart50.restoreState(rReader);
+        mDelayedPart51.restoreState(rReader);
+        mDelayedPart60.restoreState(rReader);
+        mDelayedPart61.restoreState(rReader);
+    }
 };
 #endif // MECHANICM2LOAD1D_HPP_INCLUDED
@@ -153,6 +153,18 @@ namespace hopsan {
             (*mpND_x2) = x2;
             (*mpND_v2) = v2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterTheta.saveState(rWriter);
+            mFilterOmega.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterTheta.restoreState(rReader);
+            mFilterOmega.restoreState(rReader);
+        }
     };
 }
 
@@ -253,5 +253,21 @@ public:
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(cm2);
+        rWriter.write(cm1);
+        rWriter.write(cm1f);
+        rWriter.write(cm2f);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(cm2);
+        rReader.read(cm1);
+        rReader.read(cm1f);
+        rReader.read(cm2f);
+    }
 };
 #endif // MECHANICSPRING_HPP_INCLUDED
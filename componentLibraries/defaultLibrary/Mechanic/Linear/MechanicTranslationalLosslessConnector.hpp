@@ -128,6 +128,16 @@ namespace hopsan {
             (*mpP2_x) = x2;
             (*mpP2_v) = v2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mInt.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mInt.restoreState(rReader);
+        }
     };
 }
 
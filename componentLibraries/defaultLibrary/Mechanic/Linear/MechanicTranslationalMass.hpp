@@ -189,6 +189,18 @@ namespace hopsan {
             (*mpP1_me) = mMass;
             (*mpP2_me) = mMass;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterX.saveState(rWriter);
+            mFilterV.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterX.restoreState(rReader);
+            mFilterV.restoreState(rReader);
+        }
     };
 }
 
@@ -175,6 +175,16 @@ namespace hopsan {
             (*mpP2_x) = x2;
             (*mpP2_v) = v2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
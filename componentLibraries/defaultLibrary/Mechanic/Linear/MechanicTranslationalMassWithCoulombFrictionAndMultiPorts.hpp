@@ -242,6 +242,16 @@ namespace hopsan {
                 (*mvpP2_me[i]) = m;
             }
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
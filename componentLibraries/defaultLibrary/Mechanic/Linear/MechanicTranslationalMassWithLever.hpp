@@ -155,6 +155,16 @@ namespace hopsan {
             (*mpND_v2) = v2;
             (*mpND_me2) = m;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
@@ -119,6 +119,16 @@ namespace hopsan {
             (*mpPm1_x) = x;
             (*mpPm1_v) = v;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mInt.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mInt.restoreState(rReader);
+        }
     };
 }
 
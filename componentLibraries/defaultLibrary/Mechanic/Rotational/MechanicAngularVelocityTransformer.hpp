@@ -94,6 +94,16 @@ namespace hopsan {
             (*mpOut_a) = a;
             (*mpOut_w) = w;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mInt.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mInt.restoreState(rReader);
+        }
     };
 }
 
@@ -119,7 +119,7 @@ private:
      Delay mDelayedPart21;
      Delay mDelayedPart30;
      Delay mDelayedPart31;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<6> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -163,7 +163,7 @@ output)", "", 0.01,&mpmyfric);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,6);
+        mpSolver = new FixedSizeEquationSystemSolver<6>(this);
      }
 
     void initialize()
@@ -379,5 +379,45 @@ gearRatio*wmr2*Zcmr1,-tmax,tmax);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(wmr2);
+        rWriter.write(thetamr2);
+        rWriter.write(thetamr1);
+        rWriter.write(tormr1);
+        rWriter.write(wmr1);
+        rWriter.write(tormr2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart31.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(wmr2);
+        rReader.read(thetamr2);
+        rReader.read(thetamr1);
+        rReader.read(tormr1);
+        rReader.read(wmr1);
+        rReader.read(tormr2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart31.restoreState(rReader);
+    }
 };
 #endif // MECHANICGEARCLUTCH_HPP_INCLUDED
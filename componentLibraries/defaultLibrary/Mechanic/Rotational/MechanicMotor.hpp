@@ -123,6 +123,18 @@ namespace hopsan {
             (*mpND_c1) = c1;
             (*mpND_Zc1) = Zc1;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+            mDerivator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+            mDerivator.restoreState(rReader);
+        }
     };
 }
 
@@ -148,6 +148,18 @@ namespace hopsan {
             (*mpND_a2) = a2;
             (*mpND_w2) = w2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilter.saveState(rWriter);
+            mInt.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilter.restoreState(rReader);
+            mInt.restoreState(rReader);
+        }
     };
 }
 
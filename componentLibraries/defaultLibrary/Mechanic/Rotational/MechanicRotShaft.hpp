@@ -244,5 +244,21 @@ NodeMechanicRotational::EquivalentInertia);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(cmr2);
+        rWriter.write(cmr1);
+        rWriter.write(cmr1f);
+        rWriter.write(cmr2f);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(cmr2);
+        rReader.read(cmr1);
+        rReader.read(cmr1f);
+        rReader.read(cmr2f);
+    }
 };
 #endif // MECHANICROTSHAFT_HPP_INCLUDED
@@ -162,6 +162,18 @@ namespace hopsan {
             (*mpND_a2) = a2;
             (*mpND_w2) = w2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterX.saveState(rWriter);
+            mFilterV.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterX.restoreState(rReader);
+            mFilterV.restoreState(rReader);
+        }
     };
 }
 
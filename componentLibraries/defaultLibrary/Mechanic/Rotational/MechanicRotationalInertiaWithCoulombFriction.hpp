@@ -147,6 +147,16 @@ namespace hopsan {
             (*mpP2_a) = a2;
             (*mpP2_w) = w2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
@@ -156,6 +156,18 @@ namespace hopsan {
             (*mpP2_a) = a2;
             (*mpP2_w) = w2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mThetaFilter.saveState(rWriter);
+            mOmegaFilter.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mThetaFilter.restoreState(rReader);
+            mOmegaFilter.restoreState(rReader);
+        }
     };
 }
 
@@ -156,6 +156,18 @@ namespace hopsan {
             (*mpP2_a) = a2;
             (*mpP2_w) = w2;
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterTheta.saveState(rWriter);
+            mFilterOmega.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterTheta.restoreState(rReader);
+            mFilterOmega.restoreState(rReader);
+        }
     };
 }
 
@@ -139,5 +139,15 @@ public:
         (*mpPmr1_theta)=theta_out;
         (*mpPmr1_w)=w_in;
      }
+
+     void saveState(ComponentStateWriter &rWriter) const
+     {
+         mInt.saveState(rWriter);
+     }
+
+     void restoreState(ComponentStateReader &rReader)
+     {
+         mInt.restoreState(rReader);
+     }
 };
 #endif // MECHANICTHETASOURCE_HPP_INCLUDED
@@ -140,7 +140,7 @@ private:
      Delay mDelayedPart30;
      Delay mDelayedPart40;
      Delay mDelayedPart50;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<8> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -182,7 +182,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,8);
+        mpSolver = new FixedSizeEquationSystemSolver<8>(this);
      }
 
     void initialize()
@@ -483,5 +483,53 @@ Bm*mTimestep*wmr1)/(2.*Jm + Bm*mTimestep);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(thetamr1);
+        rWriter.write(wmr1);
+        rWriter.write(qmp2);
+        rWriter.write(dEp1);
+        rWriter.write(dEp2);
+        rWriter.write(pp1);
+        rWriter.write(pp2);
+        rWriter.write(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart12.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+        mDelayedPart50.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(thetamr1);
+        rReader.read(wmr1);
+        rReader.read(qmp2);
+        rReader.read(dEp1);
+        rReader.read(dEp2);
+        rReader.read(pp1);
+        rReader.read(pp2);
+        rReader.read(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart12.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+        mDelayedPart50.restoreState(rReader);
+    }
 };
 #endif // PNEUMATICMACHINE_HPP_INCLUDED
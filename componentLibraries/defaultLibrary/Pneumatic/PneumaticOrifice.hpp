@@ -127,7 +127,7 @@ private:
      Delay mDelayedPart30;
      Delay mDelayedPart40;
      Delay mDelayedPart50;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<7> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -167,7 +167,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,7);
+        mpSolver = new FixedSizeEquationSystemSolver<7>(this);
      }
 
     void initialize()
@@ -448,5 +448,45 @@ Tp1*onPositive(qmp2)));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qma);
+        rWriter.write(qmb);
+        rWriter.write(qmp2);
+        rWriter.write(dEp1);
+        rWriter.write(dEp2);
+        rWriter.write(pp1);
+        rWriter.write(pp2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+        mDelayedPart50.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qma);
+        rReader.read(qmb);
+        rReader.read(qmp2);
+        rReader.read(dEp1);
+        rReader.read(dEp2);
+        rReader.read(pp1);
+        rReader.read(pp2);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+        mDelayedPart50.restoreState(rReader);
+    }
 };
 #endif // PNEUMATICORIFICE_HPP_INCLUDED
@@ -122,7 +122,7 @@ private:
      double *mpmass;
      Delay mDelayedPart10;
      Delay mDelayedPart11;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<1> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -164,7 +164,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,1);
+        mpSolver = new FixedSizeEquationSystemSolver<1>(this);
      }
 
     void initialize()
@@ -316,5 +316,31 @@ delayedPart[1][1];
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(mass);
+        rWriter.write(cp2);
+        rWriter.write(cp1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(mass);
+        rReader.read(cp2);
+        rReader.read(cp1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+    }
 };
 #endif // PNEUMATICVOLUME2_HPP_INCLUDED
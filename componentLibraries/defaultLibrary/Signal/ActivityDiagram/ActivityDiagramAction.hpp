@@ -153,5 +153,15 @@ public:
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(stated);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(stated);
+    }
 };
 #endif // ACTIVITYDIAGRAMACTION_HPP_INCLUDED
@@ -151,5 +151,15 @@ public:
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(stated);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(stated);
+    }
 };
 #endif // ACTIVITYDIAGRAMCONNECTOR_HPP_INCLUDED
@@ -241,5 +241,17 @@ flank","",0.,&mpevent3);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent2);
+        rWriter.write(oldEvent3);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent2);
+        rReader.read(oldEvent3);
+    }
 };
 #endif // ACTIVITYDIAGRAMDECISION_HPP_INCLUDED
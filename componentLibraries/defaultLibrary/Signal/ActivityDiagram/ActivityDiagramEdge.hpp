@@ -194,5 +194,15 @@ public:
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent);
+    }
 };
 #endif // ACTIVITYDIAGRAMEDGE_HPP_INCLUDED
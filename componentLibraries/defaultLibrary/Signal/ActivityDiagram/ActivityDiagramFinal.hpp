@@ -141,5 +141,15 @@ public:
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent);
+    }
 };
 #endif // ACTIVITYDIAGRAMFINAL_HPP_INCLUDED
@@ -224,5 +224,15 @@ flank)","",1.,&mpevent);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent);
+    }
 };
 #endif // ACTIVITYDIAGRAMFORK_HPP_INCLUDED
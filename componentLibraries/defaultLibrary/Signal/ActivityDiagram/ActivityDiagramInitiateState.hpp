@@ -140,5 +140,15 @@ flank)","",1.,&mpevent);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent);
+    }
 };
 #endif // ACTIVITYDIAGRAMINITIATESTATE_HPP_INCLUDED
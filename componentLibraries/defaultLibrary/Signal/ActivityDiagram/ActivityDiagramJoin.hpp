@@ -177,5 +177,15 @@ flank(1)", "", 0.,&mpdiffEvent);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent);
+    }
 };
 #endif // ACTIVITYDIAGRAMJOIN_HPP_INCLUDED
@@ -191,5 +191,17 @@ qpn2));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldEvent1);
+        rWriter.write(oldEvent2);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldEvent1);
+        rReader.read(oldEvent2);
+    }
 };
 #endif // ACTIVITYDIAGRAMMERGE_HPP_INCLUDED
@@ -92,7 +92,7 @@ private:
      Delay mDelayedPart20;
      Delay mDelayedPart30;
      Delay mDelayedPart31;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -135,7 +135,7 @@ part","",0.,&mpuI);
 
 //==This code has been autogenerated using Compgen==
         //Add constants/parameters
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -250,5 +250,35 @@ yref),umin,umax);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(u);
+        rWriter.write(Ierr);
+        rWriter.write(uI);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart31.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(u);
+        rReader.read(Ierr);
+        rReader.read(uI);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart31.restoreState(rReader);
+    }
 };
 #endif // SIGNALPID_HPP_INCLUDED
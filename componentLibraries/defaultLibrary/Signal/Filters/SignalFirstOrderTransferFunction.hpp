@@ -84,6 +84,16 @@ namespace hopsan {
         {
             (*mpOut) = mTF.update(*mpIn);
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mTF.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mTF.restoreState(rReader);
+        }
     };
 }
 
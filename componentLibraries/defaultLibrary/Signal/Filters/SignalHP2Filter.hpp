@@ -91,6 +91,16 @@ namespace hopsan {
         {
             (*mpOut) = mTF2.update((*mpIn));
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mTF2.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mTF2.restoreState(rReader);
+        }
     };
 }
 
@@ -76,6 +76,16 @@ namespace hopsan {
             //Filter equation
            (*mpOut) = mIntegrator.update((*mpIn));
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mIntegrator.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mIntegrator.restoreState(rReader);
+        }
     };
 }
 
@@ -89,6 +89,16 @@ namespace hopsan {
             //Write new values to nodes
             (*mpOut) = mTF.update((*mpIn));
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mTF.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mTF.restoreState(rReader);
+        }
     };
 }
 
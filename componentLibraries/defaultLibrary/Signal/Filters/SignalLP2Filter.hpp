@@ -92,6 +92,16 @@ namespace hopsan {
             //Write new values to nodes
             (*mpOut) = mTF2.update((*mpIn));
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mTF2.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mTF2.restoreState(rReader);
+        }
     };
 }
 
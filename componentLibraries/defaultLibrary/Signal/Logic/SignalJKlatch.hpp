@@ -160,5 +160,15 @@ limit(setCond,0,1)),0,1),0,1),0,1);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldQstate);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldQstate);
+    }
 };
 #endif // SIGNALJKLATCH_HPP_INCLUDED
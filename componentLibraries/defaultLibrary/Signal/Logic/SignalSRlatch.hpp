@@ -158,5 +158,15 @@ limit(resetCond,0,1))*(1 - limit(setCond,0,1)),0,1),0,1),0,1);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldQstate);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldQstate);
+    }
 };
 #endif // SIGNALSRLATCH_HPP_INCLUDED
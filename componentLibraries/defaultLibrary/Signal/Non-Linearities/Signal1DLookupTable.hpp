@@ -91,6 +91,19 @@ namespace hopsan {
 
             if ( mLookupTable.isEmpty() || mReloadCSV )
             {
+                // Components that load the same data with the same options share the table data
+                const HString sourceKey = mUseTextInput ? getLookupTableSourceKey("", mTextInput) : getLookupTableSourceKey(findFilePath(mFileName), "");
+                HString sharedKey;
+                if (!sourceKey.empty())
+                {
+                    sharedKey = "Signal1DLookupTable:"+sourceKey+":"+mSeparatorChar+":"+mCommentChar+":"+to_hstring(mNumLinesToSkip)+":"+to_hstring(mInDataId)+":"+to_hstring(mOutDataId);
+                }
+                if (getSharedLookupTable(sharedKey, mLookupTable))
+                {
+                    simulateOneTimestep();
+                    return;
+                }
+
                 bool isOK=false;
                 mLookupTable.clear();
 
@@ -185,6 +198,10 @@ namespace hopsan {
                         }
                         stopSimulation();
                     }
+                    else
+                    {
+                        addSharedLookupTable(sharedKey, mLookupTable);
+                    }
                 }
             }
             simulateOneTimestep();
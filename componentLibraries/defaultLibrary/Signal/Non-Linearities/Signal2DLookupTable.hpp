@@ -86,6 +86,19 @@ namespace hopsan {
 
             if ( mLookupTable.isEmpty() || mReloadCSV )
             {
+                // Components that load the same data with the same options share the table data
+                const HString sourceKey = mUseTextInput ? getLookupTableSourceKey("", mTextInput) : getLookupTableSourceKey(findFilePath(mFileName), "");
+                HString sharedKey;
+                if (!sourceKey.empty())
+                {
+                    sharedKey = "Signal2DLookupTable:"+sourceKey+":"+mCommentChar+":"+to_hstring(mNumLinesToSkip);
+                }
+                if (getSharedLookupTable(sharedKey, mLookupTable))
+                {
+                    simulateOneTimestep();
+                    return;
+                }
+
                 bool isOK=false;
                 mLookupTable.clear();
 
@@ -213,6 +226,10 @@ namespace hopsan {
                         }
                         stopSimulation();
                     }
+                    else
+                    {
+                        addSharedLookupTable(sharedKey, mLookupTable);
+                    }
                 }
             }
             simulateOneTimestep();
@@ -80,6 +80,16 @@ namespace hopsan {
             (*mpND_out) = mHyst.getValue((*mpND_in), (*mpHysteresisWidth), mDelayedInput.getOldest());
             mDelayedInput.update((*mpND_out));
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mDelayedInput.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mDelayedInput.restoreState(rReader);
+        }
     };
 }
 
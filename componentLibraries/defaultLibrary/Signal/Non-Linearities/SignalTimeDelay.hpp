@@ -78,6 +78,16 @@ namespace hopsan {
         {
             (*mpND_out) =  mDelay.update(*mpND_in);
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mDelay.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mDelay.restoreState(rReader);
+        }
     };
 }
 
@@ -168,6 +168,27 @@ namespace hopsan {
                 mpDelay = 0;
             }
         }
+
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            if (mpDelay)
+            {
+                mpDelay->saveState(rWriter);
+            }
+            else
+            {
+                rWriter.write(size_t(0));
+            }
+        }
+
+        //! @note The buffer is resized to the saved delay, it is resized again in the next time step if the delay input differs
+        void restoreState(ComponentStateReader &rReader)
+        {
+            if (mpDelay)
+            {
+                mpDelay->restoreState(rReader);
+            }
+        }
     };
 }
 
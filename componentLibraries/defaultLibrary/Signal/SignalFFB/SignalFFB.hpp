@@ -181,5 +181,21 @@ block","",0.,&mpexitb);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldExit);
+        rWriter.write(oldLeave);
+        rWriter.write(oldState);
+        rWriter.write(oldSet);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldExit);
+        rReader.read(oldLeave);
+        rReader.read(oldState);
+        rReader.read(oldSet);
+    }
 };
 #endif // SIGNALFFB_HPP_INCLUDED
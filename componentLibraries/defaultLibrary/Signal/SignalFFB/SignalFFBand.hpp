@@ -165,5 +165,23 @@ onPositive(-0.5 + state1));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldExiting);
+        rWriter.write(oldIn0);
+        rWriter.write(oldState0);
+        rWriter.write(oldIn1);
+        rWriter.write(oldState1);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldExiting);
+        rReader.read(oldIn0);
+        rReader.read(oldState0);
+        rReader.read(oldIn1);
+        rReader.read(oldState1);
+    }
 };
 #endif // SIGNALFFBAND_HPP_INCLUDED
@@ -156,5 +156,19 @@ onPositive(-0.5 + oldOut0) + onPositive(-0.5 + oldState));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldIn0);
+        rWriter.write(oldOut0);
+        rWriter.write(oldState);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldIn0);
+        rReader.read(oldOut0);
+        rReader.read(oldState);
+    }
 };
 #endif // SIGNALFFBANDIN_HPP_INCLUDED
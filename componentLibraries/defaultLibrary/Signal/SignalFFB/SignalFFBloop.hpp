@@ -164,5 +164,21 @@ onPositive(-0.5 + oldOut0 + oldOut1) + onPositive(-0.5 + oldState));
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(oldIn0);
+        rWriter.write(oldOut0);
+        rWriter.write(oldOut1);
+        rWriter.write(oldState);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(oldIn0);
+        rReader.read(oldOut0);
+        rReader.read(oldOut1);
+        rReader.read(oldState);
+    }
 };
 #endif // SIGNALFFBLOOP_HPP_INCLUDED
@@ -1653,5 +1653,99 @@ mTimestep*Power(q3,2)*Wb - 2*zcg)/2.;
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(Ub);
+        rWriter.write(Vb);
+        rWriter.write(Wb);
+        rWriter.write(zcg);
+        rWriter.write(Pb);
+        rWriter.write(Rb);
+        rWriter.write(Qb);
+        rWriter.write(q0);
+        rWriter.write(q1);
+        rWriter.write(q2);
+        rWriter.write(q3);
+        rWriter.write(xcg);
+        rWriter.write(ycg);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart31.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+        mDelayedPart41.saveState(rWriter);
+        mDelayedPart50.saveState(rWriter);
+        mDelayedPart51.saveState(rWriter);
+        mDelayedPart60.saveState(rWriter);
+        mDelayedPart61.saveState(rWriter);
+        mDelayedPart70.saveState(rWriter);
+        mDelayedPart71.saveState(rWriter);
+        mDelayedPart80.saveState(rWriter);
+        mDelayedPart81.saveState(rWriter);
+        mDelayedPart90.saveState(rWriter);
+        mDelayedPart91.saveState(rWriter);
+        mDelayedPart100.saveState(rWriter);
+        mDelayedPart101.saveState(rWriter);
+        mDelayedPart110.saveState(rWriter);
+        mDelayedPart111.saveState(rWriter);
+        mDelayedPart120.saveState(rWriter);
+        mDelayedPart121.saveState(rWriter);
+        mDelayedPart130.saveState(rWriter);
+        mDelayedPart131.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(Ub);
+        rReader.read(Vb);
+        rReader.read(Wb);
+        rReader.read(zcg);
+        rReader.read(Pb);
+        rReader.read(Rb);
+        rReader.read(Qb);
+        rReader.read(q0);
+        rReader.read(q1);
+        rReader.read(q2);
+        rReader.read(q3);
+        rReader.read(xcg);
+        rReader.read(ycg);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart31.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+        mDelayedPart41.restoreState(rReader);
+        mDelayedPart50.restoreState(rReader);
+        mDelayedPart51.restoreState(rReader);
+        mDelayedPart60.restoreState(rReader);
+        mDelayedPart61.restoreState(rReader);
+        mDelayedPart70.restoreState(rReader);
+        mDelayedPart71.restoreState(rReader);
+        mDelayedPart80.restoreState(rReader);
+        mDelayedPart81.restoreState(rReader);
+        mDelayedPart90.restoreState(rReader);
+        mDelayedPart91.restoreState(rReader);
+        mDelayedPart100.restoreState(rReader);
+        mDelayedPart101.restoreState(rReader);
+        mDelayedPart110.restoreState(rReader);
+        mDelayedPart111.restoreState(rReader);
+        mDelayedPart120.restoreState(rReader);
+        mDelayedPart121.restoreState(rReader);
+        mDelayedPart130.restoreState(rReader);
+        mDelayedPart131.restoreState(rReader);
+    }
 };
 #endif // AEROAIRCRAFT6DOF_HPP_INCLUDED
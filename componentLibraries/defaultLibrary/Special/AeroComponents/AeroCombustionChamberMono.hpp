@@ -138,7 +138,7 @@ private:
      Delay mDelayedPart11;
      Delay mDelayedPart20;
      Delay mDelayedPart30;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -197,7 +197,7 @@ chamber","kg/m3",0.,&mprhogas);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -381,5 +381,41 @@ gam)/(2.*(-1 + gam)))*Med);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(c2);
+        rWriter.write(mdot);
+        rWriter.write(Tc);
+        rWriter.write(c1);
+        rWriter.write(rhogas);
+        rWriter.write(pc);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(c2);
+        rReader.read(mdot);
+        rReader.read(Tc);
+        rReader.read(c1);
+        rReader.read(rhogas);
+        rReader.read(pc);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+    }
 };
 #endif // AEROCOMBUSTIONCHAMBERMONO_HPP_INCLUDED
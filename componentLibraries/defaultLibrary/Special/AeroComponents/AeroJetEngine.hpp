@@ -105,7 +105,7 @@ private:
      double *mpqmfuel;
      Delay mDelayedPart10;
      Delay mDelayedPart11;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<1> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -163,7 +163,7 @@ flow","kg/s",1.,&mpqmfuel);
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,1);
+        mpSolver = new FixedSizeEquationSystemSolver<1>(this);
      }
 
     void initialize()
@@ -281,5 +281,27 @@ flow","kg/s",1.,&mpqmfuel);
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(Shspeed);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(Shspeed);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+    }
 };
 #endif // AEROJETENGINE_HPP_INCLUDED
@@ -115,7 +115,7 @@ private:
      double *mpJp;
      Delay mDelayedPart10;
      Delay mDelayedPart20;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<2> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -168,7 +168,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,2);
+        mpSolver = new FixedSizeEquationSystemSolver<2>(this);
      }
 
     void initialize()
@@ -330,5 +330,29 @@ Power(Abs(g1 - (g2*Up)/(dp*(0.00001 + 0.159155*wmr1))),-k)),1/k))/Abs(g1 - \
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(thrust);
+        rWriter.write(cmr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(thrust);
+        rReader.read(cmr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+    }
 };
 #endif // AEROPROPELLER_HPP_INCLUDED
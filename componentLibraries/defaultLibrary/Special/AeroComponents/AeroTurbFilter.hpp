@@ -96,7 +96,7 @@ private:
      Delay mDelayedPart30;
      Delay mDelayedPart31;
      Delay mDelayedPart32;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<3> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -143,7 +143,7 @@ speed","m/s",0.,&mpdw);
             addConstant("Lu", "turbulence scale length", "ms/", 525.,Lu);
             addConstant("Lv", "turbulence scale length", "ms/", 525.,Lv);
             addConstant("Lw", "turbulence scale length", "ms/", 525.,Lw);
-        mpSolver = new EquationSystemSolver(this,3);
+        mpSolver = new FixedSizeEquationSystemSolver<3>(this);
      }
 
     void initialize()
@@ -312,5 +312,43 @@ V),1.5) + dw*Power(mTimestep,2)*Power(Abs(1 + V),2))/(16.*Power(Lw,2) + \
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(du);
+        rWriter.write(dv);
+        rWriter.write(dw);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart11.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart22.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart31.saveState(rWriter);
+        mDelayedPart32.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(du);
+        rReader.read(dv);
+        rReader.read(dw);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart11.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart22.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart31.restoreState(rReader);
+        mDelayedPart32.restoreState(rReader);
+    }
 };
 #endif // AEROTURBFILTER_HPP_INCLUDED
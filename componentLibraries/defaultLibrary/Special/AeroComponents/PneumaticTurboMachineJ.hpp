@@ -148,7 +148,7 @@ private:
      Delay mDelayedPart21;
      Delay mDelayedPart30;
      Delay mDelayedPart40;
-     EquationSystemSolver *mpSolver = nullptr;
+     FixedSizeEquationSystemSolver<7> *mpSolver = nullptr;
 
 public:
      static Component *Creator()
@@ -197,7 +197,7 @@ public:
 
 //==This code has been autogenerated using Compgen==
         //Add constantParameters
-        mpSolver = new EquationSystemSolver(this,7);
+        mpSolver = new FixedSizeEquationSystemSolver<7>(this);
      }
 
     void initialize()
@@ -1166,5 +1166,45 @@ gn(qmp2) - \
     {
         delete mpSolver;
     }
+
+    void saveState(ComponentStateWriter &rWriter) const
+    {
+        rWriter.write(qmp2);
+        rWriter.write(wmr1);
+        rWriter.write(dEp1);
+        rWriter.write(dEp2);
+        rWriter.write(pp1);
+        rWriter.write(pp2);
+        rWriter.write(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rWriter.write(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.saveState(rWriter);
+        mDelayedPart20.saveState(rWriter);
+        mDelayedPart21.saveState(rWriter);
+        mDelayedPart30.saveState(rWriter);
+        mDelayedPart40.saveState(rWriter);
+    }
+
+    void restoreState(ComponentStateReader &rReader)
+    {
+        rReader.read(qmp2);
+        rReader.read(wmr1);
+        rReader.read(dEp1);
+        rReader.read(dEp2);
+        rReader.read(pp1);
+        rReader.read(pp2);
+        rReader.read(tormr1);
+        for (int i=0; i<delayedPart.rows(); ++i)
+        {
+            rReader.read(delayedPart[i], size_t(delayedPart.cols()));
+        }
+        mDelayedPart10.restoreState(rReader);
+        mDelayedPart20.restoreState(rReader);
+        mDelayedPart21.restoreState(rReader);
+        mDelayedPart30.restoreState(rReader);
+        mDelayedPart40.restoreState(rReader);
+    }
 };
 #endif // PNEUMATICTURBOMACHINEJ_HPP_INCLUDED
@@ -273,6 +273,22 @@ namespace hopsan {
             (*mpA) = a;
         }
 
+        void saveState(ComponentStateWriter &rWriter) const
+        {
+            mFilterX.saveState(rWriter);
+            mFilterV.saveState(rWriter);
+            mFilterA.saveState(rWriter);
+            mFilterW.saveState(rWriter);
+        }
+
+        void restoreState(ComponentStateReader &rReader)
+        {
+            mFilterX.restoreState(rReader);
+            mFilterV.restoreState(rReader);
+            mFilterA.restoreState(rReader);
+            mFilterW.restoreState(rReader);
+        }
+
 
         void finalize()
         {
@@ -24,11 +24,13 @@ extern "C" {
     HOPSANC_DLLAPI int loadLibrary(const char* path);
     HOPSANC_DLLAPI int getMessage(char* buf, size_t bufSize);
     HOPSANC_DLLAPI int loadModel(const char* path);
+    HOPSANC_DLLAPI int loadModelCached(const char* path, const char* cachePath);
     HOPSANC_DLLAPI int setParameter(const char* name, const char *value);
     HOPSANC_DLLAPI int setStartTime(double value);
     HOPSANC_DLLAPI int setTimeStep(double value);
     HOPSANC_DLLAPI int setStopTime(double value);
     HOPSANC_DLLAPI int setNumberOfLogSamples(size_t value);
+    HOPSANC_DLLAPI int setLogOnlyVariables(const char *variables);
     HOPSANC_DLLAPI int simulate();
     HOPSANC_DLLAPI int getTimeVector(double *data);
     HOPSANC_DLLAPI int getDataVector(const char *variable, double *data);
@@ -63,14 +63,9 @@ int getMessage(char* buf, size_t bufSize) {
     return -1;
 }
 
-//! @brief Loads specified model file
-//! @param [in] Full path to model file
+//! @brief Finishes loading of the model in spCoreComponentSystem
 //! @returns Status (0 = success)
-int loadModel(const char* path) {
-    if(spCoreComponentSystem) {
-        delete spCoreComponentSystem;
-    }
-    spCoreComponentSystem = gHopsanCore.loadHMFModelFile(path, startTime, stopTime);
+static int finishLoadModel() {
     if(!spCoreComponentSystem) {
         printMessage("Failed to instantiate model!");
         printWaitingMessages(gHopsanCore, false, false);
@@ -83,6 +78,30 @@ int loadModel(const char* path) {
     return 0;
 }
 
+//! @brief Loads specified model file
+//! @param [in] Full path to model file
+//! @returns Status (0 = success)
+int loadModel(const char* path) {
+    if(spCoreComponentSystem) {
+        delete spCoreComponentSystem;
+    }
+    spCoreComponentSystem = gHopsanCore.loadHMFModelFile(path, startTime, stopTime);
+    return finishLoadModel();
+}
+
+//! @brief Loads specified model file through a binary model cache file
+//! The cache file is used if it is up to date, otherwise the model file is loaded and the cache is rewritten
+//! @param [in] path Full path to model file
+//! @param [in] cachePath Full path to model cache file
+//! @returns Status (0 = success)
+int loadModelCached(const char* path, const char* cachePath) {
+    if(spCoreComponentSystem) {
+        delete spCoreComponentSystem;
+    }
+    spCoreComponentSystem = gHopsanCore.loadHMFModelFileCached(path, cachePath, startTime, stopTime);
+    return finishLoadModel();
+}
+
 
 //! @brief Provides specified data vector from last simulation
 //! @param [in] variable Variable name ("component.port.variable")
@@ -118,10 +137,12 @@ int getDataVector(const char* variable, double *data)
         pSystem->getAliasHandler().getVariableFromAlias(splitVar[0], compName, portName, varId);
         hopsan::Component *pComp = pSystem->getSubComponent(compName);
         hopsan::Port *pPort = pComp->getPort(portName);
-        std::vector< std::vector<double> > *pLogData = pPort->getLogDataVectorPtr();
-        for (size_t t=0; t<pSystem->getNumActuallyLoggedSamples(); ++t) {
-            data[t] = (*pLogData)[t][size_t(varId)];
+        const hopsan::LogDataStore *pLogData = pPort->getLogDataStorePtr();
+        if(!pLogData->isLogged(size_t(varId))) {
+            printMessage("Error: Variable is not logged: "+varStr);
+            return -1;
         }
+        memcpy(data, pLogData->getColumn(size_t(varId)), pSystem->getNumActuallyLoggedSamples()*sizeof(double));
         return 0;   //Found alias variable!
     }
     else if(splitVar.size() < 3) {
@@ -161,10 +182,12 @@ int getDataVector(const char* variable, double *data)
         return -1;
     }
 
-    std::vector< std::vector<double> > *pLogData = pPort->getLogDataVectorPtr();
-    for (size_t t=0; t<spCoreComponentSystem->getNumActuallyLoggedSamples(); ++t) {
-        data[t] = (*pLogData)[t][size_t(varId)];
+    const hopsan::LogDataStore *pLogData = pPort->getLogDataStorePtr();
+    if(!pLogData->isLogged(size_t(varId))) {
+        printMessage("Error: Variable is not logged: "+varStr);
+        return -1;
     }
+    memcpy(data, pLogData->getColumn(size_t(varId)), spCoreComponentSystem->getNumActuallyLoggedSamples()*sizeof(double));
     return 0;
 }
 
@@ -363,6 +386,36 @@ int setNumberOfLogSamples(size_t value)
 }
 
 
+//! @brief Specifies that only some variables shall be logged in the next simulation, saving memory and time
+//! @param [in] variables Comma separated list of variable names ("component.port.variable" or "component.port"), empty string logs all variables
+//! @returns Status (0 = success)
+int setLogOnlyVariables(const char *variables)
+{
+    if(!spCoreComponentSystem) {
+        printMessage("Error: No model is loaded.");
+        return -1;
+    }
+
+    hopsan::HString variablesStr(variables);
+    if(variablesStr.empty()) {
+        spCoreComponentSystem->clearLogOnlyVariables();
+        return 0;
+    }
+
+    //Convert "system|component.port.variable" to the core format "system$component#port#variable"
+    std::vector<hopsan::HString> fullNames;
+    hopsan::HVector<hopsan::HString> varVec = variablesStr.split(',');
+    for(size_t i=0; i<varVec.size(); ++i) {
+        hopsan::HString fullName = varVec[i];
+        fullName.replace("|", "$");
+        fullName.replace(".", "#");
+        fullNames.push_back(fullName);
+    }
+    spCoreComponentSystem->setLogOnlyVariables(fullNames);
+    return 0;
+}
+
+
 //! @brief Returns number of logged samples from last simulation
 //! @returns Number of samples
 size_t getNumberOfLogSamples()
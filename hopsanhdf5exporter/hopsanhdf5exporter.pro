@@ -28,10 +28,12 @@ include($${PWD}/../dependencies/hdf5.pri)
 have_hdf5(){
   DEFINES *= USEHDF5
   SOURCES += \
-        hopsanhdf5exporter.cpp
+        hopsanhdf5exporter.cpp \
+        hopsanhdf5logsink.cpp
 
   HEADERS += \
-        hopsanhdf5exporter.h
+        hopsanhdf5exporter.h \
+        hopsanhdf5logsink.h
 
   !build_pass:message("Compiling hopsanhdf5exporter with HDF5 support")
 } else {
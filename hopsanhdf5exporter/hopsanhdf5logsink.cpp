@@ -0,0 +1,180 @@
+#include "hopsanhdf5logsink.h"
+#include "H5Cpp.h"
+
+#include <algorithm>
+#include <ctime>
+#include <set>
+
+using namespace hopsan;
+
+// Defined in hopsanhdf5exporter.cpp
+void appendH5Attribute(H5::H5Object &rObject, const H5std_string &attrName, const H5std_string &attrValue);
+
+class HopsanHDF5LogSinkPrivates
+{
+public:
+    H5::H5File mFile;
+    H5::DataSet mTimeDataSet;
+    //! @brief One or two (with alias) data sets per variable
+    std::vector<std::vector<H5::DataSet> > mVariableDataSets;
+    std::vector<double> mColumn;
+    hsize_t mNumWrittenSamples = 0;
+};
+
+namespace {
+
+//! @brief Create an empty one dimensional data set that can be extended
+H5::DataSet createExtendibleDataSet(H5::H5File &rFile, const HString &rName, const hsize_t chunkSamples)
+{
+    hsize_t dims[1] = {0};
+    hsize_t maxDims[1] = {H5S_UNLIMITED};
+    H5::DataSpace dataspace(1, dims, maxDims);
+    H5::DSetCreatPropList properties;
+    hsize_t chunkDims[1] = {chunkSamples};
+    properties.setChunk(1, chunkDims);
+    return rFile.createDataSet(rName.c_str(), H5::PredType::NATIVE_DOUBLE, dataspace, properties);
+}
+
+//! @brief Append values at the end of an extendible data set
+void appendToDataSet(H5::DataSet &rDataSet, const double *pData, const hsize_t offset, const hsize_t count)
+{
+    hsize_t newSize[1] = {offset+count};
+    rDataSet.extend(newSize);
+    H5::DataSpace filespace = rDataSet.getSpace();
+    hsize_t start[1] = {offset};
+    hsize_t length[1] = {count};
+    filespace.selectHyperslab(H5S_SELECT_SET, length, start);
+    H5::DataSpace memspace(1, length);
+    rDataSet.write(pData, H5::PredType::NATIVE_DOUBLE, memspace, filespace);
+}
+
+}
+
+//! @brief Constructor
+//! @param[in] rFilePath The file to write, it is truncated when the sink is opened
+//! @param[in] rToolName The tool name attribute written to the file
+//! @param[in] bufferSamples The number of samples in each of the two buffers, also used as HDF5 chunk size
+HopsanHDF5LogSink::HopsanHDF5LogSink(const hopsan::HString &rFilePath, const hopsan::HString &rToolName, const size_t bufferSamples) :
+    ThreadedLogSink(bufferSamples),
+    mFilePath(rFilePath),
+    mToolName(rToolName),
+    mChunkSamples(std::max(bufferSamples, size_t(1))),
+    mpPrivates(nullptr) {}
+
+HopsanHDF5LogSink::~HopsanHDF5LogSink()
+{
+    close();
+}
+
+bool HopsanHDF5LogSink::openOutput(const HString &rSystemName, const std::vector<LogSinkVariable> &rVariables)
+{
+    delete mpPrivates;
+    mpPrivates = new HopsanHDF5LogSinkPrivates();
+    try {
+        // turn off auto printing of thrown exceptions so that they can be handled below
+        H5::Exception::dontPrint();
+
+        mpPrivates->mFile = H5::H5File(mFilePath.c_str(), H5F_ACC_TRUNC);
+
+        //Generate date and time string
+        time_t rawtime;
+        struct tm * timeinfo;
+        char timestr[100];
+        time (&rawtime);
+        timeinfo = localtime(&rawtime);
+        std::strftime(timestr,sizeof(timestr),"%a %b %d %H:%M:%S %Y",timeinfo);
+
+        H5::Group root = mpPrivates->mFile.openGroup("/");
+        appendH5Attribute(root, "date", timestr);
+        appendH5Attribute(root, "model", rSystemName.c_str());
+        appendH5Attribute(root, "tool", mToolName.c_str());
+
+        // Create the group hierarchy, one group depth at a time, the set sorts them in the correct order
+        std::set<HString> uniqueGroupPaths;
+        uniqueGroupPaths.insert("/results/");
+        for (const auto &rVar : rVariables) {
+            uniqueGroupPaths.insert("/results/"+rVar.componentName);
+            uniqueGroupPaths.insert("/results/"+rVar.componentName+"/"+rVar.portName);
+        }
+        for (const auto &groupPath : uniqueGroupPaths) {
+            mpPrivates->mFile.createGroup(groupPath.c_str());
+        }
+
+        mpPrivates->mTimeDataSet = createExtendibleDataSet(mpPrivates->mFile, "/results/Time", mChunkSamples);
+        appendH5Attribute(mpPrivates->mTimeDataSet, "Unit", "s");
+        appendH5Attribute(mpPrivates->mTimeDataSet, "Quantity", "Time");
+
+        std::set<HString> usedAliasNames;
+        for (const auto &rVar : rVariables) {
+            std::vector<HString> names;
+            names.push_back("/results/"+rVar.componentName+"/"+rVar.portName+"/"+rVar.variableName);
+            // If variable has an alias then create an additional data set with the alias name (only once, since ports sharing a node have the same alias)
+            if (!rVar.alias.empty() && usedAliasNames.insert(rVar.alias).second) {
+                names.push_back("/results/"+rVar.alias);
+            }
+
+            mpPrivates->mVariableDataSets.push_back(std::vector<H5::DataSet>());
+            for (const auto &rName : names) {
+                H5::DataSet dataset = createExtendibleDataSet(mpPrivates->mFile, rName, mChunkSamples);
+                appendH5Attribute(dataset, "Unit", rVar.unit.c_str());
+                appendH5Attribute(dataset, "Quantity", rVar.quantity.c_str());
+                mpPrivates->mVariableDataSets.back().push_back(dataset);
+            }
+        }
+    }
+    catch(H5::Exception &e) {
+        mLastError = HString(e.getCDetailMsg())+" in "+HString(e.getCFuncName());
+        delete mpPrivates;
+        mpPrivates = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool HopsanHDF5LogSink::writeOutput(const double *pTime, const double *pValues, const size_t numSamples)
+{
+    if (!mpPrivates) {
+        return false;
+    }
+
+    const size_t numVariables = getNumVariables();
+    const hsize_t offset = mpPrivates->mNumWrittenSamples;
+    try {
+        appendToDataSet(mpPrivates->mTimeDataSet, pTime, offset, numSamples);
+
+        // Samples arrive one after the other, collect the values of each variable into a column before writing
+        std::vector<double> &rColumn = mpPrivates->mColumn;
+        rColumn.resize(numSamples);
+        for (size_t v=0; v<numVariables; ++v) {
+            for (size_t s=0; s<numSamples; ++s) {
+                rColumn[s] = pValues[s*numVariables+v];
+            }
+            for (auto &rDataSet : mpPrivates->mVariableDataSets[v]) {
+                appendToDataSet(rDataSet, rColumn.data(), offset, numSamples);
+            }
+        }
+    }
+    catch(H5::Exception &e) {
+        mLastError = HString(e.getCDetailMsg())+" in "+HString(e.getCFuncName());
+        return false;
+    }
+    mpPrivates->mNumWrittenSamples += numSamples;
+    return true;
+}
+
+bool HopsanHDF5LogSink::closeOutput()
+{
+    bool success = true;
+    if (mpPrivates) {
+        try {
+            mpPrivates->mFile.close();
+        }
+        catch(H5::Exception &e) {
+            mLastError = HString(e.getCDetailMsg())+" in "+HString(e.getCFuncName());
+            success = false;
+        }
+        delete mpPrivates;
+        mpPrivates = nullptr;
+    }
+    return success;
+}
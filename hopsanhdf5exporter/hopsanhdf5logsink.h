@@ -0,0 +1,28 @@
+#ifndef HOPSANHDF5LOGSINK_H
+#define HOPSANHDF5LOGSINK_H
+
+#include "HopsanEssentials.h"
+#include "CoreUtilities/LogSink.h"
+
+class HopsanHDF5LogSinkPrivates;
+
+//! @brief Log sink that streams results to an HDF5 file during simulation
+//! @details The file layout is the same as the one written by HopsanHDF5Exporter, but all datasets are extendible and grow as samples arrive
+class HopsanHDF5LogSink : public hopsan::ThreadedLogSink
+{
+public:
+    HopsanHDF5LogSink(const hopsan::HString &rFilePath, const hopsan::HString &rToolName, const size_t bufferSamples=4096);
+    ~HopsanHDF5LogSink();
+
+protected:
+    bool openOutput(const hopsan::HString &rSystemName, const std::vector<hopsan::LogSinkVariable> &rVariables);
+    bool writeOutput(const double *pTime, const double *pValues, const size_t numSamples);
+    bool closeOutput();
+
+private:
+    hopsan::HString mFilePath, mToolName;
+    size_t mChunkSamples;
+    HopsanHDF5LogSinkPrivates *mpPrivates;
+};
+
+#endif // HOPSANHDF5LOGSINK_H
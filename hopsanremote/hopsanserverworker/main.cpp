@@ -68,7 +68,7 @@ bool gHaveLoadedComponentLibraries=false;
 typedef struct
 {
     string fullName;
-    vector< vector<double> > *pData = 0;
+    const LogDataStore *pData = 0;
     vector< double > *pTimeData = 0;
     size_t dataLength = 0;
     size_t dataId = 0;
@@ -128,7 +128,7 @@ void collectAllModelVariables(ComponentSystem *pSys, vector<ModelVariableInfo_t>
                 }
 
                 //! @todo what about time vector
-                vector< vector<double> > *pLogData = pPort->getLogDataVectorPtr();
+                const LogDataStore *pLogData = pPort->getLogDataStorePtr();
 
                 const vector<NodeDataDescription> *pVars = pPort->getNodeDataDescriptions();
                 if (pVars)
@@ -138,7 +138,7 @@ void collectAllModelVariables(ComponentSystem *pSys, vector<ModelVariableInfo_t>
                         // Only write something if data has been logged (skip ports that are not logged)
                         // We assume that the data vector has been cleared
                         //! @todo check if log on
-                        if (pLogData->size() > 0)
+                        if (pLogData->getNumSlots() > 0)
                         {
                             const NodeDataDescription *pVarDesc = &(*pVars)[v];
                             ModelVariableInfo_t mvi;
@@ -910,10 +910,8 @@ int main(int argc, char* argv[])
                             // Copy if a data variable
                             if (rMvi.pData)
                             {
-                                for (size_t t=0; t<rMvi.dataLength; ++t)
-                                {
-                                    vars.back().data.push_back((*rMvi.pData)[t][rMvi.dataId]);
-                                }
+                                const double *pColumn = rMvi.pData->getColumn(rMvi.dataId);
+                                vars.back().data.assign(pColumn, pColumn+rMvi.dataLength);
                             }
                             // Copy if a time data variable
                             else if (rMvi.pTimeData)